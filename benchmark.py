@@ -1,4 +1,14 @@
 import subprocess
 
-subprocess.run(['Benchmark.exe'])
-subprocess.run(['Benchmark.exe', 'NOCULL'])
\ No newline at end of file
+subprocess.run(['Benchmark.exe', '--game', 'MeshShadingDemo.dll'])
+subprocess.run(['Benchmark.exe', 'NOCULL', '--game', 'MeshShadingDemo.dll'])
+
+# generated scenes, the NULL runs leave out the GPU and only measure the CPU side of a frame
+scenarios = [
+    ['--entities', '1000', '--materials', '16', '--lights', '64', '--dynamic', '0.1'],
+    ['--entities', '10000', '--materials', '64', '--lights', '256', '--dynamic', '0.1'],
+    ['--entities', '10000', '--materials', '64', '--lights', '256', '--dynamic', '0.5'],
+]
+for i, scenario in enumerate(scenarios):
+    subprocess.run(['Benchmark.exe', *scenario, '--output', f'scenario{i}.json'])
+    subprocess.run(['Benchmark.exe', 'NULL', *scenario, '--output', f'scenario{i}_null.json'])
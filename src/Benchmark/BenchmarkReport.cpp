@@ -0,0 +1,95 @@
+#include "BenchmarkReport.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using namespace Seele;
+
+BenchmarkReport::BenchmarkReport(const BenchmarkScenario& scenario) : scenario(scenario) {}
+
+void BenchmarkReport::addFrame(const GameViewTimings& timings, float frameTime) {
+    frames.add(timings);
+    frameTimes.add(frameTime);
+}
+
+void BenchmarkReport::write(const std::filesystem::path& path) const {
+    std::ofstream stream(path);
+    if (path.extension() == ".csv") {
+        writeCsv(stream);
+    } else {
+        writeJson(stream);
+    }
+}
+
+BenchmarkReport::Percentiles BenchmarkReport::compute(Array<float> samples) {
+    if (samples.empty()) {
+        return Percentiles{0, 0, 0, 0, 0, 0};
+    }
+    std::sort(samples.begin(), samples.end());
+    // nearest rank, so every reported value is one that was actually measured
+    auto percentile = [&samples](float p) {
+        size_t rank = size_t(std::ceil(p * samples.size()));
+        return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+    };
+    double sum = 0;
+    for (float s : samples) {
+        sum += s;
+    }
+    return Percentiles{
+        .min = samples.front(),
+        .mean = float(sum / samples.size()),
+        .p50 = percentile(0.5f),
+        .p90 = percentile(0.9f),
+        .p99 = percentile(0.99f),
+        .max = samples.back(),
+    };
+}
+
+Array<std::pair<std::string, BenchmarkReport::Percentiles>> BenchmarkReport::summarize() const {
+    auto phase = [this](float GameViewTimings::*member) {
+        Array<float> samples;
+        for (const auto& frame : frames) {
+            samples.add(frame.*member);
+        }
+        return compute(std::move(samples));
+    };
+    Array<std::pair<std::string, Percentiles>> result;
+    result.add({"frame", compute(frameTimes)});
+    result.add({"meshReset", phase(&GameViewTimings::meshReset)});
+    result.add({"systems", phase(&GameViewTimings::systems)});
+    result.add({"physics", phase(&GameViewTimings::physics)});
+    result.add({"commit", phase(&GameViewTimings::commit)});
+    result.add({"textureStreaming", phase(&GameViewTimings::textureStreaming)});
+    result.add({"createDescriptors", phase(&GameViewTimings::createDescriptors)});
+    result.add({"lightCommit", phase(&GameViewTimings::lightCommit)});
+    result.add({"recording", phase(&GameViewTimings::recording)});
+    return result;
+}
+
+void BenchmarkReport::writeJson(std::ofstream& stream) const {
+    nlohmann::json json;
+    json["scenario"] = {
+        {"entities", scenario.numEntities},
+        {"materials", scenario.numMaterials},
+        {"lights", scenario.numLights},
+        {"dynamicRatio", scenario.dynamicRatio},
+        {"warmupFrames", scenario.warmupFrames},
+        {"frames", frames.size()},
+        {"seed", scenario.seed},
+        {"depthCulling", scenario.depthCulling},
+        {"nullGraphics", scenario.nullGraphics},
+    };
+    for (const auto& [name, p] : summarize()) {
+        json["phases"][name] = {
+            {"min", p.min}, {"mean", p.mean}, {"p50", p.p50}, {"p90", p.p90}, {"p99", p.p99}, {"max", p.max},
+        };
+    }
+    stream << json.dump(4) << std::endl;
+}
+
+void BenchmarkReport::writeCsv(std::ofstream& stream) const {
+    stream << "phase,min,mean,p50,p90,p99,max" << std::endl;
+    for (const auto& [name, p] : summarize()) {
+        stream << name << "," << p.min << "," << p.mean << "," << p.p50 << "," << p.p90 << "," << p.p99 << "," << p.max << std::endl;
+    }
+}
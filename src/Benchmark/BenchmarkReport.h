@@ -0,0 +1,31 @@
+#pragma once
+#include "Scenario.h"
+#include "Window/GameView.h"
+
+namespace Seele {
+// per frame CPU times of a scenario run, reported as percentiles per phase
+class BenchmarkReport {
+  public:
+    BenchmarkReport(const BenchmarkScenario& scenario);
+    void addFrame(const GameViewTimings& timings, float frameTime);
+    // writes JSON unless the path ends in .csv
+    void write(const std::filesystem::path& path) const;
+
+  private:
+    struct Percentiles {
+        float min;
+        float mean;
+        float p50;
+        float p90;
+        float p99;
+        float max;
+    };
+    static Percentiles compute(Array<float> samples);
+    Array<std::pair<std::string, Percentiles>> summarize() const;
+    void writeJson(std::ofstream& stream) const;
+    void writeCsv(std::ofstream& stream) const;
+    BenchmarkScenario scenario;
+    Array<GameViewTimings> frames;
+    Array<float> frameTimes;
+};
+} // namespace Seele
@@ -0,0 +1,120 @@
+#include "MeshOptimizationBenchmark.h"
+#include "Graphics/Meshlet.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <fmt/core.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using namespace Seele;
+
+struct MeshFileStats {
+    std::string path;
+    MeshOptimizationStats before;
+    MeshOptimizationStats after;
+};
+
+static nlohmann::json toJson(const MeshOptimizationStats& stats) {
+    return {
+        {"vertices", stats.numVertices},
+        {"triangles", stats.numTriangles},
+        {"meshlets", stats.numMeshlets},
+        {"acmr", stats.getACMR()},
+        {"atvr", stats.getATVR()},
+        {"vertexFill", stats.getVertexFill()},
+        {"primitiveFill", stats.getPrimitiveFill()},
+    };
+}
+
+// the post processing of MeshLoader::import that changes the triangles, so these are the ones an import would optimize
+static bool analyzeFile(const std::filesystem::path& path, MeshFileStats& result) {
+    Assimp::Importer importer;
+    const aiScene* scene =
+        importer.ReadFile(path.string().c_str(), (uint32)(aiProcess_Triangulate | aiProcess_SortByPType | aiProcess_FindDegenerates));
+    if (scene == nullptr) {
+        return false;
+    }
+    result.path = path.string();
+    for (uint32 meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+        const aiMesh* mesh = scene->mMeshes[meshIndex];
+        if (!(mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)) {
+            continue;
+        }
+        Array<Vector> positions(mesh->mNumVertices);
+        for (uint32 i = 0; i < mesh->mNumVertices; ++i) {
+            positions[i] = Vector(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        }
+        Array<uint32> indices(mesh->mNumFaces * 3);
+        for (uint32 faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
+            indices[faceIndex * 3 + 0] = mesh->mFaces[faceIndex].mIndices[0];
+            indices[faceIndex * 3 + 1] = mesh->mFaces[faceIndex].mIndices[1];
+            indices[faceIndex * 3 + 2] = mesh->mFaces[faceIndex].mIndices[2];
+        }
+        result.before += analyzeMesh(positions, indices);
+        Array<uint32> vertexRemap;
+        uint32 numVertices = optimizeMesh(positions, indices, vertexRemap);
+        Array<Vector> optimizedPositions(numVertices);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (vertexRemap[i] != ~0u) {
+                optimizedPositions[vertexRemap[i]] = positions[i];
+            }
+        }
+        result.after += analyzeMesh(optimizedPositions, indices);
+    }
+    return true;
+}
+
+void Seele::runMeshOptimizationBenchmark(const BenchmarkScenario& scenario) {
+    Array<std::filesystem::path> files;
+    if (std::filesystem::is_directory(scenario.meshPath)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(scenario.meshPath)) {
+            if (entry.is_regular_file()) {
+                files.add(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else {
+        files.add(scenario.meshPath);
+    }
+    Array<MeshFileStats> results;
+    MeshOptimizationStats totalBefore;
+    MeshOptimizationStats totalAfter;
+    for (const auto& file : files) {
+        MeshFileStats stats;
+        // anything assimp can not read, like textures next to the meshes, is skipped
+        if (!analyzeFile(file, stats) || stats.before.numTriangles == 0) {
+            continue;
+        }
+        fmt::print("{}: {} triangles, ACMR {:.3f} -> {:.3f}, primitive fill {:.3f} -> {:.3f}\n", stats.path, stats.before.numTriangles,
+                   stats.before.getACMR(), stats.after.getACMR(), stats.before.getPrimitiveFill(), stats.after.getPrimitiveFill());
+        totalBefore += stats.before;
+        totalAfter += stats.after;
+        results.add(std::move(stats));
+    }
+    fmt::print("{} meshes, {} triangles: ACMR {:.3f} -> {:.3f}, vertex fill {:.3f} -> {:.3f}, primitive fill {:.3f} -> {:.3f}\n",
+               results.size(), totalBefore.numTriangles, totalBefore.getACMR(), totalAfter.getACMR(), totalBefore.getVertexFill(),
+               totalAfter.getVertexFill(), totalBefore.getPrimitiveFill(), totalAfter.getPrimitiveFill());
+
+    nlohmann::json json;
+    json["scenario"] = {
+        {"meshes", scenario.meshPath},
+        {"vertexCacheSize", vertexCacheSize},
+    };
+    nlohmann::json meshes = nlohmann::json::array();
+    for (const auto& stats : results) {
+        meshes.push_back({
+            {"path", stats.path},
+            {"before", toJson(stats.before)},
+            {"after", toJson(stats.after)},
+        });
+    }
+    json["meshes"] = meshes;
+    json["total"] = {
+        {"before", toJson(totalBefore)},
+        {"after", toJson(totalAfter)},
+    };
+    std::ofstream stream(scenario.outputPath);
+    stream << json.dump(4) << std::endl;
+}
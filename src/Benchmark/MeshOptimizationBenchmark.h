@@ -0,0 +1,8 @@
+#pragma once
+#include "Scenario.h"
+
+namespace Seele {
+// imports every mesh file at scenario.meshPath, a single file or a folder, the way MeshLoader does and reports
+// ACMR and meshlet fill of each mesh as it comes from the file and after optimizeMesh
+void runMeshOptimizationBenchmark(const BenchmarkScenario& scenario);
+} // namespace Seele
@@ -1,5 +1,6 @@
 #pragma once
 #include "Window/GameView.h"
+#include <fstream>
 
 namespace Seele {
 class PlayView : public GameView {
@@ -16,7 +17,12 @@ class PlayView : public GameView {
     virtual void keyCallback(Seele::KeyCode code, Seele::InputAction action, Seele::KeyModifier modifier) override;
 
   private:
-    std::thread queryThread;
+    // writes a line for every frame whose query results have arrived since the last call, never waits for the GPU
+    void writeFrameStats();
+    std::ofstream stats;
+    // oldest frame that was not written yet
+    uint64 nextStatsFrame = 0;
+    uint64 statsStart = 0;
     Gfx::OTimestampQuery renderTimestamp;
 };
 DECLARE_REF(PlayView)
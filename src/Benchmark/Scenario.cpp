@@ -0,0 +1,173 @@
+#include "Scenario.h"
+#include "Asset/AssetRegistry.h"
+#include "Asset/MaterialAsset.h"
+#include "Component/Camera.h"
+#include "Component/Mesh.h"
+#include "Component/PointLight.h"
+#include "Graphics/Mesh.h"
+#include <fmt/core.h>
+#include <random>
+
+using namespace Seele;
+using namespace Seele::System;
+
+static void printUsage() {
+    fmt::print("Benchmark [NOCULL] [NULL] [--entities N] [--materials M] [--lights K] [--dynamic RATIO]\n"
+               "          [--warmup FRAMES] [--frames FRAMES] [--seed SEED] [--output FILE.json|FILE.csv] [--game LIBRARY]\n"
+               "          [--trace FILE.json] [--textures N] [--meshes FILE|FOLDER]\n");
+}
+
+bool Seele::parseScenario(int argc, char** argv, BenchmarkScenario& scenario) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "NOCULL") {
+            scenario.depthCulling = false;
+            continue;
+        }
+        if (arg == "NULL") {
+            scenario.nullGraphics = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            printUsage();
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--entities") {
+                scenario.numEntities = std::stoul(value);
+            } else if (arg == "--materials") {
+                scenario.numMaterials = std::stoul(value);
+            } else if (arg == "--lights") {
+                scenario.numLights = std::stoul(value);
+            } else if (arg == "--dynamic") {
+                scenario.dynamicRatio = std::clamp(std::stof(value), 0.0f, 1.0f);
+            } else if (arg == "--warmup") {
+                scenario.warmupFrames = std::stoul(value);
+            } else if (arg == "--frames") {
+                scenario.numFrames = std::stoul(value);
+            } else if (arg == "--seed") {
+                scenario.seed = std::stoul(value);
+            } else if (arg == "--output") {
+                scenario.outputPath = value;
+            } else if (arg == "--game") {
+                scenario.gamePath = value;
+            } else if (arg == "--trace") {
+                scenario.tracePath = value;
+            } else if (arg == "--textures") {
+                scenario.numTextures = std::stoul(value);
+            } else if (arg == "--meshes") {
+                scenario.meshPath = value;
+            } else {
+                printUsage();
+                return false;
+            }
+        } catch (const std::logic_error&) {
+            fmt::print("Invalid value {} for {}\n", value, arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+ScenarioAnimator::ScenarioAnimator(PScene scene) : ComponentSystem<Component::Transform, Component::ScenarioMotion>(scene) {}
+
+ScenarioAnimator::~ScenarioAnimator() {}
+
+void ScenarioAnimator::update() { time += 1.0f / 60.0f; }
+
+void ScenarioAnimator::update(Component::Transform& transform, Component::ScenarioMotion& motion) {
+    float angle = motion.phase + time * motion.speed;
+    transform.setPosition(motion.center + Vector(std::cos(angle), 0, std::sin(angle)) * motion.radius);
+}
+
+ScenarioGame::ScenarioGame(const BenchmarkScenario& scenario) : scenario(scenario) {}
+
+ScenarioGame::~ScenarioGame() {}
+
+void ScenarioGame::setupScene(PScene scene, PSystemGraph graph) {
+    Array<PMeshAsset> meshes = AssetRegistry::getAllMeshes();
+    Array<PMaterialAsset> materials = AssetRegistry::getAllMaterials();
+    if (meshes.empty() || materials.empty()) {
+        fmt::print("The asset registry needs at least one mesh and one material to generate a scenario\n");
+        return;
+    }
+    std::mt19937 rng(scenario.seed);
+
+    materialInstances.clear();
+    for (uint32 i = 0; i < scenario.numMaterials; ++i) {
+        PMaterialAsset base = materials[i % materials.size()];
+        OMaterialInstance handle = base->getMaterial()->instantiate();
+        handle->setBaseMaterial(base);
+        OMaterialInstanceAsset instance = new MaterialInstanceAsset(base->getFolderPath(), fmt::format("Scenario{}", i));
+        instance->setHandle(std::move(handle));
+        instance->setBase(base);
+        materialInstances.add(std::move(instance));
+    }
+
+    // every combination of mesh and material that is used gets its own asset, so the material count really changes the number of
+    // distinct draws instead of only how the meshes were imported
+    meshVariants.clear();
+    uint32 numCombinations = meshes.size() * std::max<uint32>(1, scenario.numMaterials);
+    uint32 numVariants = std::max<uint32>(1, std::min<uint32>(scenario.numEntities, numCombinations));
+    for (uint32 i = 0; i < numVariants; ++i) {
+        PMeshAsset source = meshes[i % meshes.size()];
+        OMeshAsset variant = new MeshAsset(source->getFolderPath(), fmt::format("{}Scenario{}", source->getName(), i));
+        for (const auto& mesh : source->meshes) {
+            OMesh copy = new Mesh();
+            copy->transform = mesh->transform;
+            copy->vertexData = mesh->vertexData;
+            copy->id = mesh->id;
+            copy->vertexCount = mesh->vertexCount;
+            copy->byteSize = mesh->byteSize;
+            copy->referencedMaterial = materialInstances.empty() ? mesh->referencedMaterial
+                                                                 : PMaterialInstanceAsset(materialInstances[i % materialInstances.size()]);
+            variant->meshes.add(std::move(copy));
+        }
+        meshVariants.add(std::move(variant));
+    }
+
+    // a square grid that roughly keeps the same density no matter the entity count
+    uint32 gridSize = std::max<uint32>(1, uint32(std::ceil(std::sqrt(float(scenario.numEntities)))));
+    float spacing = 10.0f;
+    float extent = gridSize * spacing;
+    std::uniform_real_distribution<float> jitter(-spacing * 0.25f, spacing * 0.25f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    uint32 numDynamic = uint32(scenario.numEntities * scenario.dynamicRatio);
+    for (uint32 i = 0; i < scenario.numEntities; ++i) {
+        Vector position = Vector((i % gridSize) * spacing - extent / 2 + jitter(rng), 0, (i / gridSize) * spacing + jitter(rng));
+        entt::entity entity = scene->createEntity();
+        Component::Transform& transform = scene->attachComponent<Component::Transform>(entity);
+        transform.setPosition(position);
+        Component::Mesh& mesh = scene->attachComponent<Component::Mesh>(entity);
+        mesh.asset = meshVariants[i % meshVariants.size()];
+        // spread the dynamic entities over the grid instead of putting them all in the first rows
+        mesh.isStatic = uint64(i) * numDynamic / scenario.numEntities == uint64(i + 1) * numDynamic / scenario.numEntities;
+        if (!mesh.isStatic) {
+            scene->attachComponent<Component::ScenarioMotion>(entity, Component::ScenarioMotion{
+                                                                          .center = position,
+                                                                          .radius = spacing * 0.5f * unit(rng),
+                                                                          .speed = 0.5f + unit(rng),
+                                                                          .phase = unit(rng) * 6.2831853f,
+                                                                      });
+        }
+    }
+
+    for (uint32 i = 0; i < scenario.numLights; ++i) {
+        entt::entity entity = scene->createEntity();
+        Component::Transform& transform = scene->attachComponent<Component::Transform>(entity);
+        transform.setPosition(Vector(unit(rng) * extent - extent / 2, 2.0f + unit(rng) * 10.0f, unit(rng) * extent));
+        scene->attachComponent<Component::PointLight>(entity, Component::PointLight{
+                                                                  .color = Vector(unit(rng), unit(rng), unit(rng)),
+                                                                  .intensity = 10.0f + unit(rng) * 40.0f,
+                                                                  .attenuation = 0.1f,
+                                                              });
+    }
+
+    entt::entity camera = scene->createEntity();
+    Component::Transform& cameraTransform = scene->attachComponent<Component::Transform>(camera);
+    cameraTransform.setPosition(Vector(0, extent * 0.25f + 10.0f, -extent * 0.25f));
+    scene->attachComponent<Component::Camera>(camera, Component::Camera{.mainCamera = true});
+
+    graph->addSystem(new ScenarioAnimator(scene));
+}
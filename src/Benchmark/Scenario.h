@@ -0,0 +1,72 @@
+#pragma once
+#include "Asset/MaterialInstanceAsset.h"
+#include "Asset/MeshAsset.h"
+#include "Component/Transform.h"
+#include "Game.h"
+#include "System/ComponentSystem.h"
+
+namespace Seele {
+struct BenchmarkScenario {
+    uint32 numEntities = 1000;
+    uint32 numMaterials = 16;
+    uint32 numLights = 64;
+    // fraction of the entities that move every frame, the rest stays static
+    float dynamicRatio = 0.1f;
+    uint32 warmupFrames = 60;
+    uint32 numFrames = 500;
+    uint32 seed = 1;
+    bool depthCulling = true;
+    bool nullGraphics = false;
+    // .json or .csv, picked by the extension
+    std::string outputPath = "benchmark.json";
+    // runs this game library instead of a generated scene, like the benchmark used to
+    std::string gamePath;
+    // Chrome trace of the measured frames, nothing is profiled if empty
+    std::string tracePath;
+    // loads this many generated textures instead of rendering frames, see runTextureLoadBenchmark
+    uint32 numTextures = 0;
+    // reports the mesh optimization of these mesh files instead of rendering frames, see runMeshOptimizationBenchmark
+    std::string meshPath;
+};
+// arguments are "--name value" pairs, NOCULL and NULL are kept from the old command line
+bool parseScenario(int argc, char** argv, BenchmarkScenario& scenario);
+
+namespace Component {
+// moves an entity in a circle around center
+struct ScenarioMotion {
+    Vector center;
+    float radius;
+    float speed;
+    float phase;
+};
+} // namespace Component
+
+namespace System {
+class ScenarioAnimator : public ComponentSystem<Component::Transform, Component::ScenarioMotion> {
+  public:
+    ScenarioAnimator(PScene scene);
+    virtual ~ScenarioAnimator();
+    virtual void update() override;
+    virtual void update(Component::Transform& transform, Component::ScenarioMotion& motion) override;
+
+  private:
+    // advanced by a fixed step so every run moves the entities the same way, no matter how long the frames took
+    float time = 0;
+};
+} // namespace System
+
+// fills the scene with the meshes and materials of the asset registry
+class ScenarioGame : public Game {
+  public:
+    ScenarioGame(const BenchmarkScenario& scenario);
+    virtual ~ScenarioGame();
+    virtual void setupScene(PScene scene, PSystemGraph graph) override;
+
+  private:
+    BenchmarkScenario scenario;
+    // neither is registered, so nothing gets written back to the asset folder
+    Array<OMaterialInstanceAsset> materialInstances;
+    // copies of the registered meshes that only differ in their material
+    Array<OMeshAsset> meshVariants;
+};
+} // namespace Seele
@@ -0,0 +1,137 @@
+#include "TextureLoadBenchmark.h"
+#include "Asset/TextureAsset.h"
+#include "Graphics/TextureFormat.h"
+#include "ThreadPool.h"
+#include "ktx.h"
+#include <chrono>
+#include <fmt/core.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <random>
+
+using namespace Seele;
+
+// a full mip chain of a pattern that does not compress to nothing, encoded the same way TextureLoader does
+static Array<uint8> generateTexture(uint32 size, Gfx::TextureContent content, uint32 seed) {
+    bool srgb = content == Gfx::TextureContent::COLOR || content == Gfx::TextureContent::COLOR_ALPHA;
+    ktxTextureCreateInfo createInfo = {
+        .vkFormat = (uint32)(srgb ? Gfx::SE_FORMAT_R8G8B8A8_SRGB : Gfx::SE_FORMAT_R8G8B8A8_UNORM),
+        .baseWidth = size,
+        .baseHeight = size,
+        .baseDepth = 1,
+        .numDimensions = 2,
+        .numLevels = static_cast<uint32>(std::log2(size)) + 1,
+        .numLayers = 1,
+        .numFaces = 1,
+        .isArray = false,
+        .generateMipmaps = false,
+    };
+    ktxTexture2* kTexture = nullptr;
+    ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &kTexture);
+    std::mt19937 rng(seed);
+    for (uint32 level = 0; level < createInfo.numLevels; ++level) {
+        uint32 levelSize = std::max(size >> level, 1u);
+        Array<uint8> image(levelSize * levelSize * 4);
+        for (uint32 y = 0; y < levelSize; ++y) {
+            for (uint32 x = 0; x < levelSize; ++x) {
+                uint8* texel = &image[(x + y * levelSize) * 4];
+                texel[0] = uint8((x * 255) / levelSize);
+                texel[1] = uint8((y * 255) / levelSize);
+                texel[2] = uint8(rng());
+                texel[3] = content == Gfx::TextureContent::COLOR_ALPHA ? uint8((x ^ y) * 8) : 255;
+            }
+        }
+        ktxTexture_SetImageFromMemory(ktxTexture(kTexture), level, 0, 0, image.data(), image.size());
+    }
+    ktxBasisParams basisParams = {
+        .structSize = sizeof(ktxBasisParams),
+        .uastc = false,
+        .threadCount = 1,
+        .compressionLevel = KTX_ETC1S_DEFAULT_COMPRESSION_LEVEL,
+    };
+    ktxTexture2_CompressBasisEx(kTexture, &basisParams);
+    uint8 contentValue = (uint8)content;
+    ktxHashList_AddKVPair(&kTexture->kvDataHead, TextureAsset::CONTENT_KEY, 1, &contentValue);
+    uint8* data;
+    size_t dataSize;
+    ktxTexture_WriteToMemory(ktxTexture(kTexture), &data, &dataSize);
+    Array<uint8> result(dataSize);
+    std::memcpy(result.data(), data, dataSize);
+    free(data);
+    ktxTexture_Destroy(ktxTexture(kTexture));
+    return result;
+}
+
+void Seele::runTextureLoadBenchmark(Gfx::PGraphics graphics, const BenchmarkScenario& scenario) {
+    // a warm cache would skip the transcoding that is measured
+    getGlobals().cacheTranscodedTextures = false;
+    // and streaming would only upload the small levels
+    getGlobals().streamTextures = false;
+    std::mt19937 rng(scenario.seed);
+    std::uniform_int_distribution<uint32> sizeExponent(6, 11);
+    Array<uint32> sizes(scenario.numTextures);
+    Array<Array<uint8>> encoded(scenario.numTextures);
+    List<std::function<void()>> work;
+    uint64 numTexels = 0;
+    for (uint32 i = 0; i < scenario.numTextures; ++i) {
+        sizes[i] = 1u << sizeExponent(rng);
+        numTexels += uint64(sizes[i]) * sizes[i];
+        work.add([&, i]() { encoded[i] = generateTexture(sizes[i], Gfx::TextureContent(i % 4), scenario.seed + i); });
+    }
+    fmt::print("Encoding {} textures\n", scenario.numTextures);
+    getThreadPool().runAndWait(std::move(work));
+    uint64 encodedSize = 0;
+    for (const auto& data : encoded) {
+        encodedSize += data.size();
+    }
+
+    // fresh assets and buffers for every run, so both load the same way
+    auto prepare = [&](Array<OTextureAsset>& assets, Array<ArchiveBuffer>& buffers) {
+        for (uint32 i = 0; i < scenario.numTextures; ++i) {
+            assets.add(new TextureAsset("", fmt::format("Benchmark{}", i)));
+            ArchiveBuffer buffer(graphics);
+            Serialization::save(buffer, encoded[i]);
+            buffer.rewind();
+            buffers.add(std::move(buffer));
+        }
+    };
+    auto measure = [&](auto load) {
+        Array<OTextureAsset> assets;
+        Array<ArchiveBuffer> buffers;
+        prepare(assets, buffers);
+        auto start = std::chrono::high_resolution_clock::now();
+        load(assets, buffers);
+        graphics->waitDeviceIdle();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    };
+    float serialTime = measure([](Array<OTextureAsset>& assets, Array<ArchiveBuffer>& buffers) {
+        for (uint32 i = 0; i < assets.size(); ++i) {
+            assets[i]->load(buffers[i]);
+        }
+    });
+    float parallelTime = measure([](Array<OTextureAsset>& assets, Array<ArchiveBuffer>& buffers) {
+        Array<Pair<PTextureAsset, ArchiveBuffer*>> textures;
+        for (uint32 i = 0; i < assets.size(); ++i) {
+            textures.add(Pair<PTextureAsset, ArchiveBuffer*>{PTextureAsset(assets[i]), &buffers[i]});
+        }
+        TextureAsset::loadParallel(textures);
+    });
+    fmt::print("Loaded {} textures ({} MTexels, {} MB encoded): serial {:.1f} ms, parallel {:.1f} ms\n", scenario.numTextures,
+               numTexels / 1000000, encodedSize / 1000000, serialTime, parallelTime);
+
+    nlohmann::json json;
+    json["scenario"] = {
+        {"textures", scenario.numTextures},
+        {"texels", numTexels},
+        {"encodedBytes", encodedSize},
+        {"seed", scenario.seed},
+        {"nullGraphics", scenario.nullGraphics},
+    };
+    json["loadMs"] = {
+        {"serial", serialTime},
+        {"parallel", parallelTime},
+    };
+    std::ofstream stream(scenario.outputPath);
+    stream << json.dump(4) << std::endl;
+}
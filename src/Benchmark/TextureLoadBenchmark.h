@@ -0,0 +1,9 @@
+#pragma once
+#include "Graphics/Graphics.h"
+#include "Scenario.h"
+
+namespace Seele {
+// generates scenario.numTextures Basis textures between 64 and 2048 texels wide and times loading them,
+// once one after another and once with TextureAsset::loadParallel, the uploads are included
+void runTextureLoadBenchmark(Gfx::PGraphics graphics, const BenchmarkScenario& scenario);
+} // namespace Seele
@@ -1,15 +1,21 @@
 #include "Asset/AssetRegistry.h"
+#include "BenchmarkReport.h"
 #include "Graphics/Initializer.h"
+#include "Graphics/Null/Graphics.h"
 #include "Graphics/StaticMeshVertexData.h"
+#include "MeshOptimizationBenchmark.h"
 #ifdef __APPLE__
 #include "Graphics/Metal/Graphics.h"
 #else
 #include "Graphics/Vulkan/Graphics.h"
 #endif
 #include "PlayView.h"
+#include "Profiler.h"
+#include "Scenario.h"
+#include "TextureLoadBenchmark.h"
 #include "Window/WindowManager.h"
 #include <fmt/core.h>
-#include <random>
+#include <chrono>
 
 using namespace Seele;
 
@@ -17,32 +23,40 @@ using namespace Seele;
 static Gfx::OGraphics graphics;
 
 int main(int argc, char** argv) {
-    if (argc > 2)
-    {
+    BenchmarkScenario scenario;
+    if (!parseScenario(argc, argv, scenario)) {
         return -1;
     }
-    bool useDepthCulling = true;
-    if (argc == 2 && strcmp(argv[1], "NOCULL") == 0)
-    {
-        useDepthCulling = false;
-    }
-
-    std::filesystem::path binaryPath = "MeshShadingDemo.dll";
 
+    if (scenario.nullGraphics) {
+        graphics = new Null::Graphics();
+    } else {
 #ifdef __APPLE__
         graphics = new Metal::Graphics();
 #else
         graphics = new Vulkan::Graphics();
 #endif
+    }
     GraphicsInitializer initializer;
     graphics->init(initializer);
     StaticMeshVertexData* vd = StaticMeshVertexData::getInstance();
     vd->init(graphics);
-    getGlobals().useRayTracing = true;
+    // the game library decides for itself, generated scenarios only measure the raster path
+    getGlobals().useRayTracing = !scenario.gamePath.empty();
 
     OWindowManager windowManager = new WindowManager();
     AssetRegistry::init("Assets", graphics);
     vd->commitMeshes();
+    if (!scenario.meshPath.empty()) {
+        runMeshOptimizationBenchmark(scenario);
+        vd->destroy();
+        return 0;
+    }
+    if (scenario.numTextures > 0) {
+        runTextureLoadBenchmark(graphics, scenario);
+        vd->destroy();
+        return 0;
+    }
     WindowCreateInfo mainWindowInfo = {
         .width = 1920,
         .height = 1080,
@@ -57,13 +71,48 @@ int main(int argc, char** argv) {
                 .offset = {0, 0},
             },
     };
-    OGameView sceneView = new PlayView(graphics, window, sceneViewInfo, binaryPath.generic_string(), useDepthCulling);
-    sceneView->setFocused();
+    if (!scenario.gamePath.empty()) {
+        OGameView sceneView = new PlayView(graphics, window, sceneViewInfo, scenario.gamePath, scenario.depthCulling);
+        sceneView->setFocused();
+        getGlobals().profiling = !scenario.tracePath.empty();
+        while (windowManager->isActive()) {
+            windowManager->render();
+        }
+        graphics->waitDeviceIdle();
+        if (!scenario.tracePath.empty()) {
+            Profiler::writeChromeTrace(scenario.tracePath);
+        }
+        vd->destroy();
+        return 0;
+    }
 
-    while (windowManager->isActive()) {
+    ScenarioGame game(scenario);
+    OGameView sceneView = new GameView(graphics, window, sceneViewInfo, &game);
+    sceneView->setFocused();
+    getGlobals().useDepthCulling = scenario.depthCulling;
+    for (uint32 i = 0; i < scenario.warmupFrames && windowManager->isActive(); ++i) {
+        windowManager->render();
+    }
+    BenchmarkReport report(scenario);
+    if (!scenario.tracePath.empty()) {
+        // only the measured frames end up in the trace
+        Profiler::reset();
+        getGlobals().profiling = true;
+    }
+    for (uint32 i = 0; i < scenario.numFrames && windowManager->isActive(); ++i) {
+        auto frameStart = std::chrono::high_resolution_clock::now();
         windowManager->render();
+        auto frameEnd = std::chrono::high_resolution_clock::now();
+        report.addFrame(sceneView->getTimings(), std::chrono::duration<float, std::milli>(frameEnd - frameStart).count());
     }
     graphics->waitDeviceIdle();
+    report.write(scenario.outputPath);
+    fmt::print("Wrote {}\n", scenario.outputPath);
+    if (!scenario.tracePath.empty()) {
+        getGlobals().profiling = false;
+        Profiler::writeChromeTrace(scenario.tracePath);
+        fmt::print("Wrote {}\n", scenario.tracePath);
+    }
     vd->destroy();
 
     return 0;
@@ -9,21 +9,48 @@
 using namespace Seele;
 
 void AssetImporter::importMesh(MeshImportArgs args) {
-    if (get().registry->getOrCreateFolder(args.importPath)->meshes.contains(args.filePath.stem().string())) {
-        // skip importing duplicates
-        return;
+    std::string key = getPendingKey(args.filePath, args.importPath);
+    {
+        std::unique_lock l(get().importLock);
+        if (get().pendingImports.contains(key) || (AssetRegistry::containsMesh(args.importPath, args.filePath.stem().string()) &&
+                                                    get().importCache->isUpToDate(args.filePath, args.importPath))) {
+            // skip importing duplicates
+            return;
+        }
+        get().pendingImports.insert(key);
     }
-    get().meshLoader->importAsset(args);
+    // the mesh import runs synchronously, but imports textures itself, so the lock can't be held
+    Array<std::filesystem::path> textureFiles;
+    bool succeeded = get().meshLoader->importAsset(args, textureFiles);
+    finishImport(args.filePath, args.importPath, succeeded, textureFiles);
 }
 
 void AssetImporter::importTexture(TextureImportArgs args) {
-    if (get().registry->getOrCreateFolder(args.importPath)->textures.contains(args.filePath.stem().string())) {
+    std::unique_lock l(get().importLock);
+    std::string key = getPendingKey(args.filePath, args.importPath);
+    if (get().pendingImports.contains(key) || (AssetRegistry::containsTexture(args.importPath, args.filePath.stem().string()) &&
+                                                get().importCache->isUpToDate(args.filePath, args.importPath))) {
         // skip importing duplicates
         return;
     }
+    get().pendingImports.insert(key);
+    // only registers the asset, the conversion runs asynchronously and calls finishImport when it is done
     get().textureLoader->importAsset(args);
 }
 
+void AssetImporter::finishImport(const std::filesystem::path& filePath, std::string_view importPath, bool succeeded,
+                                 const Array<std::filesystem::path>& dependencies) {
+    std::unique_lock l(get().importLock);
+    get().pendingImports.erase(getPendingKey(filePath, importPath));
+    if (succeeded) {
+        get().importCache->markImported(filePath, importPath, dependencies);
+    }
+}
+
+std::string AssetImporter::getPendingKey(const std::filesystem::path& filePath, std::string_view importPath) {
+    return std::string(importPath) + "|" + filePath.generic_string();
+}
+
 void AssetImporter::importFont(FontImportArgs args) {
     if (get().registry->getOrCreateFolder(args.importPath)->fonts.contains(args.filePath.stem().string())) {
         // skip importing duplicates
@@ -55,8 +82,11 @@ void AssetImporter::init(Gfx::PGraphics graphics) {
     get().materialLoader = new MaterialLoader(graphics);
     get().fontLoader = new FontLoader(graphics);
     get().environmentLoader = new EnvironmentLoader(graphics);
+    get().importCache = new ImportCache(AssetRegistry::getRootFolder() / "ImportCache.json");
 }
 
+void AssetImporter::saveImportCache() { get().importCache->save(); }
+
 AssetImporter& AssetImporter::get() {
     static AssetImporter instance;
     return instance;
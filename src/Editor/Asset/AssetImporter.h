@@ -1,6 +1,9 @@
 #pragma once
 #include "MinimalEngine.h"
 #include "Asset/AssetRegistry.h"
+#include "ImportCache.h"
+#include <mutex>
+#include <unordered_set>
 
 
 namespace Seele {
@@ -17,14 +20,26 @@ class AssetImporter {
     static void importMaterial(struct MaterialImportArgs args);
     static void importEnvironmentMap(struct EnvironmentImportArgs args);
     static void init(Gfx::PGraphics graphics);
+    // called by the loaders once the import of a source file is over, only successful imports go into the import cache
+    // dependencies are other source files the import read, e.g. the textures of a mesh, a change to them imports it again
+    static void finishImport(const std::filesystem::path& filePath, std::string_view importPath, bool succeeded,
+                             const Array<std::filesystem::path>& dependencies = {});
+    // writes the import cache to disk, call once all pending imports are done
+    static void saveImportCache();
 
   private:
     static AssetImporter& get();
+    static std::string getPendingKey(const std::filesystem::path& filePath, std::string_view importPath);
     UPTextureLoader textureLoader;
     UPFontLoader fontLoader;
     UPMeshLoader meshLoader;
     UPMaterialLoader materialLoader;
     UPEnvironmentLoader environmentLoader;
     AssetRegistry* registry;
+    OImportCache importCache;
+    // importers can be called from worker threads, e.g. for textures referenced by a mesh
+    std::mutex importLock;
+    // sources that are being imported right now, they are neither imported twice nor marked as imported before they are done
+    std::unordered_set<std::string> pendingImports;
 };
 } // namespace Seele
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "ImportCache.h"
+#include <CRC.h>
+#include <fmt/core.h>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+using namespace Seele;
+using json = nlohmann::json;
+
+ImportCache::ImportCache(std::filesystem::path cacheFile) : cacheFile(cacheFile) {
+    if (!std::filesystem::exists(cacheFile)) {
+        return;
+    }
+    std::ifstream stream(cacheFile);
+    json j = json::parse(stream, nullptr, false);
+    if (j.is_discarded()) {
+        std::cout << "Discarding corrupt import cache " << cacheFile << std::endl;
+        return;
+    }
+    auto loadFileState = [](const json& value) {
+        return FileState{
+            .fileSize = value["size"].get<uint64>(),
+            .lastWriteTime = value["time"].get<int64>(),
+            .contentHash = value["hash"].get<uint64>(),
+        };
+    };
+    for (const auto& [key, value] : j.items()) {
+        Entry entry = Entry{
+            .source = loadFileState(value),
+        };
+        // entries written before dependencies were tracked have none
+        for (const auto& dependency : value.value("deps", json::array())) {
+            entry.dependencies.add(Pair<std::string, FileState>{dependency["path"].get<std::string>(), loadFileState(dependency)});
+        }
+        entries[key] = std::move(entry);
+    }
+}
+
+ImportCache::~ImportCache() {}
+
+bool ImportCache::isUpToDate(const std::filesystem::path& sourceFile, std::string_view importPath) {
+    std::string key = getKey(sourceFile, importPath);
+    Entry cached;
+    {
+        std::unique_lock l(cacheLock);
+        if (!entries.contains(key)) {
+            return false;
+        }
+        cached = entries[key];
+    }
+    bool touched = false;
+    if (!isUnchanged(sourceFile, cached.source, touched)) {
+        return false;
+    }
+    for (auto& [path, state] : cached.dependencies) {
+        if (!isUnchanged(path, state, touched)) {
+            return false;
+        }
+    }
+    if (touched) {
+        std::unique_lock l(cacheLock);
+        entries[key] = std::move(cached);
+        dirty = true;
+    }
+    return true;
+}
+
+void ImportCache::markImported(const std::filesystem::path& sourceFile, std::string_view importPath,
+                               const Array<std::filesystem::path>& dependencies) {
+    Entry entry;
+    if (!getFileState(sourceFile, entry.source)) {
+        return;
+    }
+    for (const auto& dependency : dependencies) {
+        std::string path = getPath(dependency);
+        // materials of a mesh often share their textures
+        bool duplicate = false;
+        for (const auto& existing : entry.dependencies) {
+            duplicate |= existing.key == path;
+        }
+        FileState state;
+        if (!duplicate && getFileState(dependency, state)) {
+            entry.dependencies.add(Pair<std::string, FileState>{path, state});
+        }
+    }
+    std::unique_lock l(cacheLock);
+    entries[getKey(sourceFile, importPath)] = std::move(entry);
+    dirty = true;
+}
+
+void ImportCache::save() {
+    std::unique_lock l(cacheLock);
+    if (!dirty) {
+        return;
+    }
+    auto saveFileState = [](const FileState& state) {
+        return json{
+            {"size", state.fileSize},
+            {"time", state.lastWriteTime},
+            {"hash", state.contentHash},
+        };
+    };
+    json j = json::object();
+    for (const auto& [key, entry] : entries) {
+        json value = saveFileState(entry.source);
+        if (!entry.dependencies.empty()) {
+            json dependencies = json::array();
+            for (const auto& [path, state] : entry.dependencies) {
+                json dependency = saveFileState(state);
+                dependency["path"] = path;
+                dependencies.push_back(std::move(dependency));
+            }
+            value["deps"] = std::move(dependencies);
+        }
+        j[key] = std::move(value);
+    }
+    std::ofstream stream(cacheFile);
+    stream << j.dump(1);
+    dirty = false;
+}
+
+std::string ImportCache::getKey(const std::filesystem::path& sourceFile, std::string_view importPath) {
+    return fmt::format("{0}:{1}", importPath, getPath(sourceFile));
+}
+
+std::string ImportCache::getPath(const std::filesystem::path& file) {
+    return std::filesystem::absolute(file).lexically_normal().generic_string();
+}
+
+bool ImportCache::getFileState(const std::filesystem::path& file, FileState& state) {
+    std::error_code ec;
+    uint64 fileSize = std::filesystem::file_size(file, ec);
+    if (ec) {
+        return false;
+    }
+    state = FileState{
+        .fileSize = fileSize,
+        .lastWriteTime = getLastWriteTime(file),
+        .contentHash = hashFile(file),
+    };
+    return true;
+}
+
+bool ImportCache::isUnchanged(const std::filesystem::path& file, FileState& state, bool& touched) {
+    std::error_code ec;
+    uint64 fileSize = std::filesystem::file_size(file, ec);
+    if (ec || fileSize != state.fileSize) {
+        return false;
+    }
+    int64 lastWriteTime = getLastWriteTime(file);
+    if (lastWriteTime == state.lastWriteTime) {
+        return true;
+    }
+    // the file was touched, but it might still have the same content, e.g. after a checkout
+    if (hashFile(file) != state.contentHash) {
+        return false;
+    }
+    state.lastWriteTime = lastWriteTime;
+    touched = true;
+    return true;
+}
+
+int64 ImportCache::getLastWriteTime(const std::filesystem::path& sourceFile) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(sourceFile, ec);
+    if (ec) {
+        return 0;
+    }
+    return time.time_since_epoch().count();
+}
+
+uint64 ImportCache::hashFile(const std::filesystem::path& sourceFile) {
+    std::ifstream stream(sourceFile, std::ios::binary);
+    Array<char> buffer(1 << 20);
+    CRC::Table<uint64, 64> table(CRC::CRC_64());
+    uint64 crc = 0;
+    bool first = true;
+    while (stream) {
+        stream.read(buffer.data(), buffer.size());
+        std::streamsize numRead = stream.gcount();
+        if (numRead <= 0) {
+            break;
+        }
+        crc = first ? CRC::Calculate(buffer.data(), numRead, table) : CRC::Calculate(buffer.data(), numRead, table, crc);
+        first = false;
+    }
+    return crc;
+}
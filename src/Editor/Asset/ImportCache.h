@@ -0,0 +1,47 @@
+#pragma once
+#include "Containers/Map.h"
+#include "Containers/Pair.h"
+#include "MinimalEngine.h"
+#include <filesystem>
+#include <mutex>
+
+namespace Seele {
+// Remembers the content of every source file that was imported, so that
+// importing an unchanged file again can be skipped
+// Entries are keyed by import path and source file, persisted as json
+class ImportCache {
+  public:
+    ImportCache(std::filesystem::path cacheFile);
+    ~ImportCache();
+    // true if the file was imported into importPath before and neither its content nor that of its dependencies changed since
+    bool isUpToDate(const std::filesystem::path& sourceFile, std::string_view importPath);
+    void markImported(const std::filesystem::path& sourceFile, std::string_view importPath,
+                      const Array<std::filesystem::path>& dependencies = {});
+    void save();
+
+  private:
+    struct FileState {
+        uint64 fileSize = 0;
+        int64 lastWriteTime = 0;
+        uint64 contentHash = 0;
+    };
+    struct Entry {
+        FileState source;
+        // keyed by absolute path, e.g. the texture files of a mesh, which are not imported again as long as the mesh is up to date
+        Array<Pair<std::string, FileState>> dependencies;
+    };
+    static std::string getKey(const std::filesystem::path& sourceFile, std::string_view importPath);
+    static std::string getPath(const std::filesystem::path& file);
+    // false if the file does not exist
+    static bool getFileState(const std::filesystem::path& file, FileState& state);
+    // a file that was only touched updates the write time of its state and sets touched
+    static bool isUnchanged(const std::filesystem::path& file, FileState& state, bool& touched);
+    static int64 getLastWriteTime(const std::filesystem::path& sourceFile);
+    static uint64 hashFile(const std::filesystem::path& sourceFile);
+    std::mutex cacheLock;
+    Map<std::string, Entry> entries;
+    std::filesystem::path cacheFile;
+    bool dirty = false;
+};
+DEFINE_REF(ImportCache)
+} // namespace Seele
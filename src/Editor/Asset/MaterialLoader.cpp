@@ -206,7 +206,6 @@ void MaterialLoader::import(MaterialImportArgs args, PMaterialAsset asset) {
                                    std::move(parameters), std::move(mat));
 
     asset->material->compile();
-    graphics->getShaderCompiler()->registerMaterial(asset->material);
     asset->setStatus(Asset::Status::Ready);
 
     if (asset->getName().empty()) {
@@ -4,6 +4,7 @@
 #include "Asset/MeshAsset.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Mesh.h"
+#include "Graphics/Meshlet.h"
 #include "Graphics/Shader.h"
 #include "Graphics/StaticMeshVertexData.h"
 #include "ThreadPool.h"
@@ -26,14 +27,22 @@ MeshLoader::MeshLoader(Gfx::PGraphics graphics) : graphics(graphics) {}
 
 MeshLoader::~MeshLoader() {}
 
-void MeshLoader::importAsset(MeshImportArgs args) {
+bool MeshLoader::importAsset(MeshImportArgs args, Array<std::filesystem::path>& textureFiles) {
     std::filesystem::path assetPath = args.filePath.filename();
     assetPath.replace_extension("asset");
-    OMeshAsset asset = new MeshAsset(args.importPath, assetPath.stem().string());
-    PMeshAsset ref = asset;
-    asset->setStatus(Asset::Status::Loading);
-    AssetRegistry::get().registerMesh(std::move(asset));
-    import(args, ref);
+    std::string name = assetPath.stem().string();
+    // a re-import fills the registered asset again, the components and scenes that use it keep pointing to it
+    PMeshAsset ref;
+    if (AssetRegistry::containsMesh(args.importPath, name)) {
+        ref = AssetRegistry::findMesh(args.importPath, name);
+        ref->setStatus(Asset::Status::Loading);
+    } else {
+        OMeshAsset asset = new MeshAsset(args.importPath, name);
+        ref = asset;
+        asset->setStatus(Asset::Status::Loading);
+        AssetRegistry::get().registerMesh(std::move(asset));
+    }
+    return import(args, ref, textureFiles);
 }
 
 void MeshLoader::convertAssimpARGB(unsigned char* dst, aiTexel* src, uint32 numPixels) {
@@ -45,43 +54,50 @@ void MeshLoader::convertAssimpARGB(unsigned char* dst, aiTexel* src, uint32 numP
     }
 }
 void MeshLoader::loadTextures(const aiScene* scene, const std::filesystem::path& meshDirectory, const std::string& importPath,
-                              Array<PTextureAsset>& textures) {
+                              Array<PTextureAsset>& textures, Array<std::filesystem::path>& texturePaths,
+                              List<std::function<void()>>& work) {
     std::cout << "Loading Textures" << std::endl;
+    // extracting embedded textures is independent for each of them, the conversion itself is already async
+    textures.resize(scene->mNumTextures);
+    texturePaths.resize(scene->mNumTextures);
     for (uint32 i = 0; i < scene->mNumTextures; ++i) {
-        aiTexture* tex = scene->mTextures[i];
-        auto texPath = std::filesystem::path(tex->mFilename.C_Str());
-        if (std::filesystem::exists(texPath)) {
-        } else if (std::filesystem::exists(meshDirectory / texPath)) {
-            texPath = meshDirectory / texPath;
-        } else {
-            if (tex->mFilename.length == 0) {
-                texPath = (meshDirectory / fmt::format("Texture{0}", i));
-            } else {
-                texPath = (meshDirectory / texPath);
-            }
-            texPath = texPath.replace_extension(tex->achFormatHint);
-            if (tex->mHeight == 0) {
-                std::cout << "Dumping texture " << texPath << std::endl;
-                // already compressed, just dump it to the disk
-                std::ofstream file(texPath, std::ios::binary);
-                file.write((const char*)tex->pcData, tex->mWidth);
-                file.flush();
+        work.add([&, scene, i]() {
+            aiTexture* tex = scene->mTextures[i];
+            auto texPath = std::filesystem::path(tex->mFilename.C_Str());
+            if (std::filesystem::exists(texPath)) {
+            } else if (std::filesystem::exists(meshDirectory / texPath)) {
+                texPath = meshDirectory / texPath;
             } else {
-                std::cout << "Writing extracted png " << texPath << std::endl;
-                // recompress data so that the TextureLoader can read it
-                unsigned char* texData = new unsigned char[tex->mWidth * tex->mHeight * 4];
-                convertAssimpARGB(texData, tex->pcData, tex->mWidth * tex->mHeight);
-                stbi_write_png(texPath.string().c_str(), tex->mWidth, tex->mHeight, 4, tex->pcData, tex->mWidth * 32);
-                delete[] texData;
+                if (tex->mFilename.length == 0) {
+                    texPath = (meshDirectory / fmt::format("Texture{0}", i));
+                } else {
+                    texPath = (meshDirectory / texPath);
+                }
+                texPath = texPath.replace_extension(tex->achFormatHint);
+                if (tex->mHeight == 0) {
+                    std::cout << "Dumping texture " << texPath << std::endl;
+                    // already compressed, just dump it to the disk
+                    std::ofstream file(texPath, std::ios::binary);
+                    file.write((const char*)tex->pcData, tex->mWidth);
+                    file.flush();
+                } else {
+                    std::cout << "Writing extracted png " << texPath << std::endl;
+                    // recompress data so that the TextureLoader can read it
+                    unsigned char* texData = new unsigned char[tex->mWidth * tex->mHeight * 4];
+                    convertAssimpARGB(texData, tex->pcData, tex->mWidth * tex->mHeight);
+                    stbi_write_png(texPath.string().c_str(), tex->mWidth, tex->mHeight, 4, tex->pcData, tex->mWidth * 32);
+                    delete[] texData;
+                }
             }
-        }
-        std::cout << "Loading model texture " << texPath.string() << std::endl;
-        AssetImporter::importTexture(TextureImportArgs{
-            .filePath = texPath,
-            .importPath = importPath,
+            std::cout << "Loading model texture " << texPath.string() << std::endl;
+            AssetImporter::importTexture(TextureImportArgs{
+                .filePath = texPath,
+                .importPath = importPath,
+            });
+            textures[i] = AssetRegistry::findTexture(importPath, texPath.stem().string());
+            texturePaths[i] = texPath;
+            std::cout << "Loaded " << i << "/" << scene->mNumTextures << std::endl;
         });
-        textures.add(AssetRegistry::findTexture(importPath, texPath.stem().string()));
-        std::cout << "Loaded " << i << "/" << scene->mNumTextures << std::endl;
     }
 }
 
@@ -105,357 +121,426 @@ constexpr const char* KEY_METALLIC_TEXTURE = "tex_m";
 constexpr const char* KEY_AMBIENT_OCCLUSION_TEXTURE = "tex_ao";
 constexpr const char* KEY_EMISSIVE_TEXTURE = "tex_emissive";
 
-void MeshLoader::loadMaterials(const aiScene* scene, const Array<PTextureAsset>& textures, const std::string& baseName,
-                               const std::filesystem::path& meshDirectory, const std::string& importPath,
-                               Array<PMaterialInstanceAsset>& globalMaterials) {
+// building the expression graph only reads the aiScene and imports textures, so every material can be converted in parallel
+// creating and compiling the Material touches global state, so that part stays serial
+struct MeshLoader::MaterialConversion {
+    std::string materialName;
+    Array<OShaderExpression> expressions;
+    Array<std::string> parameters;
+    MaterialNode brdf;
+    uint32 numTextures = 0;
+    uint32 numSamplers = 0;
+    uint32 numFloats = 0;
+    uint32 twoSided = false;
+    float opacity = 1.0f;
+    // embedded textures are extracted in the same batch, so they are only looked up once it is done
+    Array<Pair<TextureParameter*, uint32>> embeddedTextures;
+    Array<Pair<SamplerParameter*, SamplerCreateInfo>> samplers;
+    // external texture files the material refers to, they go into the import cache entry of the mesh
+    Array<std::filesystem::path> textureFiles;
+};
+
+void MeshLoader::convertMaterials(const aiScene* scene, const std::string& baseName, const std::filesystem::path& meshDirectory,
+                                  const std::string& importPath, Array<MaterialConversion>& conversions,
+                                  List<std::function<void()>>& work) {
+    conversions.resize(scene->mNumMaterials);
     for (uint32 m = 0; m < scene->mNumMaterials; ++m) {
-        aiMaterial* material = scene->mMaterials[m];
-        aiString texPath;
-        std::string materialName = fmt::format("M{0}{1}{2}", baseName, material->GetName().C_Str(), m);
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), '.'),
-                           materialName.end()); // dots break adding the .asset extension later
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), ':'),
-                           materialName.end()); // dots break adding the .asset extension later
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), '-'),
-                           materialName.end()); // dots break adding the .asset extension later
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), ' '),
-                           materialName.end()); // dots break adding the .asset extension later
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), '('),
-                           materialName.end()); // dots break adding the .asset extension later
-        materialName.erase(std::remove(materialName.begin(), materialName.end(), ')'),
-                           materialName.end()); // dots break adding the .asset extension later
-        Array<OShaderExpression> expressions;
-        Array<std::string> parameters;
-        uint32 numTextures = 0;
-        uint32 numSamplers = 0;
-        uint32 numFloats = 0;
-        auto addScalarParameter = [&](std::string paramKey, const char* matKey, int type, int index) {
-            float scalar;
-            material->Get(matKey, type, index, scalar);
-            expressions.add(new FloatParameter(paramKey, scalar, numFloats++));
-            parameters.add(paramKey);
-        };
-
-        auto addVectorParameter = [&](std::string paramKey, const char* matKey, int type, int index) {
-            aiColor3D color;
-            material->Get(matKey, type, index, color);
-            expressions.add(new VectorParameter(paramKey, Vector(color.r, color.g, color.b), numFloats));
-            numFloats += 3;
-            parameters.add(paramKey);
-        };
-
-        auto addTextureParameter = [&](std::string paramKey, aiTextureType type, int index, std::string& result,
-                                       StaticArray<int32, 4> extractMask = {0, 1, 2, -1}, std::string* alpha = nullptr) {
+        work.add([&, scene, m]() {
+            aiMaterial* material = scene->mMaterials[m];
             aiString texPath;
-            aiTextureMapping mapping;
-            uint32 uvIndex = 0;
-            aiTextureMapMode mapMode = aiTextureMapMode_Clamp;
-            float blend = std::numeric_limits<float>::max();
-            aiTextureOp op = aiTextureOp_Add;
-            if (material->GetTexture(type, index, &texPath, &mapping, &uvIndex, &blend, &op, &mapMode) != AI_SUCCESS) {
-                std::cout << "fuck" << std::endl;
-            }
-            std::string textureKey = fmt::format("{0}Texture{1}", paramKey, index);
-            auto texFilename = std::filesystem::path(texPath.C_Str());
-            PTextureAsset texture;
-
-            if (texFilename.string()[0] == '*') {
-                texture = textures[atoi(texFilename.string().substr(1).c_str())];
-            } else if (std::filesystem::exists(texFilename)) {
-                AssetImporter::importTexture(TextureImportArgs{
-                    .filePath = texFilename,
-                    .importPath = importPath,
-                });
-                texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
-            } else if (std::filesystem::exists(meshDirectory / texFilename)) {
-                AssetImporter::importTexture(TextureImportArgs{
-                    .filePath = meshDirectory / texFilename,
-                    .importPath = importPath,
-                    .type = type == aiTextureType_NORMALS ? TextureImportType::TEXTURE_NORMAL : TextureImportType::TEXTURE_2D,
-                });
-                texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
-            } else if (std::filesystem::exists(meshDirectory.parent_path() / "textures" / texFilename)) {
-                AssetImporter::importTexture(TextureImportArgs{
-                    .filePath = meshDirectory.parent_path() / "textures" / texFilename,
-                    .importPath = importPath,
-                    .type = type == aiTextureType_NORMALS ? TextureImportType::TEXTURE_NORMAL : TextureImportType::TEXTURE_2D,
-                });
-                texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
-            } else {
-                std::cout << "couldnt find " << texPath.C_Str() << std::endl;
-                return;
-            }
-            expressions.add(new TextureParameter(textureKey, texture, numTextures++));
-            parameters.add(textureKey);
-
-            std::string samplerKey = fmt::format("{0}Sampler{1}", paramKey, index);
-            SamplerCreateInfo samplerInfo = {};
-            switch (mapMode) {
-            case aiTextureMapMode_Wrap:
-                samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
-                samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
-                samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
-                break;
-            case aiTextureMapMode_Clamp:
-                samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-                samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-                samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
-                break;
-            case aiTextureMapMode_Decal:
-                samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-                samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-                samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-                break;
-            case aiTextureMapMode_Mirror:
-                samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-                samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-                samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-                break;
-            }
-            expressions.add(new SamplerParameter(samplerKey, graphics->createSampler(samplerInfo), numSamplers++));
-            parameters.add(samplerKey);
-
-            std::string sampleKey = fmt::format("{0}Sample{1}", paramKey, index);
-            expressions.add(new SampleExpression());
-            expressions.back()->key = sampleKey;
-            expressions.back()->inputs["texture"].source = textureKey;
-            expressions.back()->inputs["sampler"].source = samplerKey;
-            expressions.back()->inputs["coords"].source = fmt::format("input.texCoords[{0}]", uvIndex);
-
-            std::string colorExtract = fmt::format("{0}Extract{1}", paramKey, index);
-            expressions.add(new SwizzleExpression(extractMask));
-            expressions.back()->key = colorExtract;
-            expressions.back()->inputs["target"].source = sampleKey;
-
-            if (alpha != nullptr) {
-                std::string alphaExtract = fmt::format("{0}Alpha{1}", paramKey, index);
-                expressions.add(new SwizzleExpression({3, -1, -1, -1}));
-                expressions.back()->key = alphaExtract;
+            std::string materialName = fmt::format("M{0}{1}{2}", baseName, material->GetName().C_Str(), m);
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), '.'),
+                               materialName.end()); // dots break adding the .asset extension later
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), ':'),
+                               materialName.end()); // dots break adding the .asset extension later
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), '-'),
+                               materialName.end()); // dots break adding the .asset extension later
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), ' '),
+                               materialName.end()); // dots break adding the .asset extension later
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), '('),
+                               materialName.end()); // dots break adding the .asset extension later
+            materialName.erase(std::remove(materialName.begin(), materialName.end(), ')'),
+                               materialName.end()); // dots break adding the .asset extension later
+            Array<OShaderExpression> expressions;
+            Array<std::string> parameters;
+            uint32 numTextures = 0;
+            uint32 numSamplers = 0;
+            uint32 numFloats = 0;
+            Array<Pair<TextureParameter*, uint32>> embeddedTextures;
+            Array<Pair<SamplerParameter*, SamplerCreateInfo>> samplers;
+            Array<std::filesystem::path> textureFiles;
+            auto addScalarParameter = [&](std::string paramKey, const char* matKey, int type, int index) {
+                float scalar;
+                material->Get(matKey, type, index, scalar);
+                expressions.add(new FloatParameter(paramKey, scalar, numFloats++));
+                parameters.add(paramKey);
+            };
+
+            auto addVectorParameter = [&](std::string paramKey, const char* matKey, int type, int index) {
+                aiColor3D color;
+                material->Get(matKey, type, index, color);
+                expressions.add(new VectorParameter(paramKey, Vector(color.r, color.g, color.b), numFloats));
+                numFloats += 3;
+                parameters.add(paramKey);
+            };
+
+            auto addTextureParameter = [&](std::string paramKey, aiTextureType type, int index, std::string& result,
+                                           StaticArray<int32, 4> extractMask = {0, 1, 2, -1}, std::string* alpha = nullptr) {
+                aiString texPath;
+                aiTextureMapping mapping;
+                uint32 uvIndex = 0;
+                aiTextureMapMode mapMode = aiTextureMapMode_Clamp;
+                float blend = std::numeric_limits<float>::max();
+                aiTextureOp op = aiTextureOp_Add;
+                if (material->GetTexture(type, index, &texPath, &mapping, &uvIndex, &blend, &op, &mapMode) != AI_SUCCESS) {
+                    std::cout << "fuck" << std::endl;
+                }
+                std::string textureKey = fmt::format("{0}Texture{1}", paramKey, index);
+                auto texFilename = std::filesystem::path(texPath.C_Str());
+                PTextureAsset texture;
+                int32 embeddedIndex = -1;
+
+                if (texFilename.string()[0] == '*') {
+                    embeddedIndex = atoi(texFilename.string().substr(1).c_str());
+                } else if (std::filesystem::exists(texFilename)) {
+                    AssetImporter::importTexture(TextureImportArgs{
+                        .filePath = texFilename,
+                        .importPath = importPath,
+                        .type = type == aiTextureType_NORMALS ? TextureImportType::TEXTURE_NORMAL : TextureImportType::TEXTURE_2D,
+                    });
+                    texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
+                    textureFiles.add(texFilename);
+                } else if (std::filesystem::exists(meshDirectory / texFilename)) {
+                    AssetImporter::importTexture(TextureImportArgs{
+                        .filePath = meshDirectory / texFilename,
+                        .importPath = importPath,
+                        .type = type == aiTextureType_NORMALS ? TextureImportType::TEXTURE_NORMAL : TextureImportType::TEXTURE_2D,
+                    });
+                    texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
+                    textureFiles.add(meshDirectory / texFilename);
+                } else if (std::filesystem::exists(meshDirectory.parent_path() / "textures" / texFilename)) {
+                    AssetImporter::importTexture(TextureImportArgs{
+                        .filePath = meshDirectory.parent_path() / "textures" / texFilename,
+                        .importPath = importPath,
+                        .type = type == aiTextureType_NORMALS ? TextureImportType::TEXTURE_NORMAL : TextureImportType::TEXTURE_2D,
+                    });
+                    texture = AssetRegistry::findTexture(importPath, texFilename.stem().string());
+                    textureFiles.add(meshDirectory.parent_path() / "textures" / texFilename);
+                } else {
+                    std::cout << "couldnt find " << texPath.C_Str() << std::endl;
+                    return;
+                }
+                TextureParameter* textureParameter = new TextureParameter(textureKey, texture, numTextures++);
+                if (embeddedIndex >= 0) {
+                    embeddedTextures.add(Pair<TextureParameter*, uint32>{textureParameter, (uint32)embeddedIndex});
+                }
+                expressions.add(textureParameter);
+                parameters.add(textureKey);
+
+                std::string samplerKey = fmt::format("{0}Sampler{1}", paramKey, index);
+                SamplerCreateInfo samplerInfo = {};
+                switch (mapMode) {
+                case aiTextureMapMode_Wrap:
+                    samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
+                    samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
+                    samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_REPEAT;
+                    break;
+                case aiTextureMapMode_Clamp:
+                    samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+                    samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+                    samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+                    break;
+                case aiTextureMapMode_Decal:
+                    samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+                    samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+                    samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+                    break;
+                case aiTextureMapMode_Mirror:
+                    samplerInfo.addressModeU = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+                    samplerInfo.addressModeV = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+                    samplerInfo.addressModeW = Gfx::SE_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+                    break;
+                }
+                SamplerParameter* samplerParameter = new SamplerParameter(samplerKey, nullptr, numSamplers++);
+                samplers.add(Pair<SamplerParameter*, SamplerCreateInfo>{samplerParameter, samplerInfo});
+                expressions.add(samplerParameter);
+                parameters.add(samplerKey);
+
+                std::string sampleKey = fmt::format("{0}Sample{1}", paramKey, index);
+                expressions.add(new SampleExpression());
+                expressions.back()->key = sampleKey;
+                expressions.back()->inputs["texture"].source = textureKey;
+                expressions.back()->inputs["sampler"].source = samplerKey;
+                expressions.back()->inputs["coords"].source = fmt::format("input.texCoords[{0}]", uvIndex);
+
+                std::string colorExtract = fmt::format("{0}Extract{1}", paramKey, index);
+                expressions.add(new SwizzleExpression(extractMask));
+                expressions.back()->key = colorExtract;
                 expressions.back()->inputs["target"].source = sampleKey;
 
-                // std::string alphaMul = fmt::format("{0}AlphaMul{1}", paramKey, index);
-                // expressions.add(new MulExpression());
-                // expressions.back()->key = alphaMul;
-                // expressions.back()->inputs["lhs"].source = *alpha;
-                // expressions.back()->inputs["rhs"].source = alphaExtract;
-                *alpha = alphaExtract;
-            }
-
-            if (blend == std::numeric_limits<float>::max()) {
-                result = colorExtract;
-                return;
-            }
-            std::string blendFactorKey = fmt::format("{0}BlendFactor{1}", paramKey, index);
-            expressions.add(new FloatParameter(blendFactorKey, blend, numFloats++));
-            parameters.add(blendFactorKey);
-
-            std::string strengthKey = fmt::format("{0}Strength{1}", paramKey, index);
-            expressions.add(new MulExpression());
-            expressions.back()->key = strengthKey;
-            expressions.back()->inputs["lhs"].source = colorExtract;
-            expressions.back()->inputs["rhs"].source = blendFactorKey;
-
-            std::string blendKey = fmt::format("{0}Blend{1}", paramKey, index);
-            switch (op) {
-                /** T = T1 * T2 */
-            case aiTextureOp_Multiply:
-                expressions.add(new MulExpression());
-                break;
+                if (alpha != nullptr) {
+                    std::string alphaExtract = fmt::format("{0}Alpha{1}", paramKey, index);
+                    expressions.add(new SwizzleExpression({3, -1, -1, -1}));
+                    expressions.back()->key = alphaExtract;
+                    expressions.back()->inputs["target"].source = sampleKey;
+
+                    // std::string alphaMul = fmt::format("{0}AlphaMul{1}", paramKey, index);
+                    // expressions.add(new MulExpression());
+                    // expressions.back()->key = alphaMul;
+                    // expressions.back()->inputs["lhs"].source = *alpha;
+                    // expressions.back()->inputs["rhs"].source = alphaExtract;
+                    *alpha = alphaExtract;
+                }
 
-                /** T = T1 - T2 */
-            case aiTextureOp_Subtract:
-                expressions.add(new SubExpression());
-                break;
+                if (blend == std::numeric_limits<float>::max()) {
+                    result = colorExtract;
+                    return;
+                }
+                std::string blendFactorKey = fmt::format("{0}BlendFactor{1}", paramKey, index);
+                expressions.add(new FloatParameter(blendFactorKey, blend, numFloats++));
+                parameters.add(blendFactorKey);
 
-                /** T = T1 / T2 */
-            case aiTextureOp_Divide:
-                // expressions[blendKey] = new DivExpression();
-                throw std::logic_error("Not implemented");
+                std::string strengthKey = fmt::format("{0}Strength{1}", paramKey, index);
+                expressions.add(new MulExpression());
+                expressions.back()->key = strengthKey;
+                expressions.back()->inputs["lhs"].source = colorExtract;
+                expressions.back()->inputs["rhs"].source = blendFactorKey;
+
+                std::string blendKey = fmt::format("{0}Blend{1}", paramKey, index);
+                switch (op) {
+                    /** T = T1 * T2 */
+                case aiTextureOp_Multiply:
+                    expressions.add(new MulExpression());
+                    break;
+
+                    /** T = T1 - T2 */
+                case aiTextureOp_Subtract:
+                    expressions.add(new SubExpression());
+                    break;
+
+                    /** T = T1 / T2 */
+                case aiTextureOp_Divide:
+                    // expressions[blendKey] = new DivExpression();
+                    throw std::logic_error("Not implemented");
+
+                    /** T = (T1 + T2) - (T1 * T2) */
+                case aiTextureOp_SmoothAdd:
+                    throw std::logic_error("Not implemented");
+
+                    /** T = T1 + (T2-0.5) */
+                case aiTextureOp_SignedAdd:
+                    throw std::logic_error("Not implemented");
+
+                    /** T = T1 + T2 */
+                case aiTextureOp_Add:
+                default:
+                    expressions.add(new AddExpression());
+                    break;
+                }
+                expressions.back()->key = blendKey;
+                expressions.back()->inputs["lhs"].source = result;
+                expressions.back()->inputs["rhs"].source = strengthKey;
+
+                result = blendKey;
+            };
+            // Diffuse
+            addVectorParameter(KEY_DIFFUSE_COLOR, AI_MATKEY_COLOR_DIFFUSE);
+            std::string outputDiffuse = KEY_DIFFUSE_COLOR;
+            addScalarParameter(KEY_ALPHA, AI_MATKEY_OPACITY);
+            std::string outputAlpha = KEY_ALPHA;
+            uint32 numDiffuseTextures = material->GetTextureCount(aiTextureType_DIFFUSE);
+            for (uint32 i = 0; i < numDiffuseTextures; ++i) {
+                addTextureParameter(KEY_DIFFUSE_TEXTURE, aiTextureType_DIFFUSE, i, outputDiffuse, {0, 1, 2, -1}, &outputAlpha);
+            }
 
-                /** T = (T1 + T2) - (T1 * T2) */
-            case aiTextureOp_SmoothAdd:
-                throw std::logic_error("Not implemented");
+            // Specular
+            addVectorParameter(KEY_SPECULAR_COLOR, AI_MATKEY_COLOR_SPECULAR);
+            std::string outputSpecular = KEY_SPECULAR_COLOR;
+            uint32 numSpecular = material->GetTextureCount(aiTextureType_SPECULAR);
+            for (uint32 i = 0; i < numSpecular; ++i) {
+                addTextureParameter(KEY_SPECULAR_TEXTURE, aiTextureType_SPECULAR, i, outputSpecular);
+            }
 
-                /** T = T1 + (T2-0.5) */
-            case aiTextureOp_SignedAdd:
-                throw std::logic_error("Not implemented");
+            // Normal
+            std::string outputNormal = "";
+            uint32 numNormal = material->GetTextureCount(aiTextureType_NORMALS);
+            for (uint32 i = 0; i < numNormal; ++i) {
+                addTextureParameter(KEY_NORMAL_TEXTURE, aiTextureType_NORMALS, i, outputNormal);
+            }
 
-                /** T = T1 + T2 */
-            case aiTextureOp_Add:
-            default:
-                expressions.add(new AddExpression());
-                break;
+            // Ambient Color
+            addVectorParameter(KEY_AMBIENT_COLOR, AI_MATKEY_COLOR_AMBIENT);
+            std::string outputAmbient = KEY_AMBIENT_COLOR;
+            uint32 numAmbient = material->GetTextureCount(aiTextureType_AMBIENT);
+            for (uint32 i = 0; i < numAmbient; ++i) {
+                addTextureParameter(KEY_AMBIENT_TEXTURE, aiTextureType_AMBIENT, i, outputAmbient);
             }
-            expressions.back()->key = blendKey;
-            expressions.back()->inputs["lhs"].source = result;
-            expressions.back()->inputs["rhs"].source = strengthKey;
-
-            result = blendKey;
-        };
-        // Diffuse
-        addVectorParameter(KEY_DIFFUSE_COLOR, AI_MATKEY_COLOR_DIFFUSE);
-        std::string outputDiffuse = KEY_DIFFUSE_COLOR;
-        addScalarParameter(KEY_ALPHA, AI_MATKEY_OPACITY);
-        std::string outputAlpha = KEY_ALPHA;
-        uint32 numDiffuseTextures = material->GetTextureCount(aiTextureType_DIFFUSE);
-        for (uint32 i = 0; i < numDiffuseTextures; ++i) {
-            addTextureParameter(KEY_DIFFUSE_TEXTURE, aiTextureType_DIFFUSE, i, outputDiffuse, {0, 1, 2, -1}, &outputAlpha);
-        }
 
-        // Specular
-        addVectorParameter(KEY_SPECULAR_COLOR, AI_MATKEY_COLOR_SPECULAR);
-        std::string outputSpecular = KEY_SPECULAR_COLOR;
-        uint32 numSpecular = material->GetTextureCount(aiTextureType_SPECULAR);
-        for (uint32 i = 0; i < numSpecular; ++i) {
-            addTextureParameter(KEY_SPECULAR_TEXTURE, aiTextureType_SPECULAR, i, outputSpecular);
-        }
+            // Shininess
+            addScalarParameter(KEY_SHININESS, AI_MATKEY_SHININESS);
+            std::string outputShininess = KEY_SHININESS;
+            uint32 numShiny = material->GetTextureCount(aiTextureType_SHININESS);
+            for (uint32 i = 0; i < numShiny; ++i) {
+                addTextureParameter(KEY_SHININESS_TEXTURE, aiTextureType_SHININESS, i, outputShininess, {0, -1, -1, -1});
+            }
 
-        // Normal
-        std::string outputNormal = "";
-        uint32 numNormal = material->GetTextureCount(aiTextureType_NORMALS);
-        for (uint32 i = 0; i < numNormal; ++i) {
-            addTextureParameter(KEY_NORMAL_TEXTURE, aiTextureType_NORMALS, i, outputNormal);
-        }
+            // Roughness
+            addScalarParameter(KEY_ROUGHNESS, AI_MATKEY_ROUGHNESS_FACTOR);
+            std::string outputRoughness = KEY_ROUGHNESS;
+            uint32 numRoughness = material->GetTextureCount(aiTextureType_DIFFUSE_ROUGHNESS);
+            for (uint32 i = 0; i < numRoughness; ++i) {
+                addTextureParameter(KEY_ROUGHNESS_TEXTURE, aiTextureType_DIFFUSE_ROUGHNESS, i, outputRoughness, {0, -1, -1, -1});
+            }
 
-        // Ambient Color
-        addVectorParameter(KEY_AMBIENT_COLOR, AI_MATKEY_COLOR_AMBIENT);
-        std::string outputAmbient = KEY_AMBIENT_COLOR;
-        uint32 numAmbient = material->GetTextureCount(aiTextureType_AMBIENT);
-        for (uint32 i = 0; i < numAmbient; ++i) {
-            addTextureParameter(KEY_AMBIENT_TEXTURE, aiTextureType_AMBIENT, i, outputAmbient);
-        }
+            // Metallic
+            addScalarParameter(KEY_METALLIC, AI_MATKEY_METALLIC_FACTOR);
+            std::string outputMetallic = KEY_METALLIC;
+            uint32 numMetallic = material->GetTextureCount(aiTextureType_METALNESS);
+            for (uint32 i = 0; i < numMetallic; ++i) {
+                addTextureParameter(KEY_METALLIC_TEXTURE, aiTextureType_METALNESS, i, outputMetallic, {0, -1, -1, -1});
+            }
 
-        // Shininess
-        addScalarParameter(KEY_SHININESS, AI_MATKEY_SHININESS);
-        std::string outputShininess = KEY_SHININESS;
-        uint32 numShiny = material->GetTextureCount(aiTextureType_SHININESS);
-        for (uint32 i = 0; i < numShiny; ++i) {
-            addTextureParameter(KEY_SHININESS_TEXTURE, aiTextureType_SHININESS, i, outputShininess, {0, -1, -1, -1});
-        }
+            // Ambient Occlusion
+            std::string outputAO = "";
+            uint32 numAO = material->GetTextureCount(aiTextureType_AMBIENT_OCCLUSION);
+            for (uint32 i = 0; i < numAO; ++i) {
+                addTextureParameter(KEY_AMBIENT_OCCLUSION_TEXTURE, aiTextureType_AMBIENT_OCCLUSION, i, outputAO, {0, -1, -1, -1});
+            }
 
-        // Roughness
-        addScalarParameter(KEY_ROUGHNESS, AI_MATKEY_ROUGHNESS_FACTOR);
-        std::string outputRoughness = KEY_ROUGHNESS;
-        uint32 numRoughness = material->GetTextureCount(aiTextureType_DIFFUSE_ROUGHNESS);
-        for (uint32 i = 0; i < numRoughness; ++i) {
-            addTextureParameter(KEY_ROUGHNESS_TEXTURE, aiTextureType_DIFFUSE_ROUGHNESS, i, outputRoughness, {0, -1, -1, -1});
-        }
+            // Emissive
+            // addScalarParameter(KEY_EMISSIVE_INTENSITY, AI_MATKEY_EMISSIVE_INTENSITY);
+            addVectorParameter(KEY_EMISSIVE_COLOR, AI_MATKEY_COLOR_EMISSIVE);
+            std::string outputEmissive = KEY_EMISSIVE_COLOR;
+            uint32 numEmissive = material->GetTextureCount(aiTextureType_EMISSION_COLOR);
+            for (uint32 i = 0; i < numEmissive; ++i) {
+                addTextureParameter(KEY_EMISSIVE_TEXTURE, aiTextureType_EMISSION_COLOR, i, outputEmissive);
+            }
 
-        // Metallic
-        addScalarParameter(KEY_METALLIC, AI_MATKEY_METALLIC_FACTOR);
-        std::string outputMetallic = KEY_METALLIC;
-        uint32 numMetallic = material->GetTextureCount(aiTextureType_METALNESS);
-        for (uint32 i = 0; i < numMetallic; ++i) {
-            addTextureParameter(KEY_METALLIC_TEXTURE, aiTextureType_METALNESS, i, outputMetallic, {0, -1, -1, -1});
-        }
+            MaterialNode brdf;
+            brdf.variables["baseColor"] = outputDiffuse;
+            brdf.variables["alpha"] = outputAlpha;
+            brdf.variables["emissive"] = outputEmissive;
+            if (!outputNormal.empty()) {
+                expressions.add(new MulExpression());
+                expressions.back()->key = "NormalMul";
+                expressions.back()->inputs["lhs"].source = "2";
+                expressions.back()->inputs["rhs"].source = outputNormal;
 
-        // Ambient Occlusion
-        std::string outputAO = "";
-        uint32 numAO = material->GetTextureCount(aiTextureType_AMBIENT_OCCLUSION);
-        for (uint32 i = 0; i < numAO; ++i) {
-            addTextureParameter(KEY_AMBIENT_OCCLUSION_TEXTURE, aiTextureType_AMBIENT_OCCLUSION, i, outputAO, {0, -1, -1, -1});
-        }
+                expressions.add(new SubExpression());
+                expressions.back()->key = "NormalSub";
+                expressions.back()->inputs["lhs"].source = "NormalMul";
+                expressions.back()->inputs["rhs"].source = "float3(1,1,1)";
 
-        // Emissive
-        // addScalarParameter(KEY_EMISSIVE_INTENSITY, AI_MATKEY_EMISSIVE_INTENSITY);
-        addVectorParameter(KEY_EMISSIVE_COLOR, AI_MATKEY_COLOR_EMISSIVE);
-        std::string outputEmissive = KEY_EMISSIVE_COLOR;
-        uint32 numEmissive = material->GetTextureCount(aiTextureType_EMISSION_COLOR);
-        for (uint32 i = 0; i < numEmissive; ++i) {
-            addTextureParameter(KEY_EMISSIVE_TEXTURE, aiTextureType_EMISSION_COLOR, i, outputEmissive);
-        }
+                // normal maps are transcoded to two channel formats like BC5, so z is rebuilt from the unit length
+                expressions.add(new ConstantExpression(
+                    "float3(exp_NormalSub.xy, sqrt(saturate(1 - dot(exp_NormalSub.xy, exp_NormalSub.xy))))", ExpressionType::FLOAT3));
+                expressions.back()->key = "NormalZ";
 
-        MaterialNode brdf;
-        brdf.variables["baseColor"] = outputDiffuse;
-        brdf.variables["alpha"] = outputAlpha;
-        brdf.variables["emissive"] = outputEmissive;
-        if (!outputNormal.empty()) {
-            expressions.add(new MulExpression());
-            expressions.back()->key = "NormalMul";
-            expressions.back()->inputs["lhs"].source = "2";
-            expressions.back()->inputs["rhs"].source = outputNormal;
-
-            expressions.add(new SubExpression());
-            expressions.back()->key = "NormalSub";
-            expressions.back()->inputs["lhs"].source = "NormalMul";
-            expressions.back()->inputs["rhs"].source = "float3(1,1,1)";
-
-            brdf.variables["normal"] = "NormalSub";
-        }
-        aiShadingMode mode = aiShadingMode_CookTorrance;
-        material->Get(AI_MATKEY_SHADING_MODEL, mode);
-        switch (mode) {
-        case aiShadingMode_Phong:
-            brdf.profile = "Phong";
-            brdf.variables["specular"] = outputSpecular;
-            brdf.variables["ambient"] = outputAmbient;
-            brdf.variables["shininess"] = outputShininess;
-            break;
-        case aiShadingMode_Toon:
-            brdf.profile = "CelShading";
-            break;
-        case aiShadingMode_Blinn:
-            brdf.profile = "BlinnPhong";
-            brdf.variables["specularColor"] = outputSpecular;
-            brdf.variables["ambient"] = outputAmbient;
-            brdf.variables["shininess"] = outputShininess;
-            break;
-        default:
-        case aiShadingMode_CookTorrance:
-            brdf.profile = "CookTorrance";
-            brdf.variables["roughness"] = outputRoughness;
-            brdf.variables["metallic"] = outputMetallic;
-            if (!outputAO.empty()) {
-                brdf.variables["ambientOcclusion"] = outputAmbient;
+                brdf.variables["normal"] = "NormalZ";
             }
-            break;
-        };
-        uint32 twoSided = false;
-        float opacity = 1.0f;
-        aiString matName = material->GetName();
-        const char* mat = matName.C_Str();
-
-        if (strcmp(mat, "Leaves0119_14_S") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "TexturesCom_Leaves0119_1_alphamasked_S") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "TexturesCom_Leaves0119_2_alphamasked_S") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "3td_Africa_Grass01") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "DryWeeds-CC0") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "fgrass1_v2_256") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "arbre-feuille") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
-        }
-        if (strcmp(mat, "arbre-feuille-variante") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
+            aiShadingMode mode = aiShadingMode_CookTorrance;
+            material->Get(AI_MATKEY_SHADING_MODEL, mode);
+            switch (mode) {
+            case aiShadingMode_Phong:
+                brdf.profile = "Phong";
+                brdf.variables["specular"] = outputSpecular;
+                brdf.variables["ambient"] = outputAmbient;
+                brdf.variables["shininess"] = outputShininess;
+                break;
+            case aiShadingMode_Toon:
+                brdf.profile = "CelShading";
+                break;
+            case aiShadingMode_Blinn:
+                brdf.profile = "BlinnPhong";
+                brdf.variables["specularColor"] = outputSpecular;
+                brdf.variables["ambient"] = outputAmbient;
+                brdf.variables["shininess"] = outputShininess;
+                break;
+            default:
+            case aiShadingMode_CookTorrance:
+                brdf.profile = "CookTorrance";
+                brdf.variables["roughness"] = outputRoughness;
+                brdf.variables["metallic"] = outputMetallic;
+                if (!outputAO.empty()) {
+                    brdf.variables["ambientOcclusion"] = outputAmbient;
+                }
+                break;
+            };
+            uint32 twoSided = false;
+            float opacity = 1.0f;
+            aiString matName = material->GetName();
+            const char* mat = matName.C_Str();
+
+            if (strcmp(mat, "Leaves0119_14_S") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "TexturesCom_Leaves0119_1_alphamasked_S") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "TexturesCom_Leaves0119_2_alphamasked_S") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "3td_Africa_Grass01") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "DryWeeds-CC0") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "fgrass1_v2_256") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "arbre-feuille") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "arbre-feuille-variante") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            if (strcmp(mat, "arbre-feuille-variante2") == 0) {
+                opacity = 0.5f;
+                twoSided = true;
+            }
+            conversions[m] = MaterialConversion{
+                .materialName = std::move(materialName),
+                .expressions = std::move(expressions),
+                .parameters = std::move(parameters),
+                .brdf = std::move(brdf),
+                .numTextures = numTextures,
+                .numSamplers = numSamplers,
+                .numFloats = numFloats,
+                .twoSided = twoSided,
+                .opacity = opacity,
+                .embeddedTextures = std::move(embeddedTextures),
+                .samplers = std::move(samplers),
+                .textureFiles = std::move(textureFiles),
+            };
+        });
+    }
+}
+
+void MeshLoader::createMaterials(const Array<PTextureAsset>& textures, const std::string& importPath,
+                                 Array<MaterialConversion>& conversions, Array<PMaterialInstanceAsset>& globalMaterials) {
+    for (uint32 m = 0; m < conversions.size(); ++m) {
+        MaterialConversion& conversion = conversions[m];
+        for (auto& [parameter, textureIndex] : conversion.embeddedTextures) {
+            parameter->data = textures[textureIndex];
         }
-        if (strcmp(mat, "arbre-feuille-variante2") == 0) {
-            opacity = 0.5f;
-            twoSided = true;
+        for (auto& [parameter, samplerInfo] : conversion.samplers) {
+            parameter->data = graphics->createSampler(samplerInfo);
         }
-        OMaterialAsset baseMat = new MaterialAsset(importPath, materialName);
-        baseMat->material = new Material(graphics, numTextures, numSamplers, numFloats, twoSided, opacity, materialName,
-                                         std::move(expressions), std::move(parameters), std::move(brdf));
+        OMaterialAsset baseMat = new MaterialAsset(importPath, conversion.materialName);
+        baseMat->material = new Material(graphics, conversion.numTextures, conversion.numSamplers, conversion.numFloats, conversion.twoSided,
+                                         conversion.opacity, conversion.materialName, std::move(conversion.expressions),
+                                         std::move(conversion.parameters), std::move(conversion.brdf));
+        // compile also registers the material with the shader compiler
         baseMat->material->compile();
-        graphics->getShaderCompiler()->registerMaterial(baseMat->material);
         globalMaterials[m] = baseMat->instantiate(InstantiationParameter{
             .name = fmt::format("{0}_Inst_0", baseMat->getName()),
             .folderPath = baseMat->getFolderPath(),
@@ -522,38 +607,56 @@ void MeshLoader::loadGlobalMeshes(const aiScene* scene, const Array<PMaterialIns
             continue;
         globalMeshes[meshIndex] = new Mesh();
 
+        Array<Vector> sourcePositions(mesh->mNumVertices);
+        for (uint32 i = 0; i < mesh->mNumVertices; ++i) {
+            sourcePositions[i] = Vector(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        }
+        Array<uint32> indices(mesh->mNumFaces * 3);
+        for (uint32 faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
+            indices[faceIndex * 3 + 0] = mesh->mFaces[faceIndex].mIndices[0];
+            indices[faceIndex * 3 + 1] = mesh->mFaces[faceIndex].mIndices[1];
+            indices[faceIndex * 3 + 2] = mesh->mFaces[faceIndex].mIndices[2];
+        }
+        // reorders the indices and tells us where each vertex ends up, unreferenced vertices are dropped
+        Array<uint32> vertexRemap;
+        const uint32 numVertices = optimizeMesh(sourcePositions, indices, vertexRemap);
+
         StaticMeshVertexData* vertexData = StaticMeshVertexData::getInstance();
-        MeshId id = vertexData->allocateVertexData(mesh->mNumVertices);
+        MeshId id = vertexData->allocateVertexData(numVertices);
         uint64 offset = vertexData->getMeshOffset(id);
         collider.boundingbox.adjust(Vector(mesh->mAABB.mMin.x, mesh->mAABB.mMin.y, mesh->mAABB.mMin.z));
         collider.boundingbox.adjust(Vector(mesh->mAABB.mMax.x, mesh->mAABB.mMax.y, mesh->mAABB.mMax.z));
         //work.add([=, this, &globalMeshes]() {
             // assume static mesh for now
-            Array<Vector> positions(mesh->mNumVertices);
+            Array<Vector> positions(numVertices);
             StaticArray<Array<StaticMeshVertexData::TexCoordType>, MAX_TEXCOORDS> texCoords;
             for (size_t i = 0; i < MAX_TEXCOORDS; ++i) {
-                texCoords[i].resize(mesh->mNumVertices);
+                texCoords[i].resize(numVertices);
             }
-            Array<StaticMeshVertexData::NormalType> normals(mesh->mNumVertices);
-            Array<StaticMeshVertexData::TangentType> tangents(mesh->mNumVertices);
-            Array<StaticMeshVertexData::BiTangentType> biTangents(mesh->mNumVertices);
-            Array<StaticMeshVertexData::ColorType> colors(mesh->mNumVertices);
-
-            for (uint32 i = 0; i < mesh->mNumVertices; ++i) {
-                positions[i] = Vector(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+            Array<StaticMeshVertexData::NormalType> normals(numVertices);
+            Array<StaticMeshVertexData::TangentType> tangents(numVertices);
+            Array<StaticMeshVertexData::BiTangentType> biTangents(numVertices);
+            Array<StaticMeshVertexData::ColorType> colors(numVertices);
+
+            for (uint32 v = 0; v < mesh->mNumVertices; ++v) {
+                const uint32 i = vertexRemap[v];
+                if (i == ~0u) {
+                    continue;
+                }
+                positions[i] = sourcePositions[v];
                 for (uint32 j = 0; j < MAX_TEXCOORDS; ++j) {
                     if (mesh->HasTextureCoords(j)) {
-                        texCoords[j][i] = U16Vector2(mesh->mTextureCoords[j][i].x * 65535, mesh->mTextureCoords[j][i].y * 65535);
+                        texCoords[j][i] = U16Vector2(mesh->mTextureCoords[j][v].x * 65535, mesh->mTextureCoords[j][v].y * 65535);
                     } else {
                         texCoords[j][i] = U16Vector2(0, 0);
                     }
                 }
-                Vector normal = Vector(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+                Vector normal = Vector(mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z);
                 Vector tangent = Vector(1, 0, 0);
                 Vector biTangent = Vector(0, 0, 1);
                 if (mesh->HasTangentsAndBitangents()) {
-                    tangent = Vector(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
-                    biTangent = Vector(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+                    tangent = Vector(mesh->mTangents[v].x, mesh->mTangents[v].y, mesh->mTangents[v].z);
+                    biTangent = Vector(mesh->mBitangents[v].x, mesh->mBitangents[v].y, mesh->mBitangents[v].z);
                 }
 
                 normals[i] = normal; // encodeQTangent(Matrix3(tangent, biTangent, normal));
@@ -566,8 +669,8 @@ void MeshLoader::loadGlobalMeshes(const aiScene* scene, const Array<PMaterialIns
                 biTangents[i] = biTangent;
 
                 if (mesh->HasVertexColors(0)) {
-                    colors[i] = StaticMeshVertexData::ColorType(mesh->mColors[0][i].r * 65535, mesh->mColors[0][i].g * 65535,
-                                                                mesh->mColors[0][i].b * 65535);
+                    colors[i] = StaticMeshVertexData::ColorType(mesh->mColors[0][v].r * 65535, mesh->mColors[0][v].g * 65535,
+                                                                mesh->mColors[0][v].b * 65535);
                 } else {
                     colors[i] = StaticMeshVertexData::ColorType(1, 1, 1);
                 }
@@ -581,13 +684,6 @@ void MeshLoader::loadGlobalMeshes(const aiScene* scene, const Array<PMaterialIns
             vertexData->loadBitangents(offset, biTangents);
             vertexData->loadColors(offset, colors);
 
-            Array<uint32> indices(mesh->mNumFaces * 3);
-            for (uint32 faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
-                indices[faceIndex * 3 + 0] = mesh->mFaces[faceIndex].mIndices[0];
-                indices[faceIndex * 3 + 1] = mesh->mFaces[faceIndex].mIndices[1];
-                indices[faceIndex * 3 + 2] = mesh->mFaces[faceIndex].mIndices[2];
-            }
-
             vertexData->loadMesh(id, std::move(positions), std::move(indices));
 
             // collider.physicsMesh.addCollider(positions, indices, Matrix4(1.0f));
@@ -595,7 +691,7 @@ void MeshLoader::loadGlobalMeshes(const aiScene* scene, const Array<PMaterialIns
             globalMeshes[meshIndex]->vertexData = vertexData;
             globalMeshes[meshIndex]->id = id;
             globalMeshes[meshIndex]->referencedMaterial = materials[mesh->mMaterialIndex];
-            globalMeshes[meshIndex]->vertexCount = mesh->mNumVertices;
+            globalMeshes[meshIndex]->vertexCount = numVertices;
             globalMeshes[meshIndex]->blas = graphics->createBottomLevelAccelerationStructure(Gfx::BottomLevelASCreateInfo{
                 .mesh = globalMeshes[meshIndex],
             });
@@ -618,7 +714,7 @@ aiMatrix4x4 loadNodeTransform(aiNode* node) {
     return node->mTransformation * parent;
 }
 
-void MeshLoader::import(MeshImportArgs args, PMeshAsset meshAsset) {
+bool MeshLoader::import(MeshImportArgs args, PMeshAsset meshAsset, Array<std::filesystem::path>& textureFiles) {
     std::cout << "Starting to import " << args.filePath << std::endl;
     meshAsset->setStatus(Asset::Status::Loading);
     Assimp::Importer importer;
@@ -627,11 +723,25 @@ void MeshLoader::import(MeshImportArgs args, PMeshAsset meshAsset) {
                                aiProcess_GenUVCoords | aiProcess_FindDegenerates));
     const aiScene* scene = importer.ApplyPostProcessing(aiProcess_CalcTangentSpace);
     std::cout << importer.GetErrorString() << std::endl;
+    if (scene == nullptr) {
+        return false;
+    }
 
     Array<PTextureAsset> textures;
-    loadTextures(scene, args.filePath.parent_path(), args.importPath, textures);
+    Array<std::filesystem::path> texturePaths;
+    Array<MaterialConversion> conversions;
+    List<std::function<void()>> work;
+    loadTextures(scene, args.filePath.parent_path(), args.importPath, textures, texturePaths, work);
+    convertMaterials(scene, args.filePath.stem().string(), args.filePath.parent_path(), args.importPath, conversions, work);
+    getThreadPool().runAndWait(std::move(work));
+    textureFiles = std::move(texturePaths);
+    for (const auto& conversion : conversions) {
+        for (const auto& file : conversion.textureFiles) {
+            textureFiles.add(file);
+        }
+    }
     Array<PMaterialInstanceAsset> globalMaterials(scene->mNumMaterials);
-    loadMaterials(scene, textures, args.filePath.stem().string(), args.filePath.parent_path(), args.importPath, globalMaterials);
+    createMaterials(textures, args.importPath, conversions, globalMaterials);
 
     Array<OMesh> globalMeshes(scene->mNumMeshes);
     Component::Collider collider;
@@ -652,8 +762,10 @@ void MeshLoader::import(MeshImportArgs args, PMeshAsset meshAsset) {
     }
     meshAsset->meshes = std::move(meshes);
     meshAsset->physicsMesh = std::move(collider);
+    meshAsset->revision++;
 
     AssetRegistry::saveAsset(meshAsset, MeshAsset::IDENTIFIER, meshAsset->getFolderPath(), meshAsset->getName());
 
     meshAsset->setStatus(Asset::Status::Ready);
+    return true;
 }
@@ -4,6 +4,7 @@
 #include "Containers/Map.h"
 #include "MinimalEngine.h"
 #include <filesystem>
+#include <functional>
 
 struct aiScene;
 struct aiTexel;
@@ -22,22 +23,27 @@ class MeshLoader {
   public:
     MeshLoader(Gfx::PGraphics graphic);
     ~MeshLoader();
-    void importAsset(MeshImportArgs args);
+    // false if the file could not be read, textureFiles are the texture sources the mesh refers to
+    bool importAsset(MeshImportArgs args, Array<std::filesystem::path>& textureFiles);
 
   private:
     void findMeshRoots(aiNode* node, List<aiNode*>& meshNodes);
     Vector4 encodeQTangent(Matrix3 m);
 
+    // the texture extraction and material conversion jobs of a mesh all go into one batch, so the importing thread only waits once
+    struct MaterialConversion;
     void loadTextures(const aiScene* scene, const std::filesystem::path& meshDirectory, const std::string& importPath,
-                      Array<PTextureAsset>& textures);
-    void loadMaterials(const aiScene* scene, const Array<PTextureAsset>& textures, const std::string& baseName,
-                       const std::filesystem::path& meshDirectory, const std::string& importPath,
-                       Array<PMaterialInstanceAsset>& globalMaterials);
+                      Array<PTextureAsset>& textures, Array<std::filesystem::path>& texturePaths, List<std::function<void()>>& work);
+    void convertMaterials(const aiScene* scene, const std::string& baseName, const std::filesystem::path& meshDirectory,
+                          const std::string& importPath, Array<MaterialConversion>& conversions, List<std::function<void()>>& work);
+    // runs on the importing thread once the batch is done, creating samplers and compiling materials is not thread safe
+    void createMaterials(const Array<PTextureAsset>& textures, const std::string& importPath, Array<MaterialConversion>& conversions,
+                         Array<PMaterialInstanceAsset>& globalMaterials);
     void loadGlobalMeshes(const aiScene* scene, const Array<PMaterialInstanceAsset>& materials, Array<OMesh>& globalMeshes,
                           Component::Collider& collider);
     void convertAssimpARGB(unsigned char* dst, aiTexel* src, uint32 numPixels);
 
-    void import(MeshImportArgs args, PMeshAsset meshAsset);
+    bool import(MeshImportArgs args, PMeshAsset meshAsset, Array<std::filesystem::path>& textureFiles);
     Gfx::PGraphics graphics;
 };
 DEFINE_REF(MeshLoader)
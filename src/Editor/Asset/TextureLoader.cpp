@@ -1,7 +1,9 @@
 #include "TextureLoader.h"
+#include "Asset/AssetImporter.h"
 #include "Asset/AssetRegistry.h"
 #include "Asset/TextureAsset.h"
 #include "Graphics/Graphics.h"
+#include "Graphics/TextureFormat.h"
 #include "Graphics/Vulkan/Enums.h"
 
 #pragma GCC diagnostic push
@@ -38,10 +40,17 @@ void TextureLoader::importAsset(TextureImportArgs args) {
     auto pos = str.rfind(".");
     str.replace(str.begin() + pos, str.end(), "");
 
-    OTextureAsset asset = new TextureAsset(args.importPath, str);
-    PTextureAsset ref = asset;
-    asset->setStatus(Asset::Status::Loading);
-    AssetRegistry::get().registerTexture(std::move(asset));
+    // a re-import fills the registered asset again, it keeps its bindless slot and the material instances keep pointing to it
+    PTextureAsset ref;
+    if (AssetRegistry::containsTexture(args.importPath, str)) {
+        ref = AssetRegistry::findTexture(args.importPath, str);
+        ref->setStatus(Asset::Status::Loading);
+    } else {
+        OTextureAsset asset = new TextureAsset(args.importPath, str);
+        ref = asset;
+        asset->setStatus(Asset::Status::Loading);
+        AssetRegistry::get().registerTexture(std::move(asset));
+    }
     getThreadPool().runAsync([=]() { import(args, ref); });
 }
 
@@ -56,18 +65,87 @@ PTextureAsset TextureLoader::getPlaceholderTexture() { return placeholderAsset;
         }                                                                                                                                  \
     }
 
+static float srgbToLinear(uint8 value) {
+    float c = value / 255.0f;
+    return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static uint8 linearToSrgb(float c) {
+    c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    return (uint8)std::clamp(c * 255.0f + 0.5f, 0.0f, 255.0f);
+}
+
+// half the size with a box filter, srgb color is averaged in linear space
+static Array<uint8> downsample(const Array<uint8>& image, uint32 width, uint32 height, bool srgb) {
+    uint32 halfWidth = std::max(width / 2, 1u);
+    uint32 halfHeight = std::max(height / 2, 1u);
+    Array<uint8> result(halfWidth * halfHeight * 4);
+    for (uint32 y = 0; y < halfHeight; ++y) {
+        for (uint32 x = 0; x < halfWidth; ++x) {
+            uint32 x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+            uint32 y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+            for (uint32 c = 0; c < 4; ++c) {
+                uint8 texels[4] = {
+                    image[(x0 + y0 * width) * 4 + c],
+                    image[(x1 + y0 * width) * 4 + c],
+                    image[(x0 + y1 * width) * 4 + c],
+                    image[(x1 + y1 * width) * 4 + c],
+                };
+                uint8& texel = result[(x + y * halfWidth) * 4 + c];
+                if (srgb && c < 3) {
+                    float sum = srgbToLinear(texels[0]) + srgbToLinear(texels[1]) + srgbToLinear(texels[2]) + srgbToLinear(texels[3]);
+                    texel = linearToSrgb(sum / 4);
+                } else {
+                    texel = (uint8)((texels[0] + texels[1] + texels[2] + texels[3] + 2) / 4);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// block compressed formats cannot generate their mips when they are loaded, so the whole chain is encoded
+static void setImageWithMips(ktxTexture2* kTexture, uint32 face, Array<uint8> image, uint32 width, uint32 height, bool srgb) {
+    for (uint32 level = 0; level < kTexture->numLevels; ++level) {
+        ktxTexture_SetImageFromMemory(ktxTexture(kTexture), level, 0, face, image.data(), image.size());
+        if (level + 1 < kTexture->numLevels) {
+            image = downsample(image, width, height, srgb);
+            width = std::max(width / 2, 1u);
+            height = std::max(height / 2, 1u);
+        }
+    }
+}
+
 void TextureLoader::import(TextureImportArgs args, PTextureAsset textureAsset) {
     int totalWidth = 0, totalHeight = 0, n = 0;
     unsigned char* data = stbi_load(args.filePath.string().c_str(), &totalWidth, &totalHeight, &n, 4);
+    if (data == nullptr) {
+        std::cout << "Failed to load " << args.filePath << ": " << stbi_failure_reason() << std::endl;
+        AssetImporter::finishImport(args.filePath, args.importPath, false);
+        return;
+    }
+    Gfx::TextureContent content = Gfx::TextureContent::COLOR;
+    if (args.type == TextureImportType::TEXTURE_NORMAL) {
+        content = Gfx::TextureContent::NORMAL;
+    } else if (n == 1) {
+        content = Gfx::TextureContent::SINGLE_CHANNEL;
+    } else {
+        for (int i = 0; i < totalWidth * totalHeight; ++i) {
+            if (data[i * 4 + 3] != 255) {
+                content = Gfx::TextureContent::COLOR_ALPHA;
+                break;
+            }
+        }
+    }
+    bool srgb = content == Gfx::TextureContent::COLOR || content == Gfx::TextureContent::COLOR_ALPHA;
     ktxTexture2* kTexture = nullptr;
-    VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+    VkFormat format = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
     ktxTextureCreateInfo createInfo = {
         .vkFormat = (uint32)format,
         .baseDepth = 1,
-        .numLevels = 1,
         .numLayers = 1,
         .isArray = false,
-        .generateMipmaps = true,
+        .generateMipmaps = false,
     };
 
     if (args.type == TextureImportType::TEXTURE_CUBEMAP) {
@@ -76,13 +154,14 @@ void TextureLoader::import(TextureImportArgs args, PTextureAsset textureAsset) {
         // Cube map
         createInfo.baseWidth = totalWidth / 4;
         createInfo.baseHeight = totalHeight / 3;
+        createInfo.numLevels = static_cast<uint32>(std::floor(std::log2(std::max(createInfo.baseWidth, createInfo.baseHeight)))) + 1;
         createInfo.numFaces = 6;
         createInfo.numDimensions = 2;
 
         KTX_ASSERT(ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &kTexture));
 
-        auto loadCubeFace = [&kTexture, faceWidth, totalWidth, &data](int xPos, int yPos, int faceName) {
-            std::vector<unsigned char> vec(faceWidth * faceWidth * 4);
+        auto loadCubeFace = [&kTexture, faceWidth, totalWidth, &data, srgb](int xPos, int yPos, int faceName) {
+            Array<uint8> vec(faceWidth * faceWidth * 4);
             for (uint32 y = 0; y < faceWidth; ++y) {
                 for (uint32 x = 0; x < faceWidth; ++x) {
                     int imgX = x + (xPos * faceWidth);
@@ -90,7 +169,7 @@ void TextureLoader::import(TextureImportArgs args, PTextureAsset textureAsset) {
                     std::memcpy(&vec[(x + (faceWidth * y)) * 4], &data[(imgX + (totalWidth * imgY)) * 4], 4);
                 }
             }
-            ktxTexture_SetImageFromMemory(ktxTexture(kTexture), 0, 0, faceName, vec.data(), vec.size());
+            setImageWithMips(kTexture, faceName, std::move(vec), faceWidth, faceWidth, srgb);
         };
         loadCubeFace(2, 1, 0); // +X
         loadCubeFace(0, 1, 1); // -X
@@ -101,27 +180,38 @@ void TextureLoader::import(TextureImportArgs args, PTextureAsset textureAsset) {
     } else {
         createInfo.baseWidth = totalWidth;
         createInfo.baseHeight = totalHeight;
+        createInfo.numLevels = static_cast<uint32>(std::floor(std::log2(std::max(totalWidth, totalHeight)))) + 1;
         createInfo.numFaces = 1;
         createInfo.numDimensions = 1 + (totalHeight > 1);
 
         ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &kTexture);
 
-        ktxTexture_SetImageFromMemory(ktxTexture(kTexture), 0, 0, 0, data, totalWidth * totalHeight * 4 * sizeof(unsigned char));
+        Array<uint8> image(totalWidth * totalHeight * 4);
+        std::memcpy(image.data(), data, image.size());
+        setImageWithMips(kTexture, 0, std::move(image), totalWidth, totalHeight, srgb);
     }
     ktxBasisParams basisParams = {
         .structSize = sizeof(ktxBasisParams),
         .uastc = false,
-        .threadCount = 1,
+        // basisu encodes the slices of a texture on a job pool of its own, which is the slow part of an import
+        .threadCount = std::max(1u, std::thread::hardware_concurrency()),
         .compressionLevel = KTX_ETC1S_DEFAULT_COMPRESSION_LEVEL,
         .uastcFlags = KTX_PACK_UASTC_LEVEL_DEFAULT,
         .uastcRDO = true,
     };
+    if (content == Gfx::TextureContent::NORMAL) {
+        // x goes to the color and y to the alpha slice of ETC1S, which is what BC5 and EAC RG11 transcode to red and green
+        basisParams.normalMap = true;
+        std::memcpy(basisParams.inputSwizzle, "rrrg", 4);
+    }
     KTX_ASSERT(ktxTexture2_CompressBasisEx(kTexture, &basisParams));
     //KTX_ASSERT(ktxTexture2_DeflateZstd(kTexture, 10));
 
     char writer[100];
     snprintf(writer, sizeof(writer), "%s version %s", "SeeleEngine", "0.0.1");
     ktxHashList_AddKVPair(&kTexture->kvDataHead, KTX_WRITER_KEY, (ktx_uint32_t)strlen(writer) + 1, writer);
+    uint8 contentValue = (uint8)content;
+    ktxHashList_AddKVPair(&kTexture->kvDataHead, TextureAsset::CONTENT_KEY, 1, &contentValue);
 
     uint8* texData;
     size_t texSize;
@@ -149,5 +239,6 @@ void TextureLoader::import(TextureImportArgs args, PTextureAsset textureAsset) {
     AssetRegistry::saveAsset(textureAsset, TextureAsset::IDENTIFIER, textureAsset->getFolderPath(), textureAsset->getName());
 
     textureAsset->setStatus(Asset::Status::Ready);
+    AssetImporter::finishImport(args.filePath, args.importPath, true);
     std::cout << "Done importing " << textureAsset->getName() << std::endl;
 }
@@ -21,6 +21,10 @@ SceneView::SceneView(Gfx::PGraphics graphics, PWindow owner, const ViewportCreat
     renderGraph.addPass(new DepthCullingPass(graphics, scene));
     renderGraph.addPass(new LightCullingPass(graphics, scene));
     renderGraph.addPass(new BasePass(graphics, scene));
+    // nothing in the graph draws to the viewport, the base pass image is what the scene view shows
+    renderGraph.markOutput("BASEPASS_COLOR");
+    // features get toggled at runtime here, so only what is actually drawn gets compiled
+    renderGraph.setLazyShaderCompilation(true);
     renderGraph.setViewport(viewport);
     renderGraph.createRenderPass();
 }
@@ -36,11 +40,11 @@ void SceneView::update() {
     // co_return;
 }
 
-void SceneView::commitUpdate() {}
+void SceneView::commitUpdate() { renderCamera = viewportCamera; }
 
 void SceneView::prepareRender() {}
 
-void SceneView::render() { renderGraph.render(viewportCamera, Component::Transform()); }
+void SceneView::render() { renderGraph.render(renderCamera, Component::Transform()); }
 
 void SceneView::keyCallback(KeyCode code, InputAction action, KeyModifier) { cameraSystem.keyCallback(code, action); }
 
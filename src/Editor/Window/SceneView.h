@@ -24,6 +24,8 @@ class SceneView : public View {
   private:
     OScene scene;
     Component::Camera viewportCamera;
+    // copy of viewportCamera for the render side, taken in commitUpdate
+    Component::Camera renderCamera;
 
     RenderGraph renderGraph;
 
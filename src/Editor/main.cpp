@@ -69,6 +69,7 @@ int main() {
         });
 
         getThreadPool().waitIdle();
+        AssetImporter::saveImportCache();
         vd->commitMeshes();
         WindowCreateInfo mainWindowInfo = {
             .width = 1920,
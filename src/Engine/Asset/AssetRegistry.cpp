@@ -9,6 +9,7 @@
 #include "FontAsset.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Mesh.h"
+#include "Profiler.h"
 #include "Window/WindowManager.h"
 #include <fstream>
 #include <iostream>
@@ -41,6 +42,24 @@ PTextureAsset AssetRegistry::findTexture(std::string_view folderPath, std::strin
     return folder->textures.at(std::string(filePath));
 }
 
+bool AssetRegistry::containsMesh(std::string_view folderPath, std::string_view name) {
+    std::unique_lock l(get().assetLock);
+    AssetFolder* folder = get().assetRoot;
+    if (!folderPath.empty()) {
+        folder = get().getOrCreateFolder(folderPath);
+    }
+    return folder->meshes.contains(std::string(name));
+}
+
+bool AssetRegistry::containsTexture(std::string_view folderPath, std::string_view name) {
+    std::unique_lock l(get().assetLock);
+    AssetFolder* folder = get().assetRoot;
+    if (!folderPath.empty()) {
+        folder = get().getOrCreateFolder(folderPath);
+    }
+    return folder->textures.contains(std::string(name));
+}
+
 PFontAsset AssetRegistry::findFont(std::string_view folderPath, std::string_view filePath) {
     std::unique_lock l(get().assetLock);
     AssetFolder* folder = get().assetRoot;
@@ -86,6 +105,22 @@ PMaterialInstanceAsset AssetRegistry::findMaterialInstance(std::string_view fold
     return folder->instances.at(std::string(filePath));
 }
 
+Array<PMeshAsset> AssetRegistry::getAllMeshes() {
+    std::unique_lock l(get().assetLock);
+    Array<PMeshAsset> meshes;
+    Array<PMaterialAsset> materials;
+    get().collectFolder(get().assetRoot, meshes, materials);
+    return meshes;
+}
+
+Array<PMaterialAsset> AssetRegistry::getAllMaterials() {
+    std::unique_lock l(get().assetLock);
+    Array<PMeshAsset> meshes;
+    Array<PMaterialAsset> materials;
+    get().collectFolder(get().assetRoot, meshes, materials);
+    return materials;
+}
+
 void AssetRegistry::registerMesh(OMeshAsset mesh) {
     std::unique_lock l(get().assetLock);
     get().registerMeshInternal(std::move(mesh));
@@ -237,14 +272,31 @@ void AssetRegistry::initialize(const std::filesystem::path& _rootFolder, Gfx::PG
 }
 
 void AssetRegistry::loadRegistryInternal() {
+    PROFILE_ZONE("LoadRegistry");
     Array<Pair<PAsset, ArchiveBuffer>> peeked;
     {
+        PROFILE_ZONE("PeekAssets");
         std::unique_lock l(get().assetLock);
         peeked = peekFolder(assetRoot);
     }
+    // nothing references the GPU textures while loading, so they are all done first and transcoded in parallel
+    Array<Pair<PTextureAsset, ArchiveBuffer*>> textures;
+    for (auto& [asset, buffer] : peeked) {
+        PTextureAsset texture = asset.cast<TextureAsset>();
+        if (texture != nullptr) {
+            textures.add(Pair<PTextureAsset, ArchiveBuffer*>{texture, &buffer});
+        }
+    }
+    {
+        PROFILE_ZONE("LoadTextures");
+        TextureAsset::loadParallel(textures);
+    }
     uint64 assetSize = 0;
     for (auto& [asset, buffer] : peeked) {
-        asset->load(buffer);
+        if (asset.cast<TextureAsset>() == nullptr) {
+            PROFILE_ZONE_DETAIL("LoadAsset", asset->getName());
+            asset->load(buffer);
+        }
         assetSize += asset->getSize();
     }
     std::cout << "Done loading " << assetSize << std::endl;
@@ -255,6 +307,9 @@ Array<Pair<PAsset, ArchiveBuffer>> AssetRegistry::peekFolder(AssetFolder* folder
     for (const auto& entry : std::filesystem::directory_iterator(rootFolder / folder->folderPath)) {
         const auto& stem = entry.path().stem().string();
         if (entry.is_directory()) {
+            if (entry.path() == getCacheFolder()) {
+                continue;
+            }
             if (folder->folderPath.empty()) {
                 folder->children[stem] = new AssetFolder(stem);
             } else {
@@ -266,7 +321,8 @@ Array<Pair<PAsset, ArchiveBuffer>> AssetRegistry::peekFolder(AssetFolder* folder
             }
             continue;
         }
-        if (entry.path().filename().compare(".DS_Store") == 0) {
+        // only .asset files belong to the registry, tools like the editor keep their caches next to them
+        if (entry.path().extension() != ".asset") {
             continue;
         }
         auto stream = std::ifstream(entry.path(), std::ios::binary);
@@ -359,8 +415,27 @@ void AssetRegistry::saveFolder(const std::filesystem::path& folderPath, AssetFol
     }
 }
 
+void AssetRegistry::collectFolder(AssetFolder* folder, Array<PMeshAsset>& meshes, Array<PMaterialAsset>& materials) {
+    for (const auto& [_, mesh] : folder->meshes) {
+        meshes.add(PMeshAsset(mesh));
+    }
+    for (const auto& [_, material] : folder->materials) {
+        materials.add(PMaterialAsset(material));
+    }
+    for (const auto& [_, child] : folder->children) {
+        collectFolder(child, meshes, materials);
+    }
+}
+
 std::filesystem::path AssetRegistry::getRootFolder() { return get().rootFolder; }
 
+std::filesystem::path AssetRegistry::getCacheFolder() {
+    if (get().rootFolder.empty()) {
+        return {};
+    }
+    return get().rootFolder / "Cache";
+}
+
 void AssetRegistry::registerMeshInternal(OMeshAsset mesh) {
     AssetFolder* folder = getOrCreateFolder(mesh->getFolderPath());
     folder->meshes[mesh->getName()] = std::move(mesh);
@@ -22,6 +22,9 @@ class AssetRegistry {
     static void init(std::filesystem::path path, Gfx::PGraphics graphics);
 
     static std::filesystem::path getRootFolder();
+    // derived data like compiled shaders lives here, it is never scanned for assets
+    // empty as long as the registry is not initialized
+    static std::filesystem::path getCacheFolder();
 
     static PMeshAsset findMesh(std::string_view folderPath, std::string_view filePath);
     static PTextureAsset findTexture(std::string_view folderPath, std::string_view filePath);
@@ -30,6 +33,12 @@ class AssetRegistry {
     static PEnvironmentMapAsset findEnvironmentMap(std::string_view folder, std::string_view name);
     static PMaterialAsset findMaterial(std::string_view folderPath, std::string_view filePath);
     static PMaterialInstanceAsset findMaterialInstance(std::string_view folderPath, std::string_view filePath);
+    // unlike find these do not throw for names that are not registered yet
+    static bool containsMesh(std::string_view folderPath, std::string_view name);
+    static bool containsTexture(std::string_view folderPath, std::string_view name);
+    // every registered asset of that type, sorted by folder and name
+    static Array<PMeshAsset> getAllMeshes();
+    static Array<PMaterialAsset> getAllMaterials();
 
     static void registerMesh(OMeshAsset mesh);
     static void registerTexture(OTextureAsset texture);
@@ -74,6 +83,7 @@ class AssetRegistry {
     Pair<PAsset, ArchiveBuffer> peekAsset(ArchiveBuffer& buffer);
     void saveRegistryInternal();
     void saveFolder(const std::filesystem::path& folderPath, AssetFolder* folder);
+    void collectFolder(AssetFolder* folder, Array<PMeshAsset>& meshes, Array<PMaterialAsset>& materials);
 
     void registerMeshInternal(OMeshAsset mesh);
     void registerTextureInternal(OTextureAsset texture);
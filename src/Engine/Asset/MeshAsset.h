@@ -16,6 +16,8 @@ class MeshAsset : public Asset {
     // Workaround while no editor
     Array<OMesh> meshes;
     Component::Collider physicsMesh;
+    // bumped whenever a re-import replaces the meshes, components map the new ones for culling once it changed
+    uint32 revision = 0;
 };
 DEFINE_REF(MeshAsset)
 } // namespace Seele
\ No newline at end of file
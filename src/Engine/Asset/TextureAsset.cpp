@@ -1,9 +1,18 @@
 #include "TextureAsset.h"
+#include "AssetRegistry.h"
+#include "CRC.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureFormat.h"
 #include "Graphics/Vulkan/Enums.h"
+#include "Material/Material.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
 #include "Window/WindowManager.h"
 #include "ktx.h"
+#include <fmt/format.h>
+#include <fstream>
+#include <thread>
 
 using namespace Seele;
 
@@ -20,33 +29,222 @@ TextureAsset::TextureAsset() {}
 
 TextureAsset::TextureAsset(std::string_view folderPath, std::string_view name) : Asset(folderPath, name) {}
 
-TextureAsset::~TextureAsset() {}
+TextureAsset::~TextureAsset() {
+    if (bindlessSlot != INVALID_SLOT) {
+        Material::freeTexture(bindlessSlot);
+    }
+    if (transcoded != nullptr) {
+        ktxTexture_Destroy(ktxTexture(transcoded));
+    }
+}
 
 void TextureAsset::save(ArchiveBuffer& buffer) const { 
     Serialization::save(buffer, ktxData);
 }
 
+static Gfx::TextureContent getContent(ktxTexture2* ktxHandle) {
+    unsigned int size = 0;
+    void* value = nullptr;
+    if (ktxHashList_FindValue(&ktxHandle->kvDataHead, TextureAsset::CONTENT_KEY, &size, &value) == KTX_SUCCESS && size == 1) {
+        return static_cast<Gfx::TextureContent>(*(uint8*)value);
+    }
+    return Gfx::TextureContent::COLOR_ALPHA;
+}
+
+// what the basis data is transcoded to for each of the formats chooseTextureFormat returns
+static ktx_transcode_fmt_e getTranscodeTarget(Gfx::SeFormat format) {
+    switch (format) {
+    case Gfx::SE_FORMAT_BC7_SRGB_BLOCK:
+        return KTX_TTF_BC7_RGBA;
+    case Gfx::SE_FORMAT_BC1_RGB_SRGB_BLOCK:
+        return KTX_TTF_BC1_RGB;
+    case Gfx::SE_FORMAT_BC3_SRGB_BLOCK:
+        return KTX_TTF_BC3_RGBA;
+    case Gfx::SE_FORMAT_BC4_UNORM_BLOCK:
+        return KTX_TTF_BC4_R;
+    case Gfx::SE_FORMAT_BC5_UNORM_BLOCK:
+        return KTX_TTF_BC5_RG;
+    case Gfx::SE_FORMAT_ASTC_4x4_SRGB_BLOCK:
+    case Gfx::SE_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        return KTX_TTF_ASTC_4x4_RGBA;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        return KTX_TTF_ETC1_RGB;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        return KTX_TTF_ETC2_RGBA;
+    case Gfx::SE_FORMAT_EAC_R11_UNORM_BLOCK:
+        return KTX_TTF_ETC2_EAC_R11;
+    case Gfx::SE_FORMAT_EAC_R11G11_UNORM_BLOCK:
+        return KTX_TTF_ETC2_EAC_RG11;
+    default:
+        return KTX_TTF_RGBA32;
+    }
+}
+
+// empty if the transcoded textures are not cached
+static std::filesystem::path getTranscodeCachePath(const Array<uint8>& ktxData, Gfx::SeFormat format) {
+    std::filesystem::path cacheFolder = AssetRegistry::getCacheFolder();
+    if (!getGlobals().cacheTranscodedTextures || cacheFolder.empty()) {
+        return {};
+    }
+    uint64 hash = CRC::Calculate(ktxData.data(), ktxData.size(), CRC::CRC_64());
+    return cacheFolder / "Textures" / fmt::format("{0:016x}_{1}.ktx2", hash, (uint32)format);
+}
+
+static void storeTranscoded(const std::filesystem::path& path, ktxTexture2* ktxHandle) {
+    uint8* data;
+    size_t size;
+    if (ktxTexture_WriteToMemory(ktxTexture(ktxHandle), &data, &size) != KTX_SUCCESS) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    // textures are loaded on several threads, so nobody may read the file before it is complete
+    std::filesystem::path tempPath = path;
+    tempPath += fmt::format(".{0}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+    bool written = false;
+    {
+        std::ofstream stream(tempPath, std::ios::binary);
+        stream.write((const char*)data, size);
+        written = bool(stream);
+    }
+    free(data);
+    if (written) {
+        std::filesystem::rename(tempPath, path, ec);
+    }
+    if (!written || ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
 void TextureAsset::load(ArchiveBuffer& buffer) {
+    transcode(buffer);
+    createTexture(buffer.getGraphics());
+}
+
+void TextureAsset::loadParallel(const Array<Pair<PTextureAsset, ArchiveBuffer*>>& textures) {
+    if (textures.empty()) {
+        return;
+    }
+    Gfx::PGraphics graphics = textures[0].value->getGraphics();
+    List<std::function<void()>> work;
+    for (const auto& [asset, buffer] : textures) {
+        work.add([asset, buffer]() {
+            PROFILE_ZONE_DETAIL("TranscodeTexture", asset->getName());
+            asset->transcode(*buffer);
+        });
+    }
+    getThreadPool().runAndWait(std::move(work));
+    for (const auto& [asset, buffer] : textures) {
+        PROFILE_ZONE_DETAIL("CreateTexture", asset->getName());
+        asset->createTexture(graphics);
+    }
+}
+
+void TextureAsset::transcode(ArchiveBuffer& buffer) {
     ktxTexture2* ktxHandle;
     Serialization::load(buffer, ktxData);
     KTX_ASSERT(
         ktxTexture_CreateFromMemory(ktxData.data(), ktxData.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, (ktxTexture**)&ktxHandle));
-    ktxTexture2_TranscodeBasis(ktxHandle, KTX_TTF_RGBA32, 0);
 
     Gfx::PGraphics graphics = buffer.getGraphics();
+    Gfx::TextureContent content = getContent(ktxHandle);
+    // block compressed formats cannot generate their mips on the GPU, so textures imported without them stay uncompressed
+    Gfx::SeFormat format = Gfx::SE_FORMAT_R8G8B8A8_SRGB;
+    if (ktxHandle->numLevels > 1) {
+        format =
+            Gfx::chooseTextureFormat(content, [graphics](Gfx::SeFormat candidate) { return graphics->supportsSampledFormat(candidate); });
+    }
+    std::filesystem::path cachePath = Gfx::isBlockCompressed(format) ? getTranscodeCachePath(ktxData, format) : std::filesystem::path();
+    ktxTexture2* cached = nullptr;
+    if (!cachePath.empty() && ktxTexture_CreateFromNamedFile(cachePath.string().c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                                             (ktxTexture**)&cached) == KTX_SUCCESS) {
+        ktxTexture_Destroy(ktxTexture(ktxHandle));
+        ktxHandle = cached;
+    } else if (ktxTexture2_NeedsTranscoding(ktxHandle)) {
+        KTX_ASSERT(ktxTexture2_TranscodeBasis(ktxHandle, getTranscodeTarget(format), 0));
+        if (content == Gfx::TextureContent::NORMAL && !Gfx::isBlockCompressed(format)) {
+            // basis stores y in alpha, BC5 and EAC RG11 move it to green by themselves
+            uint8* texels = ktxTexture_GetData(ktxTexture(ktxHandle));
+            size_t size = ktxTexture_GetDataSize(ktxTexture(ktxHandle));
+            for (size_t i = 0; i + 3 < size; i += 4) {
+                texels[i + 1] = texels[i + 3];
+            }
+        }
+        if (!cachePath.empty()) {
+            storeTranscoded(cachePath, ktxHandle);
+        }
+    }
+    if (transcoded != nullptr) {
+        // a streamed texture that is imported again
+        ktxTexture_Destroy(ktxTexture(transcoded));
+    }
+    transcoded = ktxHandle;
+}
+
+void TextureAsset::createTexture(Gfx::PGraphics graphics) {
+    width = transcoded->baseWidth;
+    height = transcoded->baseHeight;
+    // the backends only create plain 2D textures from a subset of the levels
+    bool streamed = getGlobals().streamTextures && transcoded->numLevels > 1 && !transcoded->isCubemap && !transcoded->isArray &&
+                    transcoded->baseDepth <= 1;
+    createLevels(graphics, streamed ? getInitialLevel() : 0);
+    if (!streamed) {
+        ktxTexture_Destroy(ktxTexture(transcoded));
+        transcoded = nullptr;
+    }
+    byteSize = sizeof(TextureAsset) + ktxData.size();
+}
+
+void TextureAsset::streamTo(Gfx::PGraphics graphics, uint32 level) {
+    assert(isStreamed());
+    if (level != residentLevel) {
+        PROFILE_ZONE_DETAIL("StreamTexture", name);
+        createLevels(graphics, level);
+    }
+}
+
+uint32 TextureAsset::getNumLevels() const { return transcoded != nullptr ? transcoded->numLevels : texture->getMipLevels(); }
+
+uint64 TextureAsset::getLevelSize(uint32 level) const { return ktxTexture_GetImageSize(ktxTexture(transcoded), level); }
+
+uint32 TextureAsset::getInitialLevel() const {
+    uint32 level = 0;
+    while (level + 1 < transcoded->numLevels && std::max(width, height) >> level > STREAMING_INITIAL_SIZE) {
+        level++;
+    }
+    return level;
+}
+
+void TextureAsset::createLevels(Gfx::PGraphics graphics, uint32 level) {
+    ktxTexture2* ktxHandle = transcoded;
+    // KTX2 stores the smallest level first, so the levels from level on are a prefix of the data
+    Array<uint64> mipOffsets;
+    ktx_size_t size = ktxTexture_GetDataSize(ktxTexture(ktxHandle));
+    if (ktxHandle->numLevels > 1) {
+        for (uint32 i = level; i < ktxHandle->numLevels; ++i) {
+            ktx_size_t offset;
+            KTX_ASSERT(ktxTexture_GetImageOffset(ktxTexture(ktxHandle), i, 0, 0, &offset));
+            mipOffsets.add(offset);
+        }
+        if (level > 0) {
+            size = mipOffsets[0] + ktxTexture_GetImageSize(ktxTexture(ktxHandle), level);
+        }
+    }
+
     TextureCreateInfo createInfo = {
         .sourceData =
             {
-                .size = ktxTexture_GetDataSize(ktxTexture(ktxHandle)),
+                .size = size,
                 .data = ktxTexture_GetData(ktxTexture(ktxHandle)),
                 .owner = Gfx::QueueType::GRAPHICS,
             },
         .format = (Gfx::SeFormat)ktxHandle->vkFormat,
-        .width = ktxHandle->baseWidth,
-        .height = ktxHandle->baseHeight,
+        .width = std::max(ktxHandle->baseWidth >> level, 1u),
+        .height = std::max(ktxHandle->baseHeight >> level, 1u),
         .depth = ktxHandle->baseDepth,
         .elements = ktxHandle->numLayers,
         .useMip = true,
+        .mipOffsets = std::move(mipOffsets),
         .usage = Gfx::SE_IMAGE_USAGE_SAMPLED_BIT,
         .name = name,
     };
@@ -56,13 +254,24 @@ void TextureAsset::load(ArchiveBuffer& buffer) {
         texture = graphics->createTexture3D(createInfo);
     } else {
         texture = graphics->createTexture2D(createInfo);
+        Material::updateTexture(getBindlessSlot(), Gfx::PTexture2D(texture));
     }
+    residentLevel = level;
+}
 
-    ktxTexture_Destroy(ktxTexture(ktxHandle));
-
-    byteSize = sizeof(TextureAsset) + ktxData.size();
+uint32 TextureAsset::getBindlessSlot() {
+    uint32 slot = bindlessSlot.load();
+    if (slot != INVALID_SLOT) {
+        return slot;
+    }
+    // a material instance and the texture itself might ask for the slot at the same time while loading
+    uint32 allocated = Material::allocateTexture();
+    if (!bindlessSlot.compare_exchange_strong(slot, allocated)) {
+        Material::freeTexture(allocated);
+    }
+    return bindlessSlot.load();
 }
 
-uint32 TextureAsset::getWidth() { return texture->getWidth(); }
+uint32 TextureAsset::getWidth() { return width; }
 
-uint32 TextureAsset::getHeight() { return texture->getHeight(); }
+uint32 TextureAsset::getHeight() { return height; }
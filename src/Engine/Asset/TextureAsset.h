@@ -1,25 +1,64 @@
 #pragma once
 #include "Asset.h"
+#include "Containers/Pair.h"
+#include <atomic>
+#include <limits>
 
 struct ktxTexture2;
 namespace Seele {
 DECLARE_NAME_REF(Gfx, Texture)
+DECLARE_REF(TextureAsset)
 class TextureAsset : public Asset {
   public:
     static constexpr uint64 IDENTIFIER = 0x1;
+    // KTX key whose one byte value is the Gfx::TextureContent of the texture, textures without it are treated as color with alpha
+    static constexpr const char* CONTENT_KEY = "SeeleTextureContent";
+    // streamed textures start out with the levels that are at most this many texels wide and high, see TextureStreamer
+    static constexpr uint32 STREAMING_INITIAL_SIZE = 128;
     TextureAsset();
     TextureAsset(std::string_view folderPath, std::string_view name);
     virtual ~TextureAsset();
     virtual void save(ArchiveBuffer& buffer) const override;
     virtual void load(ArchiveBuffer& buffer) override;
+    // decodes and transcodes the KTX data without touching the GPU, so it can run for many textures at once
+    void transcode(ArchiveBuffer& buffer);
+    // creates the texture from what transcode produced, its copies share the transfer submissions of the other uploads
+    // streamed textures only get their small levels and keep the transcoded data to create the others from
+    void createTexture(Gfx::PGraphics graphics);
+    // recreates a streamed texture with the levels from level down to the smallest one, the previous texture is destroyed
+    // once the frames that still sample it are done
+    void streamTo(Gfx::PGraphics graphics, uint32 level);
+    bool isStreamed() const { return transcoded != nullptr; }
+    uint32 getNumLevels() const;
+    // bytes of a single level, 0 being the full resolution
+    uint64 getLevelSize(uint32 level) const;
+    // finest level the texture currently has
+    uint32 getResidentLevel() const { return residentLevel; }
+    // level a streamed texture starts out with
+    uint32 getInitialLevel() const;
+    // transcodes on the thread pool, then creates the textures on the calling thread, whose command pools are the ones being submitted
+    static void loadParallel(const Array<Pair<PTextureAsset, ArchiveBuffer*>>& textures);
     Gfx::PTexture getTexture() { return texture; }
+    // index into the texture array of Material, it stays the same when the texture is streamed
+    // allocated by the first material instance that refers to the texture, or once a 2D texture is created
+    // cube maps and arrays are never bound through that array, so they never take a slot
+    uint32 getBindlessSlot();
     void setTexture(Array<uint8> data) { ktxData = std::move(data); }
+    // of the full resolution, even if the texture is streamed
     uint32 getWidth();
     uint32 getHeight();
 
   private:
+    void createLevels(Gfx::PGraphics graphics, uint32 level);
     Gfx::OTexture texture;
     Array<uint8> ktxData;
+    // between transcode and createTexture, and for as long as the texture is streamed
+    ktxTexture2* transcoded = nullptr;
+    uint32 residentLevel = 0;
+    static constexpr uint32 INVALID_SLOT = std::numeric_limits<uint32>::max();
+    std::atomic_uint32_t bindlessSlot = INVALID_SLOT;
+    uint32 width = 0;
+    uint32 height = 0;
     friend class TextureLoader;
 };
 DEFINE_REF(TextureAsset)
@@ -6,6 +6,8 @@ namespace Component {
 struct Mesh {
     PMeshAsset asset;
     Array<uint32> meshletOffsets;
+    // of the asset the meshlet offsets were mapped for
+    uint32 revision = 0;
     bool isStatic = true;
 };
 } // namespace Component
@@ -0,0 +1,61 @@
+#include "BindlessSlots.h"
+
+using namespace Seele;
+using namespace Seele::Gfx;
+
+BindlessSlots::BindlessSlots(uint32 capacity) : capacity(capacity), allocated(capacity, false) {}
+
+BindlessSlots::~BindlessSlots() {}
+
+uint32 BindlessSlots::allocate() {
+    uint32 slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop();
+    } else if (numUsed < capacity) {
+        slot = numUsed++;
+    } else {
+        throw std::logic_error("Out of bindless slots");
+    }
+    allocated[slot] = true;
+    return slot;
+}
+
+void BindlessSlots::free(uint32 slot) {
+    assert(allocated[slot]);
+    allocated[slot] = false;
+    markChanged(slot);
+    freeSlots.add(slot);
+}
+
+void BindlessSlots::markChanged(uint32 slot) {
+    for (auto& set : changes) {
+        if (!set.queued[slot]) {
+            set.queued[slot] = true;
+            set.slots.add(slot);
+        }
+    }
+}
+
+uint32 BindlessSlots::addSet() {
+    SetChanges set = {
+        .queued = Array<bool>(capacity, false),
+    };
+    for (uint32 slot = 0; slot < numUsed; ++slot) {
+        if (allocated[slot]) {
+            set.queued[slot] = true;
+            set.slots.add(slot);
+        }
+    }
+    changes.add(std::move(set));
+    return (uint32)changes.size() - 1;
+}
+
+Array<uint32> BindlessSlots::takeChanges(uint32 set) {
+    Array<uint32> result = std::move(changes[set].slots);
+    changes[set].slots = Array<uint32>();
+    for (uint32 slot : result) {
+        changes[set].queued[slot] = false;
+    }
+    return result;
+}
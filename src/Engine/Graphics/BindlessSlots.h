@@ -0,0 +1,41 @@
+#pragma once
+#include "Containers/Array.h"
+#include "MinimalEngine.h"
+
+namespace Seele {
+namespace Gfx {
+// stable indices into a descriptor array that several descriptor sets share, one for every frame that might still read it
+// each set only gets the slots written that changed since it was written the last time
+class BindlessSlots {
+  public:
+    BindlessSlots(uint32 capacity);
+    ~BindlessSlots();
+    // throws if every slot is taken
+    uint32 allocate();
+    // the slot can be handed out again right away, every set clears it before it is bound the next time
+    void free(uint32 slot);
+    // what the slot refers to changed, so every set has to write it again
+    void markChanged(uint32 slot);
+    // a set that has not been written yet, it gets every allocated slot
+    uint32 addSet();
+    // slots the set has to write, they count as written afterwards
+    Array<uint32> takeChanges(uint32 set);
+    uint32 getNumSets() const { return (uint32)changes.size(); }
+    bool isAllocated(uint32 slot) const { return allocated[slot]; }
+    constexpr uint32 getCapacity() const { return capacity; }
+
+  private:
+    struct SetChanges {
+        // in the order they changed
+        Array<uint32> slots;
+        Array<bool> queued;
+    };
+    uint32 capacity;
+    // slots above it were never handed out
+    uint32 numUsed = 0;
+    Array<bool> allocated;
+    Array<uint32> freeSlots;
+    Array<SetChanges> changes;
+};
+} // namespace Gfx
+} // namespace Seele
@@ -24,6 +24,9 @@ class RenderCommand {
     virtual void drawMesh(uint32 groupX, uint32 groupY, uint32 groupZ) = 0;
     virtual void drawMeshIndirect(Gfx::PShaderBuffer buffer, uint64 offset, uint32 drawCount, uint32 stride) = 0;
     virtual void traceRays(uint32 width, uint32 height, uint32 depth) = 0;
+    // finishes recording, has to run on the thread that recorded the command
+    // executeCommands ends the commands that were not ended yet, so that only works for ones recorded on the submitting thread
+    virtual void end() = 0;
     std::string name;
 };
 DEFINE_REF(RenderCommand)
@@ -37,6 +40,8 @@ class ComputeCommand {
     virtual void pushConstants(Gfx::SeShaderStageFlags stage, uint32 offset, uint32 size, const void* data) = 0;
     virtual void dispatch(uint32 threadX, uint32 threadY, uint32 threadZ) = 0;
     virtual void dispatchIndirect(Gfx::PShaderBuffer buffer, uint32 offset) = 0;
+    // same as for render commands
+    virtual void end() = 0;
     std::string name;
 };
 DEFINE_REF(ComputeCommand)
@@ -1,4 +1,5 @@
 #include "Descriptor.h"
+#include <fmt/core.h>
 
 using namespace Seele;
 using namespace Seele::Gfx;
@@ -7,8 +8,22 @@ DescriptorLayout::DescriptorLayout(const std::string& name) : name(name) {}
 
 DescriptorLayout::~DescriptorLayout() {}
 
-void DescriptorLayout::addDescriptorBinding(DescriptorBinding binding) {
+DescriptorBindingHandle DescriptorLayout::addDescriptorBinding(DescriptorBinding binding) {
     descriptorBindings.add(binding);
+    return DescriptorBindingHandle{
+        .index = (uint32)descriptorBindings.size() - 1,
+    };
+}
+
+DescriptorBindingHandle DescriptorLayout::findBinding(const std::string& bindingName) const {
+    for (uint32 i = 0; i < descriptorBindings.size(); ++i) {
+        if (descriptorBindings[i].name == bindingName) {
+            return DescriptorBindingHandle{
+                .index = i,
+            };
+        }
+    }
+    throw std::logic_error(fmt::format("Descriptor layout {} has no binding {}", name, bindingName));
 }
 
 ODescriptorSet DescriptorLayout::allocateDescriptorSet() { return pool->allocateDescriptorSet(); }
@@ -17,18 +17,27 @@ struct DescriptorBinding {
     SeDescriptorAccessTypeFlags access = SE_DESCRIPTOR_ACCESS_READ_BIT;
 };
 
+// position of a binding in its layout, kept by whoever writes the set so the name does not have to be looked up every frame
+struct DescriptorBindingHandle {
+    uint32 index = std::numeric_limits<uint32>::max();
+    constexpr bool isValid() const { return index != std::numeric_limits<uint32>::max(); }
+};
+
 DECLARE_REF(DescriptorPool)
 DECLARE_REF(DescriptorSet)
 class DescriptorLayout {
   public:
     DescriptorLayout(const std::string& name);
     virtual ~DescriptorLayout();
-    void addDescriptorBinding(DescriptorBinding binding);
+    DescriptorBindingHandle addDescriptorBinding(DescriptorBinding binding);
+    // throws if the layout has no binding with that name
+    DescriptorBindingHandle findBinding(const std::string& bindingName) const;
     void reset();
     ODescriptorSet allocateDescriptorSet();
     virtual void create() = 0;
     constexpr uint32 getHash() const { return hash; }
     constexpr const std::string& getName() const { return name; }
+    constexpr const Array<DescriptorBinding>& getBindings() const { return descriptorBindings; }
 
   protected:
     Array<DescriptorBinding> descriptorBindings;
@@ -59,14 +68,39 @@ class DescriptorSet {
     DescriptorSet(PDescriptorLayout layout);
     virtual ~DescriptorSet();
     virtual void writeChanges() = 0;
-    virtual void updateConstants(const std::string& name, uint32 offset, void* data) = 0;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer shaderBuffer) = 0;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer vertexBuffer) = 0;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer indexBuffer) = 0;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer) = 0;
-    virtual void updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState) = 0;
-    virtual void updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture) = 0;
-    virtual void updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as) = 0;
+    virtual void updateConstants(DescriptorBindingHandle binding, uint32 offset, void* data) = 0;
+    virtual void updateBuffer(DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer shaderBuffer) = 0;
+    virtual void updateBuffer(DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer vertexBuffer) = 0;
+    virtual void updateBuffer(DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer indexBuffer) = 0;
+    virtual void updateBuffer(DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) = 0;
+    virtual void updateSampler(DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState) = 0;
+    virtual void updateTexture(DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture) = 0;
+    virtual void updateAccelerationStructure(DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as) = 0;
+    // look the binding up by name first, fine for sets that are written once
+    void updateConstants(const std::string& name, uint32 offset, void* data) { updateConstants(layout->findBinding(name), offset, data); }
+    void updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer shaderBuffer) {
+        updateBuffer(layout->findBinding(name), index, shaderBuffer);
+    }
+    void updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer vertexBuffer) {
+        updateBuffer(layout->findBinding(name), index, vertexBuffer);
+    }
+    void updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer indexBuffer) {
+        updateBuffer(layout->findBinding(name), index, indexBuffer);
+    }
+    void updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer) {
+        updateBuffer(layout->findBinding(name), index, uniformBuffer);
+    }
+    void updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState) {
+        updateSampler(layout->findBinding(name), index, samplerState);
+    }
+    void updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture) {
+        updateTexture(layout->findBinding(name), index, texture);
+    }
+    void updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as) {
+        updateAccelerationStructure(layout->findBinding(name), index, as);
+    }
+    // a command that has not completed yet reads the set, so it must not be written
+    virtual bool isCurrentlyBound() const = 0;
     bool operator<(PDescriptorSet other);
 
     constexpr PDescriptorLayout getLayout() const { return layout; }
@@ -92,6 +126,7 @@ class PipelineLayout {
     void addMapping(std::string name, uint32 index);
     constexpr std::string getName() const { return name; };
     constexpr bool hasPushConstants() const { return !pushConstants.empty(); }
+    constexpr const Array<SePushConstantRange>& getPushConstants() const { return pushConstants; }
     constexpr uint64 getPushConstantsSize() const { return pushConstants[0].size; }
     constexpr const std::string& getPushConstantName(uint64 offset) {
         for (uint32 i = 0; i < pushConstants.size(); ++i) {
@@ -0,0 +1,51 @@
+#include "DescriptorArenas.h"
+
+using namespace Seele;
+using namespace Seele::Gfx;
+
+DescriptorArenas::DescriptorArenas() {}
+
+DescriptorArenas::~DescriptorArenas() {}
+
+bool DescriptorArenas::beginFrame(uint64 frameNumber, const std::function<bool(uint32)>& isReleased) {
+    if (frameNumber == currentFrame) {
+        return false;
+    }
+    statistics.allocated = 0;
+    statistics.created = 0;
+    statistics.retained = 0;
+    // after a long pause every arena is old enough, each one only has to be looked at once
+    uint64 first = std::max(currentFrame + 1, frameNumber >= numFramesBuffered ? frameNumber - numFramesBuffered + 1 : 0);
+    for (uint64 frame = first; frame <= frameNumber; ++frame) {
+        recycle(arenas[frame % numFramesBuffered], isReleased);
+    }
+    currentFrame = frameNumber;
+    return true;
+}
+
+uint32 DescriptorArenas::allocate() {
+    uint32 set;
+    if (!freeSets.empty()) {
+        set = freeSets.back();
+        freeSets.pop();
+    } else {
+        set = statistics.total++;
+        statistics.created++;
+    }
+    statistics.allocated++;
+    arenas[currentFrame % numFramesBuffered].add(set);
+    return set;
+}
+
+void DescriptorArenas::recycle(Array<uint32>& arena, const std::function<bool(uint32)>& isReleased) {
+    Array<uint32> retained;
+    for (uint32 set : arena) {
+        if (isReleased(set)) {
+            freeSets.add(set);
+        } else {
+            retained.add(set);
+        }
+    }
+    statistics.retained += (uint32)retained.size();
+    arena = std::move(retained);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "Containers/Array.h"
+#include "Enums.h"
+#include "MinimalEngine.h"
+#include <functional>
+
+namespace Seele {
+namespace Gfx {
+// decides which descriptor set of a pool is handed out next, the sets themselves are kept by the backend and addressed by index
+// every set handed out in a frame goes into the arena of that frame, and when the arena comes around again numFramesBuffered
+// frames later it is recycled in one pass, so allocating never has to search for a set that is not in use anymore
+class DescriptorArenas {
+  public:
+    struct Statistics {
+        // sets handed out since the current frame began
+        uint32 allocated = 0;
+        // of those, how many did not exist yet
+        uint32 created = 0;
+        // sets that were still held when their arena was recycled, like the ones of materials that live for many frames
+        uint32 retained = 0;
+        // every set the backend has created
+        uint32 total = 0;
+    };
+    DescriptorArenas();
+    ~DescriptorArenas();
+    // recycles the arenas of every frame that passed since the last call, false if the frame did not change
+    // sets that isReleased does not accept stay in their arena and are checked again the next time it comes around
+    bool beginFrame(uint64 frameNumber, const std::function<bool(uint32)>& isReleased);
+    // index of a set that can be written again, or getNumSets() - 1 if the backend has to create one at the end
+    uint32 allocate();
+    constexpr uint32 getNumSets() const { return statistics.total; }
+    // the numbers of the current frame up to now, beginFrame starts counting again
+    constexpr const Statistics& getStatistics() const { return statistics; }
+
+  private:
+    void recycle(Array<uint32>& arena, const std::function<bool(uint32)>& isReleased);
+    StaticArray<Array<uint32>, numFramesBuffered> arenas;
+    Array<uint32> freeSets;
+    uint64 currentFrame = 0;
+    Statistics statistics;
+};
+} // namespace Gfx
+} // namespace Seele
@@ -49,6 +49,37 @@ FormatCompatibilityInfo Gfx::getFormatInfo(SeFormat format) {
             .blockExtent = UVector(1, 1, 1),
             .texelsPerBlock = 1,
         };
+    case SE_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case SE_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case SE_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case SE_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case SE_FORMAT_BC4_UNORM_BLOCK:
+    case SE_FORMAT_BC4_SNORM_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+    case SE_FORMAT_EAC_R11_UNORM_BLOCK:
+    case SE_FORMAT_EAC_R11_SNORM_BLOCK:
+        return FormatCompatibilityInfo{
+            .blockSize = 8,
+            .blockExtent = UVector(4, 4, 1),
+            .texelsPerBlock = 16,
+        };
+    case SE_FORMAT_BC2_UNORM_BLOCK:
+    case SE_FORMAT_BC2_SRGB_BLOCK:
+    case SE_FORMAT_BC3_UNORM_BLOCK:
+    case SE_FORMAT_BC3_SRGB_BLOCK:
+    case SE_FORMAT_BC5_UNORM_BLOCK:
+    case SE_FORMAT_BC5_SNORM_BLOCK:
+    case SE_FORMAT_BC6H_UFLOAT_BLOCK:
+    case SE_FORMAT_BC6H_SFLOAT_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case SE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+    case SE_FORMAT_EAC_R11G11_UNORM_BLOCK:
+    case SE_FORMAT_EAC_R11G11_SNORM_BLOCK:
+    case SE_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case SE_FORMAT_ASTC_4x4_SRGB_BLOCK:
     case SE_FORMAT_BC7_UNORM_BLOCK:
     case SE_FORMAT_BC7_SRGB_BLOCK:
         return FormatCompatibilityInfo{
@@ -113,3 +144,9 @@ FormatCompatibilityInfo Gfx::getFormatInfo(SeFormat format) {
         throw new std::logic_error("not yet implemented");
     }
 }
+
+bool Gfx::isBlockCompressed(SeFormat format) {
+    return (format >= SE_FORMAT_BC1_RGB_UNORM_BLOCK && format <= SE_FORMAT_ASTC_12x12_SRGB_BLOCK) ||
+           (format >= SE_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG && format <= SE_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG) ||
+           (format >= SE_FORMAT_ASTC_4x4_SFLOAT_BLOCK && format <= SE_FORMAT_ASTC_12x12_SFLOAT_BLOCK);
+}
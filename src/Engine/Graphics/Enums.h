@@ -155,7 +155,7 @@ enum class KeyModifier : uint32 {
 typedef uint32 KeyModifierFlags;
 
 namespace Gfx {
-static constexpr bool useAsyncCompute = false;
+static constexpr bool useAsyncCompute = true;
 static constexpr bool useMeshShading = true;
 static constexpr uint32 numFramesBuffered = 3;
 
@@ -165,6 +165,8 @@ static constexpr uint32 numMeshletsPerTask = 256;
 double getCurrentFrameDelta();
 double getCurrentFrameTime();
 uint32 getCurrentFrameIndex();
+// counts every frame since the start, unlike the frame index it never wraps around
+uint64 getCurrentFrameNumber();
 
 enum class QueueType {
     GRAPHICS = 1,
@@ -851,6 +853,8 @@ struct FormatCompatibilityInfo {
 };
 
 FormatCompatibilityInfo getFormatInfo(SeFormat format);
+// formats whose texels are stored in blocks of more than one, these can be copied but not blitted
+bool isBlockCompressed(SeFormat format);
 
 typedef enum SeImageType {
     SE_IMAGE_TYPE_1D = 0,
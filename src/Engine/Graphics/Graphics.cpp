@@ -1,9 +1,29 @@
 #include "Graphics.h"
+#include "Command.h"
 #include "Shader.h"
+#include "ThreadPool.h"
 
 
 using namespace Seele::Gfx;
 
+thread_local QueueType Graphics::computeQueueType = QueueType::GRAPHICS;
+
 Graphics::Graphics() { shaderCompiler = new ShaderCompiler(this); }
 
 Graphics::~Graphics() {}
+
+Array<ORenderCommand> Graphics::recordRenderCommands(const std::string& name, uint64 numCommands,
+                                                     std::function<void(PRenderCommand, uint64)> record) {
+    Array<ORenderCommand> commands(numCommands);
+    List<std::function<void()>> jobs;
+    for (uint64 i = 0; i < numCommands; ++i) {
+        jobs.add([this, &commands, &name, &record, i]() {
+            commands[i] = createRenderCommand(name);
+            record(commands[i], i);
+            // the command pool of this thread might be recording the next command right after, so it is ended here
+            commands[i]->end();
+        });
+    }
+    getThreadPool().runAndWait(std::move(jobs));
+    return commands;
+}
@@ -2,8 +2,10 @@
 #include "Containers/Array.h"
 #include "Initializer.h"
 #include "MinimalEngine.h"
+#include "Query.h"
 #include "RenderTarget.h"
 #include "Resources.h"
+#include <functional>
 
 
 namespace Seele {
@@ -65,7 +67,16 @@ class Graphics {
     virtual void executeCommands(Array<ORenderCommand> commands) = 0;
     virtual void executeCommands(OComputeCommand commands) = 0;
     virtual void executeCommands(Array<OComputeCommand> commands) = 0;
-
+    // submits the work recorded for from so far, the next work submitted for to waits for it on the GPU
+    // returns false if both run on the same queue, then the barriers between them are all the ordering there is
+    virtual bool queueHandoff(QueueType from, QueueType to) = 0;
+    // queue the compute commands of the calling thread are created and executed for, the render graph switches it for
+    // passes that run on the async compute queue
+    static void setComputeQueue(QueueType queue) { computeQueueType = queue; }
+    static QueueType getComputeQueue() { return computeQueueType; }
+
+    // whether textures of format can be created with optimal tiling and sampled in shaders
+    virtual bool supportsSampledFormat(SeFormat format) const = 0;
     virtual OTexture2D createTexture2D(const TextureCreateInfo& createInfo) = 0;
     virtual OTexture2DArray createTexture2DArray(const TextureCreateInfo& createInfo) = 0;
     virtual OTexture3D createTexture3D(const TextureCreateInfo& createInfo) = 0;
@@ -77,6 +88,10 @@ class Graphics {
 
     virtual ORenderCommand createRenderCommand(const std::string& name = "") = 0;
     virtual OComputeCommand createComputeCommand(const std::string& name = "") = 0;
+    // records numCommands render commands on the thread pool, each one on the thread that created it
+    // the result is in index order no matter which thread recorded which command, so submission stays deterministic
+    virtual Array<ORenderCommand> recordRenderCommands(const std::string& name, uint64 numCommands,
+                                                       std::function<void(PRenderCommand, uint64)> record);
 
     virtual void beginShaderCompilation(const ShaderCompilationInfo& compileInfo) = 0;
     virtual OVertexShader createVertexShader(const ShaderCreateInfo& createInfo) = 0;
@@ -98,6 +113,9 @@ class Graphics {
     virtual Gfx::OOcclusionQuery createOcclusionQuery(const std::string& name = "") = 0;
     virtual Gfx::OPipelineStatisticsQuery createPipelineStatisticsQuery(const std::string& name = "") = 0;
     virtual Gfx::OTimestampQuery createTimestampQuery(uint64 numTimestamps, const std::string& name = "") = 0;
+    // query results of an earlier frame, see getCurrentFrameNumber, this never waits for the GPU
+    bool getFrameStats(uint64 frameNumber, FrameStats& stats) const { return frameStats.get(frameNumber, stats); }
+    FrameStatsRing& getFrameStatsRing() { return frameStats; }
 
     virtual void beginDebugRegion(const std::string& name) = 0;
     virtual void endDebugRegion() = 0;
@@ -109,6 +127,8 @@ class Graphics {
 
     constexpr bool supportMeshShading() const { return meshShadingEnabled; }
     constexpr bool supportRayTracing() const { return rayTracingEnabled; }
+    // false if the backend does not resolve its queries, getFrameStats never returns a frame then
+    constexpr bool supportFrameStats() const { return frameStatsEnabled; }
 
     // Ray Tracing
     virtual OBottomLevelAS createBottomLevelAccelerationStructure(const BottomLevelASCreateInfo& createInfo) = 0;
@@ -126,6 +146,9 @@ class Graphics {
     OShaderCompiler shaderCompiler;
     bool meshShadingEnabled = false;
     bool rayTracingEnabled = false;
+    bool frameStatsEnabled = true;
+    FrameStatsRing frameStats;
+    thread_local static QueueType computeQueueType;
     friend class Window;
 };
 DEFINE_REF(Graphics)
@@ -54,6 +54,9 @@ struct TextureCreateInfo {
     uint32 elements = 1;
     uint32 samples = 1;
     bool useMip = false;
+    // offset in sourceData of every mip level it contains, with all layers of a level next to each other
+    // empty if sourceData only holds the first level, useMip then generates the others from it
+    Array<uint64> mipOffsets;
     Gfx::SeImageUsageFlags usage = Gfx::SE_IMAGE_USAGE_SAMPLED_BIT;
     Gfx::SeMemoryPropertyFlags memoryProps = Gfx::SE_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
     std::string name;
@@ -44,8 +44,8 @@ void buildAdjacency(const uint32 numVerts, const Array<uint32>& indices, Adjacen
 
 int32 skipDeadEnd(const Array<uint32>& liveTriCount, List<uint32>& deadEndStack, uint32& cursor) {
     while (!deadEndStack.empty()) {
-        uint32 vertIdx = deadEndStack.front();
-        deadEndStack.popFront();
+        uint32 vertIdx = deadEndStack.back();
+        deadEndStack.popBack();
         if (liveTriCount[vertIdx] > 0) {
             return vertIdx;
         }
@@ -82,6 +82,9 @@ int32 getNextVertex(const uint32 cacheSize, const Array<uint32>& oneRing, const
 }
 
 void tipsifyIndexBuffer(const Array<uint32>& indices, const uint32 numVerts, const uint32 cacheSize, Array<uint32>& outIndices) {
+    if (indices.empty()) {
+        return;
+    }
     AdjacencyInfo adjacencyStruct;
     buildAdjacency(numVerts, indices, adjacencyStruct);
 
@@ -128,13 +131,13 @@ void tipsifyIndexBuffer(const Array<uint32>& indices, const uint32 numVerts, con
             liveTriCount[c]--;
 
             if (timeStamp - cacheTimeStamps[a] > cacheSize) {
-                cacheTimeStamps[a] = timeStamp;
+                cacheTimeStamps[a] = timeStamp++;
             }
             if (timeStamp - cacheTimeStamps[b] > cacheSize) {
-                cacheTimeStamps[b] = timeStamp;
+                cacheTimeStamps[b] = timeStamp++;
             }
             if (timeStamp - cacheTimeStamps[c] > cacheSize) {
-                cacheTimeStamps[c] = timeStamp;
+                cacheTimeStamps[c] = timeStamp++;
             }
             emittedTriangles[triangle] = true;
         }
@@ -185,4 +188,82 @@ bool addTriangle(const Array<Vector>& positions, Meshlet& current, Triangle& tri
     current.primitiveLayout[current.numPrimitives * 3 + 2] = uint8(f3);
     current.numPrimitives++;
     return true;
-}
\ No newline at end of file
+}
+
+MeshletBounds Seele::computeMeshletBounds(const Array<Vector>& positions, const uint32* vertexIndices, const uint8* primitiveIndices,
+                                          uint32 numVertices, uint32 numPrimitives) {
+    meshopt_Bounds bounds = meshopt_computeMeshletBounds(vertexIndices, primitiveIndices, numPrimitives, (float*)positions.data(),
+                                                         positions.size(), sizeof(Vector));
+    MeshletBounds result = {
+        .sphere =
+            {
+                .center = Vector(bounds.center[0], bounds.center[1], bounds.center[2]),
+                .radius = bounds.radius,
+            },
+        .cone =
+            {
+                .apex = Vector(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]),
+                .cutoff = bounds.cone_cutoff,
+                .axis = Vector(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]),
+            },
+    };
+    for (uint32 i = 0; i < numVertices; ++i) {
+        result.bounding.adjust(positions[vertexIndices[i]]);
+    }
+    return result;
+}
+
+MeshOptimizationStats& MeshOptimizationStats::operator+=(const MeshOptimizationStats& other) {
+    numVertices += other.numVertices;
+    numTriangles += other.numTriangles;
+    numTransformedVertices += other.numTransformedVertices;
+    numMeshlets += other.numMeshlets;
+    numMeshletVertices += other.numMeshletVertices;
+    numMeshletPrimitives += other.numMeshletPrimitives;
+    return *this;
+}
+
+MeshOptimizationStats Seele::analyzeMesh(const Array<Vector>& positions, const Array<uint32>& indices) {
+    MeshOptimizationStats stats = {
+        .numVertices = positions.size(),
+        .numTriangles = indices.size() / 3,
+    };
+    if (indices.empty()) {
+        return stats;
+    }
+    meshopt_VertexCacheStatistics cacheStats =
+        meshopt_analyzeVertexCache(indices.data(), indices.size(), positions.size(), vertexCacheSize, 0, 0);
+    stats.numTransformedVertices = cacheStats.vertices_transformed;
+
+    const size_t maxMeshlets = meshopt_buildMeshletsBound(indices.size(), Gfx::numVerticesPerMeshlet, Gfx::numPrimitivesPerMeshlet);
+    Array<meshopt_Meshlet> meshlets(maxMeshlets);
+    Array<uint32> meshletVertexIndices(maxMeshlets * Gfx::numVerticesPerMeshlet);
+    Array<uint8> meshletTriangles(maxMeshlets * Gfx::numPrimitivesPerMeshlet * 3);
+    stats.numMeshlets = meshopt_buildMeshlets(meshlets.data(), meshletVertexIndices.data(), meshletTriangles.data(), indices.data(),
+                                              indices.size(), (float*)positions.data(), positions.size(), sizeof(Vector),
+                                              Gfx::numVerticesPerMeshlet, Gfx::numPrimitivesPerMeshlet, meshletConeWeight);
+    for (size_t i = 0; i < stats.numMeshlets; ++i) {
+        stats.numMeshletVertices += meshlets[i].vertex_count;
+        stats.numMeshletPrimitives += meshlets[i].triangle_count;
+    }
+    return stats;
+}
+
+uint32 Seele::optimizeMesh(const Array<Vector>& positions, Array<uint32>& indices, Array<uint32>& vertexRemap) {
+    vertexRemap.resize(positions.size());
+    if (indices.empty()) {
+        std::fill(vertexRemap.begin(), vertexRemap.end(), ~0u);
+        return 0;
+    }
+    Array<uint32> cacheOptimized;
+    cacheOptimized.reserve(indices.size());
+    tipsifyIndexBuffer(indices, (uint32)positions.size(), vertexCacheSize, cacheOptimized);
+
+    // a threshold of 1.05 allows the vertex cache efficiency to degrade by up to 5% in favour of less overdraw
+    meshopt_optimizeOverdraw(indices.data(), cacheOptimized.data(), cacheOptimized.size(), (float*)positions.data(), positions.size(),
+                             sizeof(Vector), 1.05f);
+
+    size_t numVertices = meshopt_optimizeVertexFetchRemap(vertexRemap.data(), indices.data(), indices.size(), positions.size());
+    meshopt_remapIndexBuffer(indices.data(), indices.data(), indices.size(), vertexRemap.data());
+    return (uint32)numVertices;
+}
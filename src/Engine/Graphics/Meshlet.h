@@ -3,6 +3,10 @@
 #include "Math/AABB.h"
 
 namespace Seele {
+// favour meshlets with tight normal cones, so that backface cone culling can reject more of them
+constexpr float meshletConeWeight = 0.25f;
+// post transform cache size that index buffers are optimized for
+constexpr uint32 vertexCacheSize = 16;
 struct Meshlet {
     AABB boundingBox;
     uint32 uniqueVertices[Gfx::numVerticesPerMeshlet];       // unique vertiex indices in the vertex data
@@ -11,4 +15,47 @@ struct Meshlet {
     uint32 numPrimitives;
     uint32 lod = 0;
 };
-} // namespace Seele
\ No newline at end of file
+// normal cone of all triangles in a meshlet, a meshlet is backfacing if
+// dot(normalize(apex - cameraPosition), axis) >= cutoff
+struct MeshletCone {
+    Vector apex = Vector(0);
+    float cutoff = 1.0f; // a zero axis with cutoff 1 is a degenerate cone that is never culled
+    Vector axis = Vector(0);
+    float pad0 = 0;
+};
+struct MeshletBounds {
+    AABB bounding;
+    BoundingSphere sphere;
+    MeshletCone cone;
+};
+// vertexIndices index into positions, primitiveIndices index into vertexIndices
+MeshletBounds computeMeshletBounds(const Array<Vector>& positions, const uint32* vertexIndices, const uint8* primitiveIndices,
+                                   uint32 numVertices, uint32 numPrimitives);
+
+struct MeshOptimizationStats {
+    uint64 numVertices = 0;
+    uint64 numTriangles = 0;
+    // vertices that a FIFO cache of vertexCacheSize entries has to transform
+    uint64 numTransformedVertices = 0;
+    uint64 numMeshlets = 0;
+    uint64 numMeshletVertices = 0;
+    uint64 numMeshletPrimitives = 0;
+    // average cache miss ratio, 0.5 is optimal for large regular meshes
+    float getACMR() const { return numTriangles > 0 ? numTransformedVertices / float(numTriangles) : 0.0f; }
+    // average transform to vertex ratio, 1 is optimal
+    float getATVR() const { return numVertices > 0 ? numTransformedVertices / float(numVertices) : 0.0f; }
+    // fraction of the vertex and primitive slots that are used across all meshlets
+    float getVertexFill() const { return numMeshlets > 0 ? numMeshletVertices / float(numMeshlets * Gfx::numVerticesPerMeshlet) : 0.0f; }
+    float getPrimitiveFill() const {
+        return numMeshlets > 0 ? numMeshletPrimitives / float(numMeshlets * Gfx::numPrimitivesPerMeshlet) : 0.0f;
+    }
+    MeshOptimizationStats& operator+=(const MeshOptimizationStats& other);
+};
+// simulates the vertex cache and builds meshlets the same way VertexData::loadMeshlets does
+MeshOptimizationStats analyzeMesh(const Array<Vector>& positions, const Array<uint32>& indices);
+// import time optimization of a triangle list, runs Tipsify for vertex cache locality, reorders clusters for overdraw
+// and renumbers vertices in the order they are first referenced
+// indices are rewritten in place, vertexRemap[oldIndex] is the new index or ~0u if the vertex is not referenced
+// returns the number of referenced vertices
+uint32 optimizeMesh(const Array<Vector>& positions, Array<uint32>& indices, Array<uint32>& vertexRemap);
+} // namespace Seele
@@ -0,0 +1,159 @@
+#include "MeshletCulling.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Seele;
+
+DepthPyramid::DepthPyramid() {}
+
+DepthPyramid::DepthPyramid(UVector2 dimensions, const Array<float>& depth) {
+    // same chain as DepthCullingPass::publishOutputs
+    uint32 width = dimensions.x;
+    uint32 height = dimensions.y;
+    uint32 bufferSize = 0;
+    while (width > 1 && height > 1) {
+        mipOffsets.add(bufferSize);
+        mipDims.add(UVector2(width, height));
+        bufferSize += width * height;
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+    }
+    buffer.resize(bufferSize);
+    if (mipOffsets.empty()) {
+        return;
+    }
+    assert(depth.size() == dimensions.x * dimensions.y);
+    std::memcpy(buffer.data(), depth.data(), depth.size() * sizeof(float));
+    // same as DepthMipGen::reduceLevel, texels outside of the source are treated as closest
+    auto readSource = [&](uint32 level, UVector2 pos) {
+        if (pos.x >= mipDims[level].x || pos.y >= mipDims[level].y) {
+            return 1.0f;
+        }
+        return load(level, pos);
+    };
+    for (uint32 level = 1; level < mipOffsets.size(); ++level) {
+        for (uint32 y = 0; y < mipDims[level].y; ++y) {
+            for (uint32 x = 0; x < mipDims[level].x; ++x) {
+                UVector2 readOffset = UVector2(x, y) * 2u;
+                float d0 = readSource(level - 1, readOffset + UVector2(0, 0));
+                float d1 = readSource(level - 1, readOffset + UVector2(0, 1));
+                float d2 = readSource(level - 1, readOffset + UVector2(1, 0));
+                float d3 = readSource(level - 1, readOffset + UVector2(1, 1));
+                buffer[mipOffsets[level] + x + (y * mipDims[level].x)] = std::min(std::min(d0, d1), std::min(d2, d3));
+            }
+        }
+    }
+}
+
+float DepthPyramid::load(uint32 level, UVector2 position) const {
+    return buffer[mipOffsets[level] + position.x + (position.y * mipDims[level].x)];
+}
+
+MeshletCuller::MeshletCuller(MeshletCullingParams params) : params(params) {}
+
+void MeshletCuller::cullInstance(const Matrix4& transform, const Array<MeshletBounds>& meshlets, Array<uint32>& visibleMeshlets) {
+    // extracting the planes from the combined matrix puts them into model space,
+    // same as the task shader which does all tests in model space
+    const Matrix4 modelViewProjection = params.viewProjection * transform;
+    const Vector modelCameraPosition = Vector(glm::inverse(transform) * Vector4(params.cameraPosition, 1.0f));
+    StaticArray<Plane, 4> frustum;
+    for (uint32 i = 0; i < 4; ++i) {
+        // left, right, bottom, top
+        const uint32 row = i / 2;
+        const float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        Plane& plane = frustum[i];
+        plane.n = Vector(modelViewProjection[0][3] + sign * modelViewProjection[0][row],
+                         modelViewProjection[1][3] + sign * modelViewProjection[1][row],
+                         modelViewProjection[2][3] + sign * modelViewProjection[2][row]);
+        plane.d = modelViewProjection[3][3] + sign * modelViewProjection[3][row];
+        float length = glm::length(plane.n);
+        plane.n /= length;
+        plane.d /= length;
+    }
+    const bool useDepth = params.depthCulling && depthPyramid != nullptr && depthPyramid->getNumLevels() > 0;
+    for (uint32 i = 0; i < meshlets.size(); ++i) {
+        const MeshletBounds& meshlet = meshlets[i];
+        stats.numMeshlets++;
+        if (params.frustumCulling && !insideFrustum(frustum, meshlet.sphere)) {
+            stats.numFrustumCulled++;
+            continue;
+        }
+        if (params.backfaceCulling && isBackfacing(meshlet.cone, modelCameraPosition)) {
+            stats.numBackfaceCulled++;
+            continue;
+        }
+        if (useDepth && !isBoxVisible(meshlet.bounding, modelViewProjection)) {
+            stats.numOcclusionCulled++;
+            continue;
+        }
+        visibleMeshlets.add(i);
+    }
+}
+
+bool MeshletCuller::insideFrustum(const StaticArray<Plane, 4>& frustum, const BoundingSphere& sphere) const {
+    for (uint32 i = 0; i < frustum.size(); ++i) {
+        if (glm::dot(frustum[i].n, sphere.center) + frustum[i].d < -sphere.radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MeshletCuller::isBackfacing(const MeshletCone& cone, Vector modelCameraPosition) const {
+    Vector view = cone.apex - modelCameraPosition;
+    float length = glm::length(view);
+    if (length == 0.0f) {
+        return false;
+    }
+    return glm::dot(view / length, cone.axis) >= cone.cutoff;
+}
+
+bool MeshletCuller::isBoxVisible(const AABB& bounding, const Matrix4& modelViewProjection) const {
+    const IVector2 screenDimensions = IVector2(params.screenDimensions);
+    IVector2 screenCornerMin = screenDimensions;
+    IVector2 screenCornerMax = IVector2(0, 0);
+    // larger values are closer, see clipToScreen in Common.slang
+    float maxDepth = 0;
+    StaticArray<Vector, 8> corners;
+    corners[0] = Vector(bounding.min.x, bounding.min.y, bounding.min.z);
+    corners[1] = Vector(bounding.min.x, bounding.min.y, bounding.max.z);
+    corners[2] = Vector(bounding.min.x, bounding.max.y, bounding.min.z);
+    corners[3] = Vector(bounding.min.x, bounding.max.y, bounding.max.z);
+    corners[4] = Vector(bounding.max.x, bounding.min.y, bounding.min.z);
+    corners[5] = Vector(bounding.max.x, bounding.min.y, bounding.max.z);
+    corners[6] = Vector(bounding.max.x, bounding.max.y, bounding.min.z);
+    corners[7] = Vector(bounding.max.x, bounding.max.y, bounding.max.z);
+    for (const auto& corner : corners) {
+        Vector4 clip = modelViewProjection * Vector4(corner, 1.0f);
+        // the box intersects the camera plane, the projection is meaningless so we have to assume it is visible
+        if (clip.w <= 0.0f) {
+            return true;
+        }
+        Vector4 ndc = clip / clip.w;
+        Vector2 screen = (Vector2(ndc.x, ndc.y) + 1.0f) / 2.0f * Vector2(screenDimensions);
+        // unlike the shader, clamp to the last texel so the lookup never leaves the mip
+        IVector2 screenCoords = IVector2(std::clamp(int32(screen.x), 0, screenDimensions.x - 1),
+                                         std::clamp(int32(screen.y), 0, screenDimensions.y - 1));
+        screenCornerMin = glm::min(screenCornerMin, screenCoords);
+        screenCornerMax = glm::max(screenCornerMax, screenCoords);
+        maxDepth = std::max(maxDepth, 1.0f - ndc.z);
+    }
+    // go down the mip chain until the box covers at most 2x2 texels
+    uint32 level = 0;
+    while ((screenCornerMax.x - screenCornerMin.x > 1 || screenCornerMax.y - screenCornerMin.y > 1) &&
+           level + 1 < depthPyramid->getNumLevels()) {
+        level++;
+        screenCornerMin /= 2;
+        screenCornerMax /= 2;
+    }
+    UVector2 mipMax = depthPyramid->getDimensions(level) - 1u;
+    UVector2 texelMin = glm::min(UVector2(screenCornerMin), mipMax);
+    UVector2 texelMax = glm::min(UVector2(screenCornerMax), mipMax);
+    float d1 = depthPyramid->load(level, UVector2(texelMin.x, texelMin.y));
+    float d2 = depthPyramid->load(level, UVector2(texelMax.x, texelMin.y));
+    float d3 = depthPyramid->load(level, UVector2(texelMin.x, texelMax.y));
+    float d4 = depthPyramid->load(level, UVector2(texelMax.x, texelMax.y));
+    // the farthest occluder depth has to be behind the closest point of the box
+    float d = std::min(std::min(d1, d2), std::min(d3, d4));
+    return d < maxDepth;
+}
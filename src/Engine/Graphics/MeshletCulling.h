@@ -0,0 +1,68 @@
+#pragma once
+#include "Containers/Array.h"
+#include "Math/Math.h"
+#include "Meshlet.h"
+#include "MinimalEngine.h"
+
+namespace Seele {
+// CPU mirror of the depth mip buffer built by the DepthCullingPass
+// mips are stored back to back, each texel holds the farthest (min) depth of the 2x2 texels below it
+class DepthPyramid {
+  public:
+    DepthPyramid();
+    // depth has to contain dimensions.x * dimensions.y values in row major order
+    DepthPyramid(UVector2 dimensions, const Array<float>& depth);
+    uint32 getNumLevels() const { return (uint32)mipOffsets.size(); }
+    UVector2 getDimensions(uint32 level) const { return mipDims[level]; }
+    float load(uint32 level, UVector2 position) const;
+
+  private:
+    Array<float> buffer;
+    Array<uint32> mipOffsets;
+    Array<UVector2> mipDims;
+};
+
+struct MeshletCullingParams {
+    Matrix4 viewProjection = Matrix4(1);
+    Vector cameraPosition = Vector(0);
+    UVector2 screenDimensions = UVector2(0);
+    bool frustumCulling = true;
+    bool backfaceCulling = true;
+    // only used when a depth pyramid is set
+    bool depthCulling = true;
+};
+
+struct MeshletCullingStats {
+    uint64 numMeshlets = 0;
+    uint64 numFrustumCulled = 0;
+    uint64 numBackfaceCulled = 0;
+    uint64 numOcclusionCulled = 0;
+    uint64 getNumVisible() const { return numMeshlets - numFrustumCulled - numBackfaceCulled - numOcclusionCulled; }
+    // fraction of meshlets that were rejected by any test
+    float getCulledRatio() const { return numMeshlets > 0 ? 1.0f - getNumVisible() / float(numMeshlets) : 0.0f; }
+};
+
+// Reference implementation of the meshlet culling done in DepthCullingTask
+// so that culling efficiency can be measured and tested without a GPU
+class MeshletCuller {
+  public:
+    MeshletCuller(MeshletCullingParams params);
+    void setDepthPyramid(const DepthPyramid* pyramid) { depthPyramid = pyramid; }
+    // appends the indices of all meshlets of a single instance that pass all enabled tests
+    void cullInstance(const Matrix4& transform, const Array<MeshletBounds>& meshlets, Array<uint32>& visibleMeshlets);
+    const MeshletCullingStats& getStats() const { return stats; }
+    void resetStats() { stats = MeshletCullingStats(); }
+
+  private:
+    struct Plane {
+        Vector n;
+        float d;
+    };
+    bool insideFrustum(const StaticArray<Plane, 4>& frustum, const BoundingSphere& sphere) const;
+    bool isBackfacing(const MeshletCone& cone, Vector modelCameraPosition) const;
+    bool isBoxVisible(const AABB& bounding, const Matrix4& modelViewProjection) const;
+    MeshletCullingParams params;
+    MeshletCullingStats stats;
+    const DepthPyramid* depthPyramid = nullptr;
+};
+} // namespace Seele
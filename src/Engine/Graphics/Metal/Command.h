@@ -70,7 +70,7 @@ class RenderCommand : public Gfx::RenderCommand {
   public:
     RenderCommand(MTL::RenderCommandEncoder* encode, const std::string& name);
     virtual ~RenderCommand();
-    void end();
+    virtual void end() override;
     virtual void setViewport(Gfx::PViewport viewport) override;
     virtual void bindPipeline(Gfx::PGraphicsPipeline pipeline) override;
     virtual void bindPipeline(Gfx::PRayTracingPipeline pipeline) override;
@@ -92,6 +92,7 @@ class RenderCommand : public Gfx::RenderCommand {
     Array<PCommandBoundResource> boundResources;
     MTL::RenderCommandEncoder* encoder;
     std::string name;
+    bool ended = false;
     friend class CommandQueue;
 };
 DEFINE_REF(RenderCommand)
@@ -99,7 +100,7 @@ class ComputeCommand : public Gfx::ComputeCommand {
   public:
     ComputeCommand(MTL::CommandBuffer* cmdBuffer, const std::string& name);
     virtual ~ComputeCommand();
-    void end();
+    virtual void end() override;
     virtual void bindPipeline(Gfx::PComputePipeline pipeline) override;
     virtual void bindDescriptor(Gfx::PDescriptorSet set) override;
     virtual void bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) override;
@@ -113,6 +114,7 @@ class ComputeCommand : public Gfx::ComputeCommand {
     Array<PCommandBoundResource> boundResources;
     MTL::ComputeCommandEncoder* encoder;
     std::string name;
+    bool ended = false;
     friend class CommandQueue;
 };
 DEFINE_REF(ComputeCommand)
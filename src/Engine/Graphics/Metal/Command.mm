@@ -104,7 +104,13 @@ RenderCommand::RenderCommand(MTL::RenderCommandEncoder* encoder, const std::stri
 
 RenderCommand::~RenderCommand() { encoder->release(); }
 
-void RenderCommand::end() { encoder->endEncoding(); }
+void RenderCommand::end() {
+    if (ended) {
+        return;
+    }
+    encoder->endEncoding();
+    ended = true;
+}
 
 void RenderCommand::setViewport(Gfx::PViewport viewport) {
     MTL::Viewport vp = viewport.cast<Viewport>()->getHandle();
@@ -244,8 +250,12 @@ ComputeCommand::~ComputeCommand() {
 }
 
 void ComputeCommand::end() {
+    if (ended) {
+        return;
+    }
     encoder->endEncoding();
     commandBuffer->commit();
+    ended = true;
 }
 
 void ComputeCommand::bindPipeline(Gfx::PComputePipeline pipeline) {
@@ -3,6 +3,7 @@
 #include "Foundation/NSArray.hpp"
 #include "Foundation/NSObject.hpp"
 #include "Graphics/Descriptor.h"
+#include "Graphics/DescriptorArenas.h"
 #include "Graphics/Initializer.h"
 #include "Graphics/Metal/Command.h"
 #include "Graphics/Metal/Resources.h"
@@ -13,6 +14,7 @@
 #include "Metal/MTLLibrary.hpp"
 #include "Metal/MTLResource.hpp"
 #include "MinimalEngine.h"
+#include <mutex>
 
 namespace Seele {
 namespace Metal {
@@ -35,7 +37,8 @@ class DescriptorLayout : public Gfx::DescriptorLayout {
     constexpr uint64 flattenIndex(uint32 binding, uint32 arrayIndex) const { return uint64(arrayIndex) << 32 | binding; }
     PGraphics graphics;
     NS::Array* arguments;
-    Map<std::string, DescriptorMapping> variableMapping;
+    // indexed by the handles of the bindings
+    Array<DescriptorMapping> variableMapping;
     uint32 numResources;
     // descriptor sets containing only uniform data are not actually argument buffers, so they need to be
     // handled separately
@@ -49,16 +52,18 @@ class DescriptorSetHandle : public CommandBoundResource {
 public:
     DescriptorSetHandle(PGraphics grapics, PDescriptorPool owner, const std::string& name);
     virtual ~DescriptorSetHandle();
-    void updateConstants(const std::string& name, uint32 offset, void* data);
-    void updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer uniformBuffer);
-    void updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer uniformBuffer);
-    void updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer uniformBuffer);
-    void updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer);
-    void updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState);
-    void updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture);
-    void updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as);
+    void updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data);
+    void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer uniformBuffer);
+    void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer uniformBuffer);
+    void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer uniformBuffer);
+    void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer);
+    void updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState);
+    void updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture);
+    void updateAccelerationStructure(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as);
     
     PDescriptorPool owner;
+    // a DescriptorSet refers to it, so it must not be handed out again even if no command reads it
+    bool isUsed = false;
     OBufferAllocation argumentBuffer = nullptr;
     MTL::ArgumentEncoder* encoder = nullptr;
     Array<PCommandBoundResource> boundResources;
@@ -116,7 +121,10 @@ class DescriptorPool : public Gfx::DescriptorPool {
   private:
     PGraphics graphics;
     PDescriptorLayout layout;
+    // indexed by the sets the arenas hand out
     Array<ODescriptorSetHandle> allocatedSets;
+    Gfx::DescriptorArenas arenas;
+    std::mutex lock;
 };
 DEFINE_REF(DescriptorPool)
 
@@ -125,14 +133,20 @@ class DescriptorSet : public Gfx::DescriptorSet {
     DescriptorSet(PGraphics graphics, PDescriptorPool owner, PDescriptorSetHandle handle);
     virtual ~DescriptorSet();
     virtual void writeChanges() override;
-    virtual void updateConstants(const std::string& name, uint32 offset, void* data) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer uniformBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer uniformBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer uniformBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer) override;
-    virtual void updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState) override;
-    virtual void updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture) override;
-    virtual void updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as) override;
+    using Gfx::DescriptorSet::updateAccelerationStructure;
+    using Gfx::DescriptorSet::updateBuffer;
+    using Gfx::DescriptorSet::updateConstants;
+    using Gfx::DescriptorSet::updateSampler;
+    using Gfx::DescriptorSet::updateTexture;
+    virtual void updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer uniformBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer uniformBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer uniformBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) override;
+    virtual void updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState) override;
+    virtual void updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture) override;
+    virtual void updateAccelerationStructure(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as) override;
+    virtual bool isCurrentlyBound() const override { return setHandle->isCurrentlyBound(); }
     
     constexpr bool isPlainDescriptor() const { return owner->getLayout()->isPlainDescriptor(); }
     constexpr MTL::ArgumentEncoder* createEncoder() const { return owner->getLayout()->createEncoder(); }
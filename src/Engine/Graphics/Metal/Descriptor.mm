@@ -44,11 +44,11 @@ void DescriptorLayout::create() {
         objects[i]->setDataType(MTL::DataTypeChar);
         objects[i]->setArrayLength(descriptorBindings[i].uniformLength);
     
-        variableMapping[descriptorBindings[i].name] = DescriptorMapping{
+        variableMapping.add(DescriptorMapping{
             .index = mappingCounter,
             .constantSize = descriptorBindings[i].uniformLength,
             .access = descriptorBindings[i].access,
-        };
+        });
         mappingCounter += descriptorBindings[i].descriptorCount;
     }
     numResources = mappingCounter;
@@ -71,9 +71,9 @@ DescriptorSetHandle::~DescriptorSetHandle() {
     std::cout << "destroying descriptor set" << std::endl;
 }
 
-void DescriptorSetHandle::updateConstants(const std::string& name, uint32 offset, void* data) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index;
-    Array<uint8> contents(owner->getLayout()->variableMapping[name].constantSize);
+void DescriptorSetHandle::updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index;
+    Array<uint8> contents(owner->getLayout()->variableMapping[binding.index].constantSize);
     std::memcpy(contents.data(), (uint8*)data + offset, contents.size());
     uniformWrites.add(UniformWriteInfo{
         .index = flattenedIndex,
@@ -81,52 +81,57 @@ void DescriptorSetHandle::updateConstants(const std::string& name, uint32 offset
     });
 }
 
-void DescriptorSetHandle::updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer uniformBuffer) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer uniformBuffer) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
     PShaderBuffer buffer = uniformBuffer.cast<ShaderBuffer>();
     bufferWrites.add(BufferWriteInfo{
         .index = flattenedIndex,
         .buffer = buffer->getAlloc(),
-        .access = owner->getLayout()->variableMapping[name].access,
+        .access = owner->getLayout()->variableMapping[binding.index].access,
     });
     boundResources.add(buffer->getAlloc());
 }
 
-void DescriptorSetHandle::updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer uniformBuffer) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer uniformBuffer) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
     PVertexBuffer buffer = uniformBuffer.cast<VertexBuffer>();
     bufferWrites.add(BufferWriteInfo{
         .index = flattenedIndex,
         .buffer = buffer->getAlloc(),
-        .access = owner->getLayout()->variableMapping[name].access,
+        .access = owner->getLayout()->variableMapping[binding.index].access,
     });
     boundResources.add(buffer->getAlloc());
 }
 
-void DescriptorSetHandle::updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer uniformBuffer) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer uniformBuffer) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
     PIndexBuffer buffer = uniformBuffer.cast<IndexBuffer>();
     bufferWrites.add(BufferWriteInfo{
         .index = flattenedIndex,
         .buffer = buffer->getAlloc(),
-        .access = owner->getLayout()->variableMapping[name].access,
+        .access = owner->getLayout()->variableMapping[binding.index].access,
     });
     boundResources.add(buffer->getAlloc());
 }
 
-void DescriptorSetHandle::updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
     PIndexBuffer buffer = uniformBuffer.cast<IndexBuffer>();
     bufferWrites.add(BufferWriteInfo{
         .index = flattenedIndex,
         .buffer = buffer->getAlloc(),
-        .access = owner->getLayout()->variableMapping[name].access,
+        .access = owner->getLayout()->variableMapping[binding.index].access,
     });
     boundResources.add(buffer->getAlloc());
 }
 
-void DescriptorSetHandle::updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
+    // the writes are applied every time the set is bound, so a slot that is written again replaces what it held before
+    samplerWrites.remove_if([flattenedIndex](const SamplerWriteInfo& write) { return write.index == flattenedIndex; });
+    if (samplerState == nullptr) {
+        return;
+    }
     PSampler sampler = samplerState.cast<Sampler>();
     samplerWrites.add(SamplerWriteInfo{
         .index = flattenedIndex,
@@ -134,35 +139,44 @@ void DescriptorSetHandle::updateSampler(const std::string& name, uint32 index, G
     });
 }
 
-void DescriptorSetHandle::updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture) {
-    uint32 flattenedIndex = owner->getLayout()->variableMapping[name].index + index;
+void DescriptorSetHandle::updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture) {
+    uint32 flattenedIndex = owner->getLayout()->variableMapping[binding.index].index + index;
+    for (const auto& write : textureWrites) {
+        if (write.index == flattenedIndex) {
+            boundResources.remove(PCommandBoundResource(write.texture));
+            boundResources.remove(PCommandBoundResource(write.texture->getSource()));
+        }
+    }
+    textureWrites.remove_if([flattenedIndex](const TextureWriteInfo& write) { return write.index == flattenedIndex; });
+    if (texture == nullptr) {
+        return;
+    }
     PTextureView tex = texture.cast<TextureView>();
     textureWrites.add(TextureWriteInfo{
         .index = flattenedIndex,
         .texture = tex,
-        .access = owner->getLayout()->variableMapping[name].access,
+        .access = owner->getLayout()->variableMapping[binding.index].access,
     });
     boundResources.add(tex);
     boundResources.add(tex->getSource());
 }
 
-void DescriptorSetHandle::updateAccelerationStructure(const std::string& , uint32 , Gfx::PTopLevelAS ){}
+void DescriptorSetHandle::updateAccelerationStructure(Gfx::DescriptorBindingHandle, uint32, Gfx::PTopLevelAS) {}
 
 DescriptorPool::DescriptorPool(PGraphics graphics, PDescriptorLayout layout) : graphics(graphics), layout(layout) {}
 
 DescriptorPool::~DescriptorPool() {}
 
 Gfx::ODescriptorSet DescriptorPool::allocateDescriptorSet() {
-    for (uint32 setIndex = 0; setIndex < allocatedSets.size(); ++setIndex) {
-        if (allocatedSets[setIndex]->isCurrentlyBound()) {
-            // Currently in use, skip
-            continue;
-        }
-        // Found set, stop searching
-        return new DescriptorSet(graphics, this, allocatedSets[setIndex]);
+    std::unique_lock l(lock);
+    arenas.beginFrame(Gfx::getCurrentFrameNumber(),
+                      [this](uint32 set) { return !allocatedSets[set]->isCurrentlyBound() && !allocatedSets[set]->isUsed; });
+    uint32 setIndex = arenas.allocate();
+    if (setIndex == allocatedSets.size()) {
+        allocatedSets.add(new DescriptorSetHandle(graphics, this, layout->getName()));
     }
-    allocatedSets.add(new DescriptorSetHandle(graphics, this, layout->getName()));
-    return new DescriptorSet(graphics, this, allocatedSets.back());
+    allocatedSets[setIndex]->isUsed = true;
+    return new DescriptorSet(graphics, this, allocatedSets[setIndex]);
 }
 
 void DescriptorPool::reset() {}
@@ -171,34 +185,33 @@ DescriptorSet::DescriptorSet(PGraphics graphics, PDescriptorPool owner, PDescrip
     : Gfx::DescriptorSet(owner->getLayout()), graphics(graphics), owner(owner), setHandle(handle) {
 }
 
-DescriptorSet::~DescriptorSet() {
-}
+DescriptorSet::~DescriptorSet() { setHandle->isUsed = false; }
 
 void DescriptorSet::writeChanges() {}
 
-void DescriptorSet::updateConstants(const std::string& name, uint32 offset, void* data) {
-    setHandle->updateConstants(name, offset, data);
+void DescriptorSet::updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) {
+    setHandle->updateConstants(binding, offset, data);
 }
-void DescriptorSet::updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer uniformBuffer){
-    setHandle->updateBuffer(name, index, uniformBuffer);
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer uniformBuffer){
+    setHandle->updateBuffer(binding, index, uniformBuffer);
 }
-void DescriptorSet::updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer uniformBuffer){
-    setHandle->updateBuffer(name, index, uniformBuffer);
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer uniformBuffer){
+    setHandle->updateBuffer(binding, index, uniformBuffer);
 }
-void DescriptorSet::updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer uniformBuffer){
-    setHandle->updateBuffer(name, index, uniformBuffer);
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer uniformBuffer){
+    setHandle->updateBuffer(binding, index, uniformBuffer);
 }
-void DescriptorSet::updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer){
-    setHandle->updateBuffer(name, index, uniformBuffer);
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer){
+    setHandle->updateBuffer(binding, index, uniformBuffer);
 }
-void DescriptorSet::updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState){
-    setHandle->updateSampler(name, index, samplerState);
+void DescriptorSet::updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState){
+    setHandle->updateSampler(binding, index, samplerState);
 }
-void DescriptorSet::updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture){
-    setHandle->updateTexture(name, index, texture);
+void DescriptorSet::updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture){
+    setHandle->updateTexture(binding, index, texture);
 }
-void DescriptorSet::updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as){
-    setHandle->updateAccelerationStructure(name, index, as);
+void DescriptorSet::updateAccelerationStructure(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as){
+    setHandle->updateAccelerationStructure(binding, index, as);
 }
 
 PipelineLayout::PipelineLayout(PGraphics graphics, const std::string& name, Gfx::PPipelineLayout baseLayout)
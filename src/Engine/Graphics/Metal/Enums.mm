@@ -154,6 +154,14 @@ MTL::PixelFormat Seele::Metal::cast(Gfx::SeFormat format) {
         return MTL::PixelFormatETC2_RGB8;
     case Gfx::SE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
         return MTL::PixelFormatETC2_RGB8_sRGB;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+        return MTL::PixelFormatETC2_RGB8A1;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+        return MTL::PixelFormatETC2_RGB8A1_sRGB;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        return MTL::PixelFormatEAC_RGBA8;
+    case Gfx::SE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        return MTL::PixelFormatEAC_RGBA8_sRGB;
     case Gfx::SE_FORMAT_ASTC_4x4_SRGB_BLOCK:
         return MTL::PixelFormatASTC_4x4_sRGB;
     case Gfx::SE_FORMAT_ASTC_5x4_SRGB_BLOCK:
@@ -26,7 +26,9 @@ class Graphics : public Gfx::Graphics {
     virtual void executeCommands(Array<Gfx::ORenderCommand> commands) override;
     virtual void executeCommands(Gfx::OComputeCommand commands) override;
     virtual void executeCommands(Array<Gfx::OComputeCommand> commands) override;
+    virtual bool queueHandoff(Gfx::QueueType from, Gfx::QueueType to) override;
 
+    virtual bool supportsSampledFormat(Gfx::SeFormat format) const override;
     virtual Gfx::OTexture2D createTexture2D(const TextureCreateInfo& createInfo) override;
     virtual Gfx::OTexture2DArray createTexture2DArray(const TextureCreateInfo& createInfo) override;
     virtual Gfx::OTexture3D createTexture3D(const TextureCreateInfo& createInfo) override;
@@ -38,6 +40,8 @@ class Graphics : public Gfx::Graphics {
 
     virtual Gfx::ORenderCommand createRenderCommand(const std::string& name = "") override;
     virtual Gfx::OComputeCommand createComputeCommand(const std::string& name = "") override;
+    virtual Array<Gfx::ORenderCommand> recordRenderCommands(const std::string& name, uint64 numCommands,
+                                                            std::function<void(Gfx::PRenderCommand, uint64)> record) override;
 
     virtual void beginShaderCompilation(const ShaderCompilationInfo& compileInfo) override;
     virtual Gfx::OVertexShader createVertexShader(const ShaderCreateInfo& createInfo) override;
@@ -1,6 +1,7 @@
 #include "Graphics.h"
 #include "Buffer.h"
 #include "Command.h"
+#include "Enums.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Initializer.h"
 #include "Graphics/Metal/Descriptor.h"
@@ -12,6 +13,7 @@
 #include "RenderPass.h"
 #include "Resources.h"
 #include "Shader.h"
+#include "ThreadPool.h"
 #include "Window.h"
 #include <slang.h>
 
@@ -30,6 +32,8 @@ void Graphics::init(GraphicsInitializer) {
     ioQueue = new IOCommandQueue(this);
     cache = new PipelineCache(this, "pipelines.metal");
     meshShadingEnabled = true;
+    // the queries do not record anything yet, so no frame would ever complete
+    frameStatsEnabled = false;
 }
 
 Gfx::OWindow Graphics::createWindow(const WindowCreateInfo& createInfo) { return new Window(this, createInfo); }
@@ -65,6 +69,26 @@ void Graphics::executeCommands(Gfx::OComputeCommand commands) {
 
 void Graphics::executeCommands(Array<Gfx::OComputeCommand> commands) { queue->executeCommands(std::move(commands)); }
 
+// compute and rendering share the one command queue
+bool Graphics::queueHandoff(Gfx::QueueType, Gfx::QueueType) { return false; }
+
+bool Graphics::supportsSampledFormat(Gfx::SeFormat format) const {
+    if (format >= Gfx::SE_FORMAT_BC1_RGB_UNORM_BLOCK && format <= Gfx::SE_FORMAT_BC7_SRGB_BLOCK) {
+        if (!device->supportsBCTextureCompression()) {
+            return false;
+        }
+    } else if (Gfx::isBlockCompressed(format) && !device->supportsFamily(MTL::GPUFamilyApple2)) {
+        return false;
+    }
+    // not every Vulkan format has a pixel format in Metal
+    try {
+        cast(format);
+    } catch (const std::logic_error&) {
+        return false;
+    }
+    return true;
+}
+
 Gfx::OTexture2D Graphics::createTexture2D(const TextureCreateInfo& createInfo) { return new Texture2D(this, createInfo); }
 
 Gfx::OTexture2DArray Graphics::createTexture2DArray(const TextureCreateInfo& createInfo) { return new Texture2DArray(this, createInfo); }
@@ -85,6 +109,23 @@ Gfx::ORenderCommand Graphics::createRenderCommand(const std::string& name) { ret
 
 Gfx::OComputeCommand Graphics::createComputeCommand(const std::string& name) { return queue->getComputeCommand(name); }
 
+Array<Gfx::ORenderCommand> Graphics::recordRenderCommands(const std::string& name, uint64 numCommands,
+                                                          std::function<void(Gfx::PRenderCommand, uint64)> record) {
+    // the encoders of a parallel encoder execute in the order they were created, so they are created here
+    // and only the encoding is spread over the workers
+    Array<Gfx::ORenderCommand> commands(numCommands);
+    List<std::function<void()>> jobs;
+    for (uint64 i = 0; i < numCommands; ++i) {
+        commands[i] = createRenderCommand(name);
+        jobs.add([&commands, &record, i]() {
+            record(commands[i], i);
+            commands[i]->end();
+        });
+    }
+    getThreadPool().runAndWait(std::move(jobs));
+    return commands;
+}
+
 void Graphics::beginShaderCompilation(const ShaderCompilationInfo& compileInfo) {
     beginCompilation(compileInfo, SLANG_METAL, compileInfo.rootSignature);
 }
@@ -14,6 +14,8 @@ class PipelineCache {
 
   private:
     PGraphics graphics;
+    // pipelines can be requested from multiple threads during warm up
+    std::mutex cacheLock;
     Map<uint32, OGraphicsPipeline> graphicsPipelines;
     Map<uint32, OComputePipeline> computePipelines;
     std::string cacheFile;
@@ -27,6 +27,7 @@ PipelineCache::PipelineCache(PGraphics graphics, const std::string& name) : grap
 PipelineCache::~PipelineCache() {}
 
 PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo createInfo) {
+    std::scoped_lock lock(cacheLock);
     PRenderPass renderPass = createInfo.renderPass.cast<RenderPass>();
     MTL::RenderPipelineDescriptor* pipelineDescriptor = MTL::RenderPipelineDescriptor::alloc()->init();
 
@@ -162,6 +163,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo cr
 }
 
 PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo createInfo) {
+    std::scoped_lock lock(cacheLock);
     PRenderPass renderPass = createInfo.renderPass.cast<RenderPass>();
     MTL::MeshRenderPipelineDescriptor* pipelineDescriptor = MTL::MeshRenderPipelineDescriptor::alloc()->init();
 
@@ -247,6 +249,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo crea
 }
 
 PComputePipeline PipelineCache::createPipeline(Gfx::ComputePipelineCreateInfo createInfo) {
+    std::scoped_lock lock(cacheLock);
     PComputeShader shader = createInfo.computeShader.cast<ComputeShader>();
     uint32 hash = shader->getShaderHash();
     if (computePipelines.contains(hash)) {
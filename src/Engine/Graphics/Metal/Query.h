@@ -11,8 +11,6 @@ class QueryPool {
     virtual ~QueryPool();
     void begin();
     void end();
-    // stalls for the currently first pending query, dont call in render thread
-    void getQueryResults(Array<uint64>& results);
 
   protected:
     PGraphics graphics;
@@ -23,7 +21,6 @@ class OcclusionQuery : public Gfx::OcclusionQuery, public QueryPool {
     virtual ~OcclusionQuery();
     virtual void beginQuery() override;
     virtual void endQuery() override;
-    virtual Gfx::OcclusionResult getResults() override;
 };
 DEFINE_REF(OcclusionQuery)
 class PipelineStatisticsQuery : public Gfx::PipelineStatisticsQuery, public QueryPool {
@@ -32,7 +29,6 @@ class PipelineStatisticsQuery : public Gfx::PipelineStatisticsQuery, public Quer
     virtual ~PipelineStatisticsQuery();
     virtual void beginQuery() override;
     virtual void endQuery() override;
-    virtual Gfx::PipelineStatisticsResult getResults() override;
 };
 DEFINE_REF(PipelineStatisticsQuery)
 
@@ -41,7 +37,6 @@ class TimestampQuery : public Gfx::TimestampQuery, public QueryPool {
     TimestampQuery(PGraphics graphics, const std::string& name, uint32 numTimestamps);
     virtual ~TimestampQuery();
     virtual void write(Gfx::SePipelineStageFlagBits stage, const std::string& name = "") override;
-    virtual Gfx::Timestamp getResult() override;
 
   private:
     Array<std::string> pendingTimestamps;
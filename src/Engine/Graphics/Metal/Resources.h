@@ -5,6 +5,7 @@
 #include <Foundation/Foundation.hpp>
 #include <Metal/Metal.hpp>
 #include <QuartzCore/QuartzCore.hpp>
+#include <atomic>
 #include <iostream>
 
 namespace Seele {
@@ -32,7 +33,7 @@ public:
         if (isCurrentlyBound())
             abort();
     }
-    constexpr bool isCurrentlyBound() const { return bindCount > 0; }
+    bool isCurrentlyBound() const { return bindCount > 0; }
     void bind() { bindCount++;
         std::cout << "Bind " << bindCount << " " << name << std::endl;
     }
@@ -46,7 +47,8 @@ public:
   protected:
     PGraphics graphics;
     std::string name;
-    uint64 bindCount = 0;
+    // commands for the same frame can be encoded on multiple threads
+    std::atomic_uint64_t bindCount = 0;
 };
 DEFINE_REF(CommandBoundResource)
 
@@ -25,11 +25,11 @@ Shader::~Shader() {
 }
 
 void Shader::create(const ShaderCreateInfo& createInfo) {
-    auto [kernelBlob, entryPoint] = generateShader(createInfo);
-    hash = CRC::Calculate(kernelBlob->getBufferPointer(), kernelBlob->getBufferSize(), CRC::CRC_32());
+    auto [code, entryPoint] = generateShader(createInfo);
+    hash = CRC::Calculate(code.data(), code.size(), CRC::CRC_32());
     std::regex pattern("\\[\\[buffer\\(\\d+\\)\\]\\]");
     
-    std::string codeStr = std::string((const char*)kernelBlob->getBufferPointer());
+    std::string codeStr = std::string((const char*)code.data(), code.size());
     auto matches_begin = std::sregex_iterator(codeStr.begin(), codeStr.end(), pattern);
     auto matches_end = std::sregex_iterator();
 
@@ -39,7 +39,7 @@ void Shader::create(const ShaderCreateInfo& createInfo) {
     
     NS::Error* error;
     MTL::CompileOptions* options = MTL::CompileOptions::alloc()->init();
-    library = graphics->getDevice()->newLibrary(NS::String::string((char*)kernelBlob->getBufferPointer(), NS::ASCIIStringEncoding), options,
+    library = graphics->getDevice()->newLibrary(NS::String::string(codeStr.c_str(), NS::ASCIIStringEncoding), options,
                                                 &error);
     options->release();
     if (error) {
@@ -23,6 +23,7 @@ class TextureView : public Gfx::TextureView, public CommandBoundResource {
                                  Gfx::SePipelineStageFlags dstStage) override;
     virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
                               Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void transferOwnership(Gfx::QueueType newOwner) override;
 
     MTL::Texture* getHandle() const { return view; }
     PTextureHandle getSource() const { return source;}
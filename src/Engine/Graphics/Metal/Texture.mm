@@ -41,6 +41,8 @@ void TextureView::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags
     return source->changeLayout(newLayout, srcAccess, srcStage, dstAccess, dstStage);
 }
 
+void TextureView::transferOwnership(Gfx::QueueType) {}
+
 Gfx::OTextureView TextureHandle::createTextureView(uint32 baseMipLevel, uint32 viewLevelCount, uint32 baseArrayLayer,
                                                    uint32 viewLayerCount) {
     MTL::Texture* viewTexture;
@@ -61,7 +63,9 @@ TextureHandle::TextureHandle(PGraphics graphics, MTL::TextureType type, const Te
     : CommandBoundResource(graphics, createInfo.name), texture(existingImage), type(type), width(createInfo.width), height(createInfo.height),
       depth(createInfo.depth), arrayCount(createInfo.elements), mipLevels(1), samples(createInfo.samples), format(createInfo.format),
       usage(createInfo.usage), layout(Gfx::SE_IMAGE_LAYOUT_UNDEFINED), ownsImage(existingImage == nullptr) {
-    if (createInfo.useMip) {
+    if (!createInfo.mipOffsets.empty()) {
+        mipLevels = static_cast<uint32>(createInfo.mipOffsets.size());
+    } else if (createInfo.useMip) {
         mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
     }
     if (existingImage == nullptr) {
@@ -106,14 +110,32 @@ TextureHandle::TextureHandle(PGraphics graphics, MTL::TextureType type, const Te
             sliceSize /= 6;
             numSlices *= 6;
         }
-        uint32 offset = 0;
-        for (uint32 slice = 0; slice < numSlices; ++slice) {
-            blitEnc->copyFromBuffer(stagingBuffer->buffer, offset, sliceSize / createInfo.height, arrayCount == 1 ? 0 : sliceSize,
-                                    MTL::Size(createInfo.width, createInfo.height, createInfo.depth), texture, slice, 0, MTL::Origin());
-            offset += sliceSize;
-        }
-        if (mipLevels > 1) {
-            blitEnc->generateMipmaps(texture);
+        if (createInfo.mipOffsets.empty()) {
+            uint32 offset = 0;
+            for (uint32 slice = 0; slice < numSlices; ++slice) {
+                blitEnc->copyFromBuffer(stagingBuffer->buffer, offset, sliceSize / createInfo.height, arrayCount == 1 ? 0 : sliceSize,
+                                        MTL::Size(createInfo.width, createInfo.height, createInfo.depth), texture, slice, 0, MTL::Origin());
+                offset += sliceSize;
+            }
+            if (mipLevels > 1) {
+                blitEnc->generateMipmaps(texture);
+            }
+        } else {
+            // block compressed formats cannot generate their mips, so every level comes with the source data
+            Gfx::FormatCompatibilityInfo formatInfo = Gfx::getFormatInfo(format);
+            for (uint32 level = 0; level < mipLevels; ++level) {
+                uint32 levelWidth = std::max(width >> level, 1u);
+                uint32 levelHeight = std::max(height >> level, 1u);
+                uint32 levelDepth = std::max(depth >> level, 1u);
+                uint64 rowSize = (levelWidth + formatInfo.blockExtent.x - 1) / formatInfo.blockExtent.x * formatInfo.blockSize;
+                uint64 imageSize = rowSize * ((levelHeight + formatInfo.blockExtent.y - 1) / formatInfo.blockExtent.y);
+                uint64 offset = createInfo.mipOffsets[level];
+                for (uint32 slice = 0; slice < numSlices; ++slice) {
+                    blitEnc->copyFromBuffer(stagingBuffer->buffer, offset, rowSize, levelDepth > 1 ? imageSize : 0,
+                                            MTL::Size(levelWidth, levelHeight, levelDepth), texture, slice, level, MTL::Origin());
+                    offset += imageSize * levelDepth;
+                }
+            }
         }
         graphics->getQueue()->getCommands()->bindResource(PBufferAllocation(stagingBuffer));
         graphics->getDestructionManager()->queueResourceForDestruction(std::move(stagingBuffer));
@@ -15,15 +15,6 @@
 using namespace Seele;
 using namespace Seele::Metal;
 
-double currentFrameDelta = 0;
-double Gfx::getCurrentFrameDelta() { return currentFrameDelta; }
-
-double currentFrameTime = 0;
-double Gfx::getCurrentFrameTime() { return currentFrameTime; }
-
-uint32 currentFrameIndex = 0;
-uint32 Gfx::getCurrentFrameIndex() { return currentFrameIndex; }
-
 void glfwKeyCallback(GLFWwindow* handle, int key, int, int action, int modifier) {
     if (key == -1) {
         return;
@@ -105,15 +96,14 @@ void Window::beginFrame() {
     createBackBuffer();
     static double start = glfwGetTime();
     double end = glfwGetTime();
-    currentFrameDelta = end - start;
-    currentFrameTime += currentFrameDelta;
+    updateFrameTime(end - start);
     start = end;
 }
 
 void Window::endFrame() {
     graphics->getQueue()->submitCommands();
     graphics->getQueue()->getCommands()->present(drawable);
-    currentFrameIndex++;
+    setCurrentFrameIndex(Gfx::getCurrentFrameIndex() + 1);
     drawable->release();
 }
 
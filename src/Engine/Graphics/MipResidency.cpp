@@ -0,0 +1,147 @@
+#include "MipResidency.h"
+#include <algorithm>
+
+using namespace Seele;
+using namespace Seele::Gfx;
+
+MipResidency::MipResidency(uint64 budget) : budget(budget) {}
+
+MipResidency::~MipResidency() {}
+
+uint32 MipResidency::add(Array<uint64> levelSizes, uint32 initialLevel) {
+    uint32 id;
+    if (freeIds.empty()) {
+        id = (uint32)entries.size();
+        entries.add(Entry());
+    } else {
+        id = freeIds.back();
+        freeIds.pop();
+    }
+    Entry& entry = entries[id];
+    entry.initialLevel = std::min<uint32>(initialLevel, (uint32)levelSizes.size() - 1);
+    entry.levelSizes = std::move(levelSizes);
+    entry.resident = entry.initialLevel;
+    entry.requested = entry.initialLevel;
+    entry.wanted = entry.initialLevel;
+    entry.lastRequested = 0;
+    entry.used = true;
+    for (uint32 level = entry.resident; level < entry.levelSizes.size(); ++level) {
+        residentSize += entry.levelSizes[level];
+    }
+    return id;
+}
+
+void MipResidency::remove(uint32 id) {
+    Entry& entry = entries[id];
+    for (uint32 level = entry.resident; level < entry.levelSizes.size(); ++level) {
+        residentSize -= entry.levelSizes[level];
+    }
+    entry = Entry();
+    freeIds.add(id);
+}
+
+void MipResidency::request(uint32 id, uint32 level) {
+    Entry& entry = entries[id];
+    level = std::min<uint32>(level, (uint32)entry.levelSizes.size() - 1);
+    if (entry.lastRequested != frame) {
+        entry.requested = level;
+        entry.lastRequested = frame;
+    } else {
+        entry.requested = std::min(entry.requested, level);
+    }
+}
+
+Array<Pair<uint32, uint32>> MipResidency::update() {
+    Array<uint32> previous(entries.size());
+    Array<uint32> streaming;
+    for (uint32 id = 0; id < entries.size(); ++id) {
+        Entry& entry = entries[id];
+        previous[id] = entry.resident;
+        if (!entry.used) {
+            continue;
+        }
+        entry.wanted = entry.lastRequested == frame ? std::min(entry.requested, entry.initialLevel) : entry.initialLevel;
+        if (entry.resident > entry.wanted) {
+            streaming.add(id);
+        }
+    }
+    // the budget was lowered, what nobody asks for goes first, then the finest levels of the least recently requested textures
+    while (residentSize > budget) {
+        uint32 victim = findVictim(INVALID_ID, true);
+        if (victim == INVALID_ID) {
+            victim = findVictim(INVALID_ID, false);
+        }
+        if (victim == INVALID_ID) {
+            break;
+        }
+        evict(victim);
+    }
+    // the blurriest textures get their levels first, every texture gets at most one level per frame to spread out the uploads
+    std::sort(streaming.begin(), streaming.end(), [this](uint32 lhs, uint32 rhs) {
+        return entries[lhs].resident - entries[lhs].wanted > entries[rhs].resident - entries[rhs].wanted;
+    });
+    for (uint32 id : streaming) {
+        Entry& entry = entries[id];
+        uint64 size = entry.levelSizes[entry.resident - 1];
+        while (residentSize + size > budget) {
+            uint32 victim = findVictim(id, true);
+            if (victim == INVALID_ID) {
+                break;
+            }
+            evict(victim);
+        }
+        // a smaller level of another texture might still fit
+        if (residentSize + size > budget) {
+            continue;
+        }
+        entry.resident--;
+        residentSize += size;
+    }
+    Array<Pair<uint32, uint32>> changes;
+    for (uint32 id = 0; id < entries.size(); ++id) {
+        if (entries[id].used && entries[id].resident != previous[id]) {
+            changes.add(Pair<uint32, uint32>{id, entries[id].resident});
+        }
+    }
+    frame++;
+    return changes;
+}
+
+uint32 MipResidency::findVictim(uint32 exclude, bool onlyUnwanted) const {
+    uint32 result = INVALID_ID;
+    for (uint32 id = 0; id < entries.size(); ++id) {
+        const Entry& entry = entries[id];
+        if (!entry.used || id == exclude || entry.resident >= entry.initialLevel) {
+            continue;
+        }
+        bool unwanted = entry.resident < entry.wanted;
+        if (onlyUnwanted && !unwanted) {
+            continue;
+        }
+        if (result == INVALID_ID) {
+            result = id;
+            continue;
+        }
+        const Entry& best = entries[result];
+        bool bestUnwanted = best.resident < best.wanted;
+        if (unwanted != bestUnwanted) {
+            if (unwanted) {
+                result = id;
+            }
+        } else if (entry.lastRequested != best.lastRequested) {
+            if (entry.lastRequested < best.lastRequested) {
+                result = id;
+            }
+        } else if (entry.resident < best.resident) {
+            // the finest level frees the most
+            result = id;
+        }
+    }
+    return result;
+}
+
+void MipResidency::evict(uint32 id) {
+    Entry& entry = entries[id];
+    residentSize -= entry.levelSizes[entry.resident];
+    entry.resident++;
+}
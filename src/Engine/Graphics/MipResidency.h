@@ -0,0 +1,54 @@
+#pragma once
+#include "Containers/Array.h"
+#include "Containers/Pair.h"
+#include "MinimalEngine.h"
+
+namespace Seele {
+namespace Gfx {
+// decides which mip levels of streamed textures are resident, from the level each texture was asked for during a frame
+// and a budget for the bytes of all of them, without knowing how the levels get to the GPU
+// levels are numbered like mips, 0 is the full resolution, and a texture is resident from its resident level to its smallest one
+class MipResidency {
+  public:
+    static constexpr uint32 INVALID_ID = std::numeric_limits<uint32>::max();
+    MipResidency(uint64 budget);
+    ~MipResidency();
+    // levelSizes[i] is the size of level i, initialLevel is the level the texture starts out with and is never evicted
+    uint32 add(Array<uint64> levelSizes, uint32 initialLevel);
+    void remove(uint32 id);
+    // finest level the texture would be sampled at this frame, the finest request of a frame wins
+    void request(uint32 id, uint32 level);
+    // ends the frame, streams every texture that is coarser than requested one level further in as long as the budget allows
+    // and makes room by evicting levels nobody asked for, least recently requested first
+    // returns the textures whose resident level changed, with their new resident level
+    Array<Pair<uint32, uint32>> update();
+    uint32 getResidentLevel(uint32 id) const { return entries[id].resident; }
+    // bytes of the levels that are resident, including the initial ones
+    uint64 getResidentSize() const { return residentSize; }
+    uint64 getBudget() const { return budget; }
+    void setBudget(uint64 newBudget) { budget = newBudget; }
+
+  private:
+    struct Entry {
+        Array<uint64> levelSizes;
+        uint32 initialLevel = 0;
+        uint32 resident = 0;
+        uint32 requested = 0;
+        // level the texture should have this frame, its initial level if it was not requested
+        uint32 wanted = 0;
+        // 0 if it was never requested
+        uint64 lastRequested = 0;
+        bool used = false;
+    };
+    // entry that gives up its finest resident level next, INVALID_ID if there is none
+    // levels that were requested this frame are only given up if onlyUnwanted is false
+    uint32 findVictim(uint32 exclude, bool onlyUnwanted) const;
+    void evict(uint32 id);
+    Array<Entry> entries;
+    Array<uint32> freeIds;
+    uint64 budget;
+    uint64 residentSize = 0;
+    uint64 frame = 1;
+};
+} // namespace Gfx
+} // namespace Seele
@@ -0,0 +1,106 @@
+#include "Buffer.h"
+#include <cstring>
+
+using namespace Seele;
+using namespace Seele::Null;
+
+Buffer::Buffer(const DataSource& sourceData) : contents(sourceData.size) {
+    if (sourceData.data != nullptr) {
+        std::memcpy(contents.data(), sourceData.data, sourceData.size);
+    }
+}
+
+Buffer::~Buffer() {}
+
+void Buffer::updateContents(uint64 regionOffset, uint64 regionSize, void* ptr) {
+    if (regionSize == 0 || ptr == nullptr) {
+        return;
+    }
+    assert(regionOffset + regionSize <= contents.size());
+    std::memcpy(contents.data() + regionOffset, ptr, regionSize);
+}
+
+void Buffer::readContents(uint64 regionOffset, uint64 regionSize, void* ptr) {
+    if (regionSize == 0) {
+        return;
+    }
+    assert(regionOffset + regionSize <= contents.size());
+    std::memcpy(ptr, contents.data() + regionOffset, regionSize);
+}
+
+void Buffer::rotateBuffer(uint64 size) {
+    // like the GPU backends, allocations only ever grow, and their old contents stay around
+    if (size > contents.size()) {
+        contents.resize(size);
+    }
+}
+
+VertexBuffer::VertexBuffer(Gfx::QueueFamilyMapping mapping, const VertexBufferCreateInfo& createInfo)
+    : Gfx::VertexBuffer(mapping, createInfo), Buffer(createInfo.sourceData) {}
+
+VertexBuffer::~VertexBuffer() {}
+
+void VertexBuffer::updateRegion(uint64 offset, uint64 size, void* data) { Null::Buffer::updateContents(offset, size, data); }
+
+void VertexBuffer::download(Array<uint8>& buffer) {
+    buffer.resize(getSize());
+    Null::Buffer::readContents(0, getSize(), buffer.data());
+}
+
+void VertexBuffer::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void VertexBuffer::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+IndexBuffer::IndexBuffer(Gfx::QueueFamilyMapping mapping, const IndexBufferCreateInfo& createInfo)
+    : Gfx::IndexBuffer(mapping, createInfo), Buffer(createInfo.sourceData) {}
+
+IndexBuffer::~IndexBuffer() {}
+
+void IndexBuffer::download(Array<uint8>& buffer) {
+    buffer.resize(getSize());
+    Null::Buffer::readContents(0, getSize(), buffer.data());
+}
+
+void IndexBuffer::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void IndexBuffer::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+UniformBuffer::UniformBuffer(Gfx::QueueFamilyMapping mapping, const UniformBufferCreateInfo& createInfo)
+    : Gfx::UniformBuffer(mapping, createInfo), Buffer(createInfo.sourceData) {}
+
+UniformBuffer::~UniformBuffer() {}
+
+void UniformBuffer::rotateBuffer(uint64 size) { Null::Buffer::rotateBuffer(size); }
+
+void UniformBuffer::updateContents(uint64 offset, uint64 size, void* data) { Null::Buffer::updateContents(offset, size, data); }
+
+void UniformBuffer::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void UniformBuffer::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {
+}
+
+ShaderBuffer::ShaderBuffer(Gfx::QueueFamilyMapping mapping, const ShaderBufferCreateInfo& createInfo)
+    : Gfx::ShaderBuffer(mapping, createInfo), Buffer(createInfo.sourceData), clearValue(createInfo.clearValue) {}
+
+ShaderBuffer::~ShaderBuffer() {}
+
+void ShaderBuffer::readContents(uint64 offset, uint64 size, void* data) { Null::Buffer::readContents(offset, size, data); }
+
+void ShaderBuffer::rotateBuffer(uint64 size, bool) { Null::Buffer::rotateBuffer(size); }
+
+void ShaderBuffer::updateContents(uint64 offset, uint64 size, void* data) { Null::Buffer::updateContents(offset, size, data); }
+
+void* ShaderBuffer::map() { return contents.data(); }
+
+void ShaderBuffer::unmap() {}
+
+void ShaderBuffer::clear() {
+    // same as vkCmdFillBuffer, the value is repeated for every 4 bytes
+    for (uint64 i = 0; i + sizeof(uint32) <= contents.size(); i += sizeof(uint32)) {
+        std::memcpy(contents.data() + i, &clearValue, sizeof(uint32));
+    }
+}
+
+void ShaderBuffer::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void ShaderBuffer::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Graphics/Buffer.h"
+#include "Graphics/Initializer.h"
+
+namespace Seele {
+namespace Null {
+// host memory backing of all buffer types
+class Buffer {
+  public:
+    Buffer(const DataSource& sourceData);
+    virtual ~Buffer();
+    uint64 getSize() const { return contents.size(); }
+    const uint8* getContents() const { return contents.data(); }
+    void updateContents(uint64 regionOffset, uint64 regionSize, void* ptr);
+    void readContents(uint64 regionOffset, uint64 regionSize, void* ptr);
+
+  protected:
+    void rotateBuffer(uint64 size);
+    Array<uint8> contents;
+};
+DEFINE_REF(Buffer)
+
+class VertexBuffer : public Gfx::VertexBuffer, public Buffer {
+  public:
+    VertexBuffer(Gfx::QueueFamilyMapping mapping, const VertexBufferCreateInfo& createInfo);
+    virtual ~VertexBuffer();
+    virtual void updateRegion(uint64 offset, uint64 size, void* data) override;
+    virtual void download(Array<uint8>& buffer) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(VertexBuffer)
+
+class IndexBuffer : public Gfx::IndexBuffer, public Buffer {
+  public:
+    IndexBuffer(Gfx::QueueFamilyMapping mapping, const IndexBufferCreateInfo& createInfo);
+    virtual ~IndexBuffer();
+    virtual void download(Array<uint8>& buffer) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(IndexBuffer)
+
+class UniformBuffer : public Gfx::UniformBuffer, public Buffer {
+  public:
+    UniformBuffer(Gfx::QueueFamilyMapping mapping, const UniformBufferCreateInfo& createInfo);
+    virtual ~UniformBuffer();
+    virtual void rotateBuffer(uint64 size) override;
+    virtual void updateContents(uint64 offset, uint64 size, void* data) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(UniformBuffer)
+
+class ShaderBuffer : public Gfx::ShaderBuffer, public Buffer {
+  public:
+    ShaderBuffer(Gfx::QueueFamilyMapping mapping, const ShaderBufferCreateInfo& createInfo);
+    virtual ~ShaderBuffer();
+    virtual void readContents(uint64 offset, uint64 size, void* data) override;
+    virtual void rotateBuffer(uint64 size, bool preserveContents = false) override;
+    virtual void updateContents(uint64 offset, uint64 size, void* data) override;
+    virtual void* map() override;
+    virtual void unmap() override;
+    virtual void clear() override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+    uint32 clearValue;
+};
+DEFINE_REF(ShaderBuffer)
+} // namespace Null
+} // namespace Seele
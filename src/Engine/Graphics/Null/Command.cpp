@@ -0,0 +1,99 @@
+#include "Command.h"
+
+using namespace Seele;
+using namespace Seele::Null;
+
+CommandStatistics& CommandStatistics::operator+=(const CommandStatistics& other) {
+    numRenderCommands += other.numRenderCommands;
+    numComputeCommands += other.numComputeCommands;
+    numRenderPasses += other.numRenderPasses;
+    numPipelineBinds += other.numPipelineBinds;
+    numDescriptorBinds += other.numDescriptorBinds;
+    numPushConstants += other.numPushConstants;
+    numDraws += other.numDraws;
+    numIndirectDraws += other.numIndirectDraws;
+    numVertices += other.numVertices;
+    numMeshDraws += other.numMeshDraws;
+    numMeshGroups += other.numMeshGroups;
+    numDispatches += other.numDispatches;
+    numDispatchGroups += other.numDispatchGroups;
+    numTraceRays += other.numTraceRays;
+    return *this;
+}
+
+RenderCommand::RenderCommand(const std::string& _name) : recordingThread(std::this_thread::get_id()) {
+    name = _name;
+    statistics.numRenderCommands = 1;
+}
+
+RenderCommand::~RenderCommand() {}
+
+void RenderCommand::setViewport(Gfx::PViewport) {}
+
+void RenderCommand::bindPipeline(Gfx::PGraphicsPipeline) { statistics.numPipelineBinds++; }
+
+void RenderCommand::bindPipeline(Gfx::PRayTracingPipeline) { statistics.numPipelineBinds++; }
+
+void RenderCommand::bindDescriptor(Gfx::PDescriptorSet) { statistics.numDescriptorBinds++; }
+
+void RenderCommand::bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) { statistics.numDescriptorBinds += sets.size(); }
+
+void RenderCommand::bindVertexBuffer(const Array<Gfx::PVertexBuffer>&) {}
+
+void RenderCommand::bindIndexBuffer(Gfx::PIndexBuffer) {}
+
+void RenderCommand::pushConstants(Gfx::SeShaderStageFlags, uint32, uint32, const void*) { statistics.numPushConstants++; }
+
+void RenderCommand::draw(uint32 vertexCount, uint32 instanceCount, int32, uint32) {
+    statistics.numDraws++;
+    statistics.numVertices += uint64(vertexCount) * instanceCount;
+}
+
+void RenderCommand::drawIndirect(Gfx::PShaderBuffer, uint64, uint32 drawCount, uint32) {
+    statistics.numDraws += drawCount;
+    statistics.numIndirectDraws += drawCount;
+}
+
+void RenderCommand::drawIndexed(uint32 indexCount, uint32 instanceCount, int32, uint32, uint32) {
+    statistics.numDraws++;
+    statistics.numVertices += uint64(indexCount) * instanceCount;
+}
+
+void RenderCommand::drawMesh(uint32 groupX, uint32 groupY, uint32 groupZ) {
+    statistics.numMeshDraws++;
+    statistics.numMeshGroups += uint64(groupX) * groupY * groupZ;
+}
+
+void RenderCommand::drawMeshIndirect(Gfx::PShaderBuffer, uint64, uint32 drawCount, uint32) {
+    statistics.numMeshDraws += drawCount;
+    statistics.numIndirectDraws += drawCount;
+}
+
+void RenderCommand::traceRays(uint32, uint32, uint32) { statistics.numTraceRays++; }
+
+void RenderCommand::end() {
+    endingThread = std::this_thread::get_id();
+    ended = true;
+}
+
+ComputeCommand::ComputeCommand(const std::string& _name) {
+    name = _name;
+    statistics.numComputeCommands = 1;
+}
+
+ComputeCommand::~ComputeCommand() {}
+
+void ComputeCommand::bindPipeline(Gfx::PComputePipeline) { statistics.numPipelineBinds++; }
+
+void ComputeCommand::bindDescriptor(Gfx::PDescriptorSet) { statistics.numDescriptorBinds++; }
+
+void ComputeCommand::bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) { statistics.numDescriptorBinds += sets.size(); }
+
+void ComputeCommand::pushConstants(Gfx::SeShaderStageFlags, uint32, uint32, const void*) { statistics.numPushConstants++; }
+
+void ComputeCommand::dispatch(uint32 threadX, uint32 threadY, uint32 threadZ) {
+    statistics.numDispatches++;
+    statistics.numDispatchGroups += uint64(threadX) * threadY * threadZ;
+}
+
+void ComputeCommand::dispatchIndirect(Gfx::PShaderBuffer, uint32) { statistics.numDispatches++; }
@@ -0,0 +1,79 @@
+#pragma once
+#include "Graphics/Command.h"
+#include <thread>
+
+namespace Seele {
+namespace Null {
+// what the recorded commands would have made a GPU do
+struct CommandStatistics {
+    uint64 numRenderCommands = 0;
+    uint64 numComputeCommands = 0;
+    uint64 numRenderPasses = 0;
+    uint64 numPipelineBinds = 0;
+    uint64 numDescriptorBinds = 0;
+    uint64 numPushConstants = 0;
+    // draw, drawIndexed and their indirect versions
+    uint64 numDraws = 0;
+    uint64 numIndirectDraws = 0;
+    // vertices or indices of all direct draws, times their instance count
+    uint64 numVertices = 0;
+    uint64 numMeshDraws = 0;
+    uint64 numMeshGroups = 0;
+    uint64 numDispatches = 0;
+    uint64 numDispatchGroups = 0;
+    uint64 numTraceRays = 0;
+    CommandStatistics& operator+=(const CommandStatistics& other);
+};
+
+class RenderCommand : public Gfx::RenderCommand {
+  public:
+    RenderCommand(const std::string& name);
+    virtual ~RenderCommand();
+    virtual void setViewport(Gfx::PViewport viewport) override;
+    virtual void bindPipeline(Gfx::PGraphicsPipeline pipeline) override;
+    virtual void bindPipeline(Gfx::PRayTracingPipeline pipeline) override;
+    virtual void bindDescriptor(Gfx::PDescriptorSet set) override;
+    virtual void bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) override;
+    virtual void bindVertexBuffer(const Array<Gfx::PVertexBuffer>& buffer) override;
+    virtual void bindIndexBuffer(Gfx::PIndexBuffer indexBuffer) override;
+    virtual void pushConstants(Gfx::SeShaderStageFlags stage, uint32 offset, uint32 size, const void* data) override;
+    virtual void draw(uint32 vertexCount, uint32 instanceCount, int32 firstVertex, uint32 firstInstance) override;
+    virtual void drawIndirect(Gfx::PShaderBuffer buffer, uint64 offset, uint32 drawCount, uint32 stride) override;
+    virtual void drawIndexed(uint32 indexCount, uint32 instanceCount, int32 firstIndex, uint32 vertexOffset, uint32 firstInstance) override;
+    virtual void drawMesh(uint32 groupX, uint32 groupY, uint32 groupZ) override;
+    virtual void drawMeshIndirect(Gfx::PShaderBuffer buffer, uint64 offset, uint32 drawCount, uint32 stride) override;
+    virtual void traceRays(uint32 width, uint32 height, uint32 depth) override;
+    virtual void end() override;
+    const CommandStatistics& getStatistics() const { return statistics; }
+    constexpr bool isEnded() const { return ended; }
+    std::thread::id getRecordingThread() const { return recordingThread; }
+    std::thread::id getEndingThread() const { return endingThread; }
+
+  private:
+    CommandStatistics statistics;
+    // commands are recorded on the thread that created them
+    std::thread::id recordingThread;
+    std::thread::id endingThread;
+    bool ended = false;
+};
+DEFINE_REF(RenderCommand)
+
+class ComputeCommand : public Gfx::ComputeCommand {
+  public:
+    ComputeCommand(const std::string& name);
+    virtual ~ComputeCommand();
+    virtual void bindPipeline(Gfx::PComputePipeline pipeline) override;
+    virtual void bindDescriptor(Gfx::PDescriptorSet set) override;
+    virtual void bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) override;
+    virtual void pushConstants(Gfx::SeShaderStageFlags stage, uint32 offset, uint32 size, const void* data) override;
+    virtual void dispatch(uint32 threadX, uint32 threadY, uint32 threadZ) override;
+    virtual void dispatchIndirect(Gfx::PShaderBuffer buffer, uint32 offset) override;
+    virtual void end() override {}
+    const CommandStatistics& getStatistics() const { return statistics; }
+
+  private:
+    CommandStatistics statistics;
+};
+DEFINE_REF(ComputeCommand)
+} // namespace Null
+} // namespace Seele
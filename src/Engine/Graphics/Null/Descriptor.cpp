@@ -0,0 +1,68 @@
+#include "Descriptor.h"
+#include "CRC.h"
+
+using namespace Seele;
+using namespace Seele::Null;
+
+DescriptorLayout::DescriptorLayout(const std::string& name) : Gfx::DescriptorLayout(name) {}
+
+DescriptorLayout::~DescriptorLayout() {}
+
+void DescriptorLayout::create() {
+    if (pool != nullptr) {
+        return;
+    }
+    for (const auto& binding : descriptorBindings) {
+        hash = CRC::Calculate(binding.name.data(), binding.name.size(), CRC::CRC_32(), hash);
+        hash = CRC::Calculate(&binding.descriptorType, sizeof(Gfx::SeDescriptorType), CRC::CRC_32(), hash);
+        hash = CRC::Calculate(&binding.descriptorCount, sizeof(uint32), CRC::CRC_32(), hash);
+    }
+    pool = new DescriptorPool(this);
+}
+
+DescriptorPool::DescriptorPool(PDescriptorLayout layout) : layout(layout) {}
+
+DescriptorPool::~DescriptorPool() {}
+
+Gfx::ODescriptorSet DescriptorPool::allocateDescriptorSet() { return new DescriptorSet(layout); }
+
+void DescriptorPool::reset() {}
+
+DescriptorSet::DescriptorSet(PDescriptorLayout layout) : Gfx::DescriptorSet(layout) {}
+
+DescriptorSet::~DescriptorSet() {}
+
+void DescriptorSet::writeChanges() {}
+
+void DescriptorSet::updateConstants(Gfx::DescriptorBindingHandle, uint32, void*) {}
+
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle, uint32, Gfx::PShaderBuffer) {}
+
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle, uint32, Gfx::PVertexBuffer) {}
+
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle, uint32, Gfx::PIndexBuffer) {}
+
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle, uint32, Gfx::PUniformBuffer) {}
+
+void DescriptorSet::updateSampler(Gfx::DescriptorBindingHandle, uint32, Gfx::PSampler) {}
+
+void DescriptorSet::updateTexture(Gfx::DescriptorBindingHandle, uint32, Gfx::PTextureView) {}
+
+void DescriptorSet::updateAccelerationStructure(Gfx::DescriptorBindingHandle, uint32, Gfx::PTopLevelAS) {}
+
+PipelineLayout::PipelineLayout(const std::string& name, Gfx::PPipelineLayout baseLayout) : Gfx::PipelineLayout(name, baseLayout) {}
+
+PipelineLayout::~PipelineLayout() {}
+
+void PipelineLayout::create() {
+    layoutHash = 0;
+    for (const auto& [_, layout] : descriptorSetLayouts) {
+        layout->create();
+        uint32 setHash = layout->getHash();
+        layoutHash = CRC::Calculate(&setHash, sizeof(uint32), CRC::CRC_32(), layoutHash);
+    }
+    for (const auto& range : pushConstants) {
+        layoutHash = CRC::Calculate(&range.offset, sizeof(uint32), CRC::CRC_32(), layoutHash);
+        layoutHash = CRC::Calculate(&range.size, sizeof(uint32), CRC::CRC_32(), layoutHash);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Graphics/Descriptor.h"
+
+namespace Seele {
+namespace Null {
+class DescriptorLayout : public Gfx::DescriptorLayout {
+  public:
+    DescriptorLayout(const std::string& name);
+    virtual ~DescriptorLayout();
+    virtual void create() override;
+};
+DEFINE_REF(DescriptorLayout)
+
+class DescriptorPool : public Gfx::DescriptorPool {
+  public:
+    DescriptorPool(PDescriptorLayout layout);
+    virtual ~DescriptorPool();
+    virtual Gfx::ODescriptorSet allocateDescriptorSet() override;
+    virtual void reset() override;
+
+  private:
+    PDescriptorLayout layout;
+};
+DEFINE_REF(DescriptorPool)
+
+// writes are dropped, there is nothing that would read them
+class DescriptorSet : public Gfx::DescriptorSet {
+  public:
+    DescriptorSet(PDescriptorLayout layout);
+    virtual ~DescriptorSet();
+    virtual void writeChanges() override;
+    using Gfx::DescriptorSet::updateAccelerationStructure;
+    using Gfx::DescriptorSet::updateBuffer;
+    using Gfx::DescriptorSet::updateConstants;
+    using Gfx::DescriptorSet::updateSampler;
+    using Gfx::DescriptorSet::updateTexture;
+    virtual void updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer shaderBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer vertexBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer indexBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) override;
+    virtual void updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState) override;
+    virtual void updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture) override;
+    virtual void updateAccelerationStructure(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as) override;
+    virtual bool isCurrentlyBound() const override { return false; }
+};
+DEFINE_REF(DescriptorSet)
+
+class PipelineLayout : public Gfx::PipelineLayout {
+  public:
+    PipelineLayout(const std::string& name, Gfx::PPipelineLayout baseLayout);
+    virtual ~PipelineLayout();
+    virtual void create() override;
+};
+DEFINE_REF(PipelineLayout)
+} // namespace Null
+} // namespace Seele
@@ -0,0 +1,290 @@
+#include "Graphics.h"
+#include "Buffer.h"
+#include "Descriptor.h"
+#include "Graphics/slang-compile.h"
+#include "Pipeline.h"
+#include "Query.h"
+#include "Texture.h"
+#include "Window.h"
+
+using namespace Seele;
+using namespace Seele::Null;
+
+Graphics::Graphics() {}
+
+Graphics::~Graphics() {}
+
+void Graphics::init(GraphicsInitializer) {
+    queueMapping = Gfx::QueueFamilyMapping{
+        .graphicsFamily = 0,
+        .computeFamily = 0,
+        .transferFamily = 0,
+    };
+    // take the same code paths as the GPU backends usually do
+    meshShadingEnabled = true;
+    rayTracingEnabled = false;
+}
+
+Gfx::OWindow Graphics::createWindow(const WindowCreateInfo& createInfo) { return new Window(queueMapping, createInfo); }
+
+Gfx::OViewport Graphics::createViewport(Gfx::PWindow owner, const ViewportCreateInfo& createInfo) {
+    return new Viewport(owner, createInfo);
+}
+
+Gfx::ORenderPass Graphics::createRenderPass(Gfx::RenderTargetLayout layout, Array<Gfx::SubPassDependency> dependencies, URect renderArea,
+                                            std::string name, Array<uint32>, Array<uint32>) {
+    return new RenderPass(std::move(layout), std::move(dependencies), renderArea, name);
+}
+
+void Graphics::beginRenderPass(Gfx::PRenderPass) {
+    assert(!renderPassActive);
+    renderPassActive = true;
+    std::unique_lock l(statisticsLock);
+    statistics.numRenderPasses++;
+    executedRenders.clear();
+}
+
+void Graphics::endRenderPass() {
+    assert(renderPassActive);
+    renderPassActive = false;
+}
+
+void Graphics::waitDeviceIdle() {}
+
+void Graphics::executeCommands(Gfx::ORenderCommand commands) {
+    Array<Gfx::ORenderCommand> command;
+    command.add(std::move(commands));
+    executeCommands(std::move(command));
+}
+
+void Graphics::executeCommands(Array<Gfx::ORenderCommand> commands) {
+    std::unique_lock l(statisticsLock);
+    for (auto& command : commands) {
+        auto nullCommand = Gfx::PRenderCommand(command).cast<RenderCommand>();
+        if (!nullCommand->isEnded()) {
+            nullCommand->end();
+        }
+        statistics += nullCommand->getStatistics();
+        executedRenders.add(std::move(command));
+    }
+}
+
+void Graphics::executeCommands(Gfx::OComputeCommand commands) {
+    Array<Gfx::OComputeCommand> command;
+    command.add(std::move(commands));
+    executeCommands(std::move(command));
+}
+
+void Graphics::executeCommands(Array<Gfx::OComputeCommand> commands) {
+    std::unique_lock l(statisticsLock);
+    for (auto& command : commands) {
+        statistics += Gfx::PComputeCommand(command).cast<ComputeCommand>()->getStatistics();
+    }
+}
+
+// nothing runs asynchronously, so every queue is the same one
+bool Graphics::queueHandoff(Gfx::QueueType, Gfx::QueueType) { return false; }
+
+// the contents are only kept in memory, so every format that has a size works
+bool Graphics::supportsSampledFormat(Gfx::SeFormat) const { return true; }
+
+Gfx::OTexture2D Graphics::createTexture2D(const TextureCreateInfo& createInfo) { return new Texture2D(queueMapping, createInfo); }
+
+Gfx::OTexture2DArray Graphics::createTexture2DArray(const TextureCreateInfo& createInfo) {
+    return new Texture2DArray(queueMapping, createInfo);
+}
+
+Gfx::OTexture3D Graphics::createTexture3D(const TextureCreateInfo& createInfo) { return new Texture3D(queueMapping, createInfo); }
+
+Gfx::OTextureCube Graphics::createTextureCube(const TextureCreateInfo& createInfo) { return new TextureCube(queueMapping, createInfo); }
+
+Gfx::OUniformBuffer Graphics::createUniformBuffer(const UniformBufferCreateInfo& bulkData) {
+    return new UniformBuffer(queueMapping, bulkData);
+}
+
+Gfx::OShaderBuffer Graphics::createShaderBuffer(const ShaderBufferCreateInfo& bulkData) { return new ShaderBuffer(queueMapping, bulkData); }
+
+Gfx::OVertexBuffer Graphics::createVertexBuffer(const VertexBufferCreateInfo& bulkData) { return new VertexBuffer(queueMapping, bulkData); }
+
+Gfx::OIndexBuffer Graphics::createIndexBuffer(const IndexBufferCreateInfo& bulkData) { return new IndexBuffer(queueMapping, bulkData); }
+
+Gfx::ORenderCommand Graphics::createRenderCommand(const std::string& name) { return new RenderCommand(name); }
+
+Gfx::OComputeCommand Graphics::createComputeCommand(const std::string& name) { return new ComputeCommand(name); }
+
+void Graphics::beginShaderCompilation(const ShaderCompilationInfo& compileInfo) {
+    // the code is never used, but compiling it fills in the parameter mappings of the pipeline layout
+    beginCompilation(compileInfo, SLANG_SPIRV, compileInfo.rootSignature);
+}
+
+Gfx::OVertexShader Graphics::createVertexShader(const ShaderCreateInfo&) { return new VertexShader(); }
+
+Gfx::OFragmentShader Graphics::createFragmentShader(const ShaderCreateInfo&) { return new FragmentShader(); }
+
+Gfx::OComputeShader Graphics::createComputeShader(const ShaderCreateInfo&) { return new ComputeShader(); }
+
+Gfx::OMeshShader Graphics::createMeshShader(const ShaderCreateInfo&) { return new MeshShader(); }
+
+Gfx::OTaskShader Graphics::createTaskShader(const ShaderCreateInfo&) { return new TaskShader(); }
+
+// everything that legacy and mesh pipelines share
+static void addGraphicsState(PipelineKey& key, Gfx::PPipelineLayout layout, Gfx::PRenderPass renderPass,
+                             const Gfx::MultisampleState& multisample, const Gfx::RasterizationState& rasterization,
+                             const Gfx::DepthStencilState& depthStencil, const Gfx::ColorBlendState& blend) {
+    key.add(layout.getHandle());
+    key.add(renderPass.getHandle());
+    // field by field, the padding at the end is not initialized
+    key.add(multisample.samples);
+    key.add(multisample.sampleShadingEnable);
+    key.add(multisample.minSampleShading);
+    key.add(multisample.alphaCoverageEnable);
+    key.add(multisample.alphaToOneEnable);
+    key.add(rasterization);
+    key.add(depthStencil);
+    key.add(blend.logicOpEnable);
+    key.add(blend.logicOp);
+    key.add(blend.attachmentCount);
+    key.add(blend.blendAttachments.data(), blend.attachmentCount * sizeof(Gfx::ColorBlendState::BlendAttachment));
+    key.add(blend.blendConstants);
+}
+
+template <typename Pipeline, typename Create>
+static RefPtr<Pipeline> findOrCreate(std::unordered_map<PipelineKey, OwningPtr<Pipeline>, PipelineKeyHasher>& pipelines, PipelineKey key,
+                                     Create&& create) {
+    key.finalize();
+    auto it = pipelines.find(key);
+    if (it == pipelines.end()) {
+        it = pipelines.emplace(std::move(key), create()).first;
+    }
+    return it->second;
+}
+
+Gfx::PGraphicsPipeline Graphics::createGraphicsPipeline(Gfx::LegacyPipelineCreateInfo createInfo) {
+    PipelineKey key;
+    key.add(createInfo.topology);
+    key.add(createInfo.vertexInput.getHandle());
+    key.add(createInfo.vertexShader.getHandle());
+    key.add(createInfo.fragmentShader.getHandle());
+    addGraphicsState(key, createInfo.pipelineLayout, createInfo.renderPass, createInfo.multisampleState, createInfo.rasterizationState,
+                     createInfo.depthStencilState, createInfo.colorBlend);
+    std::unique_lock l(pipelineLock);
+    return findOrCreate(graphicsPipelines, std::move(key), [&]() { return new GraphicsPipeline(createInfo.pipelineLayout); });
+}
+
+Gfx::PGraphicsPipeline Graphics::createGraphicsPipeline(Gfx::MeshPipelineCreateInfo createInfo) {
+    PipelineKey key;
+    key.add(createInfo.taskShader.getHandle());
+    key.add(createInfo.meshShader.getHandle());
+    key.add(createInfo.fragmentShader.getHandle());
+    addGraphicsState(key, createInfo.pipelineLayout, createInfo.renderPass, createInfo.multisampleState, createInfo.rasterizationState,
+                     createInfo.depthStencilState, createInfo.colorBlend);
+    std::unique_lock l(pipelineLock);
+    return findOrCreate(graphicsPipelines, std::move(key), [&]() { return new GraphicsPipeline(createInfo.pipelineLayout); });
+}
+
+Gfx::PRayTracingPipeline Graphics::createRayTracingPipeline(Gfx::RayTracingPipelineCreateInfo createInfo) {
+    PipelineKey key;
+    key.add(createInfo.pipelineLayout.getHandle());
+    key.add(createInfo.rayGenGroup.shader.getHandle());
+    key.add(createInfo.rayGenGroup.parameters);
+    key.add(createInfo.hitGroups.size());
+    for (const auto& group : createInfo.hitGroups) {
+        key.add(group.closestHitShader.getHandle());
+        key.add(group.anyHitShader.getHandle());
+        key.add(group.intersectionShader.getHandle());
+        key.add(group.parameters);
+    }
+    key.add(createInfo.missGroups.size());
+    for (const auto& group : createInfo.missGroups) {
+        key.add(group.shader.getHandle());
+        key.add(group.parameters);
+    }
+    key.add(createInfo.callableGroups.size());
+    for (const auto& group : createInfo.callableGroups) {
+        key.add(group.shader.getHandle());
+        key.add(group.parameters);
+    }
+    std::unique_lock l(pipelineLock);
+    return findOrCreate(rayTracingPipelines, std::move(key), [&]() { return new RayTracingPipeline(createInfo.pipelineLayout); });
+}
+
+Gfx::PComputePipeline Graphics::createComputePipeline(Gfx::ComputePipelineCreateInfo createInfo) {
+    PipelineKey key;
+    key.add(createInfo.pipelineLayout.getHandle());
+    key.add(createInfo.computeShader.getHandle());
+    std::unique_lock l(pipelineLock);
+    return findOrCreate(computePipelines, std::move(key), [&]() { return new ComputePipeline(createInfo.pipelineLayout); });
+}
+
+Gfx::OSampler Graphics::createSampler(const SamplerCreateInfo& createInfo) { return new Gfx::Sampler(createInfo); }
+
+Gfx::ODescriptorLayout Graphics::createDescriptorLayout(const std::string& name) { return new DescriptorLayout(name); }
+
+Gfx::OPipelineLayout Graphics::createPipelineLayout(const std::string& name, Gfx::PPipelineLayout baseLayout) {
+    return new PipelineLayout(name, baseLayout);
+}
+
+Gfx::OVertexInput Graphics::createVertexInput(VertexInputStateCreateInfo createInfo) { return new Gfx::VertexInput(createInfo); }
+
+Gfx::OOcclusionQuery Graphics::createOcclusionQuery(const std::string& name) { return new OcclusionQuery(this, name); }
+
+Gfx::OPipelineStatisticsQuery Graphics::createPipelineStatisticsQuery(const std::string& name) {
+    return new PipelineStatisticsQuery(this, name);
+}
+
+Gfx::OTimestampQuery Graphics::createTimestampQuery(uint64, const std::string&) { return new TimestampQuery(this); }
+
+void Graphics::beginDebugRegion(const std::string&) {}
+
+void Graphics::endDebugRegion() {}
+
+void Graphics::resolveTexture(Gfx::PTexture source, Gfx::PTexture destination) { copyTexture(source, destination); }
+
+void Graphics::copyTexture(Gfx::PTexture src, Gfx::PTexture dst) {
+    PTextureBase srcBase = src.cast<TextureBase>();
+    PTextureBase dstBase = dst.cast<TextureBase>();
+    dstBase->copyFrom(srcBase);
+}
+
+void Graphics::copyBuffer(Gfx::PShaderBuffer src, Gfx::PShaderBuffer dst) {
+    PShaderBuffer srcBuffer = src.cast<ShaderBuffer>();
+    PShaderBuffer dstBuffer = dst.cast<ShaderBuffer>();
+    dstBuffer->updateContents(0, std::min(srcBuffer->getSize(), dstBuffer->getSize()), const_cast<uint8*>(srcBuffer->getContents()));
+}
+
+Gfx::OBottomLevelAS Graphics::createBottomLevelAccelerationStructure(const Gfx::BottomLevelASCreateInfo&) { return new BottomLevelAS(); }
+
+Gfx::OTopLevelAS Graphics::createTopLevelAccelerationStructure(const Gfx::TopLevelASCreateInfo&) { return new TopLevelAS(); }
+
+void Graphics::buildBottomLevelAccelerationStructures(Array<Gfx::PBottomLevelAS>) {}
+
+Gfx::ORayGenShader Graphics::createRayGenShader(const ShaderCreateInfo&) { return new RayGenShader(); }
+
+Gfx::OAnyHitShader Graphics::createAnyHitShader(const ShaderCreateInfo&) { return new AnyHitShader(); }
+
+Gfx::OClosestHitShader Graphics::createClosestHitShader(const ShaderCreateInfo&) { return new ClosestHitShader(); }
+
+Gfx::OMissShader Graphics::createMissShader(const ShaderCreateInfo&) { return new MissShader(); }
+
+Gfx::OIntersectionShader Graphics::createIntersectionShader(const ShaderCreateInfo&) { return new IntersectionShader(); }
+
+Gfx::OCallableShader Graphics::createCallableShader(const ShaderCreateInfo&) { return new CallableShader(); }
+
+CommandStatistics Graphics::getStatistics() {
+    std::unique_lock l(statisticsLock);
+    return statistics;
+}
+
+void Graphics::resetStatistics() {
+    std::unique_lock l(statisticsLock);
+    statistics = CommandStatistics();
+}
+
+Array<PRenderCommand> Graphics::getExecutedRenderCommands() {
+    std::unique_lock l(statisticsLock);
+    Array<PRenderCommand> result;
+    for (const auto& command : executedRenders) {
+        result.add(Gfx::PRenderCommand(command).cast<RenderCommand>());
+    }
+    return result;
+}
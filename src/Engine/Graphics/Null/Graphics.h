@@ -0,0 +1,107 @@
+#pragma once
+#include "Graphics/Graphics.h"
+#include "Graphics/Null/Command.h"
+#include "Graphics/Null/Pipeline.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace Seele {
+namespace Null {
+// Headless backend that keeps all resources in host memory and only counts the recorded commands,
+// so everything up to the submission of a frame can be run and profiled without a GPU
+class Graphics : public Gfx::Graphics {
+  public:
+    Graphics();
+    virtual ~Graphics();
+    virtual void init(GraphicsInitializer initializer) override;
+
+    virtual Gfx::OWindow createWindow(const WindowCreateInfo& createInfo) override;
+    virtual Gfx::OViewport createViewport(Gfx::PWindow owner, const ViewportCreateInfo& createInfo) override;
+
+    virtual Gfx::ORenderPass createRenderPass(Gfx::RenderTargetLayout layout, Array<Gfx::SubPassDependency> dependencies, URect renderArea,
+                                              std::string name = "", Array<uint32> viewMasks = {0},
+                                              Array<uint32> correlationMasks = {}) override;
+    virtual void beginRenderPass(Gfx::PRenderPass renderPass) override;
+    virtual void endRenderPass() override;
+    virtual void waitDeviceIdle() override;
+
+    virtual void executeCommands(Gfx::ORenderCommand commands) override;
+    virtual void executeCommands(Array<Gfx::ORenderCommand> commands) override;
+    virtual void executeCommands(Gfx::OComputeCommand commands) override;
+    virtual void executeCommands(Array<Gfx::OComputeCommand> commands) override;
+    virtual bool queueHandoff(Gfx::QueueType from, Gfx::QueueType to) override;
+
+    virtual bool supportsSampledFormat(Gfx::SeFormat format) const override;
+    virtual Gfx::OTexture2D createTexture2D(const TextureCreateInfo& createInfo) override;
+    virtual Gfx::OTexture2DArray createTexture2DArray(const TextureCreateInfo& createInfo) override;
+    virtual Gfx::OTexture3D createTexture3D(const TextureCreateInfo& createInfo) override;
+    virtual Gfx::OTextureCube createTextureCube(const TextureCreateInfo& createInfo) override;
+    virtual Gfx::OUniformBuffer createUniformBuffer(const UniformBufferCreateInfo& bulkData) override;
+    virtual Gfx::OShaderBuffer createShaderBuffer(const ShaderBufferCreateInfo& bulkData) override;
+    virtual Gfx::OVertexBuffer createVertexBuffer(const VertexBufferCreateInfo& bulkData) override;
+    virtual Gfx::OIndexBuffer createIndexBuffer(const IndexBufferCreateInfo& bulkData) override;
+
+    virtual Gfx::ORenderCommand createRenderCommand(const std::string& name = "") override;
+    virtual Gfx::OComputeCommand createComputeCommand(const std::string& name = "") override;
+
+    virtual void beginShaderCompilation(const ShaderCompilationInfo& compileInfo) override;
+    virtual Gfx::OVertexShader createVertexShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OFragmentShader createFragmentShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OComputeShader createComputeShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OMeshShader createMeshShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OTaskShader createTaskShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::PGraphicsPipeline createGraphicsPipeline(Gfx::LegacyPipelineCreateInfo createInfo) override;
+    virtual Gfx::PGraphicsPipeline createGraphicsPipeline(Gfx::MeshPipelineCreateInfo createInfo) override;
+    virtual Gfx::PRayTracingPipeline createRayTracingPipeline(Gfx::RayTracingPipelineCreateInfo createInfo) override;
+    virtual Gfx::PComputePipeline createComputePipeline(Gfx::ComputePipelineCreateInfo createInfo) override;
+    virtual Gfx::OSampler createSampler(const SamplerCreateInfo& createInfo) override;
+
+    virtual Gfx::ODescriptorLayout createDescriptorLayout(const std::string& name = "") override;
+    virtual Gfx::OPipelineLayout createPipelineLayout(const std::string& name = "", Gfx::PPipelineLayout baseLayout = nullptr) override;
+
+    virtual Gfx::OVertexInput createVertexInput(VertexInputStateCreateInfo createInfo) override;
+
+    virtual Gfx::OOcclusionQuery createOcclusionQuery(const std::string& name = "") override;
+    virtual Gfx::OPipelineStatisticsQuery createPipelineStatisticsQuery(const std::string& name = "") override;
+    virtual Gfx::OTimestampQuery createTimestampQuery(uint64 numTimestamps, const std::string& name = "") override;
+
+    virtual void beginDebugRegion(const std::string& name) override;
+    virtual void endDebugRegion() override;
+
+    virtual void resolveTexture(Gfx::PTexture source, Gfx::PTexture destination) override;
+    virtual void copyTexture(Gfx::PTexture src, Gfx::PTexture dst) override;
+
+    virtual void copyBuffer(Gfx::PShaderBuffer src, Gfx::PShaderBuffer dst) override;
+
+    // Ray Tracing
+    virtual Gfx::OBottomLevelAS createBottomLevelAccelerationStructure(const Gfx::BottomLevelASCreateInfo& createInfo) override;
+    virtual Gfx::OTopLevelAS createTopLevelAccelerationStructure(const Gfx::TopLevelASCreateInfo& createInfo) override;
+    virtual void buildBottomLevelAccelerationStructures(Array<Gfx::PBottomLevelAS> data) override;
+
+    virtual Gfx::ORayGenShader createRayGenShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OAnyHitShader createAnyHitShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OClosestHitShader createClosestHitShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OMissShader createMissShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OIntersectionShader createIntersectionShader(const ShaderCreateInfo& createInfo) override;
+    virtual Gfx::OCallableShader createCallableShader(const ShaderCreateInfo& createInfo) override;
+
+    // sum of all commands executed since the last reset
+    CommandStatistics getStatistics();
+    void resetStatistics();
+    // render commands executed since the last beginRenderPass, in the order a primary command would execute them
+    Array<PRenderCommand> getExecutedRenderCommands();
+
+  private:
+    std::mutex statisticsLock;
+    CommandStatistics statistics;
+    Array<Gfx::ORenderCommand> executedRenders;
+    // pipelines are owned by the backend and created once per distinct create info, the same as the caches of the other backends
+    std::mutex pipelineLock;
+    std::unordered_map<PipelineKey, Gfx::OGraphicsPipeline, PipelineKeyHasher> graphicsPipelines;
+    std::unordered_map<PipelineKey, Gfx::OComputePipeline, PipelineKeyHasher> computePipelines;
+    std::unordered_map<PipelineKey, Gfx::ORayTracingPipeline, PipelineKeyHasher> rayTracingPipelines;
+    bool renderPassActive = false;
+};
+DEFINE_REF(Graphics)
+} // namespace Null
+} // namespace Seele
@@ -0,0 +1,43 @@
+#include "Pipeline.h"
+#include "CRC.h"
+#include <cstring>
+
+using namespace Seele;
+using namespace Seele::Null;
+
+void PipelineKey::add(const void* bytes, uint64 size) {
+    uint64 offset = data.size();
+    data.resize(offset + size);
+    std::memcpy(data.data() + offset, bytes, size);
+}
+
+void PipelineKey::finalize() {
+    static const CRC::Table<uint64, 64> table(CRC::CRC_64());
+    hash = CRC::Calculate(data.data(), data.size(), table);
+}
+
+GraphicsPipeline::GraphicsPipeline(Gfx::PPipelineLayout layout) : Gfx::GraphicsPipeline(layout) {}
+
+GraphicsPipeline::~GraphicsPipeline() {}
+
+ComputePipeline::ComputePipeline(Gfx::PPipelineLayout layout) : Gfx::ComputePipeline(layout) {}
+
+ComputePipeline::~ComputePipeline() {}
+
+RayTracingPipeline::RayTracingPipeline(Gfx::PPipelineLayout layout) : Gfx::RayTracingPipeline(layout) {}
+
+RayTracingPipeline::~RayTracingPipeline() {}
+
+BottomLevelAS::BottomLevelAS() {}
+
+BottomLevelAS::~BottomLevelAS() {}
+
+TopLevelAS::TopLevelAS() {}
+
+TopLevelAS::~TopLevelAS() {}
+
+RenderPass::RenderPass(Gfx::RenderTargetLayout layout, Array<Gfx::SubPassDependency> dependencies, URect renderArea,
+                       const std::string& name)
+    : Gfx::RenderPass(std::move(layout), std::move(dependencies)), renderArea(renderArea), name(name) {}
+
+RenderPass::~RenderPass() {}
@@ -0,0 +1,107 @@
+#pragma once
+#include "Graphics/Pipeline.h"
+#include "Graphics/RayTracing.h"
+#include "Graphics/RenderTarget.h"
+#include "Graphics/Shader.h"
+
+namespace Seele {
+namespace Null {
+// Description of everything that goes into a pipeline, the same as the key of the Vulkan pipeline cache
+// shaders have no code here, so they are identified by their object, which lives at least as long as the pipelines using it
+class PipelineKey {
+  public:
+    template <typename T> void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(&value, sizeof(T));
+    }
+    void add(const Array<uint8>& values) {
+        add(values.size());
+        add(values.data(), values.size());
+    }
+    void add(const void* data, uint64 size);
+    // has to be called once all state is added
+    void finalize();
+    constexpr uint64 getHash() const { return hash; }
+    friend bool operator==(const PipelineKey& lhs, const PipelineKey& rhs) { return lhs.hash == rhs.hash && lhs.data == rhs.data; }
+
+  private:
+    Array<uint8> data;
+    uint64 hash = 0;
+};
+struct PipelineKeyHasher {
+    size_t operator()(const PipelineKey& key) const { return key.getHash(); }
+};
+
+class GraphicsPipeline : public Gfx::GraphicsPipeline {
+  public:
+    GraphicsPipeline(Gfx::PPipelineLayout layout);
+    virtual ~GraphicsPipeline();
+};
+DEFINE_REF(GraphicsPipeline)
+
+class ComputePipeline : public Gfx::ComputePipeline {
+  public:
+    ComputePipeline(Gfx::PPipelineLayout layout);
+    virtual ~ComputePipeline();
+};
+DEFINE_REF(ComputePipeline)
+
+class RayTracingPipeline : public Gfx::RayTracingPipeline {
+  public:
+    RayTracingPipeline(Gfx::PPipelineLayout layout);
+    virtual ~RayTracingPipeline();
+};
+DEFINE_REF(RayTracingPipeline)
+
+class BottomLevelAS : public Gfx::BottomLevelAS {
+  public:
+    BottomLevelAS();
+    virtual ~BottomLevelAS();
+};
+DEFINE_REF(BottomLevelAS)
+
+class TopLevelAS : public Gfx::TopLevelAS {
+  public:
+    TopLevelAS();
+    virtual ~TopLevelAS();
+};
+DEFINE_REF(TopLevelAS)
+
+class RenderPass : public Gfx::RenderPass {
+  public:
+    RenderPass(Gfx::RenderTargetLayout layout, Array<Gfx::SubPassDependency> dependencies, URect renderArea, const std::string& name);
+    virtual ~RenderPass();
+    constexpr URect getRenderArea() const { return renderArea; }
+    constexpr const std::string& getName() const { return name; }
+
+  private:
+    URect renderArea;
+    std::string name;
+};
+DEFINE_REF(RenderPass)
+
+// shaders only need to exist, their code is never run
+class VertexShader : public Gfx::VertexShader {};
+DEFINE_REF(VertexShader)
+class FragmentShader : public Gfx::FragmentShader {};
+DEFINE_REF(FragmentShader)
+class ComputeShader : public Gfx::ComputeShader {};
+DEFINE_REF(ComputeShader)
+class TaskShader : public Gfx::TaskShader {};
+DEFINE_REF(TaskShader)
+class MeshShader : public Gfx::MeshShader {};
+DEFINE_REF(MeshShader)
+class RayGenShader : public Gfx::RayGenShader {};
+DEFINE_REF(RayGenShader)
+class AnyHitShader : public Gfx::AnyHitShader {};
+DEFINE_REF(AnyHitShader)
+class ClosestHitShader : public Gfx::ClosestHitShader {};
+DEFINE_REF(ClosestHitShader)
+class MissShader : public Gfx::MissShader {};
+DEFINE_REF(MissShader)
+class IntersectionShader : public Gfx::IntersectionShader {};
+DEFINE_REF(IntersectionShader)
+class CallableShader : public Gfx::CallableShader {};
+DEFINE_REF(CallableShader)
+} // namespace Null
+} // namespace Seele
@@ -0,0 +1,53 @@
+#include "Query.h"
+
+using namespace Seele;
+using namespace Seele::Null;
+
+OcclusionQuery::OcclusionQuery(Gfx::PGraphics graphics, const std::string& name) : graphics(graphics), name(name) {}
+
+OcclusionQuery::~OcclusionQuery() {}
+
+void OcclusionQuery::beginQuery() {}
+
+void OcclusionQuery::endQuery() {
+    uint64 frameNumber = Gfx::getCurrentFrameNumber();
+    graphics->getFrameStatsRing().expect(frameNumber);
+    graphics->getFrameStatsRing().resolveOcclusion(frameNumber, name,
+                                                   Gfx::OcclusionResult{
+                                                       .numFragments = 0,
+                                                   });
+}
+
+PipelineStatisticsQuery::PipelineStatisticsQuery(Gfx::PGraphics graphics, const std::string& name) : graphics(graphics), name(name) {}
+
+PipelineStatisticsQuery::~PipelineStatisticsQuery() {}
+
+void PipelineStatisticsQuery::beginQuery() {}
+
+void PipelineStatisticsQuery::endQuery() {
+    uint64 frameNumber = Gfx::getCurrentFrameNumber();
+    graphics->getFrameStatsRing().expect(frameNumber);
+    graphics->getFrameStatsRing().resolvePipelineStatistics(frameNumber, name,
+                                                            Gfx::PipelineStatisticsResult{
+                                                                .inputAssemblyVertices = 0,
+                                                                .inputAssemblyPrimitives = 0,
+                                                                .vertexShaderInvocations = 0,
+                                                                .clippingInvocations = 0,
+                                                                .clippingPrimitives = 0,
+                                                                .fragmentShaderInvocations = 0,
+                                                                .computeShaderInvocations = 0,
+                                                                .taskShaderInvocations = 0,
+                                                                .meshShaderInvocations = 0,
+                                                            });
+}
+
+TimestampQuery::TimestampQuery(Gfx::PGraphics graphics) : graphics(graphics) {}
+
+TimestampQuery::~TimestampQuery() {}
+
+void TimestampQuery::write(Gfx::SePipelineStageFlagBits, const std::string& name) {
+    uint64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64 frameNumber = Gfx::getCurrentFrameNumber();
+    graphics->getFrameStatsRing().expect(frameNumber);
+    graphics->getFrameStatsRing().resolveTimestamp(frameNumber, name, now);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Graphics/Graphics.h"
+#include "Graphics/Query.h"
+
+namespace Seele {
+namespace Null {
+// nothing runs on a GPU, so every query is resolved into the frame stats as soon as it ends
+// nothing is rasterized either, so there is nothing to count
+class OcclusionQuery : public Gfx::OcclusionQuery {
+  public:
+    OcclusionQuery(Gfx::PGraphics graphics, const std::string& name);
+    virtual ~OcclusionQuery();
+    virtual void beginQuery() override;
+    virtual void endQuery() override;
+
+  private:
+    Gfx::PGraphics graphics;
+    std::string name;
+};
+DEFINE_REF(OcclusionQuery)
+
+class PipelineStatisticsQuery : public Gfx::PipelineStatisticsQuery {
+  public:
+    PipelineStatisticsQuery(Gfx::PGraphics graphics, const std::string& name);
+    virtual ~PipelineStatisticsQuery();
+    virtual void beginQuery() override;
+    virtual void endQuery() override;
+
+  private:
+    Gfx::PGraphics graphics;
+    std::string name;
+};
+DEFINE_REF(PipelineStatisticsQuery)
+
+// timestamps are taken on the CPU when they are written
+class TimestampQuery : public Gfx::TimestampQuery {
+  public:
+    TimestampQuery(Gfx::PGraphics graphics);
+    virtual ~TimestampQuery();
+    virtual void write(Gfx::SePipelineStageFlagBits stage, const std::string& name = "") override;
+
+  private:
+    Gfx::PGraphics graphics;
+};
+DEFINE_REF(TimestampQuery)
+} // namespace Null
+} // namespace Seele
@@ -0,0 +1,196 @@
+#include "Texture.h"
+#include <cmath>
+#include <cstring>
+
+using namespace Seele;
+using namespace Seele::Null;
+
+TextureView::TextureView(PTextureBase source, uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount)
+    : source(source), baseMipLevel(baseMipLevel), levelCount(levelCount), baseArrayLayer(baseArrayLayer), layerCount(layerCount) {}
+
+TextureView::~TextureView() {}
+
+Gfx::SeFormat TextureView::getFormat() const { return source->getFormat(); }
+
+uint32 TextureView::getWidth() const { return std::max(source->getWidth() >> baseMipLevel, 1u); }
+
+uint32 TextureView::getHeight() const { return std::max(source->getHeight() >> baseMipLevel, 1u); }
+
+uint32 TextureView::getDepth() const { return std::max(source->getDepth() >> baseMipLevel, 1u); }
+
+uint32 TextureView::getNumLayers() const { return layerCount; }
+
+Gfx::SeSampleCountFlags TextureView::getNumSamples() const { return source->getNumSamples(); }
+
+uint32 TextureView::getMipLevels() const { return levelCount; }
+
+void TextureView::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags,
+                               Gfx::SePipelineStageFlags) {
+    source->changeLayout(newLayout);
+}
+
+void TextureView::pipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+void TextureView::transferOwnership(Gfx::QueueType) {}
+
+TextureBase::TextureBase(const TextureCreateInfo& createInfo, bool isCube)
+    : format(createInfo.format), width(createInfo.width), height(createInfo.height), depth(createInfo.depth),
+      layerCount(createInfo.elements), mipLevels(1), samples(createInfo.samples), facesPerLayer(isCube ? 6 : 1) {
+    if (!createInfo.mipOffsets.empty()) {
+        mipLevels = static_cast<uint32>(createInfo.mipOffsets.size());
+    } else if (createInfo.useMip) {
+        mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+    }
+    layerCount *= facesPerLayer;
+    contents.resize(mipLevels);
+    for (uint32 i = 0; i < mipLevels; ++i) {
+        contents[i].resize(getLayerSize(i) * layerCount);
+    }
+    if (createInfo.sourceData.data != nullptr) {
+        Array<uint64> levelOffsets = createInfo.mipOffsets.empty() ? Array<uint64>{0} : createInfo.mipOffsets;
+        for (uint32 i = 0; i < levelOffsets.size(); ++i) {
+            uint64 available = createInfo.sourceData.size - std::min(levelOffsets[i], createInfo.sourceData.size);
+            std::memcpy(contents[i].data(), createInfo.sourceData.data + levelOffsets[i],
+                        std::min<uint64>(available, contents[i].size()));
+        }
+    }
+    defaultView = new TextureView(this, 0, mipLevels, 0, layerCount);
+}
+
+TextureBase::~TextureBase() {}
+
+uint64 TextureBase::getLayerSize(uint32 mipLevel) const {
+    Gfx::FormatCompatibilityInfo formatInfo = Gfx::getFormatInfo(format);
+    uint64 mipWidth = std::max(width >> mipLevel, 1u);
+    uint64 mipHeight = std::max(height >> mipLevel, 1u);
+    uint64 mipDepth = std::max(depth >> mipLevel, 1u);
+    uint64 blocksX = (mipWidth + formatInfo.blockExtent.x - 1) / formatInfo.blockExtent.x;
+    uint64 blocksY = (mipHeight + formatInfo.blockExtent.y - 1) / formatInfo.blockExtent.y;
+    uint64 blocksZ = (mipDepth + formatInfo.blockExtent.z - 1) / formatInfo.blockExtent.z;
+    return blocksX * blocksY * blocksZ * formatInfo.blockSize * samples;
+}
+
+void TextureBase::changeLayout(Gfx::SeImageLayout newLayout) { layout = newLayout; }
+
+void TextureBase::download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) {
+    assert(mipLevel < mipLevels);
+    uint32 layer = arrayLayer * facesPerLayer + face;
+    assert(layer < layerCount);
+    uint64 layerSize = getLayerSize(mipLevel);
+    buffer.resize(layerSize);
+    std::memcpy(buffer.data(), contents[mipLevel].data() + layer * layerSize, layerSize);
+}
+
+void TextureBase::copyFrom(PTextureBase other) {
+    for (uint32 i = 0; i < std::min(mipLevels, other->mipLevels); ++i) {
+        std::memcpy(contents[i].data(), other->contents[i].data(), std::min(contents[i].size(), other->contents[i].size()));
+    }
+}
+
+Gfx::OTextureView TextureBase::createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 numLayers) {
+    return new TextureView(this, baseMipLevel, levelCount, baseArrayLayer, numLayers);
+}
+
+Texture2D::Texture2D(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo)
+    : Gfx::Texture2D(mapping), TextureBase(createInfo, false) {}
+
+Texture2D::~Texture2D() {}
+
+void Texture2D::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags,
+                             Gfx::SePipelineStageFlags) {
+    TextureBase::changeLayout(newLayout);
+}
+
+void Texture2D::download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) {
+    TextureBase::download(mipLevel, arrayLayer, face, buffer);
+}
+
+void Texture2D::generateMipmaps() {}
+
+Gfx::PTextureView Texture2D::getDefaultView() const { return PTextureView(defaultView); }
+
+Gfx::OTextureView Texture2D::createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) {
+    return TextureBase::createTextureView(baseMipLevel, levelCount, baseArrayLayer, layerCount);
+}
+
+void Texture2D::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void Texture2D::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+Texture2DArray::Texture2DArray(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo)
+    : Gfx::Texture2DArray(mapping), TextureBase(createInfo, false) {}
+
+Texture2DArray::~Texture2DArray() {}
+
+void Texture2DArray::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags,
+                                  Gfx::SePipelineStageFlags) {
+    TextureBase::changeLayout(newLayout);
+}
+
+void Texture2DArray::download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) {
+    TextureBase::download(mipLevel, arrayLayer, face, buffer);
+}
+
+void Texture2DArray::generateMipmaps() {}
+
+Gfx::PTextureView Texture2DArray::getDefaultView() const { return PTextureView(defaultView); }
+
+Gfx::OTextureView Texture2DArray::createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) {
+    return TextureBase::createTextureView(baseMipLevel, levelCount, baseArrayLayer, layerCount);
+}
+
+void Texture2DArray::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void Texture2DArray::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+Texture3D::Texture3D(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo)
+    : Gfx::Texture3D(mapping), TextureBase(createInfo, false) {}
+
+Texture3D::~Texture3D() {}
+
+void Texture3D::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags,
+                             Gfx::SePipelineStageFlags) {
+    TextureBase::changeLayout(newLayout);
+}
+
+void Texture3D::download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) {
+    TextureBase::download(mipLevel, arrayLayer, face, buffer);
+}
+
+void Texture3D::generateMipmaps() {}
+
+Gfx::PTextureView Texture3D::getDefaultView() const { return PTextureView(defaultView); }
+
+Gfx::OTextureView Texture3D::createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) {
+    return TextureBase::createTextureView(baseMipLevel, levelCount, baseArrayLayer, layerCount);
+}
+
+void Texture3D::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void Texture3D::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
+
+TextureCube::TextureCube(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo)
+    : Gfx::TextureCube(mapping), TextureBase(createInfo, true) {}
+
+TextureCube::~TextureCube() {}
+
+void TextureCube::changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags,
+                               Gfx::SePipelineStageFlags) {
+    TextureBase::changeLayout(newLayout);
+}
+
+void TextureCube::download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) {
+    TextureBase::download(mipLevel, arrayLayer, face, buffer);
+}
+
+void TextureCube::generateMipmaps() {}
+
+Gfx::PTextureView TextureCube::getDefaultView() const { return PTextureView(defaultView); }
+
+Gfx::OTextureView TextureCube::createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) {
+    return TextureBase::createTextureView(baseMipLevel, levelCount, baseArrayLayer, layerCount);
+}
+
+void TextureCube::executeOwnershipBarrier(Gfx::QueueType) {}
+
+void TextureCube::executePipelineBarrier(Gfx::SeAccessFlags, Gfx::SePipelineStageFlags, Gfx::SeAccessFlags, Gfx::SePipelineStageFlags) {}
@@ -0,0 +1,178 @@
+#pragma once
+#include "Graphics/Initializer.h"
+#include "Graphics/Texture.h"
+
+namespace Seele {
+namespace Null {
+DECLARE_REF(TextureBase)
+class TextureView : public Gfx::TextureView {
+  public:
+    TextureView(PTextureBase source, uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount);
+    virtual ~TextureView();
+    virtual Gfx::SeFormat getFormat() const override;
+    virtual uint32 getWidth() const override;
+    virtual uint32 getHeight() const override;
+    virtual uint32 getDepth() const override;
+    virtual uint32 getNumLayers() const override;
+    virtual Gfx::SeSampleCountFlags getNumSamples() const override;
+    virtual uint32 getMipLevels() const override;
+    virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
+                              Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void pipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                 Gfx::SePipelineStageFlags dstStage) override;
+    virtual void transferOwnership(Gfx::QueueType newOwner) override;
+    PTextureBase getSource() const { return source; }
+    constexpr uint32 getBaseMipLevel() const { return baseMipLevel; }
+    constexpr uint32 getBaseArrayLayer() const { return baseArrayLayer; }
+
+  private:
+    PTextureBase source;
+    uint32 baseMipLevel;
+    uint32 levelCount;
+    uint32 baseArrayLayer;
+    uint32 layerCount;
+};
+DEFINE_REF(TextureView)
+
+// host memory backing of all texture types, every mip level stores all of its layers back to back
+class TextureBase {
+  public:
+    TextureBase(const TextureCreateInfo& createInfo, bool isCube);
+    virtual ~TextureBase();
+    constexpr Gfx::SeFormat getFormat() const { return format; }
+    constexpr uint32 getWidth() const { return width; }
+    constexpr uint32 getHeight() const { return height; }
+    constexpr uint32 getDepth() const { return depth; }
+    constexpr uint32 getNumLayers() const { return layerCount; }
+    constexpr Gfx::SeSampleCountFlags getNumSamples() const { return samples; }
+    constexpr uint32 getMipLevels() const { return mipLevels; }
+    constexpr Gfx::SeImageLayout getLayout() const { return layout; }
+    const Array<uint8>& getContents(uint32 mipLevel) const { return contents[mipLevel]; }
+    // size in bytes of a single layer of mipLevel
+    uint64 getLayerSize(uint32 mipLevel) const;
+
+    void changeLayout(Gfx::SeImageLayout newLayout);
+    void download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer);
+    void copyFrom(PTextureBase other);
+    Gfx::OTextureView createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount);
+
+  protected:
+    Array<Array<uint8>> contents;
+    OTextureView defaultView;
+    Gfx::SeFormat format;
+    uint32 width;
+    uint32 height;
+    uint32 depth;
+    uint32 layerCount;
+    uint32 mipLevels;
+    uint32 samples;
+    uint32 facesPerLayer;
+    Gfx::SeImageLayout layout = Gfx::SE_IMAGE_LAYOUT_UNDEFINED;
+};
+DEFINE_REF(TextureBase)
+
+class Texture2D : public Gfx::Texture2D, public TextureBase {
+  public:
+    Texture2D(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo);
+    virtual ~Texture2D();
+    virtual Gfx::SeFormat getFormat() const override { return format; }
+    virtual uint32 getWidth() const override { return width; }
+    virtual uint32 getHeight() const override { return height; }
+    virtual uint32 getDepth() const override { return depth; }
+    virtual uint32 getNumLayers() const override { return layerCount; }
+    virtual Gfx::SeSampleCountFlags getNumSamples() const override { return samples; }
+    virtual uint32 getMipLevels() const override { return mipLevels; }
+    virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
+                              Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) override;
+    virtual void generateMipmaps() override;
+    virtual Gfx::PTextureView getDefaultView() const override;
+    virtual Gfx::OTextureView createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(Texture2D)
+
+class Texture2DArray : public Gfx::Texture2DArray, public TextureBase {
+  public:
+    Texture2DArray(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo);
+    virtual ~Texture2DArray();
+    virtual Gfx::SeFormat getFormat() const override { return format; }
+    virtual uint32 getWidth() const override { return width; }
+    virtual uint32 getHeight() const override { return height; }
+    virtual uint32 getDepth() const override { return depth; }
+    virtual uint32 getNumLayers() const override { return layerCount; }
+    virtual Gfx::SeSampleCountFlags getNumSamples() const override { return samples; }
+    virtual uint32 getMipLevels() const override { return mipLevels; }
+    virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
+                              Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) override;
+    virtual void generateMipmaps() override;
+    virtual Gfx::PTextureView getDefaultView() const override;
+    virtual Gfx::OTextureView createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(Texture2DArray)
+
+class Texture3D : public Gfx::Texture3D, public TextureBase {
+  public:
+    Texture3D(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo);
+    virtual ~Texture3D();
+    virtual Gfx::SeFormat getFormat() const override { return format; }
+    virtual uint32 getWidth() const override { return width; }
+    virtual uint32 getHeight() const override { return height; }
+    virtual uint32 getDepth() const override { return depth; }
+    virtual uint32 getNumLayers() const override { return layerCount; }
+    virtual Gfx::SeSampleCountFlags getNumSamples() const override { return samples; }
+    virtual uint32 getMipLevels() const override { return mipLevels; }
+    virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
+                              Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) override;
+    virtual void generateMipmaps() override;
+    virtual Gfx::PTextureView getDefaultView() const override;
+    virtual Gfx::OTextureView createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(Texture3D)
+
+class TextureCube : public Gfx::TextureCube, public TextureBase {
+  public:
+    TextureCube(Gfx::QueueFamilyMapping mapping, const TextureCreateInfo& createInfo);
+    virtual ~TextureCube();
+    virtual Gfx::SeFormat getFormat() const override { return format; }
+    virtual uint32 getWidth() const override { return width; }
+    virtual uint32 getHeight() const override { return height; }
+    virtual uint32 getDepth() const override { return depth; }
+    virtual uint32 getNumLayers() const override { return layerCount; }
+    virtual Gfx::SeSampleCountFlags getNumSamples() const override { return samples; }
+    virtual uint32 getMipLevels() const override { return mipLevels; }
+    virtual void changeLayout(Gfx::SeImageLayout newLayout, Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage,
+                              Gfx::SeAccessFlags dstAccess, Gfx::SePipelineStageFlags dstStage) override;
+    virtual void download(uint32 mipLevel, uint32 arrayLayer, uint32 face, Array<uint8>& buffer) override;
+    virtual void generateMipmaps() override;
+    virtual Gfx::PTextureView getDefaultView() const override;
+    virtual Gfx::OTextureView createTextureView(uint32 baseMipLevel, uint32 levelCount, uint32 baseArrayLayer, uint32 layerCount) override;
+
+  protected:
+    // Inherited via QueueOwnedResource
+    virtual void executeOwnershipBarrier(Gfx::QueueType newOwner) override;
+    virtual void executePipelineBarrier(Gfx::SeAccessFlags srcAccess, Gfx::SePipelineStageFlags srcStage, Gfx::SeAccessFlags dstAccess,
+                                        Gfx::SePipelineStageFlags dstStage) override;
+};
+DEFINE_REF(TextureCube)
+} // namespace Null
+} // namespace Seele
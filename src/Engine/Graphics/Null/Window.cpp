@@ -0,0 +1,69 @@
+#include "Window.h"
+
+using namespace Seele;
+using namespace Seele::Null;
+
+Window::Window(Gfx::QueueFamilyMapping mapping, const WindowCreateInfo& createInfo) : lastFrame(std::chrono::steady_clock::now()) {
+    framebufferFormat = createInfo.preferredFormat;
+    framebufferWidth = createInfo.width;
+    framebufferHeight = createInfo.height;
+    contentScaleX = 1.0f;
+    contentScaleY = 1.0f;
+    backBuffer = new Texture2D(mapping, TextureCreateInfo{
+                                            .format = framebufferFormat,
+                                            .width = framebufferWidth,
+                                            .height = framebufferHeight,
+                                            .usage = Gfx::SE_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | Gfx::SE_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                            .name = "NullBackBuffer",
+                                        });
+}
+
+Window::~Window() {}
+
+void Window::show() {}
+
+void Window::pollInput() {}
+
+void Window::beginFrame() {
+    auto now = std::chrono::steady_clock::now();
+    updateFrameTime(std::chrono::duration<double>(now - lastFrame).count());
+    lastFrame = now;
+}
+
+void Window::endFrame() { setCurrentFrameIndex((Gfx::getCurrentFrameIndex() + 1) % Gfx::numFramesBuffered); }
+
+Gfx::PTexture2D Window::getBackBuffer() const { return PTexture2D(backBuffer); }
+
+void Window::onWindowCloseEvent() {
+    if (closeCallback) {
+        closeCallback();
+    }
+}
+
+void Window::setKeyCallback(std::function<void(KeyCode, InputAction, KeyModifier)> callback) { keyCallback = callback; }
+
+void Window::setMouseMoveCallback(std::function<void(double, double)> callback) { mouseMoveCallback = callback; }
+
+void Window::setMouseButtonCallback(std::function<void(MouseButton, InputAction, KeyModifier)> callback) { mouseButtonCallback = callback; }
+
+void Window::setScrollCallback(std::function<void(double, double)> callback) { scrollCallback = callback; }
+
+void Window::setFileCallback(std::function<void(int, const char**)> callback) { fileCallback = callback; }
+
+void Window::setCloseCallback(std::function<void()> callback) { closeCallback = callback; }
+
+void Window::setResizeCallback(std::function<void(uint32, uint32)> callback) { resizeCallback = callback; }
+
+Viewport::Viewport(PWindow owner, const ViewportCreateInfo& createInfo) : Gfx::Viewport(owner, createInfo) {}
+
+Viewport::~Viewport() {}
+
+void Viewport::resize(uint32 newX, uint32 newY) {
+    sizeX = newX;
+    sizeY = newY;
+}
+
+void Viewport::move(uint32 newOffsetX, uint32 newOffsetY) {
+    offsetX = newOffsetX;
+    offsetY = newOffsetY;
+}
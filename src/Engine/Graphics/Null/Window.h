@@ -0,0 +1,50 @@
+#pragma once
+#include "Graphics/Window.h"
+#include "Texture.h"
+#include <chrono>
+
+namespace Seele {
+namespace Null {
+// a window without a surface, the back buffer is a plain texture that is never presented
+class Window : public Gfx::Window {
+  public:
+    Window(Gfx::QueueFamilyMapping mapping, const WindowCreateInfo& createInfo);
+    virtual ~Window();
+    virtual void show() override;
+    virtual void pollInput() override;
+    virtual void beginFrame() override;
+    virtual void endFrame() override;
+    virtual Gfx::PTexture2D getBackBuffer() const override;
+    virtual void onWindowCloseEvent() override;
+    virtual void setKeyCallback(std::function<void(KeyCode, InputAction, KeyModifier)> callback) override;
+    virtual void setMouseMoveCallback(std::function<void(double, double)> callback) override;
+    virtual void setMouseButtonCallback(std::function<void(MouseButton, InputAction, KeyModifier)> callback) override;
+    virtual void setScrollCallback(std::function<void(double, double)> callback) override;
+    virtual void setFileCallback(std::function<void(int, const char**)> callback) override;
+    virtual void setCloseCallback(std::function<void()> callback) override;
+    virtual void setResizeCallback(std::function<void(uint32, uint32)> callback) override;
+
+  private:
+    OTexture2D backBuffer;
+    std::chrono::steady_clock::time_point lastFrame;
+
+    std::function<void(KeyCode, InputAction, KeyModifier)> keyCallback;
+    std::function<void(double, double)> mouseMoveCallback;
+    std::function<void(MouseButton, InputAction, KeyModifier)> mouseButtonCallback;
+    std::function<void(double, double)> scrollCallback;
+    std::function<void(int, const char**)> fileCallback;
+    std::function<void()> closeCallback;
+    std::function<void(uint32, uint32)> resizeCallback;
+};
+DEFINE_REF(Window)
+
+class Viewport : public Gfx::Viewport {
+  public:
+    Viewport(PWindow owner, const ViewportCreateInfo& createInfo);
+    virtual ~Viewport();
+    virtual void resize(uint32 newX, uint32 newY) override;
+    virtual void move(uint32 newOffsetX, uint32 newOffsetY) override;
+};
+DEFINE_REF(Viewport)
+} // namespace Null
+} // namespace Seele
@@ -19,4 +19,67 @@ TimestampQuery::TimestampQuery()
 {}
 
 TimestampQuery::~TimestampQuery()
-{}
\ No newline at end of file
+{}
+
+FrameStatsRing::FrameStatsRing() : frames(NUM_FRAMES) {}
+
+FrameStatsRing::~FrameStatsRing() {}
+
+void FrameStatsRing::expect(uint64 frameNumber) {
+    std::unique_lock l(lock);
+    FrameStats* stats = getFrame(frameNumber);
+    if (stats != nullptr) {
+        stats->numPending++;
+    }
+}
+
+void FrameStatsRing::resolveTimestamp(uint64 frameNumber, const std::string& name, uint64 nanoseconds) {
+    std::unique_lock l(lock);
+    FrameStats* stats = getFrame(frameNumber);
+    if (stats != nullptr) {
+        stats->timestamps[name] = nanoseconds;
+        stats->numPending--;
+    }
+}
+
+void FrameStatsRing::resolvePipelineStatistics(uint64 frameNumber, const std::string& name, const PipelineStatisticsResult& result) {
+    std::unique_lock l(lock);
+    FrameStats* stats = getFrame(frameNumber);
+    if (stats != nullptr) {
+        stats->pipelineStatistics[name] = result;
+        stats->numPending--;
+    }
+}
+
+void FrameStatsRing::resolveOcclusion(uint64 frameNumber, const std::string& name, const OcclusionResult& result) {
+    std::unique_lock l(lock);
+    FrameStats* stats = getFrame(frameNumber);
+    if (stats != nullptr) {
+        stats->occlusion[name] = result;
+        stats->numPending--;
+    }
+}
+
+bool FrameStatsRing::get(uint64 frameNumber, FrameStats& stats) const {
+    std::unique_lock l(lock);
+    const FrameStats& frame = frames[frameNumber % NUM_FRAMES];
+    if (frameNumber == 0 || frame.frameNumber != frameNumber || frame.numPending > 0) {
+        return false;
+    }
+    stats = frame;
+    return true;
+}
+
+FrameStats* FrameStatsRing::getFrame(uint64 frameNumber) {
+    FrameStats& frame = frames[frameNumber % NUM_FRAMES];
+    if (frame.frameNumber > frameNumber) {
+        // the slot already belongs to a newer frame, nobody waits for these results anymore
+        return nullptr;
+    }
+    if (frame.frameNumber < frameNumber) {
+        frame = FrameStats{
+            .frameNumber = frameNumber,
+        };
+    }
+    return &frame;
+}
@@ -1,10 +1,12 @@
 #pragma once
 #include "Containers/Array.h"
+#include "Containers/Map.h"
 #include "Enums.h"
 #include "MinimalEngine.h"
 #include <ostream>
 #include <chrono>
 #include <fmt/format.h>
+#include <mutex>
 #include <string>
 
 namespace Seele {
@@ -18,7 +20,6 @@ class OcclusionQuery {
     virtual ~OcclusionQuery();
     virtual void beginQuery() = 0;
     virtual void endQuery() = 0;
-    virtual OcclusionResult getResults() = 0;
 };
 DEFINE_REF(OcclusionQuery)
 struct PipelineStatisticsResult {
@@ -46,7 +47,6 @@ class PipelineStatisticsQuery {
     virtual ~PipelineStatisticsQuery();
     virtual void beginQuery() = 0;
     virtual void endQuery() = 0;
-    virtual PipelineStatisticsResult getResults() = 0;
 };
 DEFINE_REF(PipelineStatisticsQuery)
 struct Timestamp {
@@ -58,8 +58,40 @@ class TimestampQuery {
     TimestampQuery();
     virtual ~TimestampQuery();
     virtual void write(SePipelineStageFlagBits stage, const std::string& name = "") = 0;
-    virtual Timestamp getResult() = 0;
 };
 DEFINE_REF(TimestampQuery)
+
+// results of the queries that were recorded during one frame, keyed by the name of the query or of the timestamp
+struct FrameStats {
+    uint64 frameNumber = 0;
+    // in nanoseconds of the GPU clock
+    Map<std::string, uint64> timestamps;
+    Map<std::string, PipelineStatisticsResult> pipelineStatistics;
+    Map<std::string, OcclusionResult> occlusion;
+    // queries that were recorded, but whose results are not available yet
+    uint32 numPending = 0;
+};
+
+// the backends resolve their queries in here once the GPU is done with them, so reading results never waits for the GPU
+class FrameStatsRing {
+  public:
+    // number of frames whose results are kept
+    static constexpr uint64 NUM_FRAMES = 16;
+    FrameStatsRing();
+    ~FrameStatsRing();
+    // a query was recorded, its frame is incomplete until it is resolved
+    void expect(uint64 frameNumber);
+    void resolveTimestamp(uint64 frameNumber, const std::string& name, uint64 nanoseconds);
+    void resolvePipelineStatistics(uint64 frameNumber, const std::string& name, const PipelineStatisticsResult& result);
+    void resolveOcclusion(uint64 frameNumber, const std::string& name, const OcclusionResult& result);
+    // false while some queries of the frame are still pending, or if it was already overwritten by a newer one
+    bool get(uint64 frameNumber, FrameStats& stats) const;
+
+  private:
+    // nullptr if the slot of the frame was already taken by a newer one
+    FrameStats* getFrame(uint64 frameNumber);
+    mutable std::mutex lock;
+    Array<FrameStats> frames;
+};
 } // namespace Gfx
 } // namespace Seele
\ No newline at end of file
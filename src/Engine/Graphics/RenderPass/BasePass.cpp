@@ -26,6 +26,43 @@ void Seele::addDebugVertex(DebugVertex vert) { gDebugVertices.add(vert); }
 void Seele::addDebugVertices(Array<DebugVertex> verts) { gDebugVertices.addAll(verts); }
 
 BasePass::BasePass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    declareRead(RenderGraphAccess{
+        .resource = "CULLINGBUFFER",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT,
+    });
+    for (VertexData* vd : VertexData::getList()) {
+        declareUploadReads(vd->getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT |
+                                                         Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT |
+                                                         Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    }
+    declareUploadReads(Material::getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    declareUploadReads(scene->getLightEnvironment()->getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    for (uint32 i = 0; i < NUM_CASCADES; ++i) {
+        declareRead(RenderGraphAccess{
+            .resource = fmt::format("SHADOWMAP_TEXTURE{0}", i),
+            .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+            .stage = Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        });
+    }
+    for (const char* lightCulling :
+         {"LIGHTCULLING_OLIGHTLIST", "LIGHTCULLING_TLIGHTLIST", "LIGHTCULLING_OLIGHTGRID", "LIGHTCULLING_TLIGHTGRID"}) {
+        declareRead(RenderGraphAccess{
+            .resource = lightCulling,
+            .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+            .stage = Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        });
+    }
+    declareWrite(RenderGraphAccess{
+        .resource = "BASEPASS_COLOR",
+        .access = Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "BASEPASS_DEPTH",
+        .access = Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | Gfx::SE_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+    });
     // waterRenderer = new WaterRenderer(graphics, scene, viewParamsLayout);
     basePassLayout = graphics->createPipelineLayout("BasePassLayout");
 
@@ -34,32 +71,32 @@ BasePass::BasePass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics)
     basePassLayout->addDescriptorLayout(Material::getDescriptorLayout());
 
     lightCullingLayout = graphics->createDescriptorLayout("pLightCullingData");
-    lightCullingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    lightIndexBinding = lightCullingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = LIGHTINDEX_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    lightCullingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    lightGridBinding = lightCullingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = LIGHTGRID_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_IMAGE,
     });
     lightCullingLayout->create();
 
     shadowMappingLayout = graphics->createDescriptorLayout("pShadowMapping");
-    shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    shadowMapsBinding = shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = SHADOWMAPS_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .descriptorCount = NUM_CASCADES,
     });
-    shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    lightSpaceBinding = shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = LIGHTSPACE_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
         .descriptorCount = NUM_CASCADES,
     });
-    shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    shadowSamplerBinding = shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = SHADOWSAMPLER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
-    shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    cascadeSplitBinding = shadowMappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = CASCADE_SPLIT_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_UNIFORM_BUFFER
     });
@@ -158,34 +195,34 @@ void BasePass::beginFrame(const Component::Camera& cam, const Component::Transfo
         skyboxData.transformMatrix = glm::rotate(skyboxData.transformMatrix, (float)(Gfx::getCurrentFrameDelta()), Vector(0, 1, 0));
 
         skyboxDataSet = skyboxDataLayout->allocateDescriptorSet();
-        skyboxDataSet->updateConstants("transformMatrix", 0, &skyboxData.transformMatrix);
-        skyboxDataSet->updateConstants("fogBlend", 0, &skyboxData.fogColor);
+        skyboxDataSet->updateConstants(skyboxTransformBinding, 0, &skyboxData.transformMatrix);
+        skyboxDataSet->updateConstants(skyboxFogBinding, 0, &skyboxData.fogColor);
         skyboxDataSet->writeChanges();
         textureSet = textureLayout->allocateDescriptorSet();
-        textureSet->updateTexture(SKYBOXDAY_NAME, 0, skybox.day->getDefaultView());
-        textureSet->updateTexture(SKYBOXNIGHT_NAME, 0, skybox.night->getDefaultView());
-        textureSet->updateSampler(SKYBOXSAMPLER_NAME, 0, skyboxSampler);
+        textureSet->updateTexture(skyboxDayBinding, 0, skybox.day->getDefaultView());
+        textureSet->updateTexture(skyboxNightBinding, 0, skybox.night->getDefaultView());
+        textureSet->updateSampler(skyboxSamplerBinding, 0, skyboxSampler);
         textureSet->writeChanges();
     }
 }
 
 void BasePass::render() {
     graphics->beginDebugRegion("BasePass");
-    opaqueCulling->updateBuffer(LIGHTINDEX_NAME, 0, oLightIndexList);
-    opaqueCulling->updateTexture(LIGHTGRID_NAME, 0, oLightGrid->getDefaultView());
-    transparentCulling->updateBuffer(LIGHTINDEX_NAME, 0, tLightIndexList);
-    transparentCulling->updateTexture(LIGHTGRID_NAME, 0, tLightGrid->getDefaultView());
+    opaqueCulling->updateBuffer(lightIndexBinding, 0, oLightIndexList);
+    opaqueCulling->updateTexture(lightGridBinding, 0, oLightGrid->getDefaultView());
+    transparentCulling->updateBuffer(lightIndexBinding, 0, tLightIndexList);
+    transparentCulling->updateTexture(lightGridBinding, 0, tLightGrid->getDefaultView());
     opaqueCulling->writeChanges();
     transparentCulling->writeChanges();
     
     shadowMappingLayout->reset();
     shadowMapping = shadowMappingLayout->allocateDescriptorSet();
     for (uint32 i = 0; i < NUM_CASCADES; ++i) {
-        shadowMapping->updateTexture(SHADOWMAPS_NAME, i, shadowMaps[i]->getDefaultView());
-        shadowMapping->updateBuffer(LIGHTSPACE_NAME, i, lightSpaceMatrices[i]);
+        shadowMapping->updateTexture(shadowMapsBinding, i, shadowMaps[i]->getDefaultView());
+        shadowMapping->updateBuffer(lightSpaceBinding, i, lightSpaceMatrices[i]);
     }
-    shadowMapping->updateSampler(SHADOWSAMPLER_NAME, 0, shadowSampler);
-    shadowMapping->updateBuffer(CASCADE_SPLIT_NAME, 0, cascadeSplits);
+    shadowMapping->updateSampler(shadowSamplerBinding, 0, shadowSampler);
+    shadowMapping->updateBuffer(cascadeSplitBinding, 0, cascadeSplits);
     shadowMapping->writeChanges();
 
     query->beginQuery();
@@ -194,7 +231,12 @@ void BasePass::render() {
     Array<VertexData::TransparentDraw> transparentData;
     // Opaque
     {
-        Array<Gfx::ORenderCommand> commands;
+        struct OpaqueBatch {
+            VertexData* vertexData;
+            const VertexData::MaterialData* materialData;
+            const Gfx::ShaderCollection* collection;
+        };
+        Array<OpaqueBatch> batches;
         Gfx::ShaderPermutation permutation = graphics->getShaderCompiler()->getTemplate("BasePass");
         permutation.setDepthCulling(true); // always use the culling info
         permutation.setPositionOnly(false);
@@ -216,61 +258,31 @@ void BasePass::render() {
                 // Material => per material
                 // LightCulling => calculated by pass
                 permutation.setMaterial(materialData.material->getName(), materialData.material->getProfile());
-                Gfx::PermutationId id(permutation);
-
-                Gfx::ORenderCommand command = graphics->createRenderCommand("BaseRender");
+                // shaders are looked up here, waiting for a compilation inside of a recording job could starve the thread pool
+                const Gfx::ShaderCollection* collection =
+                    graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation), lazyShaderCompilation);
+                assert(collection != nullptr);
+                batches.add(OpaqueBatch{
+                    .vertexData = vertexData,
+                    .materialData = &materialData,
+                    .collection = collection,
+                });
+            }
+        }
+        // one command per material batch, recorded in parallel
+        Array<Gfx::ORenderCommand> commands =
+            graphics->recordRenderCommands("BaseRender", batches.size(), [&](Gfx::PRenderCommand command, uint64 index) {
+                const OpaqueBatch& batch = batches[index];
+                VertexData* vertexData = batch.vertexData;
                 command->setViewport(viewport);
 
-                const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id);
-                assert(collection != nullptr);
+                // bool twoSided = batch.materialData->material->isTwoSided();
 
-                // bool twoSided = materialData.material->isTwoSided();
-
-                if (graphics->supportMeshShading()) {
-                    Gfx::MeshPipelineCreateInfo pipelineInfo = {
-                        .taskShader = collection->taskShader,
-                        .meshShader = collection->meshShader,
-                        .fragmentShader = collection->fragmentShader,
-                        .renderPass = renderPass,
-                        .pipelineLayout = collection->pipelineLayout,
-                        .multisampleState =
-                            {
-                                .samples = msColorAttachment.getNumSamples(),
-                            },
-                        .rasterizationState =
-                            {
-                                .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                            },
-                        .colorBlend =
-                            {
-                                .attachmentCount = 1,
-                            },
-                    };
-                    command->bindPipeline(graphics->createGraphicsPipeline(std::move(pipelineInfo)));
-                } else {
-                    Gfx::LegacyPipelineCreateInfo pipelineInfo = {
-                        .vertexShader = collection->vertexShader,
-                        .fragmentShader = collection->fragmentShader,
-                        .renderPass = renderPass,
-                        .pipelineLayout = collection->pipelineLayout,
-                        .multisampleState =
-                            {
-                                .samples = msColorAttachment.getNumSamples(),
-                            },
-                        .rasterizationState =
-                            {
-                                .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                            },
-                        .colorBlend =
-                            {
-                                .attachmentCount = 1,
-                            },
-                    };
-                    command->bindPipeline(graphics->createGraphicsPipeline(std::move(pipelineInfo)));
-                }
+                command->bindPipeline(createPermutationPipeline(batch.collection, msColorAttachment.getNumSamples(), false));
                 command->bindDescriptor({viewParamsSet, vertexData->getVertexDataSet(), vertexData->getInstanceDataSet(),
-                                         scene->getLightEnvironment()->getDescriptorSet(), Material::getDescriptorSet(), shadowMapping, opaqueCulling});
-                for (const auto& drawCall : materialData.instances) {
+                                         scene->getLightEnvironment()->getDescriptorSet(), Material::getDescriptorSet(), shadowMapping,
+                                         opaqueCulling});
+                for (const auto& drawCall : batch.materialData->instances) {
                     command->pushConstants(Gfx::SE_SHADER_STAGE_TASK_BIT_EXT | Gfx::SE_SHADER_STAGE_VERTEX_BIT |
                                                Gfx::SE_SHADER_STAGE_FRAGMENT_BIT,
                                            0, sizeof(VertexData::DrawCallOffsets), &drawCall.offsets);
@@ -285,9 +297,7 @@ void BasePass::render() {
                         }
                     }
                 }
-                commands.add(std::move(command));
-            }
-        }
+            });
         graphics->executeCommands(std::move(commands));
     }
 
@@ -321,67 +331,12 @@ void BasePass::render() {
             permutation.setMaterial(t.matInst->getBaseMaterial()->getName(), t.matInst->getBaseMaterial()->getProfile());
             Gfx::PermutationId id(permutation);
 
-            const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id);
+            const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id, lazyShaderCompilation);
             assert(collection != nullptr);
 
             // bool twoSided = t.matInst->getBaseMaterial()->isTwoSided();
 
-            if (graphics->supportMeshShading()) {
-                Gfx::MeshPipelineCreateInfo pipelineInfo = {
-                    .taskShader = collection->taskShader,
-                    .meshShader = collection->meshShader,
-                    .fragmentShader = collection->fragmentShader,
-                    .renderPass = renderPass,
-                    .pipelineLayout = collection->pipelineLayout,
-                    .multisampleState =
-                        {
-                            .samples = msColorAttachment.getNumSamples(),
-                        },
-                    .rasterizationState =
-                        {
-                            .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                        },
-                    .colorBlend =
-                        {
-                            .attachmentCount = 1,
-                            .blendAttachments =
-                                {
-                                    Gfx::ColorBlendState::BlendAttachment{
-                                        .blendEnable = true,
-                                    },
-                                },
-                        },
-                };
-                Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-                transparentCommand->bindPipeline(pipeline);
-            } else {
-                Gfx::LegacyPipelineCreateInfo pipelineInfo = {
-                    .vertexShader = collection->vertexShader,
-                    .fragmentShader = collection->fragmentShader,
-                    .renderPass = renderPass,
-                    .pipelineLayout = collection->pipelineLayout,
-                    .multisampleState =
-                        {
-                            .samples = msColorAttachment.getNumSamples(),
-                        },
-                    .rasterizationState =
-                        {
-                            .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                        },
-                    .colorBlend =
-                        {
-                            .attachmentCount = 1,
-                            .blendAttachments =
-                                {
-                                    Gfx::ColorBlendState::BlendAttachment{
-                                        .blendEnable = true,
-                                    },
-                                },
-                        },
-                };
-                Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-                transparentCommand->bindPipeline(pipeline);
-            }
+            transparentCommand->bindPipeline(createPermutationPipeline(collection, msColorAttachment.getNumSamples(), true));
             transparentCommand->bindDescriptor({viewParamsSet, t.vertexData->getVertexDataSet(), t.vertexData->getInstanceDataSet(),
                                                 scene->getLightEnvironment()->getDescriptorSet(), Material::getDescriptorSet(), shadowMapping,
                                                 transparentCulling});
@@ -424,6 +379,31 @@ void BasePass::render() {
 
 void BasePass::endFrame() {}
 
+void BasePass::warmUpPipelines() {
+    // same permutations as render(), for every vertex data that a material could be drawn with
+    Gfx::ShaderPermutation opaque = graphics->getShaderCompiler()->getTemplate("BasePass");
+    opaque.setDepthCulling(true);
+    opaque.setPositionOnly(false);
+    opaque.setImageBasedLighting(getGlobals().useImagebasedLighting);
+    Gfx::ShaderPermutation transparent = graphics->getShaderCompiler()->getTemplate("BasePass");
+    transparent.setPositionOnly(false);
+    transparent.setDepthCulling(false);
+    Array<PMaterial> materials = graphics->getShaderCompiler()->getMaterials();
+    for (VertexData* vertexData : VertexData::getList()) {
+        opaque.setVertexData(vertexData->getTypeName());
+        transparent.setVertexData(vertexData->getTypeName());
+        for (const auto& material : materials) {
+            if (material->hasTransparency()) {
+                transparent.setMaterial(material->getName(), material->getProfile());
+                warmUpPipeline(Gfx::PermutationId(transparent), msColorAttachment.getNumSamples(), true);
+            } else {
+                opaque.setMaterial(material->getName(), material->getProfile());
+                warmUpPipeline(Gfx::PermutationId(opaque), msColorAttachment.getNumSamples(), false);
+            }
+        }
+    }
+}
+
 void BasePass::publishOutputs() {
     basePassDepth = graphics->createTexture2D(TextureCreateInfo{
         .format = Gfx::SE_FORMAT_D32_SFLOAT,
@@ -607,21 +587,23 @@ void BasePass::createRenderPass() {
     // Skybox
     {
         skyboxDataLayout = graphics->createDescriptorLayout("pSkyboxData");
-        skyboxDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "transformMatrix", .uniformLength = sizeof(Matrix4)});
-        skyboxDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "fogBlend", .uniformLength = sizeof(Vector4)});
+        skyboxTransformBinding =
+            skyboxDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "transformMatrix", .uniformLength = sizeof(Matrix4)});
+        skyboxFogBinding =
+            skyboxDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "fogBlend", .uniformLength = sizeof(Vector4)});
         skyboxDataLayout->create();
         textureLayout = graphics->createDescriptorLayout("pSkyboxTextures");
-        textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+        skyboxDayBinding = textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
             .name = SKYBOXDAY_NAME,
             .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
             .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
         });
-        textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+        skyboxNightBinding = textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
             .name = SKYBOXNIGHT_NAME,
             .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
             .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
         });
-        textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+        skyboxSamplerBinding = textureLayout->addDescriptorBinding(Gfx::DescriptorBinding{
             .name = SKYBOXSAMPLER_NAME,
             .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
         });
@@ -18,6 +18,7 @@ class BasePass : public RenderPass {
     virtual void endFrame() override;
     virtual void publishOutputs() override;
     virtual void createRenderPass() override;
+    virtual void warmUpPipelines() override;
 
   private:
       // hdr
@@ -36,6 +37,12 @@ class BasePass : public RenderPass {
     constexpr static const char* LIGHTSPACE_NAME = "lightSpaceMatrices";
     constexpr static const char* SHADOWSAMPLER_NAME = "shadowSampler";
     constexpr static const char* CASCADE_SPLIT_NAME = "cascadeSplit";
+    Gfx::DescriptorBindingHandle lightIndexBinding;
+    Gfx::DescriptorBindingHandle lightGridBinding;
+    Gfx::DescriptorBindingHandle shadowMapsBinding;
+    Gfx::DescriptorBindingHandle lightSpaceBinding;
+    Gfx::DescriptorBindingHandle shadowSamplerBinding;
+    Gfx::DescriptorBindingHandle cascadeSplitBinding;
 
     Gfx::ODescriptorSet opaqueCulling;
     Gfx::ODescriptorSet transparentCulling;
@@ -99,6 +106,11 @@ class BasePass : public RenderPass {
     const char* SKYBOXDAY_NAME = "day";
     const char* SKYBOXNIGHT_NAME = "night";
     const char* SKYBOXSAMPLER_NAME = "sampler";
+    Gfx::DescriptorBindingHandle skyboxTransformBinding;
+    Gfx::DescriptorBindingHandle skyboxFogBinding;
+    Gfx::DescriptorBindingHandle skyboxDayBinding;
+    Gfx::DescriptorBindingHandle skyboxNightBinding;
+    Gfx::DescriptorBindingHandle skyboxSamplerBinding;
     PScene scene;
 };
 DEFINE_REF(BasePass)
@@ -5,6 +5,27 @@
 using namespace Seele;
 
 CachedDepthPass::CachedDepthPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    declareRead(RenderGraphAccess{
+        .resource = "CULLINGBUFFER",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT,
+        // culls with the visibility of the last frame, before the visibility pass overwrites it
+        .previousFrame = true,
+    });
+    for (VertexData* vd : VertexData::getList()) {
+        declareUploadReads(vd->getUploadedBuffers(),
+                           Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT);
+    }
+    declareWrite(RenderGraphAccess{
+        .resource = "DEPTHPREPASS_DEPTH",
+        .access = Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | Gfx::SE_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "VISIBILITY",
+        .access = Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    });
     depthPrepassLayout = graphics->createPipelineLayout("CachedDepthLayout");
     depthPrepassLayout->addDescriptorLayout(viewParamsLayout);
     depthPrepassLayout->addPushConstants(Gfx::SePushConstantRange{
@@ -58,7 +79,7 @@ void CachedDepthPass::render() {
     permutation.setDepthCulling(true);
     for (VertexData* vertexData : VertexData::getList()) {
         permutation.setVertexData(vertexData->getTypeName());
-        vertexData->getInstanceDataSet()->updateBuffer(VertexData::CULLINGDATA_NAME, 0, cullingBuffer);
+        vertexData->getInstanceDataSet()->updateBuffer(vertexData->getCullingDataBinding(), 0, cullingBuffer);
         vertexData->getInstanceDataSet()->writeChanges();
 
         // Create Pipeline(VertexData)
@@ -71,44 +92,9 @@ void CachedDepthPass::render() {
         Gfx::ORenderCommand command = graphics->createRenderCommand("CullingRender");
         command->setViewport(viewport);
 
-        const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id);
+        const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id, lazyShaderCompilation);
         assert(collection != nullptr);
-        if (graphics->supportMeshShading()) {
-            Gfx::MeshPipelineCreateInfo pipelineInfo = {
-                .taskShader = collection->taskShader,
-                .meshShader = collection->meshShader,
-                .fragmentShader = collection->fragmentShader,
-                .renderPass = renderPass,
-                .pipelineLayout = collection->pipelineLayout,
-                .rasterizationState =
-                    {
-                        .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                    },
-                .colorBlend =
-                    {
-                        .attachmentCount = 1,
-                    },
-            };
-            Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-            command->bindPipeline(pipeline);
-        } else {
-            Gfx::LegacyPipelineCreateInfo pipelineInfo = {
-                .vertexShader = collection->vertexShader,
-                .fragmentShader = collection->fragmentShader,
-                .renderPass = renderPass,
-                .pipelineLayout = collection->pipelineLayout,
-                .rasterizationState =
-                    {
-                        .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                    },
-                .colorBlend =
-                    {
-                        .attachmentCount = 1,
-                    },
-            };
-            Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-            command->bindPipeline(pipeline);
-        }
+        command->bindPipeline(createPermutationPipeline(collection));
         command->bindDescriptor({viewParamsSet, vertexData->getVertexDataSet(), vertexData->getInstanceDataSet()});
         VertexData::DrawCallOffsets offsets = {
             .instanceOffset = 0,
@@ -146,6 +132,16 @@ void CachedDepthPass::render() {
 
 void CachedDepthPass::endFrame() {}
 
+void CachedDepthPass::warmUpPipelines() {
+    Gfx::ShaderPermutation permutation = graphics->getShaderCompiler()->getTemplate("CachedDepthPass");
+    permutation.setPositionOnly(getGlobals().usePositionOnly);
+    permutation.setDepthCulling(true);
+    for (VertexData* vertexData : VertexData::getList()) {
+        permutation.setVertexData(vertexData->getTypeName());
+        warmUpPipeline(Gfx::PermutationId(permutation));
+    }
+}
+
 void CachedDepthPass::publishOutputs() {
     // If we render to a part of an image, the depth buffer itself must
     // still match the size of the whole image or their coordinate systems go out of sync
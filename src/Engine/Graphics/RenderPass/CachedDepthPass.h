@@ -14,6 +14,7 @@ class CachedDepthPass : public RenderPass {
     virtual void endFrame() override;
     virtual void publishOutputs() override;
     virtual void createRenderPass() override;
+    virtual void warmUpPipelines() override;
 
   private:
     Gfx::RenderTargetAttachment depthAttachment;
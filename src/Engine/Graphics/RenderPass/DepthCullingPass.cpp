@@ -4,14 +4,38 @@
 using namespace Seele;
 
 DepthCullingPass::DepthCullingPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    declareRead(RenderGraphAccess{
+        .resource = "CULLINGBUFFER",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT,
+        // culls with the visibility of the last frame, before the visibility pass overwrites it
+        .previousFrame = true,
+    });
+    for (VertexData* vd : VertexData::getList()) {
+        declareUploadReads(vd->getUploadedBuffers(),
+                           Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT);
+    }
+    // the depth pyramid is built from the cached depth, then the culled draws add to it
+    declareWrite(RenderGraphAccess{
+        .resource = "DEPTHPREPASS_DEPTH",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT | Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                  Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                 Gfx::SE_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "VISIBILITY",
+        .access = Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    });
     depthAttachmentLayout = graphics->createDescriptorLayout("pDepthAttachment");
-    depthAttachmentLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    depthTextureBinding = depthAttachmentLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = DEPTHTEXTURE_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .shaderStages = Gfx::SE_SHADER_STAGE_TASK_BIT_EXT | Gfx::SE_SHADER_STAGE_MESH_BIT_EXT | Gfx::SE_SHADER_STAGE_COMPUTE_BIT,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
     });
-    depthAttachmentLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    depthMipBinding = depthAttachmentLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = DEPTHMIP_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
         .shaderStages = Gfx::SE_SHADER_STAGE_TASK_BIT_EXT | Gfx::SE_SHADER_STAGE_COMPUTE_BIT,
@@ -81,8 +105,8 @@ void DepthCullingPass::render() {
                                                    Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
 
         depthMipBuffer->rotateBuffer(depthMipBuffer->getNumElements() * sizeof(uint32));
-        set->updateTexture(DEPTHTEXTURE_NAME, 0, depthAttachment.getTextureView());
-        set->updateBuffer(DEPTHMIP_NAME, 0, depthMipBuffer);
+        set->updateTexture(depthTextureBinding, 0, depthAttachment.getTextureView());
+        set->updateBuffer(depthMipBinding, 0, depthMipBuffer);
         set->writeChanges();
 
         timestamps->write(Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT, "MipBegin");
@@ -127,7 +151,13 @@ void DepthCullingPass::render() {
     {
         graphics->beginDebugRegion("DepthCulling");
         graphics->beginRenderPass(renderPass);
-        Array<Gfx::ORenderCommand> commands;
+        struct DepthBatch {
+            VertexData* vertexData;
+            // only set without mesh shading, the task shader draws all instances of a vertex data at once
+            const VertexData::MaterialData* materialData;
+            const Gfx::ShaderCollection* collection;
+        };
+        Array<DepthBatch> batches;
         Gfx::ShaderPermutation permutation = graphics->getShaderCompiler()->getTemplate("DepthPass");
         permutation.setPositionOnly(true);
         permutation.setDepthCulling(getGlobals().useDepthCulling);
@@ -138,92 +168,62 @@ void DepthCullingPass::render() {
             // ViewData => global, static
             // VertexData => per meshtype
             // SceneData => per meshtype
-            Gfx::PermutationId id(permutation);
-
-            Gfx::ORenderCommand command = graphics->createRenderCommand("DepthRender");
-            command->setViewport(viewport);
-
-            const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id);
+            const Gfx::ShaderCollection* collection =
+                graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation), lazyShaderCompilation);
             assert(collection != nullptr);
             if (graphics->supportMeshShading()) {
-                Gfx::MeshPipelineCreateInfo pipelineInfo = {
-                    .taskShader = collection->taskShader,
-                    .meshShader = collection->meshShader,
-                    .fragmentShader = collection->fragmentShader,
-                    .renderPass = renderPass,
-                    .pipelineLayout = collection->pipelineLayout,
-                    .rasterizationState =
-                        {
-                            .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                        },
-                    .colorBlend =
-                        {
-                            .attachmentCount = 1,
-                        },
-                };
-                Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-                command->bindPipeline(pipeline);
-            } else {
-                Gfx::LegacyPipelineCreateInfo pipelineInfo = {
-                    .vertexShader = collection->vertexShader,
-                    .fragmentShader = collection->fragmentShader,
-                    .renderPass = renderPass,
-                    .pipelineLayout = collection->pipelineLayout,
-                    .rasterizationState =
-                        {
-                            .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
-                        },
-                    .colorBlend =
-                        {
-                            .attachmentCount = 1,
-                        },
-                };
-                Gfx::PGraphicsPipeline pipeline = graphics->createGraphicsPipeline(std::move(pipelineInfo));
-                command->bindPipeline(pipeline);
+                batches.add(DepthBatch{
+                    .vertexData = vertexData,
+                    .materialData = nullptr,
+                    .collection = collection,
+                });
+                continue;
             }
-            command->bindDescriptor({viewParamsSet, vertexData->getVertexDataSet(), vertexData->getInstanceDataSet(), set});
-            VertexData::DrawCallOffsets offsets = {
-                .instanceOffset = 0,
-                .textureOffset = 0,
-                .samplerOffset = 0,
-                .floatOffset = 0,
-            };
-            command->pushConstants(Gfx::SE_SHADER_STAGE_TASK_BIT_EXT | Gfx::SE_SHADER_STAGE_VERTEX_BIT, 0,
-                                   sizeof(VertexData::DrawCallOffsets), &offsets);
-            if (graphics->supportMeshShading()) {
-                command->drawMesh((uint32)vertexData->getNumInstances(), 1, 1);
-            } else {
-                const auto& materials = vertexData->getMaterialData();
-                for (const auto& materialData : materials) {
-                    for (const auto& drawCall : materialData.instances) {
-                        // material not used for any active meshes, skip
-                        if (materialData.instances.size() == 0)
-                            continue;
-                        command->bindIndexBuffer(vertexData->getIndexBuffer());
-                        uint32 inst = drawCall.offsets.instanceOffset;
-                        for (const auto& meshData : drawCall.instanceMeshData) {
-                            // all meshlets of a mesh share the same indices offset
-                            command->drawIndexed(meshData.indicesRange.size, 1, meshData.indicesRange.offset,
-                                                 vertexData->getIndicesOffset(meshData.meshletRange.offset), inst++);
-                        }
-                    }
-                }
+            for (const auto& materialData : vertexData->getMaterialData()) {
+                // material not used for any active meshes, skip
+                if (materialData.instances.size() == 0)
+                    continue;
+                batches.add(DepthBatch{
+                    .vertexData = vertexData,
+                    .materialData = &materialData,
+                    .collection = collection,
+                });
             }
-            commands.add(std::move(command));
         }
+        Array<Gfx::ORenderCommand> commands =
+            graphics->recordRenderCommands("DepthRender", batches.size(), [&](Gfx::PRenderCommand command, uint64 index) {
+                const DepthBatch& batch = batches[index];
+                VertexData* vertexData = batch.vertexData;
+                command->setViewport(viewport);
+                command->bindPipeline(createPermutationPipeline(batch.collection));
+                command->bindDescriptor({viewParamsSet, vertexData->getVertexDataSet(), vertexData->getInstanceDataSet(), set});
+                VertexData::DrawCallOffsets offsets = {
+                    .instanceOffset = 0,
+                    .textureOffset = 0,
+                    .samplerOffset = 0,
+                    .floatOffset = 0,
+                };
+                command->pushConstants(Gfx::SE_SHADER_STAGE_TASK_BIT_EXT | Gfx::SE_SHADER_STAGE_VERTEX_BIT, 0,
+                                       sizeof(VertexData::DrawCallOffsets), &offsets);
+                if (batch.materialData == nullptr) {
+                    command->drawMesh((uint32)vertexData->getNumInstances(), 1, 1);
+                    return;
+                }
+                command->bindIndexBuffer(vertexData->getIndexBuffer());
+                for (const auto& drawCall : batch.materialData->instances) {
+                    uint32 inst = drawCall.offsets.instanceOffset;
+                    for (const auto& meshData : drawCall.instanceMeshData) {
+                        // all meshlets of a mesh share the same indices offset
+                        command->drawIndexed(meshData.indicesRange.size, 1, meshData.indicesRange.offset,
+                                             vertexData->getIndicesOffset(meshData.meshletRange.offset), inst++);
+                    }
+                }
+            });
 
         graphics->executeCommands(std::move(commands));
         graphics->endRenderPass();
         timestamps->write(Gfx::SE_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "CullingEnd");
         query->endQuery();
-        // Sync depth read/write with compute read
-        depthAttachment.getTextureView()->pipelineBarrier(
-            Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-            Gfx::SE_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
-        // Sync visibility write with compute read
-        visibilityAttachment.getTextureView()->pipelineBarrier(Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                                                           Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                                                           Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
         graphics->endDebugRegion();
     }
     graphics->endDebugRegion();
@@ -231,6 +231,16 @@ void DepthCullingPass::render() {
 
 void DepthCullingPass::endFrame() {}
 
+void DepthCullingPass::warmUpPipelines() {
+    Gfx::ShaderPermutation permutation = graphics->getShaderCompiler()->getTemplate("DepthPass");
+    permutation.setPositionOnly(true);
+    permutation.setDepthCulling(getGlobals().useDepthCulling);
+    for (VertexData* vertexData : VertexData::getList()) {
+        permutation.setVertexData(vertexData->getTypeName());
+        warmUpPipeline(Gfx::PermutationId(permutation));
+    }
+}
+
 void DepthCullingPass::publishOutputs() {
     uint32 width = viewport->getOwner()->getFramebufferWidth();
     uint32 height = viewport->getOwner()->getFramebufferHeight();
@@ -16,6 +16,7 @@ class DepthCullingPass : public RenderPass {
     virtual void endFrame() override;
     virtual void publishOutputs() override;
     virtual void createRenderPass() override;
+    virtual void warmUpPipelines() override;
 
   private:
     constexpr static uint64 BLOCK_SIZE = 32;
@@ -30,8 +31,10 @@ class DepthCullingPass : public RenderPass {
     Array<UVector2> mipDims;
 
     constexpr static const char* DEPTHTEXTURE_NAME = "depthTexture";
+    Gfx::DescriptorBindingHandle depthTextureBinding;
     Gfx::OShaderBuffer depthMipBuffer;
     constexpr static const char* DEPTHMIP_NAME = "depthMip";
+    Gfx::DescriptorBindingHandle depthMipBinding;
     Gfx::RenderTargetAttachment depthAttachment;
     Gfx::RenderTargetAttachment visibilityAttachment;
     Gfx::ODescriptorLayout depthAttachmentLayout;
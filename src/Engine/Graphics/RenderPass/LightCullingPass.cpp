@@ -11,7 +11,36 @@
 
 using namespace Seele;
 
-LightCullingPass::LightCullingPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {}
+LightCullingPass::LightCullingPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    // only needs the depth, so it can run on the async compute queue while the shadows are rasterized
+    declaration.queue = Gfx::QueueType::COMPUTE;
+    declareRead(RenderGraphAccess{
+        .resource = "DEPTHPREPASS_DEPTH",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+    declareUploadReads(scene->getLightEnvironment()->getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    declareWrite(RenderGraphAccess{
+        .resource = "LIGHTCULLING_OLIGHTLIST",
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "LIGHTCULLING_TLIGHTLIST",
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "LIGHTCULLING_OLIGHTGRID",
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+    declareWrite(RenderGraphAccess{
+        .resource = "LIGHTCULLING_TLIGHTGRID",
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+}
 
 LightCullingPass::~LightCullingPass() {}
 
@@ -43,17 +72,13 @@ void LightCullingPass::render() {
     graphics->beginDebugRegion("LightCulling");
     query->beginQuery();
     timestamps->write(Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT, "LightCullBegin");
-    oLightGrid->pipelineBarrier(Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, Gfx::SE_ACCESS_SHADER_WRITE_BIT,
-                                Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
-    tLightGrid->pipelineBarrier(Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, Gfx::SE_ACCESS_SHADER_WRITE_BIT,
-                                Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
-    cullingDescriptorSet->updateTexture(DEPTHATTACHMENT_NAME, 0, depthAttachment);
-    cullingDescriptorSet->updateBuffer(OLIGHTINDEXCOUNTER_NAME, 0, oLightIndexCounter);
-    cullingDescriptorSet->updateBuffer(TLIGHTINDEXCOUNTER_NAME, 0, tLightIndexCounter);
-    cullingDescriptorSet->updateBuffer(OLIGHTINDEXLIST_NAME, 0, oLightIndexList);
-    cullingDescriptorSet->updateBuffer(TLIGHTINDEXLIST_NAME, 0, tLightIndexList);
-    cullingDescriptorSet->updateTexture(OLIGHTGRID_NAME, 0, oLightGrid->getDefaultView());
-    cullingDescriptorSet->updateTexture(TLIGHTGRID_NAME, 0, tLightGrid->getDefaultView());
+    cullingDescriptorSet->updateTexture(depthAttachmentBinding, 0, depthAttachment);
+    cullingDescriptorSet->updateBuffer(oLightIndexCounterBinding, 0, oLightIndexCounter);
+    cullingDescriptorSet->updateBuffer(tLightIndexCounterBinding, 0, tLightIndexCounter);
+    cullingDescriptorSet->updateBuffer(oLightIndexListBinding, 0, oLightIndexList);
+    cullingDescriptorSet->updateBuffer(tLightIndexListBinding, 0, tLightIndexList);
+    cullingDescriptorSet->updateTexture(oLightGridBinding, 0, oLightGrid->getDefaultView());
+    cullingDescriptorSet->updateTexture(tLightGridBinding, 0, tLightGrid->getDefaultView());
     cullingDescriptorSet->writeChanges();
     Gfx::OComputeCommand computeCommand = graphics->createComputeCommand("CullingCommand");
     if (getGlobals().useLightCulling) {
@@ -69,14 +94,6 @@ void LightCullingPass::render() {
     graphics->executeCommands(std::move(commands));
     timestamps->write(Gfx::SE_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "LightCullEnd");
     query->endQuery();
-    oLightIndexList->pipelineBarrier(Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                                     Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-    tLightIndexList->pipelineBarrier(Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                                     Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-    oLightGrid->pipelineBarrier(Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT, Gfx::SE_ACCESS_SHADER_READ_BIT,
-                                Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-    tLightGrid->pipelineBarrier(Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT, Gfx::SE_ACCESS_SHADER_READ_BIT,
-                                Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
     graphics->endDebugRegion();
 }
 
@@ -89,35 +106,35 @@ void LightCullingPass::publishOutputs() {
     numThreadGroups = glm::ceil(glm::vec4(viewportWidth / (float)BLOCK_SIZE, viewportHeight / (float)BLOCK_SIZE, 1, 0));
     numThreads = numThreadGroups * glm::uvec4(BLOCK_SIZE, BLOCK_SIZE, 1, 0);
     dispatchParamsSet = dispatchParamsLayout->allocateDescriptorSet();
-    dispatchParamsSet->updateConstants("numThreadGroups", 0, &numThreadGroups);
-    dispatchParamsSet->updateConstants("numThreads", 0, &numThreads);
+    dispatchParamsSet->updateConstants(numThreadGroupsBinding, 0, &numThreadGroups);
+    dispatchParamsSet->updateConstants(numThreadsBinding, 0, &numThreads);
     dispatchParamsSet->writeChanges();
 
     cullingDescriptorLayout = graphics->createDescriptorLayout("pCullingParams");
 
     // DepthTexture
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    depthAttachmentBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = DEPTHATTACHMENT_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
     });
     // o_lightIndexCounter
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    oLightIndexCounterBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = OLIGHTINDEXCOUNTER_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
     // t_lightIndexCounter
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    tLightIndexCounterBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TLIGHTINDEXCOUNTER_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
     // o_lightIndexList
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    oLightIndexListBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = OLIGHTINDEXLIST_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
     // t_lightIndexList
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    tLightIndexListBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TLIGHTINDEXLIST_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
     // o_lightGrid
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    oLightGridBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = OLIGHTGRID_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_IMAGE, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
     // t_lightGrid
-    cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    tLightGridBinding = cullingDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TLIGHTGRID_NAME, .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_IMAGE, .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,});
 
     cullingDescriptorLayout->create();
@@ -238,15 +255,15 @@ void LightCullingPass::setupFrustums() {
     viewParamsSet = createViewParamsSet();
 
     dispatchParamsLayout = graphics->createDescriptorLayout("pDispatchParams");
-    dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    numThreadGroupsBinding = dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "numThreadGroups",
         .uniformLength = sizeof(UVector4),
     });
-    dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    numThreadsBinding = dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "numThreads",
         .uniformLength = sizeof(UVector4),
     });
-    dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    frustumBufferBinding = dispatchParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = FRUSTUMBUFFER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,
@@ -286,9 +303,9 @@ void LightCullingPass::setupFrustums() {
                                    Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
 
     dispatchParamsSet = dispatchParamsLayout->allocateDescriptorSet();
-    dispatchParamsSet->updateConstants("numThreadGroups", 0, &numThreadGroups);
-    dispatchParamsSet->updateConstants("numThreads", 0, &numThreads);
-    dispatchParamsSet->updateBuffer(FRUSTUMBUFFER_NAME, 0, frustumBuffer);
+    dispatchParamsSet->updateConstants(numThreadGroupsBinding, 0, &numThreadGroups);
+    dispatchParamsSet->updateConstants(numThreadsBinding, 0, &numThreads);
+    dispatchParamsSet->updateBuffer(frustumBufferBinding, 0, frustumBuffer);
     dispatchParamsSet->writeChanges();
 
     Gfx::OComputeCommand command = graphics->createComputeCommand("FrustumCommand");
@@ -28,7 +28,10 @@ class LightCullingPass : public RenderPass {
 
     Gfx::OShaderBuffer frustumBuffer;
     const char* FRUSTUMBUFFER_NAME = "frustums";
+    Gfx::DescriptorBindingHandle frustumBufferBinding;
     Gfx::ODescriptorLayout dispatchParamsLayout;
+    Gfx::DescriptorBindingHandle numThreadGroupsBinding;
+    Gfx::DescriptorBindingHandle numThreadsBinding;
     Gfx::ODescriptorSet dispatchParamsSet;
     Gfx::OComputeShader frustumShader;
     Gfx::PComputePipeline frustumPipeline;
@@ -38,18 +41,25 @@ class LightCullingPass : public RenderPass {
     PLightEnvironment lightEnv;
     Gfx::PTextureView depthAttachment;
     constexpr static const char* DEPTHATTACHMENT_NAME = "depth";
+    Gfx::DescriptorBindingHandle depthAttachmentBinding;
     Gfx::OShaderBuffer oLightIndexCounter;
     constexpr static const char* OLIGHTINDEXCOUNTER_NAME = "oLightIndexCounter";
+    Gfx::DescriptorBindingHandle oLightIndexCounterBinding;
     Gfx::OShaderBuffer tLightIndexCounter;
     constexpr static const char* TLIGHTINDEXCOUNTER_NAME = "tLightIndexCounter";
+    Gfx::DescriptorBindingHandle tLightIndexCounterBinding;
     Gfx::OShaderBuffer oLightIndexList;
     constexpr static const char* OLIGHTINDEXLIST_NAME = "oLightIndexList";
+    Gfx::DescriptorBindingHandle oLightIndexListBinding;
     Gfx::OShaderBuffer tLightIndexList;
     constexpr static const char* TLIGHTINDEXLIST_NAME = "tLightIndexList";
+    Gfx::DescriptorBindingHandle tLightIndexListBinding;
     Gfx::OTexture2D oLightGrid;
     constexpr static const char* OLIGHTGRID_NAME = "oLightGrid";
+    Gfx::DescriptorBindingHandle oLightGridBinding;
     Gfx::OTexture2D tLightGrid;
     constexpr static const char* TLIGHTGRID_NAME = "tLightGrid";
+    Gfx::DescriptorBindingHandle tLightGridBinding;
     Gfx::ODescriptorSet cullingDescriptorSet;
     Gfx::ODescriptorLayout cullingDescriptorLayout;
     Gfx::OPipelineLayout cullingLayout;
@@ -14,28 +14,37 @@ struct SampleParams {
 };
 
 RayTracingPass::RayTracingPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    declareWrite(RenderGraphAccess{
+        .resource = "BASEPASS_COLOR",
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR,
+        .layout = Gfx::SE_IMAGE_LAYOUT_GENERAL,
+    });
+    declareUploadReads(StaticMeshVertexData::getInstance()->getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR);
+    declareUploadReads(Material::getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR);
+    declareUploadReads(scene->getLightEnvironment()->getUploadedBuffers(), Gfx::SE_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR);
     paramsLayout = graphics->createDescriptorLayout("pRayTracingParams");
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    tlasBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TLAS_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
     });
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    accumulatorBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = ACCUMULATOR_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_IMAGE,
     });
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    textureBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TEXTURE_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_IMAGE,
     });
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    indexBufferBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = INDEXBUFFER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    skyBoxBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = SKYBOX_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    skySamplerBinding = paramsLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = SKYSAMPLER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
@@ -75,8 +84,6 @@ void RayTracingPass::beginFrame(const Component::Camera& cam, const Component::T
 
 void RayTracingPass::render() {
     graphics->beginDebugRegion("RayTracingPass");
-    texture->changeLayout(Gfx::SE_IMAGE_LAYOUT_GENERAL, Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                          Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR);
     Array<Gfx::RayTracingHitGroup> callableGroups;
     Array<Gfx::PBottomLevelAS> accelerationStructures;
     Array<InstanceData> instanceData;
@@ -93,7 +100,8 @@ void RayTracingPass::render() {
             permutation.setMaterial(mat->getName(), mat->getProfile());
             permutation.setVertexData(vertexData->getTypeName());
 
-            const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation));
+            const Gfx::ShaderCollection* collection =
+                graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation), lazyShaderCompilation);
             assert(collection != nullptr);
 
             for (auto& inst : matData.instances) {
@@ -117,7 +125,8 @@ void RayTracingPass::render() {
             Gfx::ShaderPermutation permutation = graphics->getShaderCompiler()->getTemplate("RayTracing");
             permutation.setMaterial(mat->getName(), mat->getProfile());
             permutation.setVertexData(vertexData->getTypeName());
-            const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation));
+            const Gfx::ShaderCollection* collection =
+                graphics->getShaderCompiler()->findShaders(Gfx::PermutationId(permutation), lazyShaderCompilation);
             assert(collection != nullptr);
             Gfx::RayTracingHitGroup callableGroup = {
                 .closestHitShader = collection->callableShader,
@@ -151,12 +160,12 @@ void RayTracingPass::render() {
         .bottomLevelStructures = accelerationStructures,
     });
     Gfx::ODescriptorSet desc = paramsLayout->allocateDescriptorSet();
-    desc->updateAccelerationStructure(TLAS_NAME, 0, tlas);
-    desc->updateTexture(ACCUMULATOR_NAME, 0, radianceAccumulator->getDefaultView());
-    desc->updateTexture(TEXTURE_NAME, 0, texture->getDefaultView());
-    desc->updateBuffer(INDEXBUFFER_NAME, 0, StaticMeshVertexData::getInstance()->getIndexBuffer());
-    desc->updateTexture(SKYBOX_NAME, 0, skyBox->getDefaultView());
-    desc->updateSampler(SKYSAMPLER_NAME, 0, skyBoxSampler);
+    desc->updateAccelerationStructure(tlasBinding, 0, tlas);
+    desc->updateTexture(accumulatorBinding, 0, radianceAccumulator->getDefaultView());
+    desc->updateTexture(textureBinding, 0, texture->getDefaultView());
+    desc->updateBuffer(indexBufferBinding, 0, StaticMeshVertexData::getInstance()->getIndexBuffer());
+    desc->updateTexture(skyBoxBinding, 0, skyBox->getDefaultView());
+    desc->updateSampler(skySamplerBinding, 0, skyBoxSampler);
     desc->writeChanges();
 
     Gfx::ORenderCommand command = graphics->createRenderCommand("RayTracing");
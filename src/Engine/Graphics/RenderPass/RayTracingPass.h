@@ -18,16 +18,22 @@ class RayTracingPass : public RenderPass {
     Gfx::ODescriptorLayout paramsLayout;
     Gfx::OPipelineLayout pipelineLayout;
     constexpr static const char* TLAS_NAME = "scene";
+    Gfx::DescriptorBindingHandle tlasBinding;
     Gfx::OTopLevelAS tlas;
     constexpr static const char* ACCUMULATOR_NAME = "accumulator";
+    Gfx::DescriptorBindingHandle accumulatorBinding;
     Gfx::OTexture2D radianceAccumulator;
     constexpr static const char* TEXTURE_NAME = "image";
+    Gfx::DescriptorBindingHandle textureBinding;
     Gfx::OTexture2D texture;
     constexpr static const char* SKYBOX_NAME = "skybox";
+    Gfx::DescriptorBindingHandle skyBoxBinding;
     Gfx::PTextureCube skyBox;
     constexpr static const char* SKYSAMPLER_NAME = "sampler";
+    Gfx::DescriptorBindingHandle skySamplerBinding;
     Gfx::OSampler skyBoxSampler;
     constexpr static const char* INDEXBUFFER_NAME = "indexBuffer";
+    Gfx::DescriptorBindingHandle indexBufferBinding;
     Gfx::ORayGenShader rayGen;
     Gfx::OAnyHitShader anyhit;
     Gfx::OMissShader miss;
@@ -0,0 +1,112 @@
+#include "RenderGraph.h"
+#include "Graphics/Graphics.h"
+#include <typeinfo>
+
+using namespace Seele;
+
+RenderGraph::RenderGraph() { res = new RenderGraphResources(); }
+
+RenderGraph::~RenderGraph() {}
+
+void RenderGraph::addPass(ORenderPass pass) {
+    pass->setResources(res);
+    pass->setLazyShaderCompilation(lazyShaderCompilation);
+    passes.add(std::move(pass));
+}
+
+void RenderGraph::markOutput(const std::string& resource) { outputs.addUnique(resource); }
+
+void RenderGraph::setViewport(Gfx::PViewport viewport) {
+    for (auto& pass : passes) {
+        pass->setViewport(viewport);
+    }
+}
+
+void RenderGraph::setLazyShaderCompilation(bool lazy) {
+    lazyShaderCompilation = lazy;
+    for (auto& pass : passes) {
+        pass->setLazyShaderCompilation(lazy);
+    }
+}
+
+void RenderGraph::createRenderPass() {
+    if (passes.empty()) {
+        return;
+    }
+    for (auto& pass : passes) {
+        pass->waitForWarmUp();
+    }
+    graphics = passes.front()->getGraphics();
+    if (!lazyShaderCompilation) {
+        // before the passes are created, so that their warm up finds the permutations queued
+        graphics->getShaderCompiler()->compileAllPermutations();
+    }
+    RenderGraphCompiler compiler;
+    for (auto& pass : passes) {
+        RenderGraphPassDesc desc = pass->getDeclaration();
+        desc.name = typeid(**pass).name();
+        if (desc.reads.empty() && desc.writes.empty()) {
+            // without declarations there is no telling what the pass contributes, so it always runs in the order it was added
+            desc.sideEffects = true;
+        }
+        compiler.addPass(std::move(desc));
+    }
+    for (const auto& output : outputs) {
+        compiler.markOutput(output);
+    }
+    // culled passes do not even create their outputs
+    Array<uint32> alive = compiler.sortPasses();
+    for (uint32 index : alive) {
+        // setup work a pass dispatches has to run on the queue that owns the resources it creates for it
+        Gfx::Graphics::setComputeQueue(passes[index]->getDeclaration().queue);
+        passes[index]->publishOutputs();
+    }
+    Gfx::Graphics::setComputeQueue(Gfx::QueueType::GRAPHICS);
+    schedule = compiler.compile();
+    for (uint32 index : schedule.order) {
+        passes[index]->createRenderPass();
+    }
+    for (uint32 index : schedule.order) {
+        passes[index]->warmUpPipelines();
+    }
+}
+
+void RenderGraph::render(const Component::Camera& cam, const Component::Transform& transform) {
+    for (uint32 i = 0; i < schedule.order.size(); ++i) {
+        Gfx::Graphics::setComputeQueue(schedule.queues[i]);
+        passes[schedule.order[i]]->beginFrame(cam, transform);
+    }
+    for (uint32 i = 0; i < schedule.order.size(); ++i) {
+        Gfx::QueueType queue = schedule.queues[i];
+        // the release has to be submitted before the handoff, so it is part of what the other queue waits for
+        for (const auto& barrier : schedule.barriers[i]) {
+            if (barrier.srcQueue != queue) {
+                res->transferOwnership(barrier.resource, queue);
+            }
+        }
+        Array<Gfx::QueueType> handedOver;
+        for (Gfx::QueueType waitQueue : schedule.queueWaits[i]) {
+            if (graphics->queueHandoff(waitQueue, queue)) {
+                handedOver.add(waitQueue);
+            }
+        }
+        Gfx::Graphics::setComputeQueue(queue);
+        for (RenderGraphBarrier barrier : schedule.barriers[i]) {
+            if (handedOver.contains(barrier.srcQueue)) {
+                // the semaphore already waits for all work of the other queue, whose stages might not even exist on this one
+                if (barrier.newLayout == Gfx::SE_IMAGE_LAYOUT_UNDEFINED) {
+                    continue;
+                }
+                barrier.srcAccess = Gfx::SE_ACCESS_NONE;
+                barrier.srcStage = Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            }
+            res->applyBarrier(barrier);
+        }
+        passes[schedule.order[i]]->render();
+    }
+    for (uint32 i = 0; i < schedule.order.size(); ++i) {
+        Gfx::Graphics::setComputeQueue(schedule.queues[i]);
+        passes[schedule.order[i]]->endFrame();
+    }
+    Gfx::Graphics::setComputeQueue(Gfx::QueueType::GRAPHICS);
+}
@@ -1,45 +1,35 @@
 #pragma once
+#include "RenderGraphCompiler.h"
 #include "RenderGraphResources.h"
 #include "RenderPass.h"
 
 namespace Seele {
 class RenderGraph {
   public:
-    RenderGraph() { res = new RenderGraphResources(); }
-    void addPass(ORenderPass pass) {
-        pass->setResources(res);
-        passes.add(std::move(pass));
-    }
-    void setViewport(Gfx::PViewport viewport) {
-        for (auto& pass : passes) {
-            pass->setViewport(viewport);
-        }
-    }
-    void createRenderPass() {
-        for (auto& pass : passes) {
-            pass->publishOutputs();
-        }
-        for (auto& pass : passes) {
-            pass->createRenderPass();
-        }
-    }
-    void render(const Component::Camera& cam, const Component::Transform& transform) {
-        for (auto& pass : passes) {
-            pass->beginFrame(cam, transform);
-        }
-        for (auto& pass : passes) {
-            pass->render();
-        }
-        for (auto& pass : passes) {
-            pass->endFrame();
-        }
-    }
-    PRenderGraphResources getResources() {
-        return res;
-    }
+    RenderGraph();
+    ~RenderGraph();
+    void addPass(ORenderPass pass);
+    // resource that is used outside of the graph, like the image an editor view displays
+    // passes that draw to a viewport are kept anyway
+    void markOutput(const std::string& resource);
+    void setViewport(Gfx::PViewport viewport);
+    // passes of a lazy graph draw with the fallback material while the permutation of a material is compiling, and the
+    // permutations are only compiled once they are used, see ShaderCompiler
+    // meant for views that toggle rendering features at runtime, every other graph makes the compiler compile everything
+    void setLazyShaderCompilation(bool lazy);
+    // compiles the declarations of the passes into the schedule and creates the passes that were not culled
+    void createRenderPass();
+    void render(const Component::Camera& cam, const Component::Transform& transform);
+    PRenderGraphResources getResources() { return res; }
+    const RenderGraphSchedule& getSchedule() const { return schedule; }
+
   private:
+    Gfx::PGraphics graphics;
     ORenderGraphResources res;
-    List<ORenderPass> passes;
+    Array<ORenderPass> passes;
+    Array<std::string> outputs;
+    RenderGraphSchedule schedule;
+    bool lazyShaderCompilation = false;
 };
 
 } // namespace Seele
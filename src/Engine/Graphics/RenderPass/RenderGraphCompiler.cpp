@@ -0,0 +1,255 @@
+#include "RenderGraphCompiler.h"
+#include <fmt/format.h>
+#include <set>
+
+using namespace Seele;
+
+namespace Seele {
+// what was done to a resource since it was last written, to find out which barrier the next access needs
+struct RenderGraphResourceState {
+    Gfx::SeAccessFlags writeAccess = Gfx::SE_ACCESS_NONE;
+    Gfx::SePipelineStageFlags writeStages = 0;
+    // reads since the last write, later reads they already cover need no barrier of their own
+    Gfx::SeAccessFlags readAccess = Gfx::SE_ACCESS_NONE;
+    Gfx::SePipelineStageFlags readStages = 0;
+    // UNDEFINED while a pass manages the layout itself
+    Gfx::SeImageLayout layout = Gfx::SE_IMAGE_LAYOUT_UNDEFINED;
+    // queue of the last access, resources are owned by one queue at a time
+    Gfx::QueueType queue = Gfx::QueueType::GRAPHICS;
+    bool used = false;
+};
+} // namespace Seele
+
+RenderGraphCompiler::RenderGraphCompiler() {}
+
+RenderGraphCompiler::~RenderGraphCompiler() {}
+
+uint32 RenderGraphCompiler::addPass(RenderGraphPassDesc desc) {
+    passes.add(std::move(desc));
+    return uint32(passes.size() - 1);
+}
+
+void RenderGraphCompiler::markOutput(const std::string& resource) { outputs.addUnique(resource); }
+
+Array<uint32> RenderGraphCompiler::sortPasses() const {
+    uint32 numPasses = uint32(passes.size());
+    // passes that have to run before the pass
+    Array<Array<uint32>> dependencies(numPasses);
+    // passes whose writes the pass uses, they are kept as long as it is
+    Array<Array<uint32>> producers(numPasses);
+    Map<std::string, Array<uint32>> writers;
+    for (uint32 i = 0; i < numPasses; ++i) {
+        for (const auto& write : passes[i].writes) {
+            writers[write.resource].addUnique(i);
+        }
+    }
+    // writes of the same resource stay in the order they were added, a later one might only write parts of it
+    for (const auto& [resource, resourceWriters] : writers) {
+        for (uint32 w = 1; w < resourceWriters.size(); ++w) {
+            dependencies[resourceWriters[w]].addUnique(resourceWriters[w - 1]);
+            producers[resourceWriters[w]].addUnique(resourceWriters[w - 1]);
+        }
+    }
+    for (uint32 i = 0; i < numPasses; ++i) {
+        for (const auto& read : passes[i].reads) {
+            if (!writers.contains(read.resource)) {
+                // nothing in the graph writes it, so there is nothing to wait for
+                continue;
+            }
+            const Array<uint32>& resourceWriters = writers.at(read.resource);
+            bool readsOwnWrite = resourceWriters.contains(i);
+            if (read.previousFrame) {
+                for (uint32 writer : resourceWriters) {
+                    producers[i].addUnique(writer);
+                }
+                if (!readsOwnWrite) {
+                    dependencies[resourceWriters.front()].addUnique(i);
+                }
+                continue;
+            }
+            // the contents written by the last writer added before the reader, or by the last writer at all if the reader was
+            // added first, a pass that also writes the resource reads what the writer before it left
+            int64 source = readsOwnWrite ? -1 : int64(resourceWriters.size()) - 1;
+            for (uint32 w = 0; w < resourceWriters.size() && resourceWriters[w] < i; ++w) {
+                source = w;
+            }
+            if (source < 0) {
+                continue;
+            }
+            dependencies[i].addUnique(resourceWriters[source]);
+            producers[i].addUnique(resourceWriters[source]);
+            // the next writer must not overwrite the contents before they were read
+            if (uint32(source + 1) < resourceWriters.size() && resourceWriters[source + 1] != i) {
+                dependencies[resourceWriters[source + 1]].addUnique(i);
+            }
+        }
+    }
+
+    Array<bool> alive(numPasses, false);
+    Array<uint32> pending;
+    for (uint32 i = 0; i < numPasses; ++i) {
+        bool writesOutput = false;
+        for (const auto& write : passes[i].writes) {
+            writesOutput |= outputs.contains(write.resource);
+        }
+        if (passes[i].sideEffects || writesOutput) {
+            alive[i] = true;
+            pending.add(i);
+        }
+    }
+    while (!pending.empty()) {
+        uint32 pass = pending.back();
+        pending.pop();
+        for (uint32 producer : producers[pass]) {
+            if (!alive[producer]) {
+                alive[producer] = true;
+                pending.add(producer);
+            }
+        }
+    }
+
+    // Kahn's algorithm, always picking the pass that was added first so independent passes keep their order
+    Array<uint32> numDependencies(numPasses, 0);
+    Array<Array<uint32>> dependents(numPasses);
+    uint32 numAlive = 0;
+    for (uint32 i = 0; i < numPasses; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+        numAlive++;
+        for (uint32 dependency : dependencies[i]) {
+            if (alive[dependency]) {
+                numDependencies[i]++;
+                dependents[dependency].add(i);
+            }
+        }
+    }
+    std::set<uint32> ready;
+    for (uint32 i = 0; i < numPasses; ++i) {
+        if (alive[i] && numDependencies[i] == 0) {
+            ready.insert(i);
+        }
+    }
+    Array<uint32> order;
+    while (!ready.empty()) {
+        uint32 pass = *ready.begin();
+        ready.erase(ready.begin());
+        order.add(pass);
+        for (uint32 dependent : dependents[pass]) {
+            if (--numDependencies[dependent] == 0) {
+                ready.insert(dependent);
+            }
+        }
+    }
+    if (order.size() != numAlive) {
+        std::string cycle;
+        for (uint32 i = 0; i < numPasses; ++i) {
+            if (alive[i] && numDependencies[i] > 0) {
+                cycle += fmt::format(" {}", passes[i].name);
+            }
+        }
+        throw std::logic_error(fmt::format("Render graph passes depend on each other in a cycle:{}", cycle));
+    }
+    return order;
+}
+
+// records the barrier access needs into barriers and the queues it has to wait for into queueWaits, if not null,
+// and updates the state of the resource
+static void accessResource(RenderGraphResourceState& state, const RenderGraphAccess& access, bool write, Gfx::QueueType queue,
+                           Array<RenderGraphBarrier>* barriers, Array<Gfx::QueueType>* queueWaits) {
+    bool layoutChange = access.layout != Gfx::SE_IMAGE_LAYOUT_UNDEFINED && access.layout != state.layout;
+    // even reads need the resource handed over, it can only belong to one queue
+    bool queueChange = state.used && state.queue != queue;
+    bool written = state.writeStages != 0;
+    bool hazard = false;
+    if (write) {
+        hazard = written || state.readStages != 0;
+    } else {
+        // reads that earlier reads already waited for can go ahead without another barrier
+        hazard = written && ((access.stage & ~state.readStages) != 0 || (access.access & ~state.readAccess) != 0);
+    }
+    if (barriers != nullptr && (hazard || layoutChange || queueChange)) {
+        RenderGraphBarrier barrier = {
+            .resource = access.resource,
+            .srcAccess = state.writeAccess,
+            // reads only wait for the write, writes and layout transitions also for the reads before them
+            .srcStage = (write || layoutChange) ? state.writeStages | state.readStages : state.writeStages,
+            .dstAccess = access.access,
+            .dstStage = access.stage,
+            .newLayout = layoutChange ? access.layout : Gfx::SE_IMAGE_LAYOUT_UNDEFINED,
+            .srcQueue = state.used ? state.queue : queue,
+            .dstQueue = queue,
+        };
+        if (barrier.srcStage == 0) {
+            // nothing in the graph wrote it, so it could have been anything outside of it
+            barrier.srcAccess = Gfx::SE_ACCESS_MEMORY_WRITE_BIT;
+            barrier.srcStage = Gfx::SE_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        }
+        barriers->add(std::move(barrier));
+    }
+    if (queueWaits != nullptr && queueChange) {
+        queueWaits->addUnique(state.queue);
+    }
+    state.queue = queue;
+    state.used = true;
+    if (write) {
+        state.writeAccess = access.access;
+        state.writeStages = access.stage;
+        state.readAccess = Gfx::SE_ACCESS_NONE;
+        state.readStages = 0;
+        // a pass that manages the layout itself leaves it in whatever layout it likes
+        state.layout = access.layout;
+    } else if (layoutChange) {
+        // the transition is a write of its own, so only the reads after it count
+        state.readAccess = access.access;
+        state.readStages = access.stage;
+        state.layout = access.layout;
+    } else {
+        state.readAccess |= access.access;
+        state.readStages |= access.stage;
+    }
+}
+
+RenderGraphSchedule RenderGraphCompiler::compile() const {
+    RenderGraphSchedule schedule;
+    schedule.order = sortPasses();
+
+    Map<std::string, RenderGraphResourceState> states;
+    auto recordPass = [&](const RenderGraphPassDesc& pass, Array<RenderGraphBarrier>* barriers, Array<Gfx::QueueType>* queueWaits) {
+        // a resource that is read and written by the same pass needs only one barrier
+        Map<std::string, Pair<RenderGraphAccess, bool>> accesses;
+        for (const auto& read : pass.reads) {
+            if (!accesses.contains(read.resource)) {
+                accesses[read.resource] = Pair<RenderGraphAccess, bool>{read, false};
+                continue;
+            }
+            accesses[read.resource].key.access |= read.access;
+            accesses[read.resource].key.stage |= read.stage;
+        }
+        for (const auto& write : pass.writes) {
+            if (!accesses.contains(write.resource)) {
+                accesses[write.resource] = Pair<RenderGraphAccess, bool>{write, true};
+                continue;
+            }
+            RenderGraphAccess& merged = accesses[write.resource].key;
+            merged.access |= write.access;
+            merged.stage |= write.stage;
+            if (write.layout != Gfx::SE_IMAGE_LAYOUT_UNDEFINED) {
+                merged.layout = write.layout;
+            }
+            accesses[write.resource].value = true;
+        }
+        for (const auto& [resource, access] : accesses) {
+            accessResource(states[resource], access.key, access.value, pass.queue, barriers, queueWaits);
+        }
+    };
+    // every frame runs the same passes, so the first one has to wait for what the last one left behind
+    for (uint32 pass : schedule.order) {
+        recordPass(passes[pass], nullptr, nullptr);
+    }
+    for (uint32 pass : schedule.order) {
+        schedule.queues.add(passes[pass].queue);
+        recordPass(passes[pass], &schedule.barriers.add(), &schedule.queueWaits.add());
+    }
+    return schedule;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Graphics/Enums.h"
+#include "MinimalEngine.h"
+
+namespace Seele {
+// how a pass uses one of the resources of its graph
+struct RenderGraphAccess {
+    std::string resource;
+    Gfx::SeAccessFlags access = Gfx::SE_ACCESS_NONE;
+    Gfx::SePipelineStageFlags stage = Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    // the graph transitions textures into this layout before the pass runs
+    // UNDEFINED leaves the layout to the pass, like render pass attachments that are transitioned by their render pass
+    Gfx::SeImageLayout layout = Gfx::SE_IMAGE_LAYOUT_UNDEFINED;
+    // reads what the previous frame wrote, so the pass runs before the writers of the current frame instead of after them
+    bool previousFrame = false;
+};
+
+struct RenderGraphPassDesc {
+    std::string name;
+    Array<RenderGraphAccess> reads;
+    Array<RenderGraphAccess> writes;
+    // kept even if none of its writes are used, like passes that draw to a viewport
+    bool sideEffects = false;
+    // COMPUTE runs the pass on the async compute queue, so it can overlap with the rasterization of the passes around it
+    Gfx::QueueType queue = Gfx::QueueType::GRAPHICS;
+};
+
+struct RenderGraphBarrier {
+    std::string resource;
+    Gfx::SeAccessFlags srcAccess;
+    Gfx::SePipelineStageFlags srcStage;
+    Gfx::SeAccessFlags dstAccess;
+    Gfx::SePipelineStageFlags dstStage;
+    // UNDEFINED if the barrier does not change the layout
+    Gfx::SeImageLayout newLayout = Gfx::SE_IMAGE_LAYOUT_UNDEFINED;
+    // the queue that used the resource last, the resource is handed over to dstQueue if they differ
+    Gfx::QueueType srcQueue = Gfx::QueueType::GRAPHICS;
+    Gfx::QueueType dstQueue = Gfx::QueueType::GRAPHICS;
+};
+
+struct RenderGraphSchedule {
+    // indices of the passes that were not culled, in the order they are executed
+    Array<uint32> order;
+    // barriers[i] have to be recorded right before the pass order[i]
+    Array<Array<RenderGraphBarrier>> barriers;
+    // queue the pass order[i] runs on
+    Array<Gfx::QueueType> queues;
+    // other queues whose work so far has to be finished before the pass order[i] starts
+    Array<Array<Gfx::QueueType>> queueWaits;
+};
+
+// turns the declared reads and writes of the passes into an execution order, culls the passes that do not contribute to
+// an output and places the barriers between them, without needing a graphics backend
+class RenderGraphCompiler {
+  public:
+    RenderGraphCompiler();
+    ~RenderGraphCompiler();
+    // returns the index the pass has in the schedule
+    uint32 addPass(RenderGraphPassDesc desc);
+    // resource that is used outside of the graph, every pass it depends on is kept
+    void markOutput(const std::string& resource);
+    // passes that are not culled in execution order, throws if they depend on each other in a cycle
+    Array<uint32> sortPasses() const;
+    RenderGraphSchedule compile() const;
+
+  private:
+    Array<RenderGraphPassDesc> passes;
+    Array<std::string> outputs;
+};
+} // namespace Seele
@@ -44,3 +44,37 @@ void RenderGraphResources::registerQueryOutput(const std::string& outputName, Gf
 void Seele::RenderGraphResources::registerTimestampQueryOutput(const std::string& outputName, Gfx::PTimestampQuery query) {
     registeredTimestamps[outputName] = query;
 }
+
+void RenderGraphResources::transferOwnership(const std::string& resource, Gfx::QueueType newOwner) {
+    if (registeredBuffers.contains(resource)) {
+        registeredBuffers[resource]->transferOwnership(newOwner);
+    } else if (registeredUniforms.contains(resource)) {
+        registeredUniforms[resource]->transferOwnership(newOwner);
+    } else if (registeredTextures.contains(resource)) {
+        registeredTextures[resource]->transferOwnership(newOwner);
+    } else if (registeredAttachments.contains(resource)) {
+        registeredAttachments[resource].getTextureView()->transferOwnership(newOwner);
+    }
+}
+
+void RenderGraphResources::applyBarrier(const RenderGraphBarrier& barrier) {
+    if (registeredBuffers.contains(barrier.resource)) {
+        registeredBuffers[barrier.resource]->pipelineBarrier(barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+    } else if (registeredUniforms.contains(barrier.resource)) {
+        registeredUniforms[barrier.resource]->pipelineBarrier(barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+    } else if (registeredTextures.contains(barrier.resource)) {
+        Gfx::PTexture texture = registeredTextures[barrier.resource];
+        if (barrier.newLayout != Gfx::SE_IMAGE_LAYOUT_UNDEFINED) {
+            texture->changeLayout(barrier.newLayout, barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+        } else {
+            texture->pipelineBarrier(barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+        }
+    } else if (registeredAttachments.contains(barrier.resource)) {
+        Gfx::PTextureView view = registeredAttachments[barrier.resource].getTextureView();
+        if (barrier.newLayout != Gfx::SE_IMAGE_LAYOUT_UNDEFINED) {
+            view->changeLayout(barrier.newLayout, barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+        } else {
+            view->pipelineBarrier(barrier.srcAccess, barrier.srcStage, barrier.dstAccess, barrier.dstStage);
+        }
+    }
+}
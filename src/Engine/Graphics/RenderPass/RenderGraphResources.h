@@ -4,10 +4,12 @@
 #include "Graphics/RenderTarget.h"
 #include "Graphics/Texture.h"
 #include "MinimalEngine.h"
+#include "RenderGraphCompiler.h"
 
 
 namespace Seele {
 DECLARE_REF(ViewFrame)
+DECLARE_NAME_REF(Gfx, Graphics)
 
 class RenderGraphResources {
   public:
@@ -25,6 +27,9 @@ class RenderGraphResources {
     void registerUniformOutput(const std::string& outputName, Gfx::PUniformBuffer buffer);
     void registerQueryOutput(const std::string& outputName, Gfx::PPipelineStatisticsQuery query);
     void registerTimestampQueryOutput(const std::string& outputName, Gfx::PTimestampQuery query);
+    // releases the resource on the queue that owns it and acquires it on newOwner, nothing happens if both share a queue family
+    void transferOwnership(const std::string& resource, Gfx::QueueType newOwner);
+    void applyBarrier(const RenderGraphBarrier& barrier);
 
   protected:
     Map<std::string, Gfx::RenderTargetAttachment> registeredAttachments;
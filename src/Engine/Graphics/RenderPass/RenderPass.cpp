@@ -1,27 +1,117 @@
 #include "RenderPass.h"
+#include "Graphics/Graphics.h"
+#include <iostream>
 
 using namespace Seele;
 
 RenderPass::RenderPass(Gfx::PGraphics graphics) : graphics(graphics) {
     viewParamsLayout = graphics->createDescriptorLayout("pViewParams");
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "viewMatrix", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "inverseViewMatrix", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "projectionMatrix", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "inverseProjection", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "viewProjectionMatrix", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "inverseViewProjectionMatrix", .uniformLength = sizeof(Matrix4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "cameraPosition_WS", .uniformLength = sizeof(Vector4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "cameraForward_WS", .uniformLength = sizeof(Vector4)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "screenDimensions", .uniformLength = sizeof(Vector2)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "invScreenDimensions", .uniformLength = sizeof(Vector2)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "frameIndex", .uniformLength = sizeof(uint32)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "time", .uniformLength = sizeof(float)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "pad0", .uniformLength = sizeof(float)});
-    viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = "pad1", .uniformLength = sizeof(float)});
+    auto addViewParam = [&](const char* name, auto& field) {
+        viewParamsBindings.add(Pair<Gfx::DescriptorBindingHandle, uint64>{
+            .key = viewParamsLayout->addDescriptorBinding(Gfx::DescriptorBinding{.name = name, .uniformLength = sizeof(field)}),
+            .value = (uint64)((uint8*)&field - (uint8*)&viewParams),
+        });
+    };
+    addViewParam("viewMatrix", viewParams.viewMatrix);
+    addViewParam("inverseViewMatrix", viewParams.inverseViewMatrix);
+    addViewParam("projectionMatrix", viewParams.projectionMatrix);
+    addViewParam("inverseProjection", viewParams.inverseProjection);
+    addViewParam("viewProjectionMatrix", viewParams.viewProjectionMatrix);
+    addViewParam("inverseViewProjectionMatrix", viewParams.inverseViewProjectionMatrix);
+    addViewParam("cameraPosition_WS", viewParams.cameraPosition_WS);
+    addViewParam("cameraForward_WS", viewParams.cameraForward_WS);
+    addViewParam("screenDimensions", viewParams.screenDimensions);
+    addViewParam("invScreenDimensions", viewParams.invScreenDimensions);
+    addViewParam("frameIndex", viewParams.frameIndex);
+    addViewParam("time", viewParams.time);
+    addViewParam("pad0", viewParams.pad0);
+    addViewParam("pad1", viewParams.pad1);
     viewParamsLayout->create();
 }
 
-RenderPass::~RenderPass() {}
+RenderPass::~RenderPass() { waitForWarmUp(); }
+
+void RenderPass::waitForWarmUp() {
+    for (auto& job : warmUpJobs) {
+        job.wait();
+    }
+    warmUpJobs.clear();
+}
+
+Gfx::PGraphicsPipeline RenderPass::createPermutationPipeline(const Gfx::ShaderCollection* collection, Gfx::SeSampleCountFlags samples,
+                                                             bool blending) {
+    Gfx::ColorBlendState colorBlend = {
+        .attachmentCount = 1,
+    };
+    colorBlend.blendAttachments[0].blendEnable = blending;
+    if (graphics->supportMeshShading()) {
+        return graphics->createGraphicsPipeline(Gfx::MeshPipelineCreateInfo{
+            .taskShader = collection->taskShader,
+            .meshShader = collection->meshShader,
+            .fragmentShader = collection->fragmentShader,
+            .renderPass = renderPass,
+            .pipelineLayout = collection->pipelineLayout,
+            .multisampleState =
+                {
+                    .samples = samples,
+                },
+            .rasterizationState =
+                {
+                    .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
+                },
+            .colorBlend = colorBlend,
+        });
+    }
+    return graphics->createGraphicsPipeline(Gfx::LegacyPipelineCreateInfo{
+        .vertexShader = collection->vertexShader,
+        .fragmentShader = collection->fragmentShader,
+        .renderPass = renderPass,
+        .pipelineLayout = collection->pipelineLayout,
+        .multisampleState =
+            {
+                .samples = samples,
+            },
+        .rasterizationState =
+            {
+                .cullMode = Gfx::SE_CULL_MODE_BACK_BIT,
+            },
+        .colorBlend = colorBlend,
+    });
+}
+
+void RenderPass::warmUpPipeline(Gfx::PermutationId id, Gfx::SeSampleCountFlags samples, bool blending) {
+    auto promise = std::make_shared<std::promise<void>>();
+    // the pipeline is created right after the compilation of the permutation, so no worker ever waits for it
+    auto createPipeline = [this, samples, blending, promise](const Gfx::ShaderCollection* collection) {
+        if (collection != nullptr) {
+            try {
+                createPermutationPipeline(collection, samples, blending);
+            } catch (const std::exception& e) {
+                // the pass reports the error once it actually needs the permutation
+                std::cout << "Pipeline warm up failed: " << e.what() << std::endl;
+            }
+        }
+        promise->set_value();
+    };
+    if (graphics->getShaderCompiler()->whenCompiled(id, std::move(createPipeline))) {
+        warmUpJobs.add(promise->get_future().share());
+    }
+    // otherwise it was never registered or deferred by lazy compilation, the first use will create it
+}
+
+void RenderPass::declareRead(RenderGraphAccess access) { declaration.reads.add(std::move(access)); }
+
+void RenderPass::declareWrite(RenderGraphAccess access) { declaration.writes.add(std::move(access)); }
+
+void RenderPass::declareUploadReads(const Array<Pair<std::string, Gfx::PShaderBuffer>>& buffers, Gfx::SePipelineStageFlags stage) {
+    for (const auto& [resource, buffer] : buffers) {
+        declareRead(RenderGraphAccess{
+            .resource = resource,
+            .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+            .stage = stage,
+        });
+    }
+}
 
 void RenderPass::setResources(PRenderGraphResources _resources) { resources = _resources; }
 
@@ -72,20 +162,9 @@ Gfx::ODescriptorSet RenderPass::createViewParamsSet()
     // extract_planes_from_view_projection_matrix(viewParams.viewProjectionMatrix, viewParams.viewFrustum);
 
     Gfx::ODescriptorSet viewParamsSet = viewParamsLayout->allocateDescriptorSet();
-    viewParamsSet->updateConstants("viewMatrix", 0, &viewParams.viewMatrix);
-    viewParamsSet->updateConstants("inverseViewMatrix", 0, &viewParams.inverseViewMatrix);
-    viewParamsSet->updateConstants("projectionMatrix", 0, &viewParams.projectionMatrix);
-    viewParamsSet->updateConstants("inverseProjection", 0, &viewParams.inverseProjection);
-    viewParamsSet->updateConstants("viewProjectionMatrix", 0, &viewParams.viewProjectionMatrix);
-    viewParamsSet->updateConstants("inverseViewProjectionMatrix", 0, &viewParams.inverseViewProjectionMatrix);
-    viewParamsSet->updateConstants("cameraPosition_WS", 0, &viewParams.cameraPosition_WS);
-    viewParamsSet->updateConstants("cameraForward_WS", 0, &viewParams.cameraForward_WS);
-    viewParamsSet->updateConstants("screenDimensions", 0, &viewParams.screenDimensions);
-    viewParamsSet->updateConstants("invScreenDimensions", 0, &viewParams.invScreenDimensions);
-    viewParamsSet->updateConstants("frameIndex", 0, &viewParams.frameIndex);
-    viewParamsSet->updateConstants("time", 0, &viewParams.time);
-    viewParamsSet->updateConstants("pad0", 0, &viewParams.pad0);
-    viewParamsSet->updateConstants("pad1", 0, &viewParams.pad1);
+    for (const auto& [binding, offset] : viewParamsBindings) {
+        viewParamsSet->updateConstants(binding, 0, (uint8*)&viewParams + offset);
+    }
     viewParamsSet->writeChanges();
     return viewParamsSet;
 }
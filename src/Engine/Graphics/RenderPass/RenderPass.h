@@ -1,9 +1,11 @@
 #pragma once
 #include "Component/Camera.h"
+#include "Graphics/Shader.h"
 #include "Graphics/VertexData.h"
 #include "Material/MaterialInstance.h"
 #include "Math/Math.h"
 #include "MinimalEngine.h"
+#include "RenderGraphCompiler.h"
 #include "RenderGraphResources.h"
 #include "Scene/Scene.h"
 
@@ -23,10 +25,31 @@ class RenderPass {
     virtual void endFrame() = 0;
     virtual void publishOutputs() = 0;
     virtual void createRenderPass() = 0;
+    // queues the pipelines of all known permutations on the thread pool, so they are cached before they are first used
+    virtual void warmUpPipelines() {}
+    // has to be called before the render pass gets recreated, the warm up jobs use it
+    void waitForWarmUp();
     void setResources(PRenderGraphResources _resources);
     void setViewport(Gfx::PViewport _viewport);
+    // see RenderGraph::setLazyShaderCompilation
+    void setLazyShaderCompilation(bool lazy) { lazyShaderCompilation = lazy; }
+    Gfx::PGraphics getGraphics() const { return graphics; }
+    // the graph orders, culls and synchronizes the passes by what they read and write
+    const RenderGraphPassDesc& getDeclaration() const { return declaration; }
 
   protected:
+    // declared in the constructor, barriers between passes are recorded by the graph from these
+    // barriers between work inside of a pass are still up to the pass
+    void declareRead(RenderGraphAccess access);
+    void declareWrite(RenderGraphAccess access);
+    // shader reads of buffers the UploadPass writes, like the ones of VertexData::getUploadedBuffers
+    void declareUploadReads(const Array<Pair<std::string, Gfx::PShaderBuffer>>& buffers, Gfx::SePipelineStageFlags stage);
+    // pipeline used to draw a shader permutation of this pass, so warm up and rendering create the exact same state
+    Gfx::PGraphicsPipeline createPermutationPipeline(const Gfx::ShaderCollection* collection, Gfx::SeSampleCountFlags samples = 1,
+                                                     bool blending = false);
+    // only permutations that are already queued for compilation are warmed up
+    // the jobs can outlive the derived pass until the base destructor, so they may only touch base members
+    void warmUpPipeline(Gfx::PermutationId id, Gfx::SeSampleCountFlags samples = 1, bool blending = false);
     void updateViewParameters(const Component::Camera& cam, const Component::Transform& transform);
     Gfx::ODescriptorSet createViewParamsSet();
     struct Plane {
@@ -67,11 +90,17 @@ class RenderPass {
         uint32 pad0;
         uint32 pad1;
     } viewParams;
+    RenderGraphPassDesc declaration;
     PRenderGraphResources resources;
     Gfx::ODescriptorLayout viewParamsLayout;
+    // every member of viewParams with its offset in it
+    Array<Pair<Gfx::DescriptorBindingHandle, uint64>> viewParamsBindings;
     Gfx::ORenderPass renderPass;
     Gfx::PGraphics graphics;
     Gfx::PViewport viewport;
+    // passed to ShaderCompiler::findShaders
+    bool lazyShaderCompilation = false;
+    Array<std::shared_future<void>> warmUpJobs;
 };
 DEFINE_REF(RenderPass)
 template <typename RP>
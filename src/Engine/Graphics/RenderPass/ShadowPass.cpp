@@ -10,6 +10,22 @@
 using namespace Seele;
 
 ShadowPass::ShadowPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    declareRead(RenderGraphAccess{
+        .resource = "CULLINGBUFFER",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT,
+    });
+    for (VertexData* vd : VertexData::getList()) {
+        declareUploadReads(vd->getUploadedBuffers(),
+                           Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT);
+    }
+    for (uint32 i = 0; i < NUM_CASCADES; ++i) {
+        declareWrite(RenderGraphAccess{
+            .resource = fmt::format("SHADOWMAP_TEXTURE{0}", i),
+            .access = Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | Gfx::SE_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .stage = Gfx::SE_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | Gfx::SE_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+        });
+    }
     shadowLayout = graphics->createPipelineLayout("ShadowLayout");
     shadowLayout->addDescriptorLayout(viewParamsLayout);
     shadowLayout->addPushConstants(Gfx::SePushConstantRange{
@@ -179,7 +195,7 @@ void ShadowPass::render() {
                 Gfx::ORenderCommand command = graphics->createRenderCommand("ShadowRender");
                 command->setViewport(shadowViewport);
 
-                const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id);
+                const Gfx::ShaderCollection* collection = graphics->getShaderCompiler()->findShaders(id, lazyShaderCompilation);
                 constexpr float depthBiasConstant = -1.25f;
                 constexpr float depthBiasSlope = -1.75f;
                 if (graphics->supportMeshShading()) {
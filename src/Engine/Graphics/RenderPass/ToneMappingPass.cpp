@@ -3,32 +3,40 @@
 using namespace Seele;
 
 ToneMappingPass::ToneMappingPass(Gfx::PGraphics graphics) : RenderPass(graphics) {
+    declareRead(RenderGraphAccess{
+        .resource = "BASEPASS_COLOR",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        .layout = Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    });
+    // draws to the viewport
+    declaration.sideEffects = true;
     tonemappingLayout = graphics->createDescriptorLayout("pToneMappingParams");
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    offsetBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "offset",
         .uniformLength = sizeof(Vector4),
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    slopeBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "slope",
         .uniformLength = sizeof(Vector4),
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    powerBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "power",
         .uniformLength = sizeof(Vector4),
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    satBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "sat",
         .uniformLength = sizeof(float),
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    hdrInputTextureBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "hdrInputTexture",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    hdrSamplerBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "hdrSampler",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
-    tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    tonemappingLuminanceBinding = tonemappingLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "averageLuminance",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
@@ -51,31 +59,31 @@ ToneMappingPass::ToneMappingPass(Gfx::PGraphics graphics) : RenderPass(graphics)
     frag = graphics->createFragmentShader({1});
 
     histogramLayout = graphics->createDescriptorLayout("pHistogramParams");
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    minLogLumBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "minLogLum",
         .uniformLength = sizeof(float),
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    inverseLogLumRangeBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "inverseLogLumRange",
         .uniformLength = sizeof(float),
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    timeCoeffBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "timeCoeff",
         .uniformLength = sizeof(float),
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    numPixelsBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "numPixels",
         .uniformLength = sizeof(uint32),
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    hdrImageBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "hdrImage",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    histogramBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "histogram",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    histogramLuminanceBinding = histogramLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "averageLuminance",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
@@ -130,19 +138,16 @@ void ToneMappingPass::beginFrame(const Component::Camera& cam, const Component::
 
 void ToneMappingPass::render() {
     graphics->beginDebugRegion("ToneMapping");
-    hdrInputTexture.getTextureView()->changeLayout(Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                                               Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, Gfx::SE_ACCESS_SHADER_READ_BIT,
-                                               Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
 
     histogramLayout->reset();
     histogramSet = histogramLayout->allocateDescriptorSet();
-    histogramSet->updateConstants("minLogLum", 0, &minLogLum);
-    histogramSet->updateConstants("inverseLogLumRange", 0, &inverseLogLumRange);
-    histogramSet->updateConstants("timeCoeff", 0, &timeCoeff);
-    histogramSet->updateConstants("numPixels", 0, &numPixels);
-    histogramSet->updateTexture("hdrImage", 0, hdrInputTexture.getTextureView());
-    histogramSet->updateBuffer("histogram", 0, histogramBuffer);
-    histogramSet->updateBuffer("averageLuminance", 0, luminanceBuffer);
+    histogramSet->updateConstants(minLogLumBinding, 0, &minLogLum);
+    histogramSet->updateConstants(inverseLogLumRangeBinding, 0, &inverseLogLumRange);
+    histogramSet->updateConstants(timeCoeffBinding, 0, &timeCoeff);
+    histogramSet->updateConstants(numPixelsBinding, 0, &numPixels);
+    histogramSet->updateTexture(hdrImageBinding, 0, hdrInputTexture.getTextureView());
+    histogramSet->updateBuffer(histogramBinding, 0, histogramBuffer);
+    histogramSet->updateBuffer(histogramLuminanceBinding, 0, luminanceBuffer);
     histogramSet->writeChanges();
 
     {
@@ -169,13 +174,13 @@ void ToneMappingPass::render() {
 
     tonemappingLayout->reset();
     Gfx::ODescriptorSet tonemappingSet = tonemappingLayout->allocateDescriptorSet();
-    tonemappingSet->updateConstants("offset", 0, &offset);
-    tonemappingSet->updateConstants("slope", 0, &slope);
-    tonemappingSet->updateConstants("power", 0, &power);
-    tonemappingSet->updateConstants("sat", 0, &sat);
-    tonemappingSet->updateTexture("hdrInputTexture", 0, hdrInputTexture.getTextureView());
-    tonemappingSet->updateSampler("hdrSampler", 0, sampler);
-    tonemappingSet->updateBuffer("averageLuminance", 0, luminanceBuffer);
+    tonemappingSet->updateConstants(offsetBinding, 0, &offset);
+    tonemappingSet->updateConstants(slopeBinding, 0, &slope);
+    tonemappingSet->updateConstants(powerBinding, 0, &power);
+    tonemappingSet->updateConstants(satBinding, 0, &sat);
+    tonemappingSet->updateTexture(hdrInputTextureBinding, 0, hdrInputTexture.getTextureView());
+    tonemappingSet->updateSampler(hdrSamplerBinding, 0, sampler);
+    tonemappingSet->updateBuffer(tonemappingLuminanceBinding, 0, luminanceBuffer);
     tonemappingSet->writeChanges();
     graphics->beginRenderPass(renderPass);
     Gfx::ORenderCommand command = graphics->createRenderCommand("ToneMapping");
@@ -28,6 +28,13 @@ class ToneMappingPass : public RenderPass {
     uint32 numPixels;
     UVector2 threadGroups;
     Gfx::ODescriptorLayout histogramLayout;
+    Gfx::DescriptorBindingHandle minLogLumBinding;
+    Gfx::DescriptorBindingHandle inverseLogLumRangeBinding;
+    Gfx::DescriptorBindingHandle timeCoeffBinding;
+    Gfx::DescriptorBindingHandle numPixelsBinding;
+    Gfx::DescriptorBindingHandle hdrImageBinding;
+    Gfx::DescriptorBindingHandle histogramBinding;
+    Gfx::DescriptorBindingHandle histogramLuminanceBinding;
     Gfx::ODescriptorSet histogramSet;
     Gfx::OPipelineLayout histogramPipelineLayout;
     Gfx::OComputeShader histogramShader;
@@ -43,6 +50,13 @@ class ToneMappingPass : public RenderPass {
     Vector4 power = Vector4(1.0);
     float sat = 1.0;
     Gfx::ODescriptorLayout tonemappingLayout;
+    Gfx::DescriptorBindingHandle offsetBinding;
+    Gfx::DescriptorBindingHandle slopeBinding;
+    Gfx::DescriptorBindingHandle powerBinding;
+    Gfx::DescriptorBindingHandle satBinding;
+    Gfx::DescriptorBindingHandle hdrInputTextureBinding;
+    Gfx::DescriptorBindingHandle hdrSamplerBinding;
+    Gfx::DescriptorBindingHandle tonemappingLuminanceBinding;
     Gfx::OPipelineLayout tonemappingPipelineLayout;
     Gfx::OVertexShader vert;
     Gfx::OFragmentShader frag;
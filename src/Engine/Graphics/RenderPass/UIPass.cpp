@@ -12,15 +12,15 @@ UIPass::UIPass(Gfx::PGraphics graphics, UI::PSystem system) : RenderPass(graphic
     glyphInstanceBuffer = graphics->createShaderBuffer(ShaderBufferCreateInfo{.name = "GlyphInstanceBuffer"});
     elementBuffer = graphics->createShaderBuffer(ShaderBufferCreateInfo{.name = "RenderStyleElements"});
     textDescriptorLayout = graphics->createDescriptorLayout("pText");
-    textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    glyphInstanceBinding = textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = GLYPHINSTANCE_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    textSamplerBinding = textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = GLYPHSAMPLER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
-    textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    textTexturesBinding = textDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TEXTURES_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .descriptorCount = 1024,
@@ -31,15 +31,15 @@ UIPass::UIPass(Gfx::PGraphics graphics, UI::PSystem system) : RenderPass(graphic
     textPipelineLayout->addDescriptorLayout(textDescriptorLayout);
 
     uiDescriptorLayout = graphics->createDescriptorLayout("pParams");
-    uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    elementBinding = uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = ELEMENT_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    uiSamplerBinding = uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = GLYPHSAMPLER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
-    uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    uiTexturesBinding = uiDescriptorLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = TEXTURES_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .descriptorCount = 1024,
@@ -85,10 +85,10 @@ void UIPass::beginFrame(const Component::Camera& cam, const Component::Transform
 
     textDescriptorLayout->reset();
     textDescriptorSet = textDescriptorLayout->allocateDescriptorSet();
-    textDescriptorSet->updateBuffer(GLYPHINSTANCE_NAME, 0, glyphInstanceBuffer);
-    textDescriptorSet->updateSampler(GLYPHSAMPLER_NAME, 0, glyphSampler);
+    textDescriptorSet->updateBuffer(glyphInstanceBinding, 0, glyphInstanceBuffer);
+    textDescriptorSet->updateSampler(textSamplerBinding, 0, glyphSampler);
     for (uint32 i = 0; i < usedTextures.size(); ++i) {
-        textDescriptorSet->updateTexture(TEXTURES_NAME, i, usedTextures[i]->getDefaultView());
+        textDescriptorSet->updateTexture(textTexturesBinding, i, usedTextures[i]->getDefaultView());
     }
     textDescriptorSet->writeChanges();
 
@@ -98,10 +98,10 @@ void UIPass::beginFrame(const Component::Camera& cam, const Component::Transform
                                    Gfx::SE_PIPELINE_STAGE_VERTEX_SHADER_BIT);
     uiDescriptorLayout->reset();
     uiDescriptorSet = uiDescriptorLayout->allocateDescriptorSet();
-    uiDescriptorSet->updateBuffer(ELEMENT_NAME, 0, elementBuffer);
-    uiDescriptorSet->updateSampler(GLYPHSAMPLER_NAME, 0, glyphSampler);
+    uiDescriptorSet->updateBuffer(elementBinding, 0, elementBuffer);
+    uiDescriptorSet->updateSampler(uiSamplerBinding, 0, glyphSampler);
     for (uint32 i = 0; i < usedTextures.size(); ++i) {
-        uiDescriptorSet->updateTexture(TEXTURES_NAME, i, usedTextures[i]->getDefaultView());
+        uiDescriptorSet->updateTexture(uiTexturesBinding, i, usedTextures[i]->getDefaultView());
     }
     uiDescriptorSet->writeChanges();
 }
@@ -52,6 +52,9 @@ class UIPass : public RenderPass {
     Gfx::OTexture2D depthBuffer;
 
     Gfx::ODescriptorLayout textDescriptorLayout;
+    Gfx::DescriptorBindingHandle glyphInstanceBinding;
+    Gfx::DescriptorBindingHandle textSamplerBinding;
+    Gfx::DescriptorBindingHandle textTexturesBinding;
     Gfx::ODescriptorSet textDescriptorSet;
 
     Gfx::OVertexShader textVertexShader;
@@ -60,6 +63,9 @@ class UIPass : public RenderPass {
     Gfx::PGraphicsPipeline textPipeline;
 
     Gfx::ODescriptorLayout uiDescriptorLayout;
+    Gfx::DescriptorBindingHandle elementBinding;
+    Gfx::DescriptorBindingHandle uiSamplerBinding;
+    Gfx::DescriptorBindingHandle uiTexturesBinding;
     Gfx::ODescriptorSet uiDescriptorSet;
 
     Gfx::ODescriptorSet viewParamsSet;
@@ -0,0 +1,74 @@
+#include "UploadPass.h"
+#include "Graphics/Graphics.h"
+#include "Material/Material.h"
+#include "Profiler.h"
+#include "Scene/LightEnvironment.h"
+#include <chrono>
+
+using namespace Seele;
+
+static float elapsedMillis(std::chrono::high_resolution_clock::time_point& start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    float elapsed = std::chrono::duration<float, std::milli>(end - start).count();
+    start = end;
+    return elapsed;
+}
+
+UploadPass::UploadPass(Gfx::PGraphics graphics, PScene scene) : RenderPass(graphics), scene(scene) {
+    // the buffers are rotated, so what the previous frame reads is never overwritten
+    for (const auto& [resource, buffer] : getUploadedBuffers()) {
+        declareWrite(RenderGraphAccess{
+            .resource = resource,
+            .access = Gfx::SE_ACCESS_TRANSFER_WRITE_BIT,
+            .stage = Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
+        });
+    }
+}
+
+UploadPass::~UploadPass() {}
+
+void UploadPass::beginFrame(const Component::Camera&, const Component::Transform&) {
+    // the material buffers are only created along with the first material, which might be loaded after the graph
+    publishOutputs();
+}
+
+void UploadPass::render() {
+    graphics->beginDebugRegion("UploadPass");
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    {
+        PROFILE_ZONE("CreateDescriptors");
+        for (VertexData* vd : VertexData::getList()) {
+            vd->createDescriptors();
+        }
+    }
+    createDescriptorsTime = elapsedMillis(phaseStart);
+    {
+        PROFILE_ZONE("LightCommit");
+        scene->getLightEnvironment()->commit();
+    }
+    lightCommitTime = elapsedMillis(phaseStart);
+    graphics->endDebugRegion();
+}
+
+void UploadPass::endFrame() {}
+
+void UploadPass::publishOutputs() {
+    for (const auto& [resource, buffer] : getUploadedBuffers()) {
+        if (buffer != nullptr) {
+            resources->registerBufferOutput(resource, buffer);
+        }
+    }
+}
+
+void UploadPass::createRenderPass() {}
+
+Array<Pair<std::string, Gfx::PShaderBuffer>> UploadPass::getUploadedBuffers() const {
+    Array<Pair<std::string, Gfx::PShaderBuffer>> buffers;
+    for (VertexData* vd : VertexData::getList()) {
+        buffers.addAll(vd->getUploadedBuffers());
+    }
+    // createDescriptors updates the material buffers as well
+    buffers.addAll(Material::getUploadedBuffers());
+    buffers.addAll(scene->getLightEnvironment()->getUploadedBuffers());
+    return buffers;
+}
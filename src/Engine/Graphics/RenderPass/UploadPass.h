@@ -0,0 +1,29 @@
+#pragma once
+#include "RenderPass.h"
+
+namespace Seele {
+// uploads the draw lists, materials and lights of the frame, the buffers are resources of the graph, so the barriers
+// to the passes reading them are placed by it, see VertexData::getUploadedBuffers
+class UploadPass : public RenderPass {
+  public:
+    UploadPass(Gfx::PGraphics graphics, PScene scene);
+    UploadPass(UploadPass&&) = default;
+    UploadPass& operator=(UploadPass&&) = default;
+    virtual ~UploadPass();
+    virtual void beginFrame(const Component::Camera& cam, const Component::Transform& transform) override;
+    virtual void render() override;
+    virtual void endFrame() override;
+    virtual void publishOutputs() override;
+    virtual void createRenderPass() override;
+    // CPU time in milliseconds of the uploads of the last frame
+    float getCreateDescriptorsTime() const { return createDescriptorsTime; }
+    float getLightCommitTime() const { return lightCommitTime; }
+
+  private:
+    Array<Pair<std::string, Gfx::PShaderBuffer>> getUploadedBuffers() const;
+    PScene scene;
+    float createDescriptorsTime = 0;
+    float lightCommitTime = 0;
+};
+DEFINE_REF(UploadPass)
+} // namespace Seele
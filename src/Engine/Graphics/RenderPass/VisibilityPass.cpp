@@ -3,7 +3,19 @@
 
 using namespace Seele;
 
-VisibilityPass::VisibilityPass(Gfx::PGraphics graphics) : RenderPass(graphics) {}
+VisibilityPass::VisibilityPass(Gfx::PGraphics graphics) : RenderPass(graphics) {
+    declareRead(RenderGraphAccess{
+        .resource = "VISIBILITY",
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+    // cleared and then filled
+    declareWrite(RenderGraphAccess{
+        .resource = "CULLINGBUFFER",
+        .access = Gfx::SE_ACCESS_TRANSFER_WRITE_BIT | Gfx::SE_ACCESS_SHADER_READ_BIT | Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT | Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    });
+}
 
 VisibilityPass::~VisibilityPass() {}
 
@@ -15,8 +27,6 @@ void VisibilityPass::beginFrame(const Component::Camera& cam, const Component::T
 
 void VisibilityPass::render() {
     graphics->beginDebugRegion("VisibilityPass");
-    cullingBuffer->pipelineBarrier(Gfx::SE_ACCESS_SHADER_READ_BIT, Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT,
-                                   Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT);
     cullingBuffer->clear();
 
     cullingBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
@@ -24,8 +34,8 @@ void VisibilityPass::render() {
                                    Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
     visibilityDescriptor->reset();
     visibilitySet = visibilityDescriptor->allocateDescriptorSet();
-    visibilitySet->updateTexture(VISIBILITY_NAME, 0, visibilityAttachment.getTextureView());
-    visibilitySet->updateBuffer(CULLINGBUFFER_NAME, 0, cullingBuffer);
+    visibilitySet->updateTexture(visibilityBinding, 0, visibilityAttachment.getTextureView());
+    visibilitySet->updateBuffer(cullingBufferBinding, 0, cullingBuffer);
     visibilitySet->writeChanges();
 
     query->beginQuery();
@@ -39,9 +49,6 @@ void VisibilityPass::render() {
     graphics->executeCommands(std::move(commands));
     timestamps->write(Gfx::SE_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, "VisibilityEnd");
     query->endQuery();
-    cullingBuffer->pipelineBarrier(Gfx::SE_ACCESS_SHADER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                                   Gfx::SE_ACCESS_SHADER_READ_BIT,
-                                   Gfx::SE_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | Gfx::SE_PIPELINE_STAGE_MESH_SHADER_BIT_EXT);
     graphics->endDebugRegion();
 }
 
@@ -52,12 +59,12 @@ void VisibilityPass::publishOutputs() {
     uint32_t viewportHeight = viewport->getHeight();
     threadGroupSize = glm::ceil(glm::vec3(viewportWidth / (float)BLOCK_SIZE, viewportHeight / (float)BLOCK_SIZE, 1));
     visibilityDescriptor = graphics->createDescriptorLayout("pVisibilityParams");
-    visibilityDescriptor->addDescriptorBinding(Gfx::DescriptorBinding{
+    visibilityBinding = visibilityDescriptor->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = VISIBILITY_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
     });
-    visibilityDescriptor->addDescriptorBinding(Gfx::DescriptorBinding{
+    cullingBufferBinding = visibilityDescriptor->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = CULLINGBUFFER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_READ_BIT | Gfx::SE_DESCRIPTOR_ACCESS_WRITE_BIT,
@@ -29,9 +29,11 @@ class VisibilityPass : public RenderPass {
     Gfx::ODescriptorSet viewParamsSet;
 
     constexpr static const char* VISIBILITY_NAME = "visibilityTexture";
+    Gfx::DescriptorBindingHandle visibilityBinding;
     // Holds culling information for every meshlet for each instance
     Gfx::OShaderBuffer cullingBuffer;
     constexpr static const char* CULLINGBUFFER_NAME = "cullingBuffer";
+    Gfx::DescriptorBindingHandle cullingBufferBinding;
     UVector threadGroupSize;
 };
 DEFINE_REF(VisibilityPass)
@@ -0,0 +1,47 @@
+#include "RingAllocator.h"
+
+using namespace Seele;
+using namespace Seele::Gfx;
+
+RingAllocator::RingAllocator(uint64 capacity) : capacity(capacity) {}
+
+RingAllocator::~RingAllocator() {}
+
+uint64 RingAllocator::allocate(uint64 size, uint64 alignment) {
+    if (size == 0 || size > capacity) {
+        return INVALID_OFFSET;
+    }
+    uint64 offset = head % capacity;
+    uint64 aligned = alignment > 1 ? (offset + alignment - 1) / alignment * alignment : offset;
+    if (aligned + size > capacity) {
+        aligned = capacity;
+    }
+    uint64 begin = head + (aligned - offset);
+    if (begin + size - tail > capacity) {
+        return INVALID_OFFSET;
+    }
+    head = begin + size;
+    return begin % capacity;
+}
+
+void RingAllocator::submit(uint64 value) {
+    if (!hasUnsubmitted()) {
+        return;
+    }
+    submissions.add(Pair<uint64, uint64>{value, head});
+    submittedHead = head;
+}
+
+void RingAllocator::complete(uint64 value) {
+    while (!submissions.empty() && submissions.front().key <= value) {
+        tail = submissions.front().value;
+        submissions.popFront();
+    }
+}
+
+uint64 RingAllocator::getOldestPending() const {
+    for (const auto& submission : submissions) {
+        return submission.key;
+    }
+    return 0;
+}
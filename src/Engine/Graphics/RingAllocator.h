@@ -0,0 +1,40 @@
+#pragma once
+#include "Containers/List.h"
+#include "Containers/Pair.h"
+#include "MinimalEngine.h"
+
+namespace Seele {
+namespace Gfx {
+// hands out regions of a fixed size ring one after another, the regions are tagged with the value of the submission that reads them
+// and are reused once that value has completed, without the ring knowing anything about the backend that does the reading
+class RingAllocator {
+  public:
+    static constexpr uint64 INVALID_OFFSET = std::numeric_limits<uint64>::max();
+    RingAllocator(uint64 capacity);
+    ~RingAllocator();
+    // offset of the region in the ring, INVALID_OFFSET if it would overlap a region that is still in use
+    // a region never wraps around the end of the ring, the rest of the ring is skipped instead
+    uint64 allocate(uint64 size, uint64 alignment);
+    // everything allocated since the last submit is read by the submission that signals value
+    void submit(uint64 value);
+    // the submissions up to value have completed, their regions can be handed out again
+    void complete(uint64 value);
+    // value of the oldest submission whose regions are still in use, 0 if there is none
+    uint64 getOldestPending() const;
+    // allocated since the last submit
+    bool hasUnsubmitted() const { return head != submittedHead; }
+    constexpr uint64 getCapacity() const { return capacity; }
+    // bytes that are handed out and not completed yet, including the ones skipped at the end of the ring
+    uint64 getUsed() const { return head - tail; }
+
+  private:
+    uint64 capacity;
+    // positions only ever grow, the offset in the ring is position % capacity
+    uint64 head = 0;
+    uint64 tail = 0;
+    uint64 submittedHead = 0;
+    // value and head of each submission that has not completed yet, oldest first
+    List<Pair<uint64, uint64>> submissions;
+};
+} // namespace Gfx
+} // namespace Seele
@@ -1,9 +1,13 @@
 #include "Shader.h"
+#include "Asset/AssetRegistry.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Initializer.h"
+#include "Graphics/slang-compile.h"
 #include "Material/Material.h"
+#include "Profiler.h"
 #include "ThreadPool.h"
 #include <fmt/core.h>
+#include <fstream>
 #include <mutex>
 
 using namespace Seele;
@@ -11,29 +15,155 @@ using namespace Seele::Gfx;
 
 ShaderCompiler::ShaderCompiler(Gfx::PGraphics graphics) : graphics(graphics) {}
 
-ShaderCompiler::~ShaderCompiler() {}
+ShaderCompiler::~ShaderCompiler() {
+    waitForCompilation();
+    saveUsageLog();
+}
 
-const ShaderCollection* ShaderCompiler::findShaders(PermutationId id) const { return &shaders[id]; }
+const ShaderCollection* ShaderCompiler::findShaders(PermutationId id, bool lazy) {
+    Array<PendingPermutation> batch;
+    std::shared_future<void> future;
+    PermutationId resultId = id;
+    const ShaderCollection* previous = nullptr;
+    {
+        std::scoped_lock lock(registrationLock);
+        usedPermutations.insert(id.hash);
+        auto pending = deferred.find(id);
+        if (pending != deferred.end()) {
+            PendingPermutation permutation = std::move(pending->second);
+            deferred.erase(pending);
+            schedule(id, std::move(permutation), batch);
+        }
+        auto it = compileFutures.find(id);
+        if (it == compileFutures.end()) {
+            return nullptr;
+        }
+        future = it->second;
+        if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            // a regenerated material keeps drawing with its previous shaders until the new ones are compiled
+            std::scoped_lock shaderLock(shadersLock);
+            auto current = shaders.find(id);
+            if (current != shaders.end()) {
+                previous = *current->second;
+            }
+        }
+        auto fallback = fallbackFor.find(id);
+        if (lazy && fallback != fallbackFor.end() && future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            resultId = fallback->second;
+            future = compileFutures[resultId];
+        }
+    }
+    submit(std::move(batch));
+    if (previous != nullptr) {
+        return previous;
+    }
+    future.get();
+    std::scoped_lock lock(shadersLock);
+    return *shaders[resultId];
+}
 
 void ShaderCompiler::registerMaterial(PMaterial material) {
-    materials[material->getName()] = material;
-    compile();
+    Array<PendingPermutation> batch;
+    {
+        std::scoped_lock lock(registrationLock);
+        materials[material->getName()] = material;
+        materialVersions[material->getName()]++;
+        for (const auto& [name, pass] : passes) {
+            if (!pass.useMaterial) {
+                continue;
+            }
+            for (const auto& [vdName, vd] : vertexData) {
+                enqueuePermutations(name, pass, vd, material, batch);
+            }
+        }
+    }
+    submit(std::move(batch));
 }
 
 void ShaderCompiler::registerVertexData(VertexData* vd) {
-    vertexData[vd->getTypeName()] = vd;
-    compile();
+    Array<PendingPermutation> batch;
+    {
+        std::scoped_lock lock(registrationLock);
+        vertexData[vd->getTypeName()] = vd;
+        for (const auto& [name, pass] : passes) {
+            if (pass.useMaterial) {
+                for (const auto& [matName, mat] : materials) {
+                    enqueuePermutations(name, pass, vd, mat, batch);
+                }
+            } else {
+                enqueuePermutations(name, pass, vd, nullptr, batch);
+            }
+        }
+    }
+    submit(std::move(batch));
 }
 
 void ShaderCompiler::registerRenderPass(std::string name, PassConfig config) {
-    passes[name] = std::move(config);
-    compile();
+    Array<PendingPermutation> batch;
+    {
+        std::scoped_lock lock(registrationLock);
+        passes[name] = std::move(config);
+        const PassConfig& pass = passes[name];
+        for (const auto& [vdName, vd] : vertexData) {
+            if (pass.useMaterial) {
+                for (const auto& [matName, mat] : materials) {
+                    enqueuePermutations(name, pass, vd, mat, batch);
+                }
+            } else {
+                enqueuePermutations(name, pass, vd, nullptr, batch);
+            }
+        }
+    }
+    submit(std::move(batch));
+}
+
+Array<PMaterial> ShaderCompiler::getMaterials() {
+    std::scoped_lock lock(registrationLock);
+    Array<PMaterial> result;
+    for (const auto& [name, material] : materials) {
+        result.add(material);
+    }
+    return result;
+}
+
+bool ShaderCompiler::whenCompiled(PermutationId id, std::function<void(const ShaderCollection*)> continuation) {
+    {
+        std::scoped_lock lock(registrationLock);
+        auto it = compileFutures.find(id);
+        if (it == compileFutures.end()) {
+            return false;
+        }
+        // the compile job takes the continuations only after resolving its future, both under registrationLock,
+        // so a continuation that is added here is always picked up
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continuations[id].add(std::move(continuation));
+            return true;
+        }
+    }
+    getThreadPool().runAsync([this, id, continuation = std::move(continuation)]() { continuation(getCompiledShaders(id)); });
+    return true;
+}
+
+void ShaderCompiler::waitForCompilation() {
+    Array<std::shared_future<void>> futures;
+    {
+        std::scoped_lock lock(registrationLock);
+        for (const auto& [id, future] : compileFutures) {
+            futures.add(future);
+        }
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
 }
 
 ShaderPermutation ShaderCompiler::getTemplate(std::string name) {
-    std::scoped_lock lock(shadersLock);
+    std::scoped_lock lock(registrationLock);
+    return createTemplate(passes[name]);
+}
+
+ShaderPermutation ShaderCompiler::createTemplate(const PassConfig& pass) {
     ShaderPermutation permutation;
-    PassConfig& pass = passes[name];
     if (pass.useMeshShading) {
         permutation.setMeshFile(pass.mainFile);
     } else if (pass.rayTracing) {
@@ -52,69 +182,205 @@ ShaderPermutation ShaderCompiler::getTemplate(std::string name) {
     return permutation;
 }
 
-void ShaderCompiler::compile() {
-    List<std::function<void()>> work;
-    for (const auto& [name, pass] : passes) {
-        for (const auto& [vdName, vd] : vertexData) {
-            if (pass.useMaterial) {
-                for (const auto& [matName, mat] : materials) {
-                    for (int y = 0; y < 2; y++) {
-                        for (int z = 0; z < 2; ++z) {
-                            work.add([=, this]() {
-                                ShaderPermutation permutation = getTemplate(name);
-                                permutation.setPositionOnly(false);
-                                permutation.setDepthCulling(y);
-                                permutation.setImageBasedLighting(z);
-                                permutation.setVertexData(vd->getTypeName());
-                                OPipelineLayout layout = graphics->createPipelineLayout(pass.baseLayout->getName(), pass.baseLayout);
-                                layout->addDescriptorLayout(vd->getVertexDataLayout());
-                                layout->addDescriptorLayout(vd->getInstanceDataLayout());
-                                permutation.setMaterial(mat->getName(), mat->getProfile());
-                                createShaders(permutation, std::move(layout), name);
-                            });
-                        }
-                    }
+void ShaderCompiler::enqueuePermutations(const std::string& passName, const PassConfig& pass, VertexData* vd, PMaterial material,
+                                         Array<PendingPermutation>& batch) {
+    if (!usageLogLoaded) {
+        loadUsageLog();
+    }
+    if (material != nullptr && !fallbackMaterialWritten) {
+        writeFallbackMaterial();
+    }
+    ShaderPermutation base = createTemplate(pass);
+    base.setVertexData(vd->getTypeName());
+    uint64 version = 0;
+    if (material != nullptr) {
+        base.setMaterial(material->getName(), material->getProfile());
+        version = materialVersions[material->getName()];
+    }
+    // material passes always output more than the position
+    const int numPositionOnly = pass.useMaterial ? 1 : 2;
+    for (int x = 0; x < numPositionOnly; x++) {
+        for (int y = 0; y < 2; y++) {
+            for (int z = 0; z < 2; z++) {
+                ShaderPermutation permutation = base;
+                permutation.setPositionOnly(x);
+                permutation.setDepthCulling(y);
+                permutation.setImageBasedLighting(z);
+                PermutationId id(permutation);
+                auto queued = queuedVersions.find(id);
+                if (queued != queuedVersions.end() && queued->second == version) {
+                    continue;
                 }
-            } else {
-                for (int x = 0; x < 2; x++) {
-                    for (int y = 0; y < 2; y++) {
-                        for (int z = 0; z < 2; z++) {
-                            work.add([=, this]() {
-                                ShaderPermutation permutation = getTemplate(name);
-                                permutation.setPositionOnly(x);
-                                permutation.setDepthCulling(y);
-                                permutation.setImageBasedLighting(z);
-                                permutation.setVertexData(vd->getTypeName());
-                                OPipelineLayout layout = graphics->createPipelineLayout(pass.baseLayout->getName(), pass.baseLayout);
-                                layout->addDescriptorLayout(vd->getVertexDataLayout());
-                                layout->addDescriptorLayout(vd->getInstanceDataLayout());
-                                createShaders(permutation, std::move(layout), name);
-                            });
-                        }
+                // a regenerated material keeps its old shaders until the new ones are compiled
+                const bool recompile = queued != queuedVersions.end();
+                queuedVersions[id] = version;
+                PendingPermutation pending = {
+                    .permutation = permutation,
+                    .passName = passName,
+                    .baseLayout = pass.baseLayout,
+                    .vertexData = vd,
+                    .version = version,
+                };
+                if (material != nullptr) {
+                    ShaderPermutation fallbackPermutation = permutation;
+                    fallbackPermutation.setMaterial(FALLBACK_MATERIAL_NAME, FALLBACK_MATERIAL_PROFILE);
+                    PermutationId fallbackId(fallbackPermutation);
+                    fallbackFor[id] = fallbackId;
+                    // the fallbacks are few and have to be there before the first lazy lookup, so they are never deferred
+                    if (!queuedVersions.contains(fallbackId)) {
+                        queuedVersions[fallbackId] = 0;
+                        schedule(fallbackId,
+                                 PendingPermutation{
+                                     .permutation = fallbackPermutation,
+                                     .passName = passName,
+                                     .baseLayout = pass.baseLayout,
+                                     .vertexData = vd,
+                                 },
+                                 batch);
                     }
                 }
+                if (deferred.contains(id)) {
+                    // was never needed, so the new source stays deferred as well
+                    deferred[id] = std::move(pending);
+                } else if (compileAll || recompile || previouslyUsed.contains(id.hash)) {
+                    schedule(id, std::move(pending), batch);
+                } else {
+                    deferred[id] = std::move(pending);
+                }
+            }
+        }
+    }
+}
+
+void ShaderCompiler::compileAllPermutations() {
+    Array<PendingPermutation> batch;
+    {
+        std::scoped_lock lock(registrationLock);
+        compileAll = true;
+        for (auto& [id, pending] : deferred) {
+            schedule(id, std::move(pending), batch);
+        }
+        deferred.clear();
+    }
+    submit(std::move(batch));
+}
+
+void ShaderCompiler::writeFallbackMaterial() {
+    const std::string sourcePath = fmt::format("./shaders/generated/{0}.slang", FALLBACK_MATERIAL_NAME);
+    {
+        std::ofstream codeStream(sourcePath);
+        codeStream << "import MaterialParameter;\n";
+        codeStream << "import Material;\n";
+        codeStream << "import LightEnv;\n";
+        codeStream << "export struct Material : IMaterial{\n";
+        codeStream << "\ttypedef " << FALLBACK_MATERIAL_PROFILE << " BRDF;\n";
+        codeStream << "\tstatic " << FALLBACK_MATERIAL_PROFILE << " prepare(MaterialParameter input) {\n";
+        codeStream << "\t\t" << FALLBACK_MATERIAL_PROFILE << " result;\n";
+        codeStream << "\t\tresult.baseColor = float3(0.5, 0.5, 0.5);\n";
+        codeStream << "\t\tresult.normal = mul(input.tangentToWorld, float3(0, 0, 1));\n";
+        codeStream << "\t\treturn result;\n";
+        codeStream << "\t}\n";
+        codeStream << "};\n";
+    }
+    invalidateSourceFile(sourcePath);
+    fallbackMaterialWritten = true;
+}
+
+void ShaderCompiler::schedule(PermutationId id, PendingPermutation pending, Array<PendingPermutation>& batch) {
+    pending.promise = std::make_shared<std::promise<void>>();
+    compileFutures[id] = pending.promise->get_future().share();
+    batch.add(std::move(pending));
+}
+
+void ShaderCompiler::submit(Array<PendingPermutation> batch) {
+    // no barrier here, whoever needs a permutation waits for its future, which is ready as soon as that permutation is done
+    // every permutation is its own job, so a large batch like the one of compileAllPermutations spreads over all workers
+    for (auto& pending : batch) {
+        getThreadPool().runAsync([this, pending = std::move(pending)]() {
+            PermutationId id(pending.permutation);
+            const ShaderCollection* collection = nullptr;
+            try {
+                OPipelineLayout layout = graphics->createPipelineLayout(pending.baseLayout->getName(), pending.baseLayout);
+                layout->addDescriptorLayout(pending.vertexData->getVertexDataLayout());
+                layout->addDescriptorLayout(pending.vertexData->getInstanceDataLayout());
+                createShaders(pending.permutation, std::move(layout), pending.passName, pending.version);
+                collection = getCompiledShaders(id);
+                pending.promise->set_value();
+            } catch (...) {
+                pending.promise->set_exception(std::current_exception());
+            }
+            Array<std::function<void(const ShaderCollection*)>> waiting;
+            {
+                std::scoped_lock lock(registrationLock);
+                auto it = continuations.find(id);
+                if (it != continuations.end()) {
+                    waiting = std::move(it->second);
+                    continuations.erase(it);
+                }
+            }
+            for (auto& continuation : waiting) {
+                continuation(collection);
             }
+        });
+    }
+}
+
+const ShaderCollection* ShaderCompiler::getCompiledShaders(PermutationId id) {
+    std::scoped_lock lock(shadersLock);
+    auto it = shaders.find(id);
+    if (it == shaders.end()) {
+        return nullptr;
+    }
+    return *it->second;
+}
+
+void ShaderCompiler::loadUsageLog() {
+    std::filesystem::path cacheFolder = AssetRegistry::getCacheFolder();
+    if (cacheFolder.empty()) {
+        // not initialized yet, try again with the next registration
+        return;
+    }
+    usageLogLoaded = true;
+    std::ifstream stream(cacheFolder / "ShaderUsage.log");
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.empty()) {
+            continue;
         }
+        previouslyUsed.insert(std::strtoull(line.c_str(), nullptr, 16));
     }
-    getThreadPool().runAndWait(std::move(work));
 }
 
-void ShaderCompiler::createShaders(ShaderPermutation permutation, Gfx::OPipelineLayout layout, std::string debugName) {
+void ShaderCompiler::saveUsageLog() {
+    std::filesystem::path cacheFolder = AssetRegistry::getCacheFolder();
+    std::scoped_lock lock(registrationLock);
+    if (cacheFolder.empty() || usedPermutations.empty()) {
+        return;
+    }
+    std::filesystem::create_directories(cacheFolder);
+    std::ofstream stream(cacheFolder / "ShaderUsage.log");
+    for (uint64 hash : usedPermutations) {
+        stream << fmt::format("{0:x}", hash) << std::endl;
+    }
+}
+
+void ShaderCompiler::createShaders(ShaderPermutation permutation, Gfx::OPipelineLayout layout, std::string debugName, uint64 version) {
+    PROFILE_ZONE_DETAIL("CreateShaders", debugName);
     PermutationId perm = PermutationId(permutation);
     {
         std::scoped_lock lock(shadersLock);
-        if (shaders.contains(perm))
+        if (shaders.contains(perm) && shaderVersions[perm] >= version)
             return;
     }
-    ShaderCollection collection;
-    collection.pipelineLayout = std::move(layout);
+    OwningPtr<ShaderCollection> collection = new ShaderCollection();
+    collection->pipelineLayout = std::move(layout);
 
     ShaderCompilationInfo createInfo;
     createInfo.name = fmt::format("{0} Material {1}", debugName, permutation.materialName);
-    createInfo.rootSignature = collection.pipelineLayout;
+    createInfo.rootSignature = collection->pipelineLayout;
     if (std::strlen(permutation.materialName) > 0) {
+        // links the Material type the pass modules declare extern, the passes are not preprocessed per material
         createInfo.modules.add(permutation.materialName);
-        createInfo.defines["MATERIAL_FILE_NAME"] = permutation.materialName;
         // createInfo.typeParameter.add({"IBRDF", "Phong"});
     }
     if (permutation.positionOnly) {
@@ -160,20 +426,27 @@ void ShaderCompiler::createShaders(ShaderPermutation permutation, Gfx::OPipeline
     uint32 shaderIndex = 0;
     if (permutation.useMeshShading) {
         if (permutation.hasTaskShader) {
-            collection.taskShader = graphics->createTaskShader({shaderIndex++});
+            collection->taskShader = graphics->createTaskShader({shaderIndex++});
         }
-        collection.meshShader = graphics->createMeshShader({shaderIndex++});
+        collection->meshShader = graphics->createMeshShader({shaderIndex++});
     } else if (permutation.rayTracing) {
-        collection.callableShader = graphics->createClosestHitShader({shaderIndex++});
+        collection->callableShader = graphics->createClosestHitShader({shaderIndex++});
     } else {
-        collection.vertexShader = graphics->createVertexShader({shaderIndex++});
+        collection->vertexShader = graphics->createVertexShader({shaderIndex++});
     }
     if (permutation.hasFragment) {
-        collection.fragmentShader = graphics->createFragmentShader({shaderIndex++});
+        collection->fragmentShader = graphics->createFragmentShader({shaderIndex++});
     }
-    collection.pipelineLayout->create();
+    collection->pipelineLayout->create();
     {
         std::scoped_lock lock(shadersLock);
+        if (shaders.contains(perm)) {
+            if (shaderVersions[perm] >= version) {
+                return;
+            }
+            retiredShaders.add(std::move(shaders[perm]));
+        }
         shaders[perm] = std::move(collection);
+        shaderVersions[perm] = version;
     }
 }
@@ -1,7 +1,12 @@
 #pragma once
 #include "CRC.h"
+#include "Containers/List.h"
 #include "Resources.h"
 #include "VertexData.h"
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Seele {
 namespace Gfx {
@@ -146,12 +151,19 @@ struct ShaderPermutation {
     void setImageBasedLighting(bool enable) { imageBasedLighting = enable; }
 };
 // Hashed ShaderPermutation for fast lookup
+// the permutation itself is kept so that two permutations with the same hash never compare equal
 struct PermutationId {
-    uint32 hash;
+    uint64 hash;
+    ShaderPermutation permutation;
     PermutationId() : hash(0) {}
-    PermutationId(ShaderPermutation permutation) : hash(CRC::Calculate(&permutation, sizeof(ShaderPermutation), CRC::CRC_32())) {}
-    friend constexpr bool operator==(const PermutationId& lhs, const PermutationId& rhs) { return lhs.hash == rhs.hash; }
-    friend constexpr auto operator<=>(const PermutationId& lhs, const PermutationId& rhs) { return lhs.hash <=> rhs.hash; }
+    PermutationId(ShaderPermutation permutation)
+        : hash(CRC::Calculate(&permutation, sizeof(ShaderPermutation), CRC::CRC_64())), permutation(permutation) {}
+    friend bool operator==(const PermutationId& lhs, const PermutationId& rhs) {
+        return lhs.hash == rhs.hash && std::memcmp(&lhs.permutation, &rhs.permutation, sizeof(ShaderPermutation)) == 0;
+    }
+};
+struct PermutationIdHasher {
+    size_t operator()(const PermutationId& id) const { return id.hash; }
 };
 struct ShaderCollection {
     OPipelineLayout pipelineLayout;
@@ -179,17 +191,83 @@ class ShaderCompiler {
   public:
     ShaderCompiler(Gfx::PGraphics graphics);
     ~ShaderCompiler();
-    const ShaderCollection* findShaders(PermutationId id) const;
+    // waits until the permutation is compiled, nullptr if it was never registered
+    // a deferred permutation gets scheduled, and lazy callers get the permutation of the fallback material while a material
+    // permutation is not ready instead of waiting, see RenderGraph::setLazyShaderCompilation
+    const ShaderCollection* findShaders(PermutationId id, bool lazy = false);
+    // registering only queues the permutations that did not exist before, which compile asynchronously
+    // registering a material again means its source was regenerated, so its permutations are compiled again
     void registerMaterial(PMaterial material);
     void registerVertexData(VertexData* vertexData);
     void registerRenderPass(std::string name, PassConfig config);
+    Array<PMaterial> getMaterials();
+    // runs the continuation on the thread pool once the permutation is compiled, right after it in the same job if it is
+    // still compiling, so nothing blocks a worker waiting for it. The collection is nullptr if the compilation failed
+    // false if the permutation was never queued, then the continuation is dropped
+    bool whenCompiled(PermutationId id, std::function<void(const ShaderCollection*)> continuation);
+    // waits for every permutation queued so far
+    void waitForCompilation();
+    // until a view that does not accept fallbacks asks for this, permutations that were not used in the last run are only
+    // compiled once they are first requested, afterwards every permutation is compiled right away
+    void compileAllPermutations();
     ShaderPermutation getTemplate(std::string name);
+    // writes every permutation requested through findShaders in this run to the cache folder
+    // permutations from that log are compiled right away on the next run, even if they would be deferred
+    void saveUsageLog();
+    // material without any parameters that lazy callers draw with while the real material is compiling
+    // it reads nothing from the material resources, so it fits every material instance
+    static constexpr const char* FALLBACK_MATERIAL_NAME = "FallbackMaterial";
+    static constexpr const char* FALLBACK_MATERIAL_PROFILE = "BlinnPhong";
 
   private:
-    void compile();
-    void createShaders(ShaderPermutation permutation, OPipelineLayout layout, std::string debugName);
+    struct PendingPermutation {
+        ShaderPermutation permutation;
+        std::string passName;
+        Gfx::PPipelineLayout baseLayout;
+        VertexData* vertexData;
+        // of the material source, a permutation is queued again once its material was regenerated
+        uint64 version = 0;
+        std::shared_ptr<std::promise<void>> promise;
+    };
+    static ShaderPermutation createTemplate(const PassConfig& pass);
+    // adds every flag combination of one pass, vertex data and material that has not been queued with the current material version
+    void enqueuePermutations(const std::string& passName, const PassConfig& pass, VertexData* vd, PMaterial material,
+                             Array<PendingPermutation>& batch);
+    // registrationLock needs to be held
+    void schedule(PermutationId id, PendingPermutation pending, Array<PendingPermutation>& batch);
+    // compiles every permutation of the batch in its own job
+    void submit(Array<PendingPermutation> batch);
+    // the collection currently stored for the permutation without waiting, nullptr if there is none
+    const ShaderCollection* getCompiledShaders(PermutationId id);
+    void loadUsageLog();
+    // registrationLock needs to be held
+    void writeFallbackMaterial();
+    void createShaders(ShaderPermutation permutation, OPipelineLayout layout, std::string debugName, uint64 version);
     std::mutex shadersLock;
-    Map<PermutationId, ShaderCollection> shaders;
+    std::unordered_map<PermutationId, OwningPtr<ShaderCollection>, PermutationIdHasher> shaders;
+    // collections are never moved, a recompiled permutation takes the place of the old one, which might still be in use
+    // by a pipeline that is being created
+    List<OwningPtr<ShaderCollection>> retiredShaders;
+    // material version of the collection in shaders, so an older compilation that finishes late does not replace a newer one
+    std::unordered_map<PermutationId, uint64, PermutationIdHasher> shaderVersions;
+    // guards everything below
+    std::mutex registrationLock;
+    std::unordered_map<PermutationId, std::shared_future<void>, PermutationIdHasher> compileFutures;
+    // run by the compile job of the permutation once it finished, see whenCompiled
+    std::unordered_map<PermutationId, Array<std::function<void(const ShaderCollection*)>>, PermutationIdHasher> continuations;
+    // material version each permutation was last queued with
+    std::unordered_map<PermutationId, uint64, PermutationIdHasher> queuedVersions;
+    Map<std::string, uint64> materialVersions;
+    // registered, but not scheduled because no caller needed them yet
+    std::unordered_map<PermutationId, PendingPermutation, PermutationIdHasher> deferred;
+    bool compileAll = false;
+    // material permutations mapped to the same permutation with the fallback material
+    std::unordered_map<PermutationId, PermutationId, PermutationIdHasher> fallbackFor;
+    bool fallbackMaterialWritten = false;
+    // the usage log only stores hashes, a collision just means a permutation gets compiled eagerly
+    std::unordered_set<uint64> usedPermutations;
+    std::unordered_set<uint64> previouslyUsed;
+    bool usageLogLoaded = false;
     Map<std::string, PMaterial> materials;
     Map<std::string, VertexData*> vertexData;
     Map<std::string, PassConfig> passes;
@@ -18,6 +18,8 @@ public:
     virtual void changeLayout(SeImageLayout newLayout, SeAccessFlags srcAccess, SePipelineStageFlags srcStage, SeAccessFlags dstAccess,
                               SePipelineStageFlags dstStage) = 0;
     virtual void pipelineBarrier(SeAccessFlags srcAccess, SePipelineStageFlags srcStage, SeAccessFlags dstAccess, SePipelineStageFlags dstStage) = 0;
+    // transfers the whole texture the view was created from
+    virtual void transferOwnership(QueueType newOwner) = 0;
 private:
 };
 DEFINE_REF(TextureView)
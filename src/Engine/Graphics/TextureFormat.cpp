@@ -0,0 +1,57 @@
+#include "TextureFormat.h"
+
+using namespace Seele;
+using namespace Seele::Gfx;
+
+static constexpr SeFormat colorFormats[] = {
+    SE_FORMAT_BC7_SRGB_BLOCK,
+    SE_FORMAT_BC1_RGB_SRGB_BLOCK,
+    SE_FORMAT_ASTC_4x4_SRGB_BLOCK,
+    SE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK,
+    SE_FORMAT_R8G8B8A8_SRGB,
+};
+
+static constexpr SeFormat colorAlphaFormats[] = {
+    SE_FORMAT_BC7_SRGB_BLOCK,
+    SE_FORMAT_BC3_SRGB_BLOCK,
+    SE_FORMAT_ASTC_4x4_SRGB_BLOCK,
+    SE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,
+    SE_FORMAT_R8G8B8A8_SRGB,
+};
+
+// no ASTC, it would put x into all three color channels
+static constexpr SeFormat normalFormats[] = {
+    SE_FORMAT_BC5_UNORM_BLOCK,
+    SE_FORMAT_EAC_R11G11_UNORM_BLOCK,
+    SE_FORMAT_R8G8B8A8_UNORM,
+};
+
+static constexpr SeFormat singleChannelFormats[] = {
+    SE_FORMAT_BC4_UNORM_BLOCK,
+    SE_FORMAT_EAC_R11_UNORM_BLOCK,
+    SE_FORMAT_ASTC_4x4_UNORM_BLOCK,
+    SE_FORMAT_R8G8B8A8_UNORM,
+};
+
+template <size_t N> static SeFormat firstSupported(const SeFormat (&formats)[N], const std::function<bool(SeFormat)>& isSupported) {
+    for (size_t i = 0; i < N - 1; ++i) {
+        if (isSupported(formats[i])) {
+            return formats[i];
+        }
+    }
+    // every device can sample 8 bit RGBA
+    return formats[N - 1];
+}
+
+SeFormat Gfx::chooseTextureFormat(TextureContent content, const std::function<bool(SeFormat)>& isSupported) {
+    switch (content) {
+    case TextureContent::COLOR:
+        return firstSupported(colorFormats, isSupported);
+    case TextureContent::NORMAL:
+        return firstSupported(normalFormats, isSupported);
+    case TextureContent::SINGLE_CHANNEL:
+        return firstSupported(singleChannelFormats, isSupported);
+    default:
+        return firstSupported(colorAlphaFormats, isSupported);
+    }
+}
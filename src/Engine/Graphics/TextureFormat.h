@@ -0,0 +1,21 @@
+#pragma once
+#include "Enums.h"
+#include <functional>
+
+namespace Seele {
+namespace Gfx {
+// what the channels of a texture hold, decides which block compressed formats keep enough of it
+enum class TextureContent : uint8 {
+    // srgb color, alpha is always opaque
+    COLOR = 0,
+    COLOR_ALPHA = 1,
+    // linear tangent space normal with x in red and y in green, z is reconstructed from them when sampling
+    NORMAL = 2,
+    // linear values like roughness or masks, only red is read
+    SINGLE_CHANNEL = 3,
+};
+// first of the formats that suit content which isSupported accepts, R8G8B8A8 if it accepts none of them
+// the preference is BC, then ASTC and then ETC2/EAC, so desktop GPUs get BC and mobile GPUs what they support
+SeFormat chooseTextureFormat(TextureContent content, const std::function<bool(SeFormat)>& isSupported);
+} // namespace Gfx
+} // namespace Seele
@@ -16,28 +16,19 @@
 using namespace Seele;
 
 constexpr static uint64 NUM_DEFAULT_ELEMENTS = 36;
-uint64 VertexData::meshletCount = 0;
+std::atomic_uint64_t VertexData::meshletCount = 0;
+uint64 VertexData::renderMeshletCount = 0;
 
 void VertexData::resetMeshData() {
     std::unique_lock l(materialDataLock);
-    instanceData.clear(true);
-    instanceMeshData.clear(true);
-    rayTracingScene.clear(true);
-    transparentData.clear(true);
-    for (auto& mat : materialData) {
+    updateTransparentData.clear(true);
+    for (auto& mat : updateMaterialData) {
         for (auto& inst : mat.instances) {
             inst.instanceData.clear(true);
             inst.instanceMeshData.clear(true);
             inst.cullingOffsets.clear(true);
             inst.rayTracingData.clear(true);
         }
-        if (mat.material != nullptr) {
-            mat.material->getDescriptorLayout()->reset();
-        }
-    }
-    if (dirty) {
-        updateBuffers();
-        dirty = false;
     }
 }
 
@@ -51,11 +42,10 @@ void VertexData::updateMesh(uint32 meshletOffset, PMesh mesh, Component::Transfo
         .inverseTransformMatrix = glm::inverse(transformMatrix),
     };
 
-    referencedInstance->updateDescriptor();
-    if (materialData.size() <= mat->getId()) {
-        materialData.resize(mat->getId() + 1);
+    if (updateMaterialData.size() <= mat->getId()) {
+        updateMaterialData.resize(mat->getId() + 1);
     }
-    MaterialData& matData = materialData[mat->getId()];
+    MaterialData& matData = updateMaterialData[mat->getId()];
     matData.material = mat;
     if (matData.instances.size() <= referencedInstance->getId()) {
         matData.instances.resize(referencedInstance->getId() + 1);
@@ -72,7 +62,7 @@ void VertexData::updateMesh(uint32 meshletOffset, PMesh mesh, Component::Transfo
         };
         if (mat->hasTransparency()) {
             auto params = referencedInstance->getMaterialOffsets();
-            transparentData.add(TransparentDraw{
+            updateTransparentData.add(TransparentDraw{
                 .matInst = referencedInstance,
                 .vertexData = this,
                 .offsets =
@@ -97,9 +87,22 @@ void VertexData::updateMesh(uint32 meshletOffset, PMesh mesh, Component::Transfo
     }
 }
 
-void VertexData::createDescriptors() {
+void VertexData::commitUpdate() {
     std::unique_lock l(materialDataLock);
+    // the render side data is not read anymore at this point, so it gets reused for the next update
+    std::swap(materialData, updateMaterialData);
+    std::swap(transparentData, updateTransparentData);
+    renderMeshletCount = meshletCount.load();
+}
 
+void VertexData::createDescriptors() {
+    // cleared before uploading, so that a load finishing during the upload is not lost
+    if (dirty.exchange(false)) {
+        updateBuffers();
+    }
+    instanceData.clear(true);
+    instanceMeshData.clear(true);
+    rayTracingScene.clear(true);
     Array<uint32> cullingOffsets;
     for (auto& mat : materialData) {
         for (auto& instance : mat.instances) {
@@ -123,34 +126,37 @@ void VertexData::createDescriptors() {
         instanceMeshData.add(transparentData[i].meshData);
         rayTracingScene.add(transparentData[i].rayTracingScene);
     }
+    // the barriers to the passes reading them are placed by the render graph, see getUploadedBuffers
     cullingOffsetBuffer->rotateBuffer(cullingOffsets.size() * sizeof(uint32));
     cullingOffsetBuffer->updateContents(0, cullingOffsets.size() * sizeof(uint32), cullingOffsets.data());
-    cullingOffsetBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
-                                         Gfx::SE_ACCESS_MEMORY_READ_BIT, Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
 
     instanceBuffer->rotateBuffer(instanceData.size() * sizeof(InstanceData));
     instanceBuffer->updateContents(0, instanceData.size() * sizeof(InstanceData), instanceData.data());
-    instanceBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT, Gfx::SE_ACCESS_MEMORY_READ_BIT,
-                                    Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
 
     instanceMeshDataBuffer->rotateBuffer(sizeof(MeshData) * instanceMeshData.size());
     instanceMeshDataBuffer->updateContents(0, sizeof(MeshData) * instanceMeshData.size(), instanceMeshData.data());
-    instanceMeshDataBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
-                                            Gfx::SE_ACCESS_MEMORY_READ_BIT, Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
 
     instanceDataLayout->reset();
     descriptorSet = instanceDataLayout->allocateDescriptorSet();
-    descriptorSet->updateBuffer(POSITIONS_NAME, 0, positionBuffer);
-    descriptorSet->updateBuffer(INDEXBUFFER_NAME, 0, indexBuffer);
-    descriptorSet->updateBuffer(INSTANCES_NAME, 0, instanceBuffer);
-    descriptorSet->updateBuffer(MESHDATA_NAME, 0, instanceMeshDataBuffer);
-    descriptorSet->updateBuffer(MESHLET_NAME, 0, meshletBuffer);
-    descriptorSet->updateBuffer(PRIMITIVEINDICES_NAME, 0, primitiveIndicesBuffer);
-    descriptorSet->updateBuffer(VERTEXINDICES_NAME, 0, vertexIndicesBuffer);
-    descriptorSet->updateBuffer(CULLINGOFFSETS_NAME, 0, cullingOffsetBuffer);
+    descriptorSet->updateBuffer(positionsBinding, 0, positionBuffer);
+    descriptorSet->updateBuffer(indexBufferBinding, 0, indexBuffer);
+    descriptorSet->updateBuffer(instancesBinding, 0, instanceBuffer);
+    descriptorSet->updateBuffer(meshDataBinding, 0, instanceMeshDataBuffer);
+    descriptorSet->updateBuffer(meshletBinding, 0, meshletBuffer);
+    descriptorSet->updateBuffer(primitiveIndicesBinding, 0, primitiveIndicesBuffer);
+    descriptorSet->updateBuffer(vertexIndicesBinding, 0, vertexIndicesBuffer);
+    descriptorSet->updateBuffer(cullingOffsetsBinding, 0, cullingOffsetBuffer);
     Material::updateDescriptor();
 }
 
+Array<Pair<std::string, Gfx::PShaderBuffer>> VertexData::getUploadedBuffers() const {
+    return {
+        Pair<std::string, Gfx::PShaderBuffer>{getTypeName() + "_CULLINGOFFSETS", cullingOffsetBuffer},
+        Pair<std::string, Gfx::PShaderBuffer>{getTypeName() + "_INSTANCES", instanceBuffer},
+        Pair<std::string, Gfx::PShaderBuffer>{getTypeName() + "_MESHDATA", instanceMeshDataBuffer},
+    };
+}
+
 Array<VertexData::MeshletGroup> VertexData::groupMeshlets(std::span<MeshletDescription> meshlets) {
     auto groupWithAllMeshets = [&]() {
         MeshletGroup group;
@@ -479,47 +485,47 @@ void VertexData::init(Gfx::PGraphics _graphics) {
     instanceDataLayout = graphics->createDescriptorLayout("pScene");
 
     // positions
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    positionsBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = POSITIONS_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // indexBuffer
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    indexBufferBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = INDEXBUFFER_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // instanceData
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    instancesBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = INSTANCES_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // meshData
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    meshDataBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = MESHDATA_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // meshletData
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    meshletBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = MESHLET_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // primitiveIndices
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    primitiveIndicesBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = PRIMITIVEINDICES_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // vertexIndices
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    vertexIndicesBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = VERTEXINDICES_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // cullingOffset
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    cullingOffsetsBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = CULLINGOFFSETS_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
     // cullingInfos
-    instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
+    cullingDataBinding = instanceDataLayout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = CULLINGDATA_NAME,
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
@@ -550,13 +556,12 @@ void VertexData::destroy() {
     indexBuffer = nullptr;
     registeredMeshes.clear();
     materialData.clear();
+    updateMaterialData.clear();
 }
 
 uint32 VertexData::addCullingMapping(MeshId id) {
-    uint32 result = (uint32)meshletCount;
     const auto& md = getMeshData(id);
-    meshletCount += md.meshletRange.size;
-    return result;
+    return (uint32)meshletCount.fetch_add(md.meshletRange.size);
 }
 
 void VertexData::resizeBuffers() { positions.resize(verticesAllocated); }
@@ -573,11 +578,7 @@ void VertexData::updateBuffers() {
 }
 
 void VertexData::loadMeshlets(MeshId id, const Array<Vector>& loadedPositions, const Array<uint32>& loadedIndices) {
-    // Array<uint32> optimizedIndices = indices;
-    // tipsifyIndexBuffer(indices, positions.size(), 25, optimizedIndices);
-
-    const float coneWeight = 0.0f;
-
+    // vertex cache and fetch order are optimized at import time, see optimizeMesh
     const uint32 meshletOffset = meshlets.size();
     const uint32 vertexOffset = vertexIndices.size();
     const uint32 primitiveOffset = primitiveIndices.size();
@@ -593,7 +594,7 @@ void VertexData::loadMeshlets(MeshId id, const Array<Vector>& loadedPositions, c
     const uint32 meshletCount =
         meshopt_buildMeshlets(meshoptMeshlets.data(), meshletVertexIndices.data(), meshletTriangles.data(), loadedIndices.data(),
                               loadedIndices.size(), (float*)loadedPositions.data(), loadedPositions.size(), sizeof(Vector),
-                              Gfx::numVerticesPerMeshlet, Gfx::numPrimitivesPerMeshlet, coneWeight);
+                              Gfx::numVerticesPerMeshlet, Gfx::numPrimitivesPerMeshlet, meshletConeWeight);
 
     const meshopt_Meshlet& last = meshoptMeshlets[meshletCount - 1];
     const uint32 vertexCount = last.vertex_offset + last.vertex_count;
@@ -616,11 +617,12 @@ void VertexData::loadMeshlets(MeshId id, const Array<Vector>& loadedPositions, c
             .size = meshoptMeshlets[i].triangle_count,
         };
         m.indicesOffset = registeredMeshes[id].vertexOffset;
-        // todo: use meshopt for bb generation
-        m.bounding = AABB();
-        for (size_t j = 0; j < m.vertexIndices.size; ++j) {
-            m.bounding.adjust(loadedPositions[vertexIndices[meshoptMeshlets[i].vertex_offset + j]]);
-        }
+        MeshletBounds bounds = computeMeshletBounds(loadedPositions, meshletVertexIndices.data() + meshoptMeshlets[i].vertex_offset,
+                                                    meshletTriangles.data() + meshoptMeshlets[i].triangle_offset,
+                                                    meshoptMeshlets[i].vertex_count, meshoptMeshlets[i].triangle_count);
+        m.bounding = bounds.bounding;
+        m.boundingSphere = bounds.sphere;
+        m.cone = bounds.cone;
     }
     registeredMeshes[id].meshData = MeshData{
         .bounding = AABB(),
@@ -1,11 +1,13 @@
 #pragma once
 #include "Component/Transform.h"
 #include "Containers/List.h"
+#include "Containers/Pair.h"
 #include "Graphics/Buffer.h"
 #include "Graphics/Command.h"
 #include "Graphics/Descriptor.h"
 #include "MeshData.h"
 #include "Meshlet.h"
+#include <atomic>
 #include <entt/entt.hpp>
 
 constexpr uint32 MAX_TEXCOORDS = 8;
@@ -54,9 +56,15 @@ class VertexData {
         uint32 cullingOffset;
         Gfx::PBottomLevelAS rayTracingScene;
     };
+    // update side, fills the draw lists of the next frame
     void resetMeshData();
     void updateMesh(uint32 meshletOffset, PMesh mesh, Component::Transform& transform);
+    // hands the draw lists filled since resetMeshData over to the render side
+    void commitUpdate();
+    // render side, uploads the committed draw lists, called by the UploadPass of the render graph
     virtual void createDescriptors();
+    // buffers createDescriptors writes, by the name of their render graph resource
+    Array<Pair<std::string, Gfx::PShaderBuffer>> getUploadedBuffers() const;
     void loadMesh(MeshId id, Array<Vector> positions, Array<uint32> indices);
     virtual void removeMesh(MeshId id);
     void commitMeshes();
@@ -73,6 +81,7 @@ class VertexData {
     uint32* getIndexData() const { return indices.data(); }
     Gfx::PDescriptorLayout getInstanceDataLayout() { return instanceDataLayout; }
     Gfx::PDescriptorSet getInstanceDataSet() { return descriptorSet; }
+    Gfx::DescriptorBindingHandle getCullingDataBinding() const { return cullingDataBinding; }
     const Array<MaterialData>& getMaterialData() const { return materialData; }
     const Array<TransparentDraw>& getTransparentData() const { return transparentData; }
     const Array<Gfx::PBottomLevelAS>& getRayTracingData() const { return rayTracingScene; }
@@ -86,9 +95,10 @@ class VertexData {
     virtual void init(Gfx::PGraphics graphics);
     virtual void destroy();
 
+    // update side, called by the mesh updaters, possibly from several threads
     uint32 addCullingMapping(MeshId id);
-    static uint64 getMeshletCount() { return meshletCount; }
-    constexpr static const char* CULLINGDATA_NAME = "cullingData";
+    // render side, the number of meshlets as of the last commitUpdate
+    static uint64 getMeshletCount() { return renderMeshletCount; }
 
   protected:
     virtual void resizeBuffers();
@@ -98,6 +108,8 @@ class VertexData {
     VertexData();
     struct MeshletDescription {
         AABB bounding;
+        BoundingSphere boundingSphere;
+        MeshletCone cone;
         // range into vertexIndices array
         PoolRange vertexIndices;
         // range into primitiveIndices array
@@ -108,7 +120,10 @@ class VertexData {
         uint32 pad0;
         uint32 pad1;
     };
+    // written by updateMesh while the previous frame is still being rendered from materialData and transparentData
     std::mutex materialDataLock;
+    Array<MaterialData> updateMaterialData;
+    Array<TransparentDraw> updateTransparentData;
     Array<MaterialData> materialData;
     Array<TransparentDraw> transparentData;
 
@@ -128,33 +143,44 @@ class VertexData {
     Array<Vector> positions;
     Array<uint32> indices;
 
-    static uint64 meshletCount;
+    static std::atomic_uint64_t meshletCount;
+    static uint64 renderMeshletCount;
 
     Gfx::PGraphics graphics;
     Gfx::ODescriptorLayout instanceDataLayout;
+    constexpr static const char* CULLINGDATA_NAME = "cullingData";
+    Gfx::DescriptorBindingHandle cullingDataBinding;
     // for mesh shading
     Gfx::OShaderBuffer positionBuffer;
     constexpr static const char* POSITIONS_NAME = "positions";
+    Gfx::DescriptorBindingHandle positionsBinding;
     Gfx::OIndexBuffer indexBuffer;
     constexpr static const char* INDEXBUFFER_NAME = "indexBuffer";
+    Gfx::DescriptorBindingHandle indexBufferBinding;
     Gfx::OShaderBuffer meshletBuffer;
     constexpr static const char* MESHLET_NAME = "meshlets";
+    Gfx::DescriptorBindingHandle meshletBinding;
     Gfx::OShaderBuffer vertexIndicesBuffer;
     constexpr static const char* VERTEXINDICES_NAME = "vertexIndices";
+    Gfx::DescriptorBindingHandle vertexIndicesBinding;
     Gfx::OShaderBuffer primitiveIndicesBuffer;
     constexpr static const char* PRIMITIVEINDICES_NAME = "primitiveIndices";
+    Gfx::DescriptorBindingHandle primitiveIndicesBinding;
     Gfx::OShaderBuffer cullingOffsetBuffer;
     constexpr static const char* CULLINGOFFSETS_NAME = "cullingOffsets";
+    Gfx::DescriptorBindingHandle cullingOffsetsBinding;
 
     Array<Gfx::PBottomLevelAS> dataToBuild;
     // Material data
     Array<InstanceData> instanceData;
     Gfx::OShaderBuffer instanceBuffer;
     constexpr static const char* INSTANCES_NAME = "instances";
+    Gfx::DescriptorBindingHandle instancesBinding;
 
     Array<MeshData> instanceMeshData;
     Gfx::OShaderBuffer instanceMeshDataBuffer;
     constexpr static const char* MESHDATA_NAME = "meshData";
+    Gfx::DescriptorBindingHandle meshDataBinding;
 
     Array<Gfx::PBottomLevelAS> rayTracingScene;
 
@@ -162,7 +188,8 @@ class VertexData {
     uint64 idCounter;
     uint64 head;
     uint64 verticesAllocated;
-    bool dirty;
+    // set by the loaders of the vertex attributes, which run on asset loading threads
+    std::atomic_bool dirty;
 
     struct MeshletGroup {
         Array<size_t> meshlets;
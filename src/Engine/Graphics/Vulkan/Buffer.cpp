@@ -2,6 +2,7 @@
 #include "Command.h"
 #include "Enums.h"
 #include "Graphics/Enums.h"
+#include "StagingRing.h"
 #include <fmt/format.h>
 #include <vk_mem_alloc.h>
 
@@ -10,7 +11,7 @@ using namespace Seele::Vulkan;
 
 BufferAllocation::BufferAllocation(PGraphics graphics, const std::string& name, VkBufferCreateInfo bufferInfo,
                                    VmaAllocationCreateInfo allocInfo, Gfx::QueueType owner, uint64 alignment)
-    : CommandBoundResource(graphics, name), size(bufferInfo.size), owner(owner) {
+    : CommandBoundResource(graphics, name), size(bufferInfo.size), owner(owner), sharingMode(bufferInfo.sharingMode) {
     if (bufferInfo.size == 0)
         return;
     VK_CHECK(vmaCreateBufferWithAlignment(graphics->getAllocator(), &bufferInfo, &allocInfo, alignment, &buffer, &allocation, &info));
@@ -66,6 +67,10 @@ void BufferAllocation::transferOwnership(Gfx::QueueType newOwner) {
     Gfx::QueueFamilyMapping mapping = graphics->getFamilyMapping();
     if (mapping.getQueueTypeFamilyIndex(newOwner) == mapping.getQueueTypeFamilyIndex(owner))
         return;
+    if (sharingMode == VK_SHARING_MODE_CONCURRENT) {
+        owner = newOwner;
+        return;
+    }
     VkBufferMemoryBarrier barrier = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
         .pNext = nullptr,
@@ -93,6 +98,30 @@ void BufferAllocation::transferOwnership(Gfx::QueueType newOwner) {
 void BufferAllocation::updateContents(uint64 regionOffset, uint64 regionSize, void* ptr) {
     if (regionSize == 0)
         return;
+    Gfx::QueueFamilyMapping mapping = graphics->getFamilyMapping();
+    // the transfer queue could overwrite what submitted work is still reading, and exclusive buffers would have to be handed over
+    // and back for every update, so those are updated in order on the queue that owns them
+    if (isCurrentlyBound() || (sharingMode == VK_SHARING_MODE_EXCLUSIVE && mapping.needsTransfer(owner, Gfx::QueueType::TRANSFER))) {
+        updateOnOwner(regionOffset, regionSize, ptr);
+        return;
+    }
+    PStagingRing stagingRing = graphics->getStagingRing();
+    auto record = [this, regionOffset, regionSize](PCommand command, VkBuffer source, uint64 sourceOffset) {
+        VkBufferCopy copy = {
+            .srcOffset = sourceOffset,
+            .dstOffset = regionOffset,
+            .size = regionSize,
+        };
+        command->bindResource(PBufferAllocation(this));
+        vkCmdCopyBuffer(command->getHandle(), source, buffer, 1, &copy);
+    };
+    uint64 value = stagingRing->upload(ptr, regionSize, 4, record);
+    // the semaphore wait makes the copy visible, so the owner needs no barrier of its own
+    // the buffer is read by whatever is submitted to the owner next, not necessarily by the commands of this thread
+    stagingRing->waitFor(graphics->getQueue(owner), value, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+}
+
+void BufferAllocation::updateOnOwner(uint64 regionOffset, uint64 regionSize, void* ptr) {
     VkBufferCreateInfo stagingInfo = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
@@ -104,8 +133,7 @@ void BufferAllocation::updateContents(uint64 regionOffset, uint64 regionSize, vo
         .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
         .usage = VMA_MEMORY_USAGE_AUTO,
     };
-    OBufferAllocation staging =
-        new BufferAllocation(graphics, fmt::format("{0}UpdateStaging", name), stagingInfo, stagingAlloc, Gfx::QueueType::GRAPHICS);
+    OBufferAllocation staging = new BufferAllocation(graphics, fmt::format("{0}UpdateStaging", name), stagingInfo, stagingAlloc, owner);
 
     uint8* data;
     VK_CHECK(vmaMapMemory(graphics->getAllocator(), staging->allocation, (void**)&data));
@@ -113,22 +141,20 @@ void BufferAllocation::updateContents(uint64 regionOffset, uint64 regionSize, vo
     VK_CHECK(vmaFlushAllocation(graphics->getAllocator(), staging->allocation, 0, regionSize));
     vmaUnmapMemory(graphics->getAllocator(), staging->allocation);
 
-    Gfx::QueueType prevOwner = owner;
-    transferOwnership(Gfx::QueueType::TRANSFER);
-
-    PCommand cmd = graphics->getQueueCommands(Gfx::QueueType::GRAPHICS)->getCommands();
+    PCommand cmd = graphics->getQueueCommands(owner)->getCommands();
     VkBufferCopy copy = {
         .srcOffset = 0,
         .dstOffset = regionOffset,
         .size = regionSize,
     };
+    // earlier reads of the region have to be done before it is overwritten
+    pipelineBarrier(VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
     cmd->bindResource(PBufferAllocation(this));
     cmd->bindResource(PBufferAllocation(staging));
     vkCmdCopyBuffer(cmd->getHandle(), staging->buffer, buffer, 1, &copy);
-    pipelineBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
-                    VK_PIPELINE_STAGE_TRANSFER_BIT);
-
-    transferOwnership(prevOwner);
+    pipelineBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+                    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
     graphics->getDestructionManager()->queueResourceForDestruction(std::move(staging));
 }
 
@@ -287,16 +313,27 @@ void Buffer::rotateBuffer(uint64 size, bool preserveContents) {
 }
 
 void Buffer::createBuffer(uint64 size, uint32 destIndex) {
-    uint32 family = graphics->getFamilyMapping().getQueueTypeFamilyIndex(initialOwner);
+    // dynamic buffers are rewritten every few frames, so they are shared by every queue family and the staging ring can update them
+    // on the transfer queue while the graphics queue owns them, without handing them over twice for every update
+    // the others are written once or by their owner, and concurrent access can be slower on some devices, so they stay exclusive
+    Gfx::QueueFamilyMapping mapping = graphics->getFamilyMapping();
+    Array<uint32> families = {mapping.getQueueTypeFamilyIndex(initialOwner)};
+    if (dynamic) {
+        for (uint32 family : {mapping.graphicsFamily, mapping.computeFamily, mapping.transferFamily}) {
+            if (families.find(family) == families.end()) {
+                families.add(family);
+            }
+        }
+    }
     VkBufferCreateInfo info = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
         .size = size,
         .usage = usage,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 1,
-        .pQueueFamilyIndices = &family,
+        .sharingMode = families.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = (uint32)families.size(),
+        .pQueueFamilyIndices = families.data(),
     };
     VmaAllocationCreateInfo allocInfo = {
         .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
@@ -16,6 +16,7 @@ class BufferAllocation : public CommandBoundResource {
     virtual ~BufferAllocation();
     void pipelineBarrier(VkAccessFlags srcAccess, VkPipelineStageFlags srcStage, VkAccessFlags dstAccess, VkPipelineStageFlags dstStage);
     void transferOwnership(Gfx::QueueType newOwner);
+    // goes through the staging ring on the transfer queue, unless the buffer is still in use
     void updateContents(uint64 regionOffset, uint64 regionSize, void* ptr);
     void readContents(uint64 regionOffset, uint64 regionSize, void* ptr);
     void* map();
@@ -28,6 +29,11 @@ class BufferAllocation : public CommandBoundResource {
     uint64 size = 0;
     VkDeviceAddress deviceAddress;
     Gfx::QueueType owner;
+    // CONCURRENT buffers can be used by every queue without handing them over
+    VkSharingMode sharingMode;
+
+  private:
+    void updateOnOwner(uint64 regionOffset, uint64 regionSize, void* ptr);
 };
 DEFINE_REF(BufferAllocation);
 class Buffer {
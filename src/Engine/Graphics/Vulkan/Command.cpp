@@ -6,11 +6,60 @@
 #include "Pipeline.h"
 #include "RayTracing.h"
 #include "RenderPass.h"
+#include "StagingRing.h"
 #include "Window.h"
 
 using namespace Seele;
 using namespace Seele::Vulkan;
 
+CommandAllocator::CommandAllocator(PGraphics graphics, uint32 queueFamilyIndex) : graphics(graphics) {
+    VkCommandPoolCreateInfo info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = queueFamilyIndex,
+    };
+    VK_CHECK(vkCreateCommandPool(graphics->getDevice(), &info, nullptr, &commandPool));
+}
+
+CommandAllocator::~CommandAllocator() {
+    assert(numPending == 0);
+    vkDestroyCommandPool(graphics->getDevice(), commandPool, nullptr);
+}
+
+VkCommandBuffer CommandAllocator::allocate() {
+    numPending++;
+    if (numAllocated < buffers.size()) {
+        return buffers[numAllocated++];
+    }
+    VkCommandBufferAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .commandPool = commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+        .commandBufferCount = 1,
+    };
+    VK_CHECK(vkAllocateCommandBuffers(graphics->getDevice(), &allocInfo, &buffers.add()));
+    numAllocated++;
+    return buffers.back();
+}
+
+void CommandAllocator::release() {
+    assert(numPending > 0);
+    numPending--;
+}
+
+bool CommandAllocator::tryReset() {
+    if (numPending > 0) {
+        return false;
+    }
+    if (numAllocated > 0) {
+        VK_CHECK(vkResetCommandPool(graphics->getDevice(), commandPool, 0));
+        numAllocated = 0;
+    }
+    return true;
+}
+
 Command::Command(PGraphics graphics, PCommandPool pool) : graphics(graphics), pool(pool), statisticsFlags(0) {
     VkCommandBufferAllocateInfo allocInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
@@ -84,7 +133,10 @@ void Command::executeCommands(Array<Gfx::ORenderCommand> commands) {
     Array<VkCommandBuffer> cmdBuffers(commands.size());
     for (uint32 i = 0; i < commands.size(); ++i) {
         auto command = Gfx::PRenderCommand(commands[i]).cast<RenderCommand>();
-        command->end();
+        // commands recorded on other threads were ended there, this only collects their handles
+        if (!command->isEnded()) {
+            command->end();
+        }
         for (auto& descriptor : command->boundResources) {
             boundResources.add(descriptor);
             // std::cout << "Cmd " << handle << " bound descriptor " << descriptor->getHandle() << std::endl;
@@ -102,7 +154,9 @@ void Command::executeCommands(Array<Gfx::OComputeCommand> commands) {
     Array<VkCommandBuffer> cmdBuffers(commands.size());
     for (uint32 i = 0; i < commands.size(); ++i) {
         auto command = Gfx::PComputeCommand(commands[i]).cast<ComputeCommand>();
-        command->end();
+        if (!command->isEnded()) {
+            command->end();
+        }
         for (auto& descriptor : command->boundResources) {
             boundResources.add(descriptor);
             // std::cout << "Cmd " << handle << " bound descriptor " << descriptor->getHandle() << std::endl;
@@ -119,17 +173,28 @@ void Command::waitForSemaphore(VkPipelineStageFlags flags, PSemaphore semaphore)
     waitFlags.add(flags);
 }
 
+void Command::waitForTimeline(VkPipelineStageFlags flags, PTimelineSemaphore timeline, uint64 value) {
+    waitTimelines.add(timeline);
+    waitTimelineValues.add(value);
+    waitTimelineFlags.add(flags);
+}
+
+void Command::signalTimeline(PTimelineSemaphore timeline, uint64 value) {
+    signalTimelineSemaphore = timeline;
+    signalTimelineValue = value;
+}
+
 void Command::checkFence() {
     assert(state == State::Submit || !fence->isSignaled());
     if (fence->isSignaled()) {
         vkResetCommandBuffer(handle, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
         fence->reset();
         for (auto& command : executingComputes) {
-            command->reset();
+            command->retire();
         }
         pool->cacheCommands(std::move(executingComputes));
         for (auto& command : executingRenders) {
-            command->reset();
+            command->retire();
         }
         pool->cacheCommands(std::move(executingRenders));
         for (auto& descriptor : boundResources) {
@@ -162,24 +227,23 @@ PFence Command::getFence() { return fence; }
 
 PCommandPool Command::getPool() { return pool; }
 
-RenderCommand::RenderCommand(PGraphics graphics, VkCommandPool cmdPool) : graphics(graphics), owner(cmdPool) {
-    VkCommandBufferAllocateInfo allocInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .pNext = nullptr,
-        .commandPool = owner,
-        .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
-        .commandBufferCount = 1,
-    };
-    VK_CHECK(vkAllocateCommandBuffers(graphics->getDevice(), &allocInfo, &handle));
-}
+RenderCommand::RenderCommand(PGraphics graphics) : graphics(graphics) {}
 
-RenderCommand::~RenderCommand() { vkFreeCommandBuffers(graphics->getDevice(), owner, 1, &handle); }
+RenderCommand::~RenderCommand() {
+    // dropped without being executed, the buffer is reclaimed with the rest of its allocator
+    if (allocator != nullptr) {
+        allocator->release();
+    }
+}
 
-void RenderCommand::begin(PRenderPass renderPass, PFramebuffer framebuffer, VkQueryPipelineStatisticFlags pipelineFlags) {
+void RenderCommand::begin(PCommandAllocator _allocator, PRenderPass renderPass, PFramebuffer framebuffer,
+                          VkQueryPipelineStatisticFlags pipelineFlags) {
     threadId = std::this_thread::get_id();
+    ended = false;
     pipeline = nullptr;
     rtPipeline = nullptr;
-    ready = false;
+    allocator = _allocator;
+    handle = allocator->allocate();
     VkCommandBufferInheritanceInfo inheritanceInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
         .subpass = 0,
@@ -208,16 +272,20 @@ void RenderCommand::begin(PRenderPass renderPass, PFramebuffer framebuffer, VkQu
     vkSetDebugUtilsObjectNameEXT(graphics->getDevice(), &nameInfo);
 }
 
-void RenderCommand::end() { VK_CHECK(vkEndCommandBuffer(handle)); }
+void RenderCommand::end() {
+    // the command pool belongs to the recording thread, ending it anywhere else races with that thread recording into the pool
+    assert(threadId == std::this_thread::get_id());
+    VK_CHECK(vkEndCommandBuffer(handle));
+    ended = true;
+}
 
-void RenderCommand::reset() {
-    vkResetCommandBuffer(handle, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+void RenderCommand::retire() {
     boundResources.clear();
-    ready = true;
+    allocator->release();
+    allocator = nullptr;
+    handle = VK_NULL_HANDLE;
 }
 
-bool RenderCommand::isReady() { return ready; }
-
 void RenderCommand::setViewport(Gfx::PViewport viewport) {
     assert(threadId == std::this_thread::get_id());
     VkViewport vp = viewport.cast<Viewport>()->getHandle();
@@ -371,22 +439,19 @@ void RenderCommand::traceRays(uint32 width, uint32 height, uint32 depth) {
     vkCmdTraceRaysKHR(handle, &rayGenRef, &missRef, &hitRef, &callableRef, width, height, depth);
 }
 
-ComputeCommand::ComputeCommand(PGraphics graphics, VkCommandPool cmdPool) : graphics(graphics), owner(cmdPool) {
-    VkCommandBufferAllocateInfo allocInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .pNext = nullptr,
-        .commandPool = owner,
-        .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
-        .commandBufferCount = 1,
-    };
-    VK_CHECK(vkAllocateCommandBuffers(graphics->getDevice(), &allocInfo, &handle));
-}
+ComputeCommand::ComputeCommand(PGraphics graphics) : graphics(graphics) {}
 
-ComputeCommand::~ComputeCommand() { vkFreeCommandBuffers(graphics->getDevice(), owner, 1, &handle); }
+ComputeCommand::~ComputeCommand() {
+    if (allocator != nullptr) {
+        allocator->release();
+    }
+}
 
-void ComputeCommand::begin(VkQueryPipelineStatisticFlags pipelineFlags) {
+void ComputeCommand::begin(PCommandAllocator _allocator, VkQueryPipelineStatisticFlags pipelineFlags) {
     threadId = std::this_thread::get_id();
-    ready = false;
+    ended = false;
+    allocator = _allocator;
+    handle = allocator->allocate();
     VkCommandBufferInheritanceInfo inheritanceInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
         .renderPass = VK_NULL_HANDLE,
@@ -416,15 +481,15 @@ void ComputeCommand::begin(VkQueryPipelineStatisticFlags pipelineFlags) {
 void ComputeCommand::end() {
     assert(threadId == std::this_thread::get_id());
     VK_CHECK(vkEndCommandBuffer(handle));
+    ended = true;
 }
 
-void ComputeCommand::reset() {
-    assert(threadId == std::this_thread::get_id());
-    vkResetCommandBuffer(handle, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+void ComputeCommand::retire() {
     boundResources.clear();
-    ready = true;
+    allocator->release();
+    allocator = nullptr;
+    handle = VK_NULL_HANDLE;
 }
-bool ComputeCommand::isReady() { return ready; }
 
 void ComputeCommand::bindPipeline(Gfx::PComputePipeline computePipeline) {
     assert(threadId == std::this_thread::get_id());
@@ -508,7 +573,8 @@ CommandPool::CommandPool(PGraphics graphics, PQueue queue) : graphics(graphics),
         .queueFamilyIndex = queue->getFamilyIndex(),
     };
     VK_CHECK(vkCreateCommandPool(graphics->getDevice(), &info, nullptr, &commandPool));
-    // TODO: dont reset individual commands, reset pool instead
+    commandAllocators.add(new CommandAllocator(graphics, queueFamilyIndex));
+    allocatorFrameIndex = Gfx::getCurrentFrameIndex();
     allocatedBuffers.add(new Command(graphics, this));
 
     command = allocatedBuffers.back();
@@ -524,6 +590,7 @@ CommandPool::~CommandPool() {
     allocatedRenderCommands.clear();
     allocatedComputeCommands.clear();
     allocatedBuffers.clear();
+    commandAllocators.clear();
     vkDestroyCommandPool(graphics->getDevice(), commandPool, nullptr);
     graphics = nullptr;
     queue = nullptr;
@@ -544,39 +611,42 @@ void CommandPool::cacheCommands(Array<OComputeCommand> commands) {
 }
 
 ORenderCommand CommandPool::createRenderCommand(const std::string& name) {
-    for (uint32 i = 0; i < allocatedRenderCommands.size(); ++i) {
-        if (allocatedRenderCommands[i]->isReady()) {
-            ORenderCommand cmdBuffer = std::move(allocatedRenderCommands[i]);
-            allocatedRenderCommands.removeAt(i, false);
-            cmdBuffer->name = name;
-            cmdBuffer->begin(command->boundRenderPass, command->boundFramebuffer, command->statisticsFlags);
-            return cmdBuffer;
-        }
+    ORenderCommand result;
+    if (allocatedRenderCommands.size() > 0) {
+        result = std::move(allocatedRenderCommands.back());
+        allocatedRenderCommands.pop();
+    } else {
+        result = new RenderCommand(graphics);
     }
-    ORenderCommand result = new RenderCommand(graphics, commandPool);
     result->name = name;
-    result->begin(command->boundRenderPass, command->boundFramebuffer, command->statisticsFlags);
+    PCommand parent = command;
+    if (parent->boundRenderPass == nullptr && graphics->getRenderPassCommand() != nullptr) {
+        // recorded on a worker thread while the rendering thread waits for it
+        parent = graphics->getRenderPassCommand();
+    }
+    result->begin(getCommandAllocator(), parent->boundRenderPass, parent->boundFramebuffer, parent->statisticsFlags);
     return result;
 }
 
 OComputeCommand CommandPool::createComputeCommand(const std::string& name) {
-    for (uint32 i = 0; i < allocatedComputeCommands.size(); ++i) {
-        if (allocatedComputeCommands[i]->isReady()) {
-            OComputeCommand cmdBuffer = std::move(allocatedComputeCommands[i]);
-            allocatedComputeCommands.removeAt(i, false);
-            cmdBuffer->name = name;
-            cmdBuffer->begin(command->statisticsFlags);
-            return cmdBuffer;
-        }
+    OComputeCommand result;
+    if (allocatedComputeCommands.size() > 0) {
+        result = std::move(allocatedComputeCommands.back());
+        allocatedComputeCommands.pop();
+    } else {
+        result = new ComputeCommand(graphics);
     }
-    OComputeCommand result = new ComputeCommand(graphics, commandPool);
     result->name = name;
-    result->begin(command->statisticsFlags);
+    result->begin(getCommandAllocator(), command->statisticsFlags);
     return result;
 }
 
 void CommandPool::submitCommands(PSemaphore signalSemaphore) {
     assert(command->state == Command::State::Begin); // Not in a renderpass
+    if (command->stagingValue > 0) {
+        graphics->getStagingRing()->flush(command->stagingValue);
+        command->stagingValue = 0;
+    }
     command->end();
     Array<VkSemaphore> semaphores = {command->signalSemaphore->getHandle()};
     command->signalSemaphore->encodeSignal();
@@ -610,3 +680,23 @@ void CommandPool::refreshCommands() {
         allocatedBuffers[i]->checkFence();
     }
 }
+
+PCommandAllocator CommandPool::getCommandAllocator() {
+    PCommandAllocator current = commandAllocators[currentAllocator];
+    if (allocatorFrameIndex == Gfx::getCurrentFrameIndex()) {
+        // threads without a frame loop, like asset loading, never switch, so reuse the allocator as soon as it is idle
+        current->tryReset();
+        return current;
+    }
+    allocatorFrameIndex = Gfx::getCurrentFrameIndex();
+    for (uint32 i = 1; i <= commandAllocators.size(); ++i) {
+        uint32 index = (currentAllocator + i) % commandAllocators.size();
+        if (commandAllocators[index]->tryReset()) {
+            currentAllocator = index;
+            return commandAllocators[index];
+        }
+    }
+    // every allocator still has a frame in flight
+    currentAllocator = (uint32)commandAllocators.size();
+    return commandAllocators.add(new CommandAllocator(graphics, queueFamilyIndex));
+}
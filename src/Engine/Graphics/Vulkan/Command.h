@@ -3,6 +3,7 @@
 #include "Graphics/Command.h"
 #include "Queue.h"
 #include "Resources.h"
+#include <atomic>
 #include <thread>
 
 namespace Seele {
@@ -13,6 +14,29 @@ DECLARE_REF(RenderCommand)
 DECLARE_REF(ComputeCommand)
 DECLARE_REF(DescriptorSet)
 DECLARE_REF(CommandPool)
+// Secondary command buffers recorded by a single thread
+// They are never reset one by one, once every buffer that was handed out has finished executing
+// the whole pool is reset at once
+class CommandAllocator {
+  public:
+    CommandAllocator(PGraphics graphics, uint32 queueFamilyIndex);
+    ~CommandAllocator();
+    // only on the owning thread
+    VkCommandBuffer allocate();
+    // from any thread, once a buffer finished executing or was dropped without being submitted
+    void release();
+    // only on the owning thread, fails while any buffer is still in use
+    bool tryReset();
+
+  private:
+    PGraphics graphics;
+    VkCommandPool commandPool;
+    Array<VkCommandBuffer> buffers;
+    uint32 numAllocated = 0;
+    std::atomic_uint32_t numPending = 0;
+};
+DEFINE_REF(CommandAllocator)
+
 class Command {
   public:
     Command(PGraphics graphics, PCommandPool pool);
@@ -25,6 +49,10 @@ class Command {
     void executeCommands(Array<Gfx::ORenderCommand> secondaryCommands);
     void executeCommands(Array<Gfx::OComputeCommand> secondaryCommands);
     void waitForSemaphore(VkPipelineStageFlags stages, PSemaphore waitSemaphore);
+    // the value does not need to be submitted yet, the queue waits on the GPU until it is signalled
+    void waitForTimeline(VkPipelineStageFlags stages, PTimelineSemaphore timeline, uint64 value);
+    // sets the timeline to value once the command completed
+    void signalTimeline(PTimelineSemaphore timeline, uint64 value);
     void bindResource(PCommandBoundResource resource);
     void checkFence();
     void waitForCommand(uint32 timeToWait = 1000000u);
@@ -50,6 +78,13 @@ class Command {
     PFramebuffer boundFramebuffer;
     Array<PSemaphore> waitSemaphores;
     Array<VkPipelineStageFlags> waitFlags;
+    Array<PTimelineSemaphore> waitTimelines;
+    Array<uint64> waitTimelineValues;
+    Array<VkPipelineStageFlags> waitTimelineFlags;
+    PTimelineSemaphore signalTimelineSemaphore = nullptr;
+    uint64 signalTimelineValue = 0;
+    // copies of the staging ring the command waits for, they are submitted together with it if nobody did so before
+    uint64 stagingValue = 0;
     Array<ORenderCommand> executingRenders;
     Array<OComputeCommand> executingComputes;
     Array<PCommandBoundResource> boundResources;
@@ -57,6 +92,7 @@ class Command {
     friend class RenderCommand;
     friend class CommandPool;
     friend class Queue;
+    friend class StagingRing;
 };
 DEFINE_REF(Command)
 
@@ -65,13 +101,14 @@ DECLARE_REF(ComputePipeline)
 DECLARE_REF(RayTracingPipeline)
 class RenderCommand : public Gfx::RenderCommand {
   public:
-    RenderCommand(PGraphics graphics, VkCommandPool cmdPool);
+    RenderCommand(PGraphics graphics);
     virtual ~RenderCommand();
     constexpr VkCommandBuffer getHandle() { return handle; }
-    void begin(PRenderPass renderPass, PFramebuffer framebuffer, VkQueryPipelineStatisticFlags pipelineFlags);
-    void end();
-    void reset();
-    bool isReady();
+    void begin(PCommandAllocator allocator, PRenderPass renderPass, PFramebuffer framebuffer, VkQueryPipelineStatisticFlags pipelineFlags);
+    virtual void end() override;
+    constexpr bool isEnded() const { return ended; }
+    // returns the buffer to its allocator once it finished executing, the command itself can be reused by any thread
+    void retire();
     virtual void setViewport(Gfx::PViewport viewport) override;
     virtual void bindPipeline(Gfx::PGraphicsPipeline pipeline) override;
     virtual void bindPipeline(Gfx::PRayTracingPipeline pipeline) override;
@@ -90,27 +127,27 @@ class RenderCommand : public Gfx::RenderCommand {
   private:
     PGraphicsPipeline pipeline = nullptr;
     PRayTracingPipeline rtPipeline = nullptr;
-    bool ready = false;
     Array<PCommandBoundResource> boundResources;
     VkViewport currentViewport = VkViewport();
     VkRect2D currentScissor = VkRect2D();
     PGraphics graphics;
     std::thread::id threadId;
-    VkCommandBuffer handle;
-    VkCommandPool owner;
+    VkCommandBuffer handle = VK_NULL_HANDLE;
+    PCommandAllocator allocator = nullptr;
+    bool ended = false;
     friend class Command;
 };
 DEFINE_REF(RenderCommand)
 
 class ComputeCommand : public Gfx::ComputeCommand {
   public:
-    ComputeCommand(PGraphics graphics, VkCommandPool cmdPool);
+    ComputeCommand(PGraphics graphics);
     virtual ~ComputeCommand();
     inline VkCommandBuffer getHandle() { return handle; }
-    void begin(VkQueryPipelineStatisticFlags pipelineFlags);
-    void end();
-    void reset();
-    bool isReady();
+    void begin(PCommandAllocator allocator, VkQueryPipelineStatisticFlags pipelineFlags);
+    virtual void end() override;
+    constexpr bool isEnded() const { return ended; }
+    void retire();
     virtual void bindPipeline(Gfx::PComputePipeline pipeline) override;
     virtual void bindDescriptor(Gfx::PDescriptorSet set) override;
     virtual void bindDescriptor(const Array<Gfx::PDescriptorSet>& sets) override;
@@ -120,12 +157,12 @@ class ComputeCommand : public Gfx::ComputeCommand {
 
   private:
     PComputePipeline pipeline;
-    bool ready = false;
     Array<PCommandBoundResource> boundResources;
     PGraphics graphics;
     std::thread::id threadId;
-    VkCommandBuffer handle;
-    VkCommandPool owner;
+    VkCommandBuffer handle = VK_NULL_HANDLE;
+    PCommandAllocator allocator = nullptr;
+    bool ended = false;
     friend class Command;
 };
 DEFINE_REF(ComputeCommand)
@@ -144,14 +181,20 @@ class CommandPool {
     void refreshCommands();
 
   private:
+    // switches to an idle allocator at the start of every frame, so the buffers of frames in flight are never touched
+    PCommandAllocator getCommandAllocator();
     PGraphics graphics;
     VkCommandPool commandPool;
     PQueue queue;
     uint32 queueFamilyIndex;
     PCommand command;
     Array<OCommand> allocatedBuffers;
+    // retired commands without a buffer, any of them can be handed out
     Array<ORenderCommand> allocatedRenderCommands;
     Array<OComputeCommand> allocatedComputeCommands;
+    Array<OCommandAllocator> commandAllocators;
+    uint32 currentAllocator = 0;
+    uint32 allocatorFrameIndex = 0;
 };
 DEFINE_REF(CommandPool)
 } // namespace Vulkan
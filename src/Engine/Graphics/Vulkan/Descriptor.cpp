@@ -9,10 +9,12 @@
 #include "Graphics/Enums.h"
 #include "Graphics/Initializer.h"
 #include "Graphics/Vulkan/Resources.h"
+#include "Profiler.h"
 #include "RayTracing.h"
 #include "Texture.h"
 #include "vulkan/vulkan_core.h"
 #include <algorithm>
+#include <fmt/core.h>
 #include <iostream>
 #include <mutex>
 
@@ -47,19 +49,19 @@ void DescriptorLayout::create() {
     }
     for (const auto& gfxBinding : descriptorBindings) {
         if (gfxBinding.descriptorType == Gfx::SE_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK) {
-            mappings[gfxBinding.name] = {
+            mappings.add(DescriptorMapping{
                 .binding = 0,
                 .constantOffset = constantsSize,
                 .constantSize = gfxBinding.uniformLength,
                 .type = cast(gfxBinding.descriptorType),
-            };
+            });
             constantsSize += gfxBinding.uniformLength;
             constantsStages |= gfxBinding.shaderStages;
         } else {
-            mappings[gfxBinding.name] = DescriptorMapping{
+            mappings.add(DescriptorMapping{
                 .binding = (uint32)bindings.size(),
                 .type = cast(gfxBinding.descriptorType),
-            };
+            });
             bindings.add(VkDescriptorSetLayoutBinding{
                 .binding = (uint32)bindings.size(),
                 .descriptorType = cast(gfxBinding.descriptorType),
@@ -91,47 +93,36 @@ void DescriptorLayout::create() {
 }
 
 DescriptorPool::DescriptorPool(PGraphics graphics, PDescriptorLayout layout)
-    : CommandBoundResource(graphics, layout->getName()), graphics(graphics), layout(layout) {
-    for (uint32 i = 0; i < cachedHandles.size(); ++i) {
-        cachedHandles[i] = nullptr;
-    }
-
-    Map<VkDescriptorType, uint32> perTypeSizes;
-    for (uint32 i = 0; i < layout->bindings.size(); ++i) {
-        auto& binding = layout->bindings[i];
-        perTypeSizes[binding.descriptorType] += 512;
-    }
-    Array<VkDescriptorPoolSize> poolSizes;
-    for (const auto& [type, num] : perTypeSizes) {
-        poolSizes.add(VkDescriptorPoolSize{
-            .type = type,
-            .descriptorCount = num,
-        });
-    }
-    VkDescriptorPoolCreateInfo createInfo = {
-        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .maxSets = maxSets * Gfx::numFramesBuffered,
-        .poolSizeCount = (uint32)poolSizes.size(),
-        .pPoolSizes = poolSizes.data(),
-    };
-    VK_CHECK(vkCreateDescriptorPool(graphics->getDevice(), &createInfo, nullptr, &poolHandle));
-}
+    : CommandBoundResource(graphics, layout->getName()), graphics(graphics), layout(layout),
+      allocatedCounter(fmt::format("{} descriptor sets allocated", layout->getName())),
+      createdCounter(fmt::format("{} descriptor sets created", layout->getName())),
+      totalCounter(fmt::format("{} descriptor sets", layout->getName())) {}
 
 DescriptorPool::~DescriptorPool() {
-    for (size_t i = 0; i < maxSets; ++i) {
-        if (cachedHandles[i] != nullptr) {
-            graphics->getDestructionManager()->queueResourceForDestruction(std::move(cachedHandles[i]));
-        }
+    for (auto& handle : handles) {
+        graphics->getDestructionManager()->queueResourceForDestruction(std::move(handle));
     }
-    vkDestroyDescriptorPool(graphics->getDevice(), poolHandle, nullptr);
-    if (nextAlloc) {
-        delete nextAlloc;
+    for (VkDescriptorPool block : blocks) {
+        vkDestroyDescriptorPool(graphics->getDevice(), block, nullptr);
     }
 }
 
 Gfx::ODescriptorSet DescriptorPool::allocateDescriptorSet() {
+    std::unique_lock l(lock);
+    uint64 frameNumber = Gfx::getCurrentFrameNumber();
+    Gfx::DescriptorArenas::Statistics lastFrame = arenas.getStatistics();
+    // a set can be written again once no command reads it and no DescriptorSet refers to it anymore
+    if (arenas.beginFrame(frameNumber, [this](uint32 set) { return !handles[set]->isCurrentlyBound() && !handles[set]->isUsed; })) {
+        exportStatistics(lastFrame);
+    }
+    uint32 setIndex = arenas.allocate();
+    if (setIndex < handles.size()) {
+        handles[setIndex]->isUsed = true;
+        return new DescriptorSet(graphics, this, handles[setIndex]);
+    }
+    if (setsInLastBlock == lastBlockSize) {
+        addBlock();
+    }
     VkDescriptorSetLayout layoutHandle = layout->getHandle();
     VkDescriptorSetVariableDescriptorCountAllocateInfo setCounts = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
@@ -141,7 +132,7 @@ Gfx::ODescriptorSet DescriptorPool::allocateDescriptorSet() {
     VkDescriptorSetAllocateInfo allocInfo = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
         .pNext = nullptr,
-        .descriptorPool = poolHandle,
+        .descriptorPool = blocks.back(),
         .descriptorSetCount = 1,
         .pSetLayouts = &layoutHandle,
     };
@@ -155,39 +146,59 @@ Gfx::ODescriptorSet DescriptorPool::allocateDescriptorSet() {
         setCounts.pDescriptorCounts = &counts;
         allocInfo.pNext = &setCounts;
     }
-    for (uint32 setIndex = 0; setIndex < cachedHandles.size(); ++setIndex) {
-        if (cachedHandles[setIndex] == nullptr) {
-            cachedHandles[setIndex] = new DescriptorSetHandle(graphics, layout->getName());
-        }
-        if (cachedHandles[setIndex]->isCurrentlyBound() || cachedHandles[setIndex]->isUsed) {
-            // Currently in use, skip
-            continue;
-        }
-        if (cachedHandles[setIndex]->getHandle() == VK_NULL_HANDLE) {
-            // If it hasnt been initialized, allocate it
-            VK_CHECK(vkAllocateDescriptorSets(graphics->getDevice(), &allocInfo, &cachedHandles[setIndex]->handle));
-            VkDebugUtilsObjectNameInfoEXT nameInfo = {
-                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
-                .pNext = nullptr,
-                .objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET,
-                .objectHandle = (uint64)cachedHandles[setIndex]->getHandle(),
-                .pObjectName = name.c_str(),
-            };
-            vkSetDebugUtilsObjectNameEXT(graphics->getDevice(), &nameInfo);
+    ODescriptorSetHandle& handle = handles.add(new DescriptorSetHandle(graphics, layout->getName()));
+    VK_CHECK(vkAllocateDescriptorSets(graphics->getDevice(), &allocInfo, &handle->handle));
+    setsInLastBlock++;
+    VkDebugUtilsObjectNameInfoEXT nameInfo = {
+        .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+        .pNext = nullptr,
+        .objectType = VK_OBJECT_TYPE_DESCRIPTOR_SET,
+        .objectHandle = (uint64)handle->getHandle(),
+        .pObjectName = name.c_str(),
+    };
+    vkSetDebugUtilsObjectNameEXT(graphics->getDevice(), &nameInfo);
+    handle->isUsed = true;
+    return new DescriptorSet(graphics, this, handle);
+}
+
+void DescriptorPool::reset() {}
+
+void DescriptorPool::addBlock() {
+    lastBlockSize = std::min(std::max(lastBlockSize * 2, minSetsPerBlock), maxSetsPerBlock);
+    setsInLastBlock = 0;
+    // sized for exactly lastBlockSize sets, so allocating from it can not fail before they are all taken
+    Map<VkDescriptorType, uint32> perTypeSizes;
+    for (const auto& binding : layout->bindings) {
+        if (binding.descriptorCount > 0) {
+            perTypeSizes[binding.descriptorType] += binding.descriptorCount * lastBlockSize;
         }
-        cachedHandles[setIndex]->isUsed = true;
-        // Found set, stop searching
-        return new DescriptorSet(graphics, this, cachedHandles[setIndex]);
     }
-    if (nextAlloc == nullptr) {
-        nextAlloc = new DescriptorPool(graphics, layout);
+    Array<VkDescriptorPoolSize> poolSizes;
+    for (const auto& [type, num] : perTypeSizes) {
+        poolSizes.add(VkDescriptorPoolSize{
+            .type = type,
+            .descriptorCount = num,
+        });
     }
-    // std::cout << "Out of descriptors, forwarding" << std::endl;
-    return nextAlloc->allocateDescriptorSet();
-    // throw std::logic_error("Out of descriptor sets");
+    VkDescriptorPoolCreateInfo createInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .maxSets = lastBlockSize,
+        .poolSizeCount = (uint32)poolSizes.size(),
+        .pPoolSizes = poolSizes.data(),
+    };
+    VK_CHECK(vkCreateDescriptorPool(graphics->getDevice(), &createInfo, nullptr, &blocks.add()));
 }
 
-void DescriptorPool::reset() {}
+void DescriptorPool::exportStatistics(const Gfx::DescriptorArenas::Statistics& lastFrame) {
+    if (!getGlobals().profiling) {
+        return;
+    }
+    Profiler::setCounter(allocatedCounter, lastFrame.allocated);
+    Profiler::setCounter(createdCounter, lastFrame.created);
+    Profiler::setCounter(totalCounter, lastFrame.total);
+}
 
 DescriptorSetHandle::DescriptorSetHandle(PGraphics graphics, const std::string& name) : CommandBoundResource(graphics, name) {}
 
@@ -212,193 +223,111 @@ DescriptorSet::~DescriptorSet() {
     setHandle->isUsed = false;
 }
 
-void DescriptorSet::updateConstants(const std::string& mappingName, uint32 offset, void* data) {
-    std::memcpy(constantData.data() + owner->getLayout()->mappings[mappingName].constantOffset, (char*)data + offset,
-                owner->getLayout()->mappings[mappingName].constantSize);
+void DescriptorSet::updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) {
+    const DescriptorMapping& map = owner->getLayout()->mappings[binding.index];
+    std::memcpy(constantData.data() + map.constantOffset, (char*)data + offset, map.constantSize);
 }
 
-void DescriptorSet::updateBuffer(const std::string& mappingName, uint32 index, Gfx::PShaderBuffer shaderBuffer) {
-    PShaderBuffer vulkanBuffer = shaderBuffer.cast<ShaderBuffer>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
-    uint32 binding = map.binding;
-    // if the buffer is empty
-    if (vulkanBuffer->getAlloc() == nullptr)
-        return;
-
-    bufferInfos.add(VkDescriptorBufferInfo{
-        .buffer = vulkanBuffer->getHandle(),
-        .offset = 0,
-        .range = vulkanBuffer->getSize(),
-    });
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pBufferInfo = &bufferInfos.back(),
-    });
-
-    boundResources[binding][index] = vulkanBuffer->getAlloc();
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer shaderBuffer) {
+    writeBuffer(binding, index, shaderBuffer.cast<ShaderBuffer>());
 }
 
-void DescriptorSet::updateBuffer(const std::string& mappingName, uint32 index, Gfx::PVertexBuffer vertexBuffer) {
-    PVertexBuffer vulkanBuffer = vertexBuffer.cast<VertexBuffer>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
-    uint32 binding = map.binding;
-    // if the buffer is empty
-    if (vulkanBuffer->getAlloc() == nullptr)
-        return;
-
-    bufferInfos.add(VkDescriptorBufferInfo{
-        .buffer = vulkanBuffer->getHandle(),
-        .offset = 0,
-        .range = vulkanBuffer->getSize(),
-    });
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pBufferInfo = &bufferInfos.back(),
-    });
-
-    boundResources[binding][index] = vulkanBuffer->getAlloc();
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer vertexBuffer) {
+    writeBuffer(binding, index, vertexBuffer.cast<VertexBuffer>());
 }
 
-void DescriptorSet::updateBuffer(const std::string& mappingName, uint32 index, Gfx::PIndexBuffer indexBuffer) {
-    PIndexBuffer vulkanBuffer = indexBuffer.cast<IndexBuffer>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
-    uint32 binding = map.binding;
-    // if the buffer is empty
-    if (vulkanBuffer->getAlloc() == nullptr)
-        return;
-
-    bufferInfos.add(VkDescriptorBufferInfo{
-        .buffer = vulkanBuffer->getHandle(),
-        .offset = 0,
-        .range = vulkanBuffer->getSize(),
-    });
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pBufferInfo = &bufferInfos.back(),
-    });
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer indexBuffer) {
+    writeBuffer(binding, index, indexBuffer.cast<IndexBuffer>());
+}
 
-    boundResources[binding][index] = vulkanBuffer->getAlloc();
+void DescriptorSet::updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) {
+    writeBuffer(binding, index, uniformBuffer.cast<UniformBuffer>());
 }
 
-void DescriptorSet::updateBuffer(const std::string& mappingName, uint32 index, Gfx::PUniformBuffer uniformBuffer) {
-    PUniformBuffer vulkanBuffer = uniformBuffer.cast<UniformBuffer>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
+void DescriptorSet::updateSampler(Gfx::DescriptorBindingHandle handle, uint32 index, Gfx::PSampler samplerState) {
+    const DescriptorMapping& map = owner->getLayout()->mappings[handle.index];
     uint32 binding = map.binding;
-    // if the buffer is empty
-    if (vulkanBuffer->getAlloc() == nullptr)
+    if (samplerState == nullptr) {
+        // the slot is not read anymore, a partially bound array can keep the stale descriptor
+        boundResources[binding][index] = nullptr;
         return;
-
-    bufferInfos.add(VkDescriptorBufferInfo{
-        .buffer = vulkanBuffer->getHandle(),
-        .offset = 0,
-        .range = vulkanBuffer->getSize(),
-    });
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pBufferInfo = &bufferInfos.back(),
-    });
-
-    boundResources[binding][index] = vulkanBuffer->getAlloc();
-}
-
-void DescriptorSet::updateSampler(const std::string& mappingName, uint32 index, Gfx::PSampler samplerState) {
+    }
     PSampler vulkanSampler = samplerState.cast<Sampler>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
-    uint32 binding = map.binding;
     if (boundResources[binding][index] == vulkanSampler->getHandle()) {
         return;
     }
 
+    addWrite(map, index, (uint32)imageInfos.size());
     imageInfos.add(VkDescriptorImageInfo{
         .sampler = vulkanSampler->getSampler(),
         .imageView = VK_NULL_HANDLE,
         .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
     });
 
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pImageInfo = &imageInfos.back(),
-    });
-
     boundResources[binding][index] = vulkanSampler->getHandle();
 }
 
-void DescriptorSet::updateTexture(const std::string& mappingName, uint32 index, Gfx::PTextureView texture) {
-    PTextureView vulkanTexture = texture.cast<TextureView>();
-    const auto& map = owner->getLayout()->mappings[mappingName];
+void DescriptorSet::updateTexture(Gfx::DescriptorBindingHandle handle, uint32 index, Gfx::PTextureView texture) {
+    const DescriptorMapping& map = owner->getLayout()->mappings[handle.index];
     uint32 binding = map.binding;
+    if (texture == nullptr) {
+        boundResources[binding][index] = nullptr;
+        return;
+    }
+    PTextureView vulkanTexture = texture.cast<TextureView>();
     if (boundResources[binding][index] == vulkanTexture->getSource()) {
         return;
     }
 
     // It is assumed that the image is in the correct layout
+    addWrite(map, index, (uint32)imageInfos.size());
     imageInfos.add(VkDescriptorImageInfo{
         .sampler = VK_NULL_HANDLE,
         .imageView = vulkanTexture->getView(),
         .imageLayout = cast(vulkanTexture->getLayout()),
     });
-    writeDescriptors.add(VkWriteDescriptorSet{
-        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = nullptr,
-        .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
-        .dstArrayElement = index,
-        .descriptorCount = 1,
-        .descriptorType = map.type,
-        .pImageInfo = &imageInfos.back(),
-    });
 
     boundResources[binding][index] = vulkanTexture->getSource();
 }
 
-void DescriptorSet::updateAccelerationStructure(const std::string& mappingName, uint32 index, Gfx::PTopLevelAS as) {
+void DescriptorSet::updateAccelerationStructure(Gfx::DescriptorBindingHandle handle, uint32 index, Gfx::PTopLevelAS as) {
     auto tlas = as.cast<TopLevelAS>();
-    uint32 binding = owner->getLayout()->mappings[mappingName].binding;
+    addWrite(owner->getLayout()->mappings[handle.index], index, (uint32)accelerationInfos.size());
     accelerationInfos.add(VkWriteDescriptorSetAccelerationStructureKHR{
         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
         .pNext = nullptr,
         .accelerationStructureCount = 1,
         .pAccelerationStructures = &tlas->handle,
     });
+}
+
+void DescriptorSet::writeBuffer(Gfx::DescriptorBindingHandle handle, uint32 index, PBuffer buffer) {
+    const DescriptorMapping& map = owner->getLayout()->mappings[handle.index];
+    // if the buffer is empty
+    if (buffer->getAlloc() == nullptr)
+        return;
+
+    addWrite(map, index, (uint32)bufferInfos.size());
+    bufferInfos.add(VkDescriptorBufferInfo{
+        .buffer = buffer->getHandle(),
+        .offset = 0,
+        .range = buffer->getSize(),
+    });
+
+    boundResources[map.binding][index] = buffer->getAlloc();
+}
+
+void DescriptorSet::addWrite(const DescriptorMapping& map, uint32 index, uint32 infoIndex) {
     writeDescriptors.add(VkWriteDescriptorSet{
         .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-        .pNext = &accelerationInfos.back(),
+        .pNext = nullptr,
         .dstSet = setHandle->getHandle(),
-        .dstBinding = binding,
+        .dstBinding = map.binding,
         .dstArrayElement = index,
         .descriptorCount = 1,
-        .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+        .descriptorType = map.type,
     });
+    writeInfoIndices.add(infoIndex);
 }
 
 void DescriptorSet::writeChanges() {
@@ -420,21 +349,17 @@ void DescriptorSet::writeChanges() {
         setHandle->constantsBuffer->updateContents(0, constantData.size(), constantData.data());
         setHandle->constantsBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
                                          Gfx::SE_ACCESS_UNIFORM_READ_BIT, Gfx::SE_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        addWrite(
+            DescriptorMapping{
+                .binding = 0,
+                .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            },
+            0, (uint32)bufferInfos.size());
         bufferInfos.add(VkDescriptorBufferInfo{
             .buffer = setHandle->constantsBuffer->buffer,
             .offset = 0,
             .range = setHandle->constantsBuffer->size,
         });
-        writeDescriptors.add(VkWriteDescriptorSet{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = setHandle->getHandle(),
-            .dstBinding = 0,
-            .dstArrayElement = 0,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .pBufferInfo = &bufferInfos.back(),
-        });
     }
 
     if (writeDescriptors.size() > 0) {
@@ -442,10 +367,31 @@ void DescriptorSet::writeChanges() {
             std::cout << "Descriptor currently bound, allocate a new one instead" << std::endl;
             assert(!setHandle->isCurrentlyBound());
         }
+        // the infos only get pointed to now, while they were added they could still move
+        for (uint32 i = 0; i < writeDescriptors.size(); ++i) {
+            VkWriteDescriptorSet& write = writeDescriptors[i];
+            switch (write.descriptorType) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                write.pImageInfo = &imageInfos[writeInfoIndices[i]];
+                break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                write.pNext = &accelerationInfos[writeInfoIndices[i]];
+                break;
+            default:
+                write.pBufferInfo = &bufferInfos[writeInfoIndices[i]];
+                break;
+            }
+        }
         vkUpdateDescriptorSets(graphics->getDevice(), (uint32)writeDescriptors.size(), writeDescriptors.data(), 0, nullptr);
         writeDescriptors.clear();
+        writeInfoIndices.clear();
         imageInfos.clear();
         bufferInfos.clear();
+        accelerationInfos.clear();
     }
 }
 
@@ -1,8 +1,9 @@
 #pragma once
-#include "Containers/List.h"
 #include "Graphics/Descriptor.h"
+#include "Graphics/DescriptorArenas.h"
 #include "Graphics/Vulkan/Buffer.h"
 #include "Resources.h"
+#include <mutex>
 #include <vulkan/vulkan_core.h>
 
 namespace Seele {
@@ -26,7 +27,8 @@ class DescriptorLayout : public Gfx::DescriptorLayout {
     uint32 constantsSize = 0;
     VkShaderStageFlags constantsStages = 0;
     Array<VkDescriptorSetLayoutBinding> bindings;
-    Map<std::string, DescriptorMapping> mappings;
+    // indexed by the handles of the bindings
+    Array<DescriptorMapping> mappings;
     VkDescriptorSetLayout layoutHandle;
     friend class DescriptorPool;
     friend class DescriptorSet;
@@ -51,18 +53,30 @@ class DescriptorPool : public Gfx::DescriptorPool, public CommandBoundResource {
     DescriptorPool(PGraphics graphics, PDescriptorLayout layout);
     virtual ~DescriptorPool();
     virtual Gfx::ODescriptorSet allocateDescriptorSet() override;
+    // sets are recycled by their frame arena, there is nothing left to reset
     virtual void reset() override;
 
-    constexpr VkDescriptorPool getHandle() const { return poolHandle; }
     constexpr PDescriptorLayout getLayout() const { return layout; }
 
   private:
+    // a new block once the last one is full, each one holding twice as many sets up to maxSetsPerBlock
+    void addBlock();
+    void exportStatistics(const Gfx::DescriptorArenas::Statistics& lastFrame);
     PGraphics graphics;
     PDescriptorLayout layout;
-    const static int maxSets = 64;
-    StaticArray<ODescriptorSetHandle, maxSets> cachedHandles;
-    VkDescriptorPool poolHandle;
-    DescriptorPool* nextAlloc = nullptr;
+    constexpr static uint32 minSetsPerBlock = 8;
+    constexpr static uint32 maxSetsPerBlock = 64;
+    // sets are never freed, so they are only ever allocated from the last block
+    Array<VkDescriptorPool> blocks;
+    uint32 setsInLastBlock = 0;
+    uint32 lastBlockSize = 0;
+    // indexed by the sets the arenas hand out
+    Array<ODescriptorSetHandle> handles;
+    Gfx::DescriptorArenas arenas;
+    std::string allocatedCounter;
+    std::string createdCounter;
+    std::string totalCounter;
+    std::mutex lock;
 };
 DEFINE_REF(DescriptorPool)
 class DescriptorSet : public Gfx::DescriptorSet {
@@ -70,23 +84,34 @@ class DescriptorSet : public Gfx::DescriptorSet {
     DescriptorSet(PGraphics graphics, PDescriptorPool owner, PDescriptorSetHandle setHandle);
     virtual ~DescriptorSet();
     virtual void writeChanges() override;
-    virtual void updateConstants(const std::string& name, uint32 offset, void* data) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PShaderBuffer shaderBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PVertexBuffer vertexBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PIndexBuffer indexBuffer) override;
-    virtual void updateBuffer(const std::string& name, uint32 index, Gfx::PUniformBuffer uniformBuffer) override;
-    virtual void updateSampler(const std::string& name, uint32 index, Gfx::PSampler samplerState) override;
-    virtual void updateTexture(const std::string& name, uint32 index, Gfx::PTextureView texture) override;
-    virtual void updateAccelerationStructure(const std::string& name, uint32 index, Gfx::PTopLevelAS as) override;
+    using Gfx::DescriptorSet::updateAccelerationStructure;
+    using Gfx::DescriptorSet::updateBuffer;
+    using Gfx::DescriptorSet::updateConstants;
+    using Gfx::DescriptorSet::updateSampler;
+    using Gfx::DescriptorSet::updateTexture;
+    virtual void updateConstants(Gfx::DescriptorBindingHandle binding, uint32 offset, void* data) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PShaderBuffer shaderBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PVertexBuffer vertexBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PIndexBuffer indexBuffer) override;
+    virtual void updateBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PUniformBuffer uniformBuffer) override;
+    virtual void updateSampler(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PSampler samplerState) override;
+    virtual void updateTexture(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTextureView texture) override;
+    virtual void updateAccelerationStructure(Gfx::DescriptorBindingHandle binding, uint32 index, Gfx::PTopLevelAS as) override;
+    virtual bool isCurrentlyBound() const override { return setHandle->isCurrentlyBound(); }
 
     constexpr VkDescriptorSet getHandle() const { return setHandle->getHandle(); }
 
   private:
+    void writeBuffer(Gfx::DescriptorBindingHandle binding, uint32 index, PBuffer buffer);
+    // the info pointers are filled in by writeChanges
+    void addWrite(const DescriptorMapping& map, uint32 index, uint32 infoIndex);
     std::vector<uint8> constantData;
-    List<VkDescriptorImageInfo> imageInfos;
-    List<VkDescriptorBufferInfo> bufferInfos;
-    List<VkWriteDescriptorSetAccelerationStructureKHR> accelerationInfos;
+    Array<VkDescriptorImageInfo> imageInfos;
+    Array<VkDescriptorBufferInfo> bufferInfos;
+    Array<VkWriteDescriptorSetAccelerationStructureKHR> accelerationInfos;
     Array<VkWriteDescriptorSet> writeDescriptors;
+    // for every write, the info it uses in the array that matches its descriptor type
+    Array<uint32> writeInfoIndices;
     // contains the previously bound resources at every binding
     // since the layout is fixed, trying to bind a texture to a buffer
     // would not work anyways, so casts should be safe
@@ -15,6 +15,7 @@
 #include "RayTracing.h"
 #include "RenderPass.h"
 #include "Shader.h"
+#include "StagingRing.h"
 #include "Window.h"
 #include <GLFW/glfw3.h>
 #include <cstring>
@@ -131,7 +132,18 @@ Graphics::~Graphics() {
     pipelineCache = nullptr;
     allocatedFramebuffers.clear();
     shaderCompiler = nullptr;
+    // secondary commands go back to the allocator of the thread that recorded them,
+    // so all pools have to be finished before the first one is destroyed
+    for (auto& pool : pools) {
+        pool->submitCommands();
+    }
+    vkDeviceWaitIdle(handle);
+    for (auto& pool : pools) {
+        pool->refreshCommands();
+    }
+    stagingRing = nullptr;
     pools.clear();
+    handoffSemaphores.clear();
     queues.clear();
     destructionManager = nullptr;
     allocator = nullptr;
@@ -163,6 +175,8 @@ void Graphics::init(GraphicsInitializer initInfo) {
     vmaCreateAllocator(&createInfo, &allocator);
     pipelineCache = new PipelineCache(this, "pipeline.cache");
     destructionManager = new DestructionManager(this);
+    // enough for the per frame instance and light data of large scenes, most textures get a staging buffer of their own anyway
+    stagingRing = new StagingRing(this, queues[transferQueue], 16 * 1024 * 1024);
 }
 
 Gfx::OWindow Graphics::createWindow(const WindowCreateInfo& createInfo) { return new Window(this, createInfo); }
@@ -189,12 +203,17 @@ void Graphics::beginRenderPass(Gfx::PRenderPass renderPass) {
             framebuffer = found->value;
         }
     }
-    getGraphicsCommands()->getCommands()->beginRenderPass(rp, framebuffer);
+    renderPassCommand = getGraphicsCommands()->getCommands();
+    renderPassCommand->beginRenderPass(rp, framebuffer);
 }
 
-void Graphics::endRenderPass() { getGraphicsCommands()->getCommands()->endRenderPass(); }
+void Graphics::endRenderPass() {
+    getGraphicsCommands()->getCommands()->endRenderPass();
+    renderPassCommand = nullptr;
+}
 
 void Graphics::waitDeviceIdle() {
+    stagingRing->flush();
     getGraphicsCommands()->submitCommands();
     vkDeviceWaitIdle(handle);
     getGraphicsCommands()->refreshCommands();
@@ -213,11 +232,41 @@ void Graphics::executeCommands(Array<Gfx::ORenderCommand> commands) {
 void Graphics::executeCommands(Gfx::OComputeCommand commands) {
     Array<Gfx::OComputeCommand> commandArray;
     commandArray.add(std::move(commands));
-    getComputeCommands()->getCommands()->executeCommands(std::move(commandArray));
+    getQueueCommands(computeQueueType)->getCommands()->executeCommands(std::move(commandArray));
 }
 
 void Graphics::executeCommands(Array<Gfx::OComputeCommand> commands) {
-    getComputeCommands()->getCommands()->executeCommands(std::move(commands));
+    getQueueCommands(computeQueueType)->getCommands()->executeCommands(std::move(commands));
+}
+
+bool Graphics::queueHandoff(Gfx::QueueType from, Gfx::QueueType to) {
+    PCommandPool source = getQueueCommands(from);
+    PCommandPool destination = getQueueCommands(to);
+    if (source == destination) {
+        return false;
+    }
+    PSemaphore semaphore = nullptr;
+    for (auto& handoff : handoffSemaphores) {
+        if (!handoff->getCurrentSemaphore()->isCurrentlyBound()) {
+            semaphore = handoff;
+            break;
+        }
+    }
+    if (semaphore == nullptr) {
+        semaphore = handoffSemaphores.add(new Semaphore(this));
+    }
+    semaphore->rotateSemaphore();
+    source->submitCommands(semaphore);
+    // the waiting command keeps the semaphore bound until it completed, which is after the signal anyway
+    semaphore->resolveSignal();
+    destination->getCommands()->waitForSemaphore(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, semaphore);
+    return true;
+}
+
+bool Graphics::supportsSampledFormat(Gfx::SeFormat format) const {
+    VkFormatProperties properties;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, cast(format), &properties);
+    return properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
 }
 
 Gfx::OTexture2D Graphics::createTexture2D(const TextureCreateInfo& createInfo) { return new Texture2D(this, createInfo); }
@@ -238,7 +287,9 @@ Gfx::OIndexBuffer Graphics::createIndexBuffer(const IndexBufferCreateInfo& bulkD
 
 Gfx::ORenderCommand Graphics::createRenderCommand(const std::string& name) { return getGraphicsCommands()->createRenderCommand(name); }
 
-Gfx::OComputeCommand Graphics::createComputeCommand(const std::string& name) { return getComputeCommands()->createComputeCommand(name); }
+Gfx::OComputeCommand Graphics::createComputeCommand(const std::string& name) {
+    return getQueueCommands(computeQueueType)->createComputeCommand(name);
+}
 
 void Graphics::beginShaderCompilation(const ShaderCompilationInfo& createInfo) {
     beginCompilation(createInfo, SLANG_SPIRV, createInfo.rootSignature);
@@ -627,6 +678,36 @@ PCommandPool Graphics::getQueueCommands(Gfx::QueueType queueType) {
         throw new std::logic_error("invalid queue type");
     }
 }
+PQueue Graphics::getQueue(Gfx::QueueType queueType) {
+    switch (queueType) {
+    case Gfx::QueueType::GRAPHICS:
+        return queues[graphicsQueue];
+    case Gfx::QueueType::COMPUTE:
+        return queues[computeQueue];
+    case Gfx::QueueType::TRANSFER:
+        return queues[transferQueue];
+    default:
+        throw new std::logic_error("invalid queue type");
+    }
+}
+
+void Graphics::registerQueryPool(QueryPool* pool) {
+    std::unique_lock l(queryPoolLock);
+    queryPools.add(pool);
+}
+
+void Graphics::unregisterQueryPool(QueryPool* pool) {
+    std::unique_lock l(queryPoolLock);
+    queryPools.remove(pool);
+}
+
+void Graphics::resolveQueries() {
+    std::unique_lock l(queryPoolLock);
+    for (auto pool : queryPools) {
+        pool->resolve();
+    }
+}
+
 PCommandPool Graphics::getGraphicsCommands() {
     if (graphicsCommands == nullptr) {
         std::unique_lock l(poolLock);
@@ -661,6 +742,8 @@ VmaAllocator Graphics::getAllocator() const { return allocator; }
 
 PDestructionManager Graphics::getDestructionManager() { return destructionManager; }
 
+PStagingRing Graphics::getStagingRing() { return stagingRing; }
+
 Array<const char*> Graphics::getRequiredExtensions() {
     Array<const char*> extensions;
 
@@ -772,6 +855,7 @@ void Graphics::pickPhysicalDevice() {
     features.get<VkPhysicalDeviceVulkan12Features>().bufferDeviceAddress = true;
     features.get<VkPhysicalDeviceVulkan12Features>().storageBuffer8BitAccess = true;
     features.get<VkPhysicalDeviceVulkan12Features>().shaderInt8 = true;
+    features.get<VkPhysicalDeviceVulkan12Features>().timelineSemaphore = true;
 
     rayTracingFeatures.get<VkPhysicalDeviceAccelerationStructureFeaturesKHR>().accelerationStructure = true;
 
@@ -6,9 +6,13 @@ namespace Seele {
 namespace Vulkan {
 DECLARE_REF(DestructionManager)
 DECLARE_REF(CommandPool)
+DECLARE_REF(Command)
 DECLARE_REF(Queue)
 DECLARE_REF(PipelineCache)
 DECLARE_REF(Framebuffer)
+DECLARE_REF(Semaphore)
+DECLARE_REF(StagingRing)
+class QueryPool;
 
 template <typename T>
 concept chainable_struct = requires(T t) {
@@ -85,16 +89,27 @@ class Graphics : public Gfx::Graphics {
     constexpr VkPhysicalDeviceRayTracingPipelinePropertiesKHR getRayTracingProperties() const {
         return props.get<VkPhysicalDeviceRayTracingPipelinePropertiesKHR>();
     }
+    constexpr VkPhysicalDeviceProperties getDeviceProperties() const { return props.get<VkPhysicalDeviceProperties2>().properties; }
     constexpr float getTimestampPeriod() const { return props.get<VkPhysicalDeviceProperties2>().properties.limits.timestampPeriod; }
     constexpr uint64 getTimestampValidBits() const { return graphicsProps.timestampValidBits; }
 
     PCommandPool getQueueCommands(Gfx::QueueType queueType);
+    PQueue getQueue(Gfx::QueueType queueType);
     PCommandPool getGraphicsCommands();
     PCommandPool getComputeCommands();
     PCommandPool getTransferCommands();
+    // primary command of the render pass that is currently recorded, secondary commands created on other threads continue it
+    PCommand getRenderPassCommand() const { return renderPassCommand; }
+    // every query pool registers itself, so that its results are resolved once per frame
+    void registerQueryPool(QueryPool* pool);
+    void unregisterQueryPool(QueryPool* pool);
+    // hands the results the GPU has finished to the frame stats, without waiting for the ones it has not
+    void resolveQueries();
 
     VmaAllocator getAllocator() const;
     PDestructionManager getDestructionManager();
+    // uploads of every thread go through it, so they run on the transfer queue instead of the one that renders
+    PStagingRing getStagingRing();
 
     // Inherited via Graphics
     virtual void init(GraphicsInitializer initializer) override;
@@ -111,7 +126,9 @@ class Graphics : public Gfx::Graphics {
     virtual void executeCommands(Array<Gfx::ORenderCommand> commands) override;
     virtual void executeCommands(Gfx::OComputeCommand commands) override;
     virtual void executeCommands(Array<Gfx::OComputeCommand> commands) override;
+    virtual bool queueHandoff(Gfx::QueueType from, Gfx::QueueType to) override;
 
+    virtual bool supportsSampledFormat(Gfx::SeFormat format) const override;
     virtual Gfx::OTexture2D createTexture2D(const TextureCreateInfo& createInfo) override;
     virtual Gfx::OTexture2DArray createTexture2DArray(const TextureCreateInfo& createInfo) override;
     virtual Gfx::OTexture3D createTexture3D(const TextureCreateInfo& createInfo) override;
@@ -185,6 +202,11 @@ class Graphics : public Gfx::Graphics {
     thread_local static PCommandPool transferCommands;
     std::mutex poolLock;
     Array<OCommandPool> pools;
+    PCommand renderPassCommand = nullptr;
+    // signalled by one queue and waited on by another, a semaphore is free again once its waiting command completed
+    Array<OSemaphore> handoffSemaphores;
+    std::mutex queryPoolLock;
+    Array<QueryPool*> queryPools;
 
     VkQueueFamilyProperties graphicsProps;
 
@@ -209,6 +231,7 @@ class Graphics : public Gfx::Graphics {
     VmaAllocator allocator;
     OPipelineCache pipelineCache;
     ODestructionManager destructionManager;
+    OStagingRing stagingRing;
 
     friend class Window;
 };
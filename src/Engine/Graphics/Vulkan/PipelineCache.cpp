@@ -4,13 +4,28 @@
 #include "Graphics.h"
 #include "RenderPass.h"
 #include "Shader.h"
+#include "ThreadPool.h"
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <vulkan/vulkan_core.h>
 
 using namespace Seele;
 using namespace Seele::Vulkan;
 
-PipelineCache::PipelineCache(PGraphics graphics, const std::string& cacheFilePath) : graphics(graphics), cacheFile(cacheFilePath) {
+// a blob from another driver or device is useless, and not every driver rejects it gracefully
+static bool isCacheCompatible(const Array<uint8>& cacheData, const VkPhysicalDeviceProperties& properties) {
+    VkPipelineCacheHeaderVersionOne header;
+    if (cacheData.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, cacheData.data(), sizeof(header));
+    return header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && header.vendorID == properties.vendorID &&
+           header.deviceID == properties.deviceID && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+PipelineCache::PipelineCache(PGraphics graphics, const std::string& cacheFilePath)
+    : lastWrite(std::chrono::steady_clock::now()), graphics(graphics), cacheFile(cacheFilePath) {
     Array<uint8> cacheData;
     std::ifstream stream(cacheFilePath, std::ios::binary | std::ios::ate);
     if (stream.good()) {
@@ -18,7 +33,12 @@ PipelineCache::PipelineCache(PGraphics graphics, const std::string& cacheFilePat
         cacheData.resize(fileSize);
         stream.seekg(0);
         stream.read((char*)cacheData.data(), fileSize);
-        std::cout << "Loaded " << fileSize << " bytes from pipeline cache" << std::endl;
+        if (isCacheCompatible(cacheData, graphics->getDeviceProperties())) {
+            std::cout << "Loaded " << fileSize << " bytes from pipeline cache" << std::endl;
+        } else {
+            std::cout << "Discarding incompatible pipeline cache" << std::endl;
+            cacheData.clear();
+        }
     }
     VkPipelineCacheCreateInfo cacheCreateInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
@@ -32,21 +52,208 @@ PipelineCache::PipelineCache(PGraphics graphics, const std::string& cacheFilePat
 }
 
 PipelineCache::~PipelineCache() {
-    size_t cacheSize;
-    VK_CHECK(vkGetPipelineCacheData(graphics->getDevice(), cache, &cacheSize, nullptr));
-    Array<uint8> cacheData(cacheSize);
-    VK_CHECK(vkGetPipelineCacheData(graphics->getDevice(), cache, &cacheSize, cacheData.data()));
-    std::ofstream stream(cacheFile, std::ios::binary);
-    stream.write((char*)cacheData.data(), cacheSize);
-    stream.flush();
-    stream.close();
+    std::shared_future<void> write;
+    {
+        std::scoped_lock lock(cacheLock);
+        write = pendingWrite;
+    }
+    if (write.valid()) {
+        write.wait();
+    }
+    writeCache();
     vkDestroyPipelineCache(graphics->getDevice(), cache, nullptr);
+}
+
+void PipelineCache::writeCache() {
+    std::scoped_lock lock(writeLock);
+    Array<uint8> cacheData;
+    size_t cacheSize;
+    VkResult result;
+    do {
+        // other threads can add pipelines in between, so the size might be outdated by the time the data is fetched
+        VK_CHECK(vkGetPipelineCacheData(graphics->getDevice(), cache, &cacheSize, nullptr));
+        cacheData.resize(cacheSize);
+        result = vkGetPipelineCacheData(graphics->getDevice(), cache, &cacheSize, cacheData.data());
+    } while (result == VK_INCOMPLETE);
+    VK_CHECK(result);
+    std::string tempFile = cacheFile + ".tmp";
+    {
+        std::ofstream stream(tempFile, std::ios::binary);
+        stream.write((char*)cacheData.data(), cacheSize);
+        stream.flush();
+        if (!stream.good()) {
+            std::cout << "Failed to write pipeline cache" << std::endl;
+            return;
+        }
+    }
+    // the rename replaces the old file in one step, so a crash never leaves a truncated cache behind
+    std::error_code error;
+    std::filesystem::rename(tempFile, cacheFile, error);
+    if (error) {
+        std::cout << "Failed to replace pipeline cache: " << error.message() << std::endl;
+        return;
+    }
     std::cout << "Written " << cacheSize << " bytes to cache" << std::endl;
 }
 
+void PipelineCache::writeCachePeriodically() {
+    auto promise = std::make_shared<std::promise<void>>();
+    {
+        std::scoped_lock lock(cacheLock);
+        auto now = std::chrono::steady_clock::now();
+        if (!dirty || now - lastWrite < CACHE_WRITE_INTERVAL) {
+            return;
+        }
+        // stays dirty, the next pipeline after the running write finished queues another one
+        if (pendingWrite.valid() && pendingWrite.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return;
+        }
+        dirty = false;
+        lastWrite = now;
+        pendingWrite = promise->get_future().share();
+    }
+    getThreadPool().runAsync([this, promise]() {
+        writeCache();
+        promise->set_value();
+    });
+}
+
+template <typename Pipeline> RefPtr<Pipeline> PipelineCache::beginCreation(Cache<Pipeline>& pipelineCache, const PipelineKey& key) {
+    std::unique_lock lock(cacheLock);
+    while (true) {
+        auto it = pipelineCache.pipelines.find(key);
+        if (it != pipelineCache.pipelines.end()) {
+            return it->second;
+        }
+        auto pending = pipelineCache.pending.find(key);
+        if (pending == pipelineCache.pending.end()) {
+            break;
+        }
+        std::shared_future<void> future = pending->second.future;
+        lock.unlock();
+        future.wait();
+        lock.lock();
+    }
+    auto promise = std::make_shared<std::promise<void>>();
+    pipelineCache.pending[key] = PendingCreation{
+        .promise = promise,
+        .future = promise->get_future().share(),
+    };
+    return nullptr;
+}
+
+template <typename Pipeline>
+RefPtr<Pipeline> PipelineCache::finishCreation(Cache<Pipeline>& pipelineCache, PipelineKey key, OwningPtr<Pipeline> pipeline) {
+    RefPtr<Pipeline> result = pipeline;
+    {
+        std::scoped_lock lock(cacheLock);
+        auto pending = pipelineCache.pending.find(key);
+        std::shared_ptr<std::promise<void>> promise = std::move(pending->second.promise);
+        pipelineCache.pending.erase(pending);
+        pipelineCache.pipelines[std::move(key)] = std::move(pipeline);
+        dirty = true;
+        promise->set_value();
+    }
+    writeCachePeriodically();
+    return result;
+}
+
+void PipelineKey::add(const void* bytes, uint64 size) {
+    uint64 offset = data.size();
+    data.resize(offset + size);
+    std::memcpy(data.data() + offset, bytes, size);
+}
+
+void PipelineKey::addShader(PShader shader) {
+    add(shader->getStage());
+    add(shader->getShaderHash());
+    add(shader->getCodeSize());
+    add(shader->getEntryPointName(), std::strlen(shader->getEntryPointName()));
+}
+
+void PipelineKey::addLayout(Gfx::PPipelineLayout layout) {
+    Array<Gfx::PDescriptorLayout> sets;
+    for (const auto& [_, descriptorLayout] : layout->getLayouts()) {
+        uint32 index = layout->findParameter(descriptorLayout->getName());
+        if (index >= sets.size()) {
+            sets.resize(index + 1);
+        }
+        sets[index] = descriptorLayout;
+    }
+    add(sets.size());
+    for (const auto& set : sets) {
+        add(set != nullptr);
+        if (set == nullptr) {
+            continue;
+        }
+        add(set->getBindings().size());
+        for (const auto& binding : set->getBindings()) {
+            add(binding.uniformLength);
+            add(binding.descriptorType);
+            add(binding.textureType);
+            add(binding.descriptorCount);
+            add(binding.bindingFlags);
+            add(binding.shaderStages);
+            add(binding.access);
+        }
+    }
+    add(layout->getPushConstants().size());
+    for (const auto& range : layout->getPushConstants()) {
+        add(range.stageFlags);
+        add(range.offset);
+        add(range.size);
+    }
+}
+
+void PipelineKey::finalize() {
+    static const CRC::Table<uint64, 64> table(CRC::CRC_64());
+    hash = CRC::Calculate(data.data(), data.size(), table);
+}
+
+// everything that legacy and mesh pipelines share, taken from the final create infos so the key matches what gets created
+static void addGraphicsState(PipelineKey& key, PPipelineLayout layout, PRenderPass renderPass,
+                             const VkPipelineRasterizationStateCreateInfo& rasterization,
+                             const VkPipelineMultisampleStateCreateInfo& multisample,
+                             const VkPipelineDepthStencilStateCreateInfo& depthStencil, const VkPipelineColorBlendStateCreateInfo& blend,
+                             const VkPipelineDynamicStateCreateInfo& dynamic) {
+    key.addLayout(layout);
+    key.add(renderPass->getCompatibilityKey());
+    key.add(rasterization.depthClampEnable);
+    key.add(rasterization.rasterizerDiscardEnable);
+    key.add(rasterization.polygonMode);
+    key.add(rasterization.cullMode);
+    key.add(rasterization.frontFace);
+    key.add(rasterization.depthBiasEnable);
+    key.add(rasterization.depthBiasConstantFactor);
+    key.add(rasterization.depthBiasClamp);
+    key.add(rasterization.depthBiasSlopeFactor);
+    key.add(rasterization.lineWidth);
+    key.add(multisample.rasterizationSamples);
+    key.add(multisample.sampleShadingEnable);
+    key.add(multisample.minSampleShading);
+    key.add(multisample.alphaToCoverageEnable);
+    key.add(multisample.alphaToOneEnable);
+    key.add(depthStencil.depthTestEnable);
+    key.add(depthStencil.depthWriteEnable);
+    key.add(depthStencil.depthCompareOp);
+    key.add(depthStencil.depthBoundsTestEnable);
+    key.add(depthStencil.stencilTestEnable);
+    key.add(depthStencil.front);
+    key.add(depthStencil.back);
+    key.add(depthStencil.minDepthBounds);
+    key.add(depthStencil.maxDepthBounds);
+    key.add(blend.logicOpEnable);
+    key.add(blend.logicOp);
+    key.add(blend.attachmentCount);
+    key.add(blend.pAttachments, blend.attachmentCount * sizeof(VkPipelineColorBlendAttachmentState));
+    key.add(blend.blendConstants);
+    key.add(dynamic.dynamicStateCount);
+    key.add(dynamic.pDynamicStates, dynamic.dynamicStateCount * sizeof(VkDynamicState));
+}
+
 PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gfxInfo) {
     PPipelineLayout layout = Gfx::PPipelineLayout(gfxInfo.pipelineLayout).cast<PipelineLayout>();
-    uint32 hash = layout->getHash();
+    PipelineKey key;
 
     Array<VkVertexInputBindingDescription> bindings;
     Array<VkVertexInputAttributeDescription> attributes;
@@ -68,8 +275,9 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
             };
         }
     }
-    hash = CRC::Calculate(bindings.data(), bindings.size() * sizeof(VkVertexInputBindingDescription), CRC::CRC_32(), hash);
-    hash = CRC::Calculate(attributes.data(), attributes.size() * sizeof(VkVertexInputAttributeDescription), CRC::CRC_32(), hash);
+
+    key.add(bindings);
+    key.add(attributes);
 
     VkPipelineVertexInputStateCreateInfo vertexInput = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
@@ -94,6 +302,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .pName = vertexShader->getEntryPointName(),
         .pSpecializationInfo = nullptr,
     };
+    key.addShader(vertexShader);
     
     if (gfxInfo.fragmentShader != nullptr) {
         PFragmentShader fragment = gfxInfo.fragmentShader.cast<FragmentShader>();
@@ -107,8 +316,8 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
             .pName = fragment->getEntryPointName(),
             .pSpecializationInfo = nullptr,
         };
+        key.addShader(fragment);
     }
-    hash = CRC::Calculate(stageInfos.data(), stageInfos.size() * sizeof(VkPipelineShaderStageCreateInfo), CRC::CRC_32(), hash);
 
     VkPipelineInputAssemblyStateCreateInfo assemblyInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
@@ -117,7 +326,8 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .topology = cast(gfxInfo.topology),
         .primitiveRestartEnable = false,
     };
-    hash = CRC::Calculate(&assemblyInfo, sizeof(VkPipelineInputAssemblyStateCreateInfo), CRC::CRC_32(), hash);
+    key.add(assemblyInfo.topology);
+    key.add(assemblyInfo.primitiveRestartEnable);
 
     VkPipelineViewportStateCreateInfo viewportInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
@@ -128,7 +338,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .scissorCount = 1,
         .pScissors = nullptr,
     };
-    hash = CRC::Calculate(&viewportInfo, sizeof(VkPipelineViewportStateCreateInfo), CRC::CRC_32(), hash);
     VkPipelineRasterizationStateCreateInfo rasterizationState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
         .pNext = nullptr,
@@ -144,7 +353,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .depthBiasSlopeFactor = gfxInfo.rasterizationState.depthBiasSlopeFactor,
         .lineWidth = gfxInfo.rasterizationState.lineWidth,
     };
-    hash = CRC::Calculate(&rasterizationState, sizeof(VkPipelineRasterizationStateCreateInfo), CRC::CRC_32(), hash);
     
     VkPipelineMultisampleStateCreateInfo multisampleState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
@@ -156,7 +364,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .alphaToCoverageEnable = gfxInfo.multisampleState.alphaCoverageEnable,
         .alphaToOneEnable = gfxInfo.multisampleState.alphaToOneEnable,
     };
-    hash = CRC::Calculate(&multisampleState, sizeof(VkPipelineMultisampleStateCreateInfo), CRC::CRC_32(), hash);
     VkPipelineDepthStencilStateCreateInfo depthStencilState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
         .pNext = nullptr,
@@ -170,7 +377,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .minDepthBounds = gfxInfo.depthStencilState.minDepthBounds,
         .maxDepthBounds = gfxInfo.depthStencilState.maxDepthBounds,
     };
-    hash = CRC::Calculate(&multisampleState, sizeof(VkPipelineMultisampleStateCreateInfo), CRC::CRC_32(), hash);
     Array<VkPipelineColorBlendAttachmentState> blendAttachments;
     for (uint32 i = 0; i < gfxInfo.colorBlend.attachmentCount; ++i) {
         const Gfx::ColorBlendState::BlendAttachment& attachment = gfxInfo.colorBlend.blendAttachments[i];
@@ -185,7 +391,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
             .colorWriteMask = attachment.colorWriteMask,
         };
     }
-    hash = CRC::Calculate(blendAttachments.data(), blendAttachments.size() * sizeof(VkPipelineColorBlendAttachmentState), CRC::CRC_32(), hash);
     VkPipelineColorBlendStateCreateInfo blendState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
         .pNext = nullptr,
@@ -201,12 +406,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
     StaticArray<VkDynamicState, 2> dynamicEnabled;
     dynamicEnabled[numDynamicEnabled++] = VK_DYNAMIC_STATE_VIEWPORT;
     dynamicEnabled[numDynamicEnabled++] = VK_DYNAMIC_STATE_SCISSOR;
-    hash = CRC::Calculate(dynamicEnabled.data(), dynamicEnabled.size() * sizeof(VkDynamicState), CRC::CRC_32(), hash);
-    
-    if (graphicsPipelines.contains(hash)) {
-        return graphicsPipelines[hash];
-    }
-    
+
     VkPipelineDynamicStateCreateInfo dynamicState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
         .pNext = nullptr,
@@ -214,6 +414,13 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
         .dynamicStateCount = (uint32)dynamicEnabled.size(),
         .pDynamicStates = dynamicEnabled.data(),
     };
+    addGraphicsState(key, layout, gfxInfo.renderPass.cast<RenderPass>(), rasterizationState, multisampleState, depthStencilState,
+                     blendState, dynamicState);
+    key.finalize();
+    PGraphicsPipeline cached = beginCreation(graphicsPipelines, key);
+    if (cached != nullptr) {
+        return cached;
+    }
     VkPipeline pipelineHandle;
 
     VkGraphicsPipelineCreateInfo createInfo = {
@@ -241,14 +448,12 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::LegacyPipelineCreateInfo gf
     std::cout << "Gfx creation time: " << delta << std::endl;
 
     OGraphicsPipeline pipeline = new GraphicsPipeline(graphics, pipelineHandle, gfxInfo.pipelineLayout);
-    PGraphicsPipeline result = pipeline;
-    graphicsPipelines[hash] = std::move(pipeline);
-    return result;
+    return finishCreation(graphicsPipelines, std::move(key), std::move(pipeline));
 }
 
 PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxInfo) {
     PPipelineLayout layout = Gfx::PPipelineLayout(gfxInfo.pipelineLayout).cast<PipelineLayout>();
-    uint32 hash = layout->getHash();
+    PipelineKey key;
     uint32 stageCount = 0;
 
     StaticArray<VkPipelineShaderStageCreateInfo, 3> stageInfos;
@@ -264,6 +469,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
             .pName = taskShader->getEntryPointName(),
             .pSpecializationInfo = nullptr,
         };
+        key.addShader(taskShader);
     }
 
     PMeshShader meshShader = gfxInfo.meshShader.cast<MeshShader>();
@@ -276,6 +482,7 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .pName = meshShader->getEntryPointName(),
         .pSpecializationInfo = nullptr,
     };
+    key.addShader(meshShader);
 
     if (gfxInfo.fragmentShader != nullptr) {
         PFragmentShader fragment = gfxInfo.fragmentShader.cast<FragmentShader>();
@@ -289,8 +496,8 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
             .pName = fragment->getEntryPointName(),
             .pSpecializationInfo = nullptr,
         };
+        key.addShader(fragment);
     }
-    hash = CRC::Calculate(stageInfos.data(), sizeof(stageInfos), CRC::CRC_32(), hash);
 
     VkPipelineViewportStateCreateInfo viewportInfo = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
@@ -301,7 +508,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .scissorCount = 1,
         .pScissors = nullptr,
     };
-    hash = CRC::Calculate(&viewportInfo, sizeof(VkPipelineViewportStateCreateInfo), CRC::CRC_32(), hash);
     VkPipelineRasterizationStateCreateInfo rasterizationState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
         .pNext = nullptr,
@@ -317,7 +523,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .depthBiasSlopeFactor = gfxInfo.rasterizationState.depthBiasSlopeFactor,
         .lineWidth = 0,
     };
-    hash = CRC::Calculate(&rasterizationState, sizeof(VkPipelineRasterizationStateCreateInfo), CRC::CRC_32(), hash);
 
     VkPipelineMultisampleStateCreateInfo multisampleState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
@@ -330,7 +535,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .alphaToCoverageEnable = gfxInfo.multisampleState.alphaCoverageEnable,
         .alphaToOneEnable = gfxInfo.multisampleState.alphaToOneEnable,
     };
-    hash = CRC::Calculate(&multisampleState, sizeof(VkPipelineMultisampleStateCreateInfo), CRC::CRC_32(), hash);
 
     VkPipelineDepthStencilStateCreateInfo depthStencilState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
@@ -364,7 +568,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .minDepthBounds = gfxInfo.depthStencilState.minDepthBounds,
         .maxDepthBounds = gfxInfo.depthStencilState.maxDepthBounds,
     };
-    hash = CRC::Calculate(&depthStencilState, sizeof(VkPipelineDepthStencilStateCreateInfo), CRC::CRC_32(), hash);
 
     Array<VkPipelineColorBlendAttachmentState> blendAttachments;
     for (uint32 i = 0; i < gfxInfo.colorBlend.attachmentCount; ++i) {
@@ -380,7 +583,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
             .colorWriteMask = attachment.colorWriteMask,
         };
     }
-    hash = CRC::Calculate(blendAttachments.data(), blendAttachments.size() * sizeof(VkPipelineColorBlendAttachmentState), CRC::CRC_32(), hash);
 
     VkPipelineColorBlendStateCreateInfo blendState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
@@ -397,7 +599,6 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
     StaticArray<VkDynamicState, 2> dynamicEnabled;
     dynamicEnabled[numDynamicEnabled++] = VK_DYNAMIC_STATE_VIEWPORT;
     dynamicEnabled[numDynamicEnabled++] = VK_DYNAMIC_STATE_SCISSOR;
-    hash = CRC::Calculate(dynamicEnabled.data(), sizeof(dynamicEnabled), CRC::CRC_32(), hash);
 
     VkPipelineDynamicStateCreateInfo dynamicState = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
@@ -405,8 +606,12 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
         .dynamicStateCount = (uint32)dynamicEnabled.size(),
         .pDynamicStates = dynamicEnabled.data(),
     };
-    if (graphicsPipelines.contains(hash)) {
-        return graphicsPipelines[hash];
+    addGraphicsState(key, layout, gfxInfo.renderPass.cast<RenderPass>(), rasterizationState, multisampleState, depthStencilState,
+                     blendState, dynamicState);
+    key.finalize();
+    PGraphicsPipeline cached = beginCreation(graphicsPipelines, key);
+    if (cached != nullptr) {
+        return cached;
     }
     VkPipeline pipelineHandle;
 
@@ -435,16 +640,21 @@ PGraphicsPipeline PipelineCache::createPipeline(Gfx::MeshPipelineCreateInfo gfxI
     std::cout << "Gfx creation time: " << delta << std::endl;
 
     OGraphicsPipeline pipeline = new GraphicsPipeline(graphics, pipelineHandle, gfxInfo.pipelineLayout);
-    PGraphicsPipeline result = pipeline;
-    graphicsPipelines[hash] = std::move(pipeline);
-    return result;
+    return finishCreation(graphicsPipelines, std::move(key), std::move(pipeline));
 }
 
 PComputePipeline PipelineCache::createPipeline(Gfx::ComputePipelineCreateInfo computeInfo) {
     PPipelineLayout layout = computeInfo.pipelineLayout.cast<PipelineLayout>();
     auto computeStage = computeInfo.computeShader.cast<ComputeShader>();
 
-    uint32 hash = layout->getHash();
+    PipelineKey key;
+    key.addLayout(layout);
+    key.addShader(computeStage);
+    key.finalize();
+    PComputePipeline cached = beginCreation(computePipelines, key);
+    if (cached != nullptr) {
+        return cached;
+    }
 
     VkComputePipelineCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
@@ -463,7 +673,6 @@ PComputePipeline PipelineCache::createPipeline(Gfx::ComputePipelineCreateInfo co
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex = 0,
     };
-    hash = CRC::Calculate(&createInfo, sizeof(createInfo), CRC::CRC_32(), hash);
 
     VkPipeline pipelineHandle;
     auto beginTime = std::chrono::high_resolution_clock::now();
@@ -473,14 +682,14 @@ PComputePipeline PipelineCache::createPipeline(Gfx::ComputePipelineCreateInfo co
     std::cout << "Compute creation time: " << delta << std::endl;
 
     OComputePipeline pipeline = new ComputePipeline(graphics, pipelineHandle, computeInfo.pipelineLayout);
-    PComputePipeline result = pipeline;
-    graphicsPipelines[hash] = std::move(pipeline);
-    return result;
+    return finishCreation(computePipelines, std::move(key), std::move(pipeline));
 }
 
 PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateInfo createInfo) {
     Array<VkPipelineShaderStageCreateInfo> shaderStages;
     Array<VkRayTracingShaderGroupCreateInfoKHR> shaderGroups;
+    PipelineKey key;
+    key.addLayout(createInfo.pipelineLayout);
     {
         auto rayGen = createInfo.rayGenGroup.shader.cast<RayGenShader>();
         shaderStages.add(VkPipelineShaderStageCreateInfo{
@@ -492,6 +701,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
             .pName = rayGen->getEntryPointName(),
             .pSpecializationInfo = nullptr,
         });
+        key.addShader(rayGen);
         shaderGroups.add(VkRayTracingShaderGroupCreateInfoKHR{
             .sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR,
             .pNext = nullptr,
@@ -515,6 +725,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
                 .pName = hit->getEntryPointName(),
                 .pSpecializationInfo = nullptr,
             });
+            key.addShader(hit);
             uint32 hitIndex = static_cast<uint32>(shaderStages.size() - 1);
             uint32 anyHitIndex = VK_SHADER_UNUSED_KHR;
             uint32 intersectionIndex = VK_SHADER_UNUSED_KHR;
@@ -530,6 +741,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
                     .pName = anyHit->getEntryPointName(),
                     .pSpecializationInfo = nullptr,
                 });
+                key.addShader(anyHit);
             }
             if (hitgroup.intersectionShader != nullptr) {
                 auto intersect = hitgroup.intersectionShader.cast<IntersectionShader>();
@@ -543,6 +755,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
                     .pName = intersect->getEntryPointName(),
                     .pSpecializationInfo = nullptr,
                 });
+                key.addShader(intersect);
             }
             shaderGroups.add(VkRayTracingShaderGroupCreateInfoKHR{
                 .sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR,
@@ -568,6 +781,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
                 .pName = miss->getEntryPointName(),
                 .pSpecializationInfo = nullptr,
             });
+            key.addShader(miss);
             shaderGroups.add(VkRayTracingShaderGroupCreateInfoKHR{
                 .sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR,
                 .pNext = nullptr,
@@ -592,6 +806,7 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
                 .pName = call->getEntryPointName(),
                 .pSpecializationInfo = nullptr,
             });
+            key.addShader(call);
             shaderGroups.add(VkRayTracingShaderGroupCreateInfoKHR{
                 .sType = VK_STRUCTURE_TYPE_RAY_TRACING_SHADER_GROUP_CREATE_INFO_KHR,
                 .pNext = nullptr,
@@ -604,11 +819,25 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
             });
         }
     }
-    uint32 hash = CRC::Calculate(shaderStages.data(), sizeof(VkPipelineShaderStageCreateInfo) * shaderStages.size(), CRC::CRC_32(),
-                                 createInfo.pipelineLayout->getHash());
-    hash = CRC::Calculate(shaderGroups.data(), sizeof(VkRayTracingShaderGroupCreateInfoKHR) * shaderGroups.size(), CRC::CRC_32(), hash);
-    if (rayTracingPipelines.contains(hash)) {
-        return rayTracingPipelines[hash];
+    for (const auto& group : shaderGroups) {
+        key.add(group.type);
+        key.add(group.generalShader);
+        key.add(group.closestHitShader);
+        key.add(group.anyHitShader);
+        key.add(group.intersectionShader);
+    }
+    // the parameters get baked into the shader binding tables
+    key.add(createInfo.rayGenGroup.parameters);
+    for (const auto& hitgroup : createInfo.hitGroups) {
+        key.add(hitgroup.parameters);
+    }
+    for (const auto& miss : createInfo.missGroups) {
+        key.add(miss.parameters);
+    }
+    key.finalize();
+    PRayTracingPipeline cached = beginCreation(rayTracingPipelines, key);
+    if (cached != nullptr) {
+        return cached;
     }
     VkRayTracingPipelineCreateInfoKHR pipelineInfo = {
         .sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR,
@@ -723,7 +952,5 @@ PRayTracingPipeline PipelineCache::createPipeline(Gfx::RayTracingPipelineCreateI
     ORayTracingPipeline pipeline =
         new RayTracingPipeline(graphics, pipelineHandle, std::move(rayGenBuffer), rayGenStride, std::move(hitBuffer), hitStride,
                                std::move(missBuffer), missStride, nullptr, 0, createInfo.pipelineLayout);
-    PRayTracingPipeline handle = pipeline;
-    rayTracingPipelines[hash] = std::move(pipeline);
-    return handle;
+    return finishCreation(rayTracingPipelines, std::move(key), std::move(pipeline));
 }
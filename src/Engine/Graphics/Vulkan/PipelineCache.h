@@ -1,9 +1,44 @@
 #pragma once
 #include "Pipeline.h"
 #include "RayTracing.h"
+#include <future>
+#include <unordered_map>
 
 namespace Seele {
 namespace Vulkan {
+DECLARE_REF(Shader)
+// Pointer-free description of everything that goes into a pipeline
+// shaders are identified by their code instead of module handle and entry point pointer,
+// render passes by their compatibility, so equal state always produces an equal key
+class PipelineKey {
+  public:
+    template <typename T> void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(&value, sizeof(T));
+    }
+    template <typename T> void add(const Array<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(values.size());
+        add(values.data(), values.size() * sizeof(T));
+    }
+    void add(const void* data, uint64 size);
+    void addShader(PShader shader);
+    // the bindings and push constants in set order, layouts with equal content are compatible even if their handles differ
+    void addLayout(Gfx::PPipelineLayout layout);
+    // has to be called once all state is added
+    void finalize();
+    constexpr uint64 getHash() const { return hash; }
+    friend bool operator==(const PipelineKey& lhs, const PipelineKey& rhs) { return lhs.hash == rhs.hash && lhs.data == rhs.data; }
+
+  private:
+    Array<uint8> data;
+    uint64 hash = 0;
+};
+struct PipelineKeyHasher {
+    size_t operator()(const PipelineKey& key) const { return key.getHash(); }
+};
+// Safe to use from multiple threads, pipelines are created outside of the lock
+// and a thread asking for a pipeline that is currently being created waits for it instead of creating it again
 class PipelineCache {
   public:
     PipelineCache(PGraphics graphics, const std::string& cacheFilePath);
@@ -13,12 +48,36 @@ class PipelineCache {
     PComputePipeline createPipeline(Gfx::ComputePipelineCreateInfo createInfo);
 
     PRayTracingPipeline createPipeline(Gfx::RayTracingPipelineCreateInfo createInfo);
+    // writes the Vk cache blob to disk, replacing the old file only once the new one is complete
+    // blocks for as long as fetching and writing the blob takes, so it is meant for shutdown and explicit flushes
+    void writeCache();
 
   private:
-    Map<uint32, OGraphicsPipeline> graphicsPipelines;
-    Map<uint32, OComputePipeline> computePipelines;
-    Map<uint32, ORayTracingPipeline> rayTracingPipelines;
+    // a crash loses at most the pipelines created since the last write
+    constexpr static std::chrono::seconds CACHE_WRITE_INTERVAL = std::chrono::seconds(5);
+    struct PendingCreation {
+        std::shared_ptr<std::promise<void>> promise;
+        std::shared_future<void> future;
+    };
+    template <typename Pipeline> struct Cache {
+        std::unordered_map<PipelineKey, OwningPtr<Pipeline>, PipelineKeyHasher> pipelines;
+        std::unordered_map<PipelineKey, PendingCreation, PipelineKeyHasher> pending;
+    };
+    // returns the cached pipeline, or nullptr if the caller has to create it and hand it to finishCreation
+    template <typename Pipeline> RefPtr<Pipeline> beginCreation(Cache<Pipeline>& cache, const PipelineKey& key);
+    template <typename Pipeline> RefPtr<Pipeline> finishCreation(Cache<Pipeline>& cache, PipelineKey key, OwningPtr<Pipeline> pipeline);
+    // hands the write to the thread pool, the thread that finished a pipeline might be the render thread
+    void writeCachePeriodically();
+    Cache<GraphicsPipeline> graphicsPipelines;
+    Cache<ComputePipeline> computePipelines;
+    Cache<RayTracingPipeline> rayTracingPipelines;
+    // guards the caches, dirty, lastWrite and pendingWrite
     std::mutex cacheLock;
+    bool dirty = false;
+    std::chrono::steady_clock::time_point lastWrite;
+    // the background write in flight, at most one is queued at a time
+    std::shared_future<void> pendingWrite;
+    std::mutex writeLock;
     VkPipelineCache cache;
     PGraphics graphics;
     std::string cacheFile;
@@ -14,9 +14,11 @@ QueryPool::QueryPool(PGraphics graphics, VkQueryType type, VkQueryPipelineStatis
                      const std::string& name)
     : graphics(graphics), type(type), name(name), flags(flags), numQueries(numBuffered), resultsStride(resultsStride) {
     createPool();
+    graphics->registerQueryPool(this);
 }
 
 QueryPool::~QueryPool() {
+    graphics->unregisterQueryPool(this);
     for (auto handle : pools) {
         vkDestroyQueryPool(graphics->getDevice(), handle, nullptr);
     }
@@ -24,43 +26,64 @@ QueryPool::~QueryPool() {
 
 void QueryPool::begin() {
     PCommand cmd = graphics->getGraphicsCommands()->getCommands();
-    vkCmdResetQueryPool(cmd->getHandle(), pools.back(), head, 1);
-    vkCmdBeginQuery(cmd->getHandle(), pools.back(), head, 0);
+    activeQuery = allocateQuery(cmd->getHandle(), name);
+    vkCmdBeginQuery(cmd->getHandle(), activeQuery.pool, activeQuery.index, 0);
     cmd->setPipelineStatisticsFlags(flags);
 }
 
 void QueryPool::end() {
     PCommand cmd = graphics->getGraphicsCommands()->getCommands();
-    vkCmdEndQuery(cmd->getHandle(), pools.back(), head);
+    vkCmdEndQuery(cmd->getHandle(), activeQuery.pool, activeQuery.index);
+    submitQuery(activeQuery);
+}
+
+void QueryPool::resolve() {
+    Array<uint64> results(resultsStride / sizeof(uint64));
+    std::unique_lock l(queryMutex);
+    while (!pending.empty()) {
+        const PendingQuery& query = pending.front();
+        // the commands of the last frames might not even be submitted, so their queries could still be unreset
+        if (query.frameNumber + Gfx::numFramesBuffered > Gfx::getCurrentFrameNumber()) {
+            break;
+        }
+        VkResult result = vkGetQueryPoolResults(graphics->getDevice(), query.pool, query.index, 1, resultsStride, results.data(),
+                                                resultsStride, VK_QUERY_RESULT_64_BIT);
+        if (result == VK_NOT_READY) {
+            break;
+        }
+        VK_CHECK(result);
+        resolveQuery(query, results);
+        pending.popFront();
+    }
+    // a pool is only destroyed once all of its queries were resolved
+    auto isPending = [this](VkQueryPool pool) {
+        return std::any_of(pending.begin(), pending.end(), [pool](const PendingQuery& query) { return query.pool == pool; });
+    };
+    while (pools.size() > 1 && !isPending(pools.front())) {
+        vkDestroyQueryPool(graphics->getDevice(), pools.front(), nullptr);
+        pools.popFront();
+    }
+}
+
+QueryPool::PendingQuery QueryPool::allocateQuery(VkCommandBuffer cmd, const std::string& queryName) {
     std::unique_lock l(queryMutex);
-    head++;
     if (head == numQueries) {
         createPool();
         head = 0;
     }
-    numAvailable++;
-    queryCV.notify_all();
+    vkCmdResetQueryPool(cmd, pools.back(), head, 1);
+    return PendingQuery{
+        .pool = pools.back(),
+        .index = head++,
+        .frameNumber = Gfx::getCurrentFrameNumber(),
+        .name = queryName,
+    };
 }
 
-void QueryPool::getQueryResults(Array<uint64>& results) {
-    {
-        std::unique_lock l(queryMutex);
-        while (numAvailable == 0) {
-            queryCV.wait(l);
-        } 
-    }
-    results.resize(resultsStride / sizeof(uint64));
-    vkGetQueryPoolResults(graphics->getDevice(), pools.front(), tail, 1, resultsStride, results.data(), resultsStride,
-                          VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT);
+void QueryPool::submitQuery(PendingQuery query) {
     std::unique_lock l(queryMutex);
-    tail++;
-    if (tail == numQueries)
-    {
-        vkDestroyQueryPool(graphics->getDevice(), pools.front(), nullptr);
-        pools.popFront();
-        tail = 0;
-    }
-    numAvailable--;
+    graphics->getFrameStatsRing().expect(query.frameNumber);
+    pending.add(std::move(query));
 }
 
 void QueryPool::createPool() {
@@ -83,11 +106,6 @@ void QueryPool::createPool() {
     };
     vkSetDebugUtilsObjectNameEXT(graphics->getDevice(), &nameInfo);
     pools.add(handle);
-    if (pools.size() > 5)
-    {
-        vkDestroyQueryPool(graphics->getDevice(), pools.front(), nullptr);
-        pools.popFront();
-    }
 }
 
 OcclusionQuery::OcclusionQuery(PGraphics graphics, const std::string& name)
@@ -99,12 +117,11 @@ void OcclusionQuery::beginQuery() { begin(); }
 
 void OcclusionQuery::endQuery() { end(); }
 
-Gfx::OcclusionResult OcclusionQuery::getResults() {
-    Array<uint64> result(1);
-    getQueryResults(result);
-    return Gfx::OcclusionResult{
-        .numFragments = result[0],
-    };
+void OcclusionQuery::resolveQuery(const PendingQuery& query, const Array<uint64>& results) {
+    graphics->getFrameStatsRing().resolveOcclusion(query.frameNumber, query.name,
+                                                   Gfx::OcclusionResult{
+                                                       .numFragments = results[0],
+                                                   });
 }
 
 PipelineStatisticsQuery::PipelineStatisticsQuery(PGraphics graphics, const std::string& name)
@@ -123,68 +140,35 @@ void PipelineStatisticsQuery::beginQuery() { begin(); }
 
 void PipelineStatisticsQuery::endQuery() { end(); }
 
-Gfx::PipelineStatisticsResult PipelineStatisticsQuery::getResults() {
-    Array<uint64> result(9);
-    getQueryResults(result);
-    return Gfx::PipelineStatisticsResult{
-        .inputAssemblyVertices = result[0],
-        .inputAssemblyPrimitives = result[1],
-        .vertexShaderInvocations = result[2],
-        .clippingInvocations = result[3],
-        .clippingPrimitives = result[4],
-        .fragmentShaderInvocations = result[5],
-        .computeShaderInvocations = result[6],
-        .taskShaderInvocations = result[7],
-        .meshShaderInvocations = result[8],
-    };
+void PipelineStatisticsQuery::resolveQuery(const PendingQuery& query, const Array<uint64>& results) {
+    graphics->getFrameStatsRing().resolvePipelineStatistics(query.frameNumber, query.name,
+                                                            Gfx::PipelineStatisticsResult{
+                                                                .inputAssemblyVertices = results[0],
+                                                                .inputAssemblyPrimitives = results[1],
+                                                                .vertexShaderInvocations = results[2],
+                                                                .clippingInvocations = results[3],
+                                                                .clippingPrimitives = results[4],
+                                                                .fragmentShaderInvocations = results[5],
+                                                                .computeShaderInvocations = results[6],
+                                                                .taskShaderInvocations = results[7],
+                                                                .meshShaderInvocations = results[8],
+                                                            });
 }
 
 TimestampQuery::TimestampQuery(PGraphics graphics, const std::string& name)
-    : QueryPool(graphics, VK_QUERY_TYPE_TIMESTAMP, 0, sizeof(uint64), 512, name) {
-}
+    : QueryPool(graphics, VK_QUERY_TYPE_TIMESTAMP, 0, sizeof(uint64), 512, name) {}
 
 TimestampQuery::~TimestampQuery() {}
 
-void TimestampQuery::write(Gfx::SePipelineStageFlagBits stage, const std::string& name) {
+void TimestampQuery::write(Gfx::SePipelineStageFlagBits stage, const std::string& timestampName) {
     PCommand cmd = graphics->getGraphicsCommands()->getCommands();
-    vkCmdResetQueryPool(cmd->getHandle(), pools.back(), head, 1);
-    vkCmdWriteTimestamp(cmd->getHandle(), cast(stage), pools.back(), head);
-    pendingTimestamps.add(name);
-    {
-        std::unique_lock l(queryMutex);
-        head++;
-        if (head == numQueries) {
-            createPool();
-            head = 0;
-        }
-        numAvailable++;
-    }
+    PendingQuery query = allocateQuery(cmd->getHandle(), timestampName);
+    vkCmdWriteTimestamp(cmd->getHandle(), cast(stage), query.pool, query.index);
+    submitQuery(std::move(query));
 }
 
-Gfx::Timestamp TimestampQuery::getResult() {
-    {
-        std::unique_lock l(queryMutex);
-        while (numAvailable == 0) {
-            queryCV.wait(l);
-        } 
-    }
-    uint64 result;
-    vkGetQueryPoolResults(graphics->getDevice(), pools.front(), tail, 1, sizeof(uint64), &result, resultsStride,
-                          VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT);
-    {
-        std::unique_lock l(queryMutex);
-        tail++;
-        if (tail == numQueries) {
-            vkDestroyQueryPool(graphics->getDevice(), pools.front(), nullptr);
-            pools.popFront();
-            tail = 0;
-        }
-        numAvailable--;
-        Gfx::Timestamp res = Gfx::Timestamp{
-            .name = pendingTimestamps.front(),
-            .time = result,
-        };
-        pendingTimestamps.popFront();
-        return res;
-    }
-}
\ No newline at end of file
+void TimestampQuery::resolveQuery(const PendingQuery& query, const Array<uint64>& results) {
+    uint64 validBits = graphics->getTimestampValidBits();
+    uint64 ticks = validBits < 64 ? results[0] & ((uint64(1) << validBits) - 1) : results[0];
+    graphics->getFrameStatsRing().resolveTimestamp(query.frameNumber, query.name, uint64(ticks * double(graphics->getTimestampPeriod())));
+}
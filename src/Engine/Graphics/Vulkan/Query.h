@@ -2,7 +2,7 @@
 #include "Buffer.h"
 #include "Graphics.h"
 #include "Graphics/Query.h"
-#include <condition_variable>
+#include <mutex>
 
 namespace Seele {
 namespace Vulkan {
@@ -13,24 +13,35 @@ class QueryPool {
     virtual ~QueryPool();
     void begin();
     void end();
-    // stalls for the currently first pending query, dont call in render thread
-    void getQueryResults(Array<uint64>& results);
-    void createPool();
+    // hands the finished queries to the frame stats of the graphics, in the order they were recorded
+    // stops at the first one the GPU is not done with yet instead of waiting for it
+    void resolve();
 
   protected:
+    struct PendingQuery {
+        VkQueryPool pool;
+        uint32 index;
+        uint64 frameNumber;
+        std::string name;
+    };
+    // resets the next query of the current pool and tags it with the current frame
+    PendingQuery allocateQuery(VkCommandBuffer cmd, const std::string& queryName);
+    // the query was recorded, it gets resolved once its results are available
+    void submitQuery(PendingQuery query);
+    virtual void resolveQuery(const PendingQuery& query, const Array<uint64>& results) = 0;
+    void createPool();
     PGraphics graphics;
     List<VkQueryPool> pools;
+    List<PendingQuery> pending;
     VkQueryType type;
     std::string name;
     VkQueryPipelineStatisticFlags flags;
-    // ring buffer
     uint32 head = 0;
-    uint32 tail = 0;
-    uint64 numAvailable;
+    // the query between begin and end
+    PendingQuery activeQuery;
     uint32 numQueries;
     uint32 resultsStride;
     std::mutex queryMutex;
-    std::condition_variable queryCV;
 };
 class OcclusionQuery : public Gfx::OcclusionQuery, public QueryPool {
   public:
@@ -38,7 +49,9 @@ class OcclusionQuery : public Gfx::OcclusionQuery, public QueryPool {
     virtual ~OcclusionQuery();
     virtual void beginQuery() override;
     virtual void endQuery() override;
-    virtual Gfx::OcclusionResult getResults() override;
+
+  protected:
+    virtual void resolveQuery(const PendingQuery& query, const Array<uint64>& results) override;
 };
 DEFINE_REF(OcclusionQuery)
 class PipelineStatisticsQuery : public Gfx::PipelineStatisticsQuery, public QueryPool {
@@ -47,7 +60,9 @@ class PipelineStatisticsQuery : public Gfx::PipelineStatisticsQuery, public Quer
     virtual ~PipelineStatisticsQuery();
     virtual void beginQuery() override;
     virtual void endQuery() override;
-    virtual Gfx::PipelineStatisticsResult getResults() override;
+
+  protected:
+    virtual void resolveQuery(const PendingQuery& query, const Array<uint64>& results) override;
 };
 DEFINE_REF(PipelineStatisticsQuery)
 
@@ -56,12 +71,9 @@ class TimestampQuery : public Gfx::TimestampQuery, public QueryPool {
     TimestampQuery(PGraphics graphics, const std::string& name);
     virtual ~TimestampQuery();
     virtual void write(Gfx::SePipelineStageFlagBits stage, const std::string& name = "") override;
-    virtual Gfx::Timestamp getResult() override;
 
-  private:
-    uint64 wrapping = 0;
-    uint64 lastMeasure = 0;
-    List<std::string> pendingTimestamps;
+  protected:
+    virtual void resolveQuery(const PendingQuery& query, const Array<uint64>& results) override;
 };
 DEFINE_REF(TimestampQuery)
 } // namespace Vulkan
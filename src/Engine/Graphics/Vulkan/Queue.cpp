@@ -3,6 +3,7 @@
 #include "Command.h"
 #include "Enums.h"
 #include "Graphics.h"
+#include "StagingRing.h"
 #include <mutex>
 
 using namespace Seele;
@@ -16,7 +17,28 @@ Queue::Queue(PGraphics graphics, uint32 familyIndex, uint32 queueIndex) : graphi
 
 Queue::~Queue() {}
 
+void Queue::waitForStaging(uint64 value, VkPipelineStageFlags stages) {
+    std::unique_lock lock(queueLock);
+    stagingValue = std::max(stagingValue, value);
+    stagingStages |= stages;
+}
+
 void Queue::submitCommandBuffer(PCommand command, const Array<VkSemaphore>& signalSemaphores) {
+    PStagingRing stagingRing = graphics->getStagingRing();
+    uint64 waitValue;
+    VkPipelineStageFlags waitStages;
+    {
+        std::unique_lock lock(queueLock);
+        waitValue = stagingValue;
+        waitStages = stagingStages;
+    }
+    // the copies of the staging ring itself signal the timeline, they must not wait on it
+    if (waitValue > 0 && stagingRing != nullptr && command->signalTimelineSemaphore != stagingRing->getTimeline() &&
+        stagingRing->getTimeline()->getCompletedValue() < waitValue) {
+        // submitted before taking the lock, the staging ring might be submitting to this very queue
+        stagingRing->flush(waitValue);
+        command->waitForTimeline(waitStages, stagingRing->getTimeline(), waitValue);
+    }
     std::unique_lock lock(queueLock);
     assert(command->state == Command::State::End);
 
@@ -25,28 +47,55 @@ void Queue::submitCommandBuffer(PCommand command, const Array<VkSemaphore>& sign
     VkCommandBuffer cmdHandle = command->handle;
 
     Array<VkSemaphore> waitSemaphores;
+    Array<VkPipelineStageFlags> waitFlags = command->waitFlags;
     // wait semaphores get bound to the cmd when they are added
     // and unbound when the command completes
     for (PSemaphore semaphore : command->waitSemaphores) {
         waitSemaphores.add(semaphore->getHandle());
     }
+    // binary semaphores ignore their value
+    Array<uint64> waitValues(waitSemaphores.size(), 0);
+    for (uint32 i = 0; i < command->waitTimelines.size(); ++i) {
+        waitSemaphores.add(command->waitTimelines[i]->getHandle());
+        waitValues.add(command->waitTimelineValues[i]);
+        waitFlags.add(command->waitTimelineFlags[i]);
+    }
+    Array<VkSemaphore> signals = signalSemaphores;
+    Array<uint64> signalValues(signals.size(), 0);
+    if (command->signalTimelineSemaphore != nullptr) {
+        signals.add(command->signalTimelineSemaphore->getHandle());
+        signalValues.add(command->signalTimelineValue);
+    }
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {
+        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+        .pNext = nullptr,
+        .waitSemaphoreValueCount = static_cast<uint32>(waitValues.size()),
+        .pWaitSemaphoreValues = waitValues.data(),
+        .signalSemaphoreValueCount = static_cast<uint32>(signalValues.size()),
+        .pSignalSemaphoreValues = signalValues.data(),
+    };
+    bool usesTimeline = !command->waitTimelines.empty() || command->signalTimelineSemaphore != nullptr;
 
     VkSubmitInfo submitInfo = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext = nullptr,
-        .waitSemaphoreCount = static_cast<uint32>(command->waitSemaphores.size()),
+        .pNext = usesTimeline ? &timelineInfo : nullptr,
+        .waitSemaphoreCount = static_cast<uint32>(waitSemaphores.size()),
         .pWaitSemaphores = waitSemaphores.data(),
-        .pWaitDstStageMask = command->waitFlags.data(),
+        .pWaitDstStageMask = waitFlags.data(),
         .commandBufferCount = 1,
         .pCommandBuffers = &cmdHandle,
-        .signalSemaphoreCount = static_cast<uint32>(signalSemaphores.size()),
-        .pSignalSemaphores = signalSemaphores.data(),
+        .signalSemaphoreCount = static_cast<uint32>(signals.size()),
+        .pSignalSemaphores = signals.data(),
     };
     VK_CHECK(vkQueueSubmit(queue, 1, &submitInfo, command->fence->getHandle()));
     command->fence->submit();
     command->state = Command::State::Submit;
     command->waitFlags.clear();
     command->waitSemaphores.clear();
+    command->waitTimelines.clear();
+    command->waitTimelineValues.clear();
+    command->waitTimelineFlags.clear();
+    command->signalTimelineSemaphore = nullptr;
 
     if (waitIdleOnSubmit) {
         command->fence->wait(1000 * 1000ull);
@@ -10,6 +10,9 @@ class Queue {
     Queue(PGraphics graphics, uint32 familyIndex, uint32 queueIndex);
     virtual ~Queue();
     void submitCommandBuffer(PCommand command, const Array<VkSemaphore>& signalSemaphore);
+    // every later submission waits on stages until the staging ring reached value, whichever thread recorded it
+    // used for copies into resources that are read by whatever runs on this queue next
+    void waitForStaging(uint64 value, VkPipelineStageFlags stages);
     constexpr uint32 getFamilyIndex() const { return familyIndex; }
     constexpr VkQueue getHandle() const { return queue; }
 
@@ -18,6 +21,8 @@ class Queue {
     PGraphics graphics;
     VkQueue queue;
     uint32 familyIndex;
+    uint64 stagingValue = 0;
+    VkPipelineStageFlags stagingStages = 0;
 };
 DEFINE_REF(Queue)
 } // namespace Vulkan
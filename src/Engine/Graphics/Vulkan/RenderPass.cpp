@@ -184,6 +184,16 @@ RenderPass::RenderPass(PGraphics graphics, Gfx::RenderTargetLayout _layout, Arra
             .dependencyFlags = 0,
         };
     }
+    for (const auto& attachment : attachments) {
+        compatibilityKey.add(attachment.format);
+        compatibilityKey.add(attachment.samples);
+    }
+    compatibilityKey.add(subPassDesc.viewMask);
+    compatibilityKey.add(subPassDesc.inputAttachmentCount);
+    compatibilityKey.add(subPassDesc.colorAttachmentCount);
+    compatibilityKey.add((uint32)resolveRefs.size());
+    compatibilityKey.add(subPassDesc.pDepthStencilAttachment != nullptr);
+    compatibilityKey.add(subPassDesc.pNext != nullptr);
     VkRenderPassCreateInfo2 info = {
         .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO_2,
         .pNext = nullptr,
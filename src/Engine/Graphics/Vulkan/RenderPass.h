@@ -19,12 +19,15 @@ class RenderPass : public Gfx::RenderPass {
     constexpr VkSubpassContents getSubpassContents() const { return subpassContents; }
     constexpr const std::string& getName() const { return name; }
     constexpr PRenderPassHandle getCommandHandle() const { return renderPass; }
+    // everything that decides render pass compatibility, pipelines created for one pass can be used with every pass with the same key
+    constexpr const Array<uint32>& getCompatibilityKey() const { return compatibilityKey; }
 
   private:
     PGraphics graphics;
     std::string name;
     ORenderPassHandle renderPass;
     Array<VkClearValue> clearValues;
+    Array<uint32> compatibilityKey;
     VkRect2D renderArea;
     VkSubpassContents subpassContents;
 };
@@ -38,6 +38,44 @@ void Semaphore::rotateSemaphore() {
     handles.add(new SemaphoreHandle(graphics, "Semaphore"));
 }
 
+TimelineSemaphore::TimelineSemaphore(PGraphics graphics) : graphics(graphics) {
+    VkSemaphoreTypeCreateInfo typeInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .pNext = nullptr,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = 0,
+    };
+    VkSemaphoreCreateInfo info = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = &typeInfo,
+        .flags = 0,
+    };
+    VK_CHECK(vkCreateSemaphore(graphics->getDevice(), &info, nullptr, &handle));
+}
+
+TimelineSemaphore::~TimelineSemaphore() { vkDestroySemaphore(graphics->getDevice(), handle, nullptr); }
+
+uint64 TimelineSemaphore::getCompletedValue() const {
+    uint64 value = 0;
+    VK_CHECK(vkGetSemaphoreCounterValue(graphics->getDevice(), handle, &value));
+    return value;
+}
+
+void TimelineSemaphore::wait(uint64 value, uint64 timeout) {
+    VkSemaphoreWaitInfo waitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .semaphoreCount = 1,
+        .pSemaphores = &handle,
+        .pValues = &value,
+    };
+    VkResult r = vkWaitSemaphores(graphics->getDevice(), &waitInfo, timeout);
+    if (r != VK_TIMEOUT) {
+        VK_CHECK(r);
+    }
+}
+
 Fence::Fence(PGraphics graphics) : graphics(graphics), status(Status::Ready) {
     VkFenceCreateInfo info = {.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, .pNext = nullptr, .flags = 0};
     VK_CHECK(vkCreateFence(graphics->getDevice(), &info, nullptr, &fence));
@@ -1,6 +1,7 @@
 #pragma once
 #include "Containers/List.h"
 #include "Graphics/Resources.h"
+#include <atomic>
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
@@ -18,14 +19,15 @@ class CommandBoundResource {
         if (isCurrentlyBound())
             abort();
     }
-    constexpr bool isCurrentlyBound() const { return bindCount > 0; }
-    constexpr void bind() { bindCount++; }
-    constexpr void unbind() { bindCount--; }
+    bool isCurrentlyBound() const { return bindCount > 0; }
+    // commands for the same frame can be recorded on multiple threads
+    void bind() { bindCount++; }
+    void unbind() { bindCount--; }
 
   protected:
     PGraphics graphics;
     std::string name;
-    uint64 bindCount = 0;
+    std::atomic_uint64_t bindCount = 0;
 };
 DEFINE_REF(CommandBoundResource)
 
@@ -69,6 +71,23 @@ class Semaphore {
 };
 DEFINE_REF(Semaphore)
 
+// counts up once per submission that signals it, so the host can check or wait for any of them without a fence each
+// and other queues can wait for a value whose submission was not even recorded yet
+class TimelineSemaphore {
+  public:
+    TimelineSemaphore(PGraphics graphics);
+    ~TimelineSemaphore();
+    constexpr VkSemaphore getHandle() const { return handle; }
+    // highest value the GPU has signalled so far
+    uint64 getCompletedValue() const;
+    void wait(uint64 value, uint64 timeout);
+
+  private:
+    PGraphics graphics;
+    VkSemaphore handle;
+};
+DEFINE_REF(TimelineSemaphore)
+
 class Fence {
   public:
     Fence(PGraphics graphics);
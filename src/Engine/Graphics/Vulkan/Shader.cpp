@@ -18,21 +18,26 @@ Shader::~Shader() {
     }
 }
 
-uint32 Seele::Vulkan::Shader::getShaderHash() const { return hash; }
+uint64 Seele::Vulkan::Shader::getShaderHash() const { return hash; }
+
+void Shader::setCode(const uint8* code, uint64 size) {
+    static const CRC::Table<uint64, 64> table(CRC::CRC_64());
+    hash = CRC::Calculate(code, size, table);
+    codeSize = size;
+}
 
 void Shader::create(const ShaderCreateInfo& createInfo) {
-    auto [kernelBlob, entryName] = generateShader(createInfo);
+    auto [code, entryName] = generateShader(createInfo);
     entryPointName = entryName;
     VkShaderModuleCreateInfo moduleInfo = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
-        .codeSize = kernelBlob->getBufferSize(),
-        .pCode = (uint32_t*)kernelBlob->getBufferPointer(),
+        .codeSize = code.size(),
+        .pCode = (uint32_t*)code.data(),
     };
     VK_CHECK(vkCreateShaderModule(graphics->getDevice(), &moduleInfo, nullptr, &module));
-
-    hash = CRC::Calculate(kernelBlob->getBufferPointer(), kernelBlob->getBufferSize(), CRC::CRC_32(), hash);
+    setCode(code.data(), code.size());
 }
 
 void Shader::create(std::string_view binary) { 
@@ -49,4 +54,5 @@ void Shader::create(std::string_view binary) {
         .pCode = (uint32*)buffer.data(),
     };
     VK_CHECK(vkCreateShaderModule(graphics->getDevice(), &moduleInfo, nullptr, &module));
+    setCode((const uint8*)buffer.data(), fullSize);
 }
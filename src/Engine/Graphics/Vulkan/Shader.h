@@ -22,14 +22,18 @@ class Shader {
         return "main";// entryPointName.c_str();
     }
     constexpr VkShaderStageFlags getStage() const { return stage; }
-    uint32 getShaderHash() const;
+    // 64 bit hash of the SPIR-V, identifies the shader independent of the module handle
+    uint64 getShaderHash() const;
+    uint64 getCodeSize() const { return codeSize; }
 
   private:
+    void setCode(const uint8* code, uint64 size);
     PGraphics graphics;
     VkShaderModule module;
     VkShaderStageFlags stage;
     std::string entryPointName;
-    uint32 hash;
+    uint64 hash = 0;
+    uint64 codeSize = 0;
 };
 DEFINE_REF(Shader)
 
@@ -0,0 +1,107 @@
+#include "StagingRing.h"
+#include "Command.h"
+#include "Enums.h"
+#include "Graphics.h"
+#include "Queue.h"
+#include <vk_mem_alloc.h>
+
+using namespace Seele;
+using namespace Seele::Vulkan;
+
+static VkBufferCreateInfo stagingInfo(uint64 size) {
+    return VkBufferCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .size = size,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    };
+}
+
+static VmaAllocationCreateInfo stagingAllocInfo() {
+    return VmaAllocationCreateInfo{
+        .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO,
+    };
+}
+
+StagingRing::StagingRing(PGraphics graphics, PQueue queue, uint64 frameSize)
+    : graphics(graphics), frameSize(frameSize), ring(frameSize * Gfx::numFramesBuffered) {
+    timeline = new TimelineSemaphore(graphics);
+    buffer = new BufferAllocation(graphics, "StagingRing", stagingInfo(ring.getCapacity()), stagingAllocInfo(), Gfx::QueueType::TRANSFER);
+    mapped = (uint8*)buffer->info.pMappedData;
+    pool = new CommandPool(graphics, queue);
+}
+
+StagingRing::~StagingRing() { flush(); }
+
+uint64 StagingRing::upload(const void* data, uint64 size, uint64 alignment,
+                           std::function<void(PCommand command, VkBuffer source, uint64 sourceOffset)> record) {
+    std::unique_lock l(lock);
+    PCommand command = pool->getCommands();
+    if (size > frameSize) {
+        // would take the ring from the uploads of whole frames, so it gets a buffer of its own that lives until the copy completed
+        OBufferAllocation dedicated =
+            new BufferAllocation(graphics, "StagingRingOverflow", stagingInfo(size), stagingAllocInfo(), Gfx::QueueType::TRANSFER);
+        std::memcpy(dedicated->info.pMappedData, data, size);
+        VK_CHECK(vmaFlushAllocation(graphics->getAllocator(), dedicated->allocation, 0, size));
+        command->bindResource(PBufferAllocation(dedicated));
+        recorded = true;
+        record(command, dedicated->buffer, 0);
+        graphics->getDestructionManager()->queueResourceForDestruction(std::move(dedicated));
+        return recordingValue;
+    }
+    ring.complete(timeline->getCompletedValue());
+    uint64 offset = ring.allocate(size, alignment);
+    while (offset == Gfx::RingAllocator::INVALID_OFFSET) {
+        // more was uploaded than the frames in flight are supposed to need, so the oldest copies have to finish first
+        if (ring.getOldestPending() == 0) {
+            submit();
+        }
+        timeline->wait(ring.getOldestPending(), std::numeric_limits<uint64>::max());
+        ring.complete(timeline->getCompletedValue());
+        offset = ring.allocate(size, alignment);
+    }
+    std::memcpy(mapped + offset, data, size);
+    VK_CHECK(vmaFlushAllocation(graphics->getAllocator(), buffer->allocation, offset, size));
+    command = pool->getCommands();
+    command->bindResource(PBufferAllocation(buffer));
+    recorded = true;
+    record(command, buffer->buffer, offset);
+    return recordingValue;
+}
+
+void StagingRing::waitFor(PCommand command, uint64 value, VkPipelineStageFlags stages) {
+    std::unique_lock l(lock);
+    if (value < recordingValue && timeline->getCompletedValue() >= value) {
+        return;
+    }
+    command->waitForTimeline(stages, timeline, value);
+    command->stagingValue = std::max(command->stagingValue, value);
+}
+
+void StagingRing::waitFor(PQueue queue, uint64 value, VkPipelineStageFlags stages) { queue->waitForStaging(value, stages); }
+
+void StagingRing::flush(uint64 value) {
+    std::unique_lock l(lock);
+    if (value >= recordingValue) {
+        submit();
+    }
+}
+
+void StagingRing::flush() {
+    std::unique_lock l(lock);
+    submit();
+}
+
+void StagingRing::submit() {
+    if (!recorded) {
+        return;
+    }
+    pool->getCommands()->signalTimeline(timeline, recordingValue);
+    pool->submitCommands();
+    ring.submit(recordingValue);
+    recordingValue++;
+    recorded = false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Buffer.h"
+#include "Graphics/RingAllocator.h"
+#include "Resources.h"
+#include <functional>
+#include <mutex>
+
+namespace Seele {
+namespace Vulkan {
+DECLARE_REF(Command)
+DECLARE_REF(CommandPool)
+DECLARE_REF(Queue)
+// persistently mapped upload memory for every thread, the copies out of it are batched into one command on the transfer queue
+// its regions are reused once the timeline value of the submission that read them has been signalled
+class StagingRing {
+  public:
+    // frameSize is what the uploads of one frame are expected to need, the ring holds that much for every frame in flight
+    // and uploads that are larger get a buffer of their own
+    StagingRing(PGraphics graphics, PQueue queue, uint64 frameSize);
+    ~StagingRing();
+    // copies size bytes of data into the ring and lets record copy them out of source at sourceOffset on the transfer queue
+    // returns the timeline value that is signalled once the copy completed
+    uint64 upload(const void* data, uint64 size, uint64 alignment,
+                  std::function<void(PCommand command, VkBuffer source, uint64 sourceOffset)> record);
+    // the next submission of command waits on stages until the copies of value have completed
+    void waitFor(PCommand command, uint64 value, VkPipelineStageFlags stages);
+    // every submission to queue from now on waits until the copies of value have completed
+    void waitFor(PQueue queue, uint64 value, VkPipelineStageFlags stages);
+    // submits the copies recorded so far, does nothing if value was already submitted
+    void flush(uint64 value);
+    void flush();
+    PTimelineSemaphore getTimeline() const { return timeline; }
+
+  private:
+    void submit();
+    std::mutex lock;
+    PGraphics graphics;
+    uint64 frameSize;
+    OTimelineSemaphore timeline;
+    OBufferAllocation buffer;
+    // destroyed first, it waits for the copies that still read the buffer
+    OCommandPool pool;
+    uint8* mapped;
+    Gfx::RingAllocator ring;
+    // value the copies that are recorded right now signal
+    uint64 recordingValue = 1;
+    bool recorded = false;
+};
+DEFINE_REF(StagingRing)
+} // namespace Vulkan
+} // namespace Seele
@@ -3,6 +3,7 @@
 #include "Enums.h"
 #include "Graphics/Enums.h"
 #include "Graphics/Initializer.h"
+#include "StagingRing.h"
 #include <fmt/format.h>
 #include <math.h>
 #include <vulkan/vulkan_core.h>
@@ -59,6 +60,8 @@ void TextureView::changeLayout(Gfx::SeImageLayout newLayout, VkAccessFlags srcAc
     return source->changeLayout(newLayout, srcAccess, srcStage, dstAccess, dstStage);
 }
 
+void TextureView::transferOwnership(Gfx::QueueType newOwner) { source->transferOwnership(newOwner); }
+
 void TextureView::setLayout(Gfx::SeImageLayout layout) { source->layout = layout; }
 
 Gfx::OTextureView TextureHandle::createTextureView(uint32 baseMipLevel, uint32 viewLevelCount, uint32 baseArrayLayer, uint32 viewLayerCount) {
@@ -98,7 +101,9 @@ TextureHandle::TextureHandle(PGraphics graphics, VkImageViewType viewType, const
       owner(createInfo.sourceData.owner), width(createInfo.width), height(createInfo.height), depth(createInfo.depth),
       layerCount(createInfo.elements), mipLevels(1), samples(createInfo.samples), format(createInfo.format), usage(createInfo.usage),
       layout(Gfx::SE_IMAGE_LAYOUT_UNDEFINED), aspect(getAspectFromFormat(createInfo.format)), viewType(viewType), ownsImage(false) {
-    if (createInfo.useMip) {
+    if (!createInfo.mipOffsets.empty()) {
+        mipLevels = static_cast<uint32>(createInfo.mipOffsets.size());
+    } else if (createInfo.useMip) {
         mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
     }
     if (existingImage == VK_NULL_HANDLE) {
@@ -163,57 +168,102 @@ TextureHandle::TextureHandle(PGraphics graphics, VkImageViewType viewType, const
         ownsImage = true;
         const DataSource& sourceData = createInfo.sourceData;
         if (sourceData.size > 0) {
-            changeLayout(Gfx::SE_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_NONE, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-            void* data;
-            VkBufferCreateInfo stagingInfo = {
-                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-                .pNext = nullptr,
-                .flags = 0,
-                .size = sourceData.size,
-                .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            Gfx::QueueFamilyMapping mapping = graphics->getFamilyMapping();
+            bool handOver = mapping.needsTransfer(Gfx::QueueType::TRANSFER, owner);
+            VkImageSubresourceRange range = {
+                .aspectMask = aspect,
+                .baseMipLevel = 0,
+                .levelCount = mipLevels,
+                .baseArrayLayer = 0,
+                .layerCount = layerCount,
             };
-            VmaAllocationCreateInfo alloc = {
-                .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
-                .usage = VMA_MEMORY_USAGE_AUTO,
+            // recorded by the transfer queue as release and by the owner as acquire
+            VkImageMemoryBarrier handOverBarrier = {
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                .srcQueueFamilyIndex = mapping.getQueueTypeFamilyIndex(Gfx::QueueType::TRANSFER),
+                .dstQueueFamilyIndex = mapping.getQueueTypeFamilyIndex(owner),
+                .image = image,
+                .subresourceRange = range,
             };
-            OBufferAllocation stagingAlloc =
-                new BufferAllocation(graphics, fmt::format("{}Staging", createInfo.name), stagingInfo, alloc, Gfx::QueueType::TRANSFER);
-            vmaMapMemory(graphics->getAllocator(), stagingAlloc->allocation, &data);
-            std::memcpy(data, sourceData.data, sourceData.size);
-            vmaUnmapMemory(graphics->getAllocator(), stagingAlloc->allocation);
-
-            PCommandPool commandPool = graphics->getQueueCommands(owner);
-            VkBufferImageCopy region = {
-                .bufferOffset = 0,
-                .bufferRowLength = 0,
-                .bufferImageHeight = 0,
-                .imageSubresource =
-                    {
-                        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                        .mipLevel = 0,
-                        .baseArrayLayer = 0,
-                        .layerCount = layerCount,
-                    },
-                .imageOffset =
-                    {
-                        .x = 0,
-                        .y = 0,
-                        .z = 0,
-                    },
-                .imageExtent = {.width = width, .height = height, .depth = depth},
+            // block compressed formats cannot be blitted, so their levels all come with the source data
+            Array<uint64> levelOffsets = createInfo.mipOffsets.empty() ? Array<uint64>{0} : createInfo.mipOffsets;
+            auto record = [&](PCommand command, VkBuffer source, uint64 sourceOffset) {
+                // nothing was written to the image yet, so it does not have to be handed to the transfer queue first
+                VkImageMemoryBarrier toTransferDst = {
+                    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                    .pNext = nullptr,
+                    .srcAccessMask = VK_ACCESS_NONE,
+                    .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                    .oldLayout = cast(layout),
+                    .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                    .image = image,
+                    .subresourceRange = range,
+                };
+                vkCmdPipelineBarrier(command->getHandle(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                                     nullptr, 0, nullptr, 1, &toTransferDst);
+                Array<VkBufferImageCopy> regions;
+                for (uint32 level = 0; level < levelOffsets.size(); ++level) {
+                    regions.add(VkBufferImageCopy{
+                        .bufferOffset = sourceOffset + levelOffsets[level],
+                        .bufferRowLength = 0,
+                        .bufferImageHeight = 0,
+                        .imageSubresource =
+                            {
+                                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                                .mipLevel = level,
+                                .baseArrayLayer = 0,
+                                .layerCount = layerCount,
+                            },
+                        .imageOffset =
+                            {
+                                .x = 0,
+                                .y = 0,
+                                .z = 0,
+                            },
+                        .imageExtent =
+                            {
+                                .width = std::max(width >> level, 1u),
+                                .height = std::max(height >> level, 1u),
+                                .depth = std::max(depth >> level, 1u),
+                            },
+                    });
+                }
+                vkCmdCopyBufferToImage(command->getHandle(), source, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32)regions.size(),
+                                       regions.data());
+                if (handOver) {
+                    VkImageMemoryBarrier release = handOverBarrier;
+                    release.dstAccessMask = VK_ACCESS_NONE;
+                    vkCmdPipelineBarrier(command->getHandle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                                         0, nullptr, 0, nullptr, 1, &release);
+                }
+                command->bindResource(PTextureHandle(this));
             };
-
-            vkCmdCopyBufferToImage(commandPool->getCommands()->getHandle(), stagingAlloc->buffer, image,
-                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-            commandPool->getCommands()->bindResource(PBufferAllocation(stagingAlloc));
-            generateMipmaps();
+            // 16 covers the texel and block sizes of every format
+            uint64 value = graphics->getStagingRing()->upload(sourceData.data, sourceData.size, 16, record);
+            layout = Gfx::SE_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            // only the owner waits for the copy, so loading a texture never holds up the frames that are rendered meanwhile
+            PCommand command = graphics->getQueueCommands(owner)->getCommands();
+            graphics->getStagingRing()->waitFor(command, value, VK_PIPELINE_STAGE_TRANSFER_BIT);
+            if (handOver) {
+                VkImageMemoryBarrier acquire = handOverBarrier;
+                acquire.srcAccessMask = VK_ACCESS_NONE;
+                vkCmdPipelineBarrier(command->getHandle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                                     nullptr, 1, &acquire);
+                command->bindResource(PTextureHandle(this));
+            }
+            if (createInfo.mipOffsets.empty()) {
+                generateMipmaps();
+            }
             // When loading a texture from a file, we will almost always use it as a texture map for fragment shaders
-            changeLayout(Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-            graphics->getDestructionManager()->queueResourceForDestruction(std::move(stagingAlloc));
+            changeLayout(Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
         }
     }
     imageView = createTextureView(0, mipLevels, 0, layerCount);
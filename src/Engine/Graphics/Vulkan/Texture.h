@@ -23,6 +23,7 @@ public:
     virtual void pipelineBarrier(VkAccessFlags srcAccess, VkPipelineStageFlags srcStage, VkAccessFlags dstAccess, VkPipelineStageFlags dstStage) override;
     virtual void changeLayout(Gfx::SeImageLayout newLayout, VkAccessFlags srcAccess, VkPipelineStageFlags srcStage, VkAccessFlags dstAccess,
                       VkPipelineStageFlags dstStage) override;
+    virtual void transferOwnership(Gfx::QueueType newOwner) override;
     VkImageView getView() const { return view; }
     Gfx::SeImageLayout getLayout() const;
     PTextureHandle getSource() const { return source; }
@@ -3,20 +3,12 @@
 #include "Enums.h"
 #include "Graphics.h"
 #include "Resources.h"
+#include "StagingRing.h"
 #include <GLFW/glfw3.h>
 
 using namespace Seele;
 using namespace Seele::Vulkan;
 
-double currentFrameDelta = 0;
-double Gfx::getCurrentFrameDelta() { return currentFrameDelta; }
-
-double currentFrameTime = 0;
-double Gfx::getCurrentFrameTime() { return currentFrameTime; }
-
-uint32 currentFrameIndex = std::numeric_limits<uint32>::max();
-uint32 Gfx::getCurrentFrameIndex() { return currentFrameIndex; }
-
 void glfwKeyCallback(GLFWwindow* handle, int key, int, int action, int modifier) {
     if (key == -1) {
         return;
@@ -108,15 +100,17 @@ void Window::beginFrame() {
                                                                      imageAvailableSemaphores[currentSemaphoreIndex]);
     static double start = glfwGetTime();
     double end = glfwGetTime();
-    currentFrameDelta = end - start;
-    currentFrameTime += currentFrameDelta;
+    updateFrameTime(end - start);
     start = end;
+    graphics->resolveQueries();
 }
 
 void Window::endFrame() {
     swapChainTextures[currentImageIndex]->changeLayout(Gfx::SE_IMAGE_LAYOUT_PRESENT_SRC_KHR, Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
                                                        Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, Gfx::SE_ACCESS_MEMORY_READ_BIT,
                                                        Gfx::SE_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    // uploads that nothing waited for yet, like textures of assets that are still loading, go out once per frame
+    graphics->getStagingRing()->flush();
     renderingDoneSemaphores[currentSemaphoreIndex]->rotateSemaphore();
     graphics->getGraphicsCommands()->submitCommands(renderingDoneSemaphores[currentSemaphoreIndex]);
     VkSemaphore renderDoneHandle = renderingDoneSemaphores[currentSemaphoreIndex]->getHandle();
@@ -139,7 +133,7 @@ void Window::endFrame() {
     }
     renderingDoneSemaphores[currentSemaphoreIndex]->resolveSignal();
     currentSemaphoreIndex = (currentSemaphoreIndex + 1) % Gfx::numFramesBuffered;
-    currentFrameIndex = currentSemaphoreIndex;
+    setCurrentFrameIndex(currentSemaphoreIndex);
     // graphics->waitDeviceIdle();
 }
 
@@ -1,13 +1,34 @@
 #include "Window.h"
 #include "Math/Matrix.h"
+#include <limits>
 
 using namespace Seele;
 using namespace Seele::Gfx;
 
+static double currentFrameDelta = 0;
+double Gfx::getCurrentFrameDelta() { return currentFrameDelta; }
+
+static double currentFrameTime = 0;
+double Gfx::getCurrentFrameTime() { return currentFrameTime; }
+
+static uint32 currentFrameIndex = std::numeric_limits<uint32>::max();
+uint32 Gfx::getCurrentFrameIndex() { return currentFrameIndex; }
+
+static uint64 currentFrameNumber = 0;
+uint64 Gfx::getCurrentFrameNumber() { return currentFrameNumber; }
+
 Window::Window() {}
 
 Window::~Window() {}
 
+void Window::updateFrameTime(double frameDelta) {
+    currentFrameDelta = frameDelta;
+    currentFrameTime += frameDelta;
+    currentFrameNumber++;
+}
+
+void Window::setCurrentFrameIndex(uint32 frameIndex) { currentFrameIndex = frameIndex; }
+
 Viewport::Viewport(PWindow owner, const ViewportCreateInfo& viewportInfo)
     : sizeX(viewportInfo.dimensions.size.x), sizeY(viewportInfo.dimensions.size.y), offsetX(viewportInfo.dimensions.offset.x),
       offsetY(viewportInfo.dimensions.offset.y), fieldOfView(viewportInfo.fieldOfView), orthoLeft(viewportInfo.left),
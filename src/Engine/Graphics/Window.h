@@ -30,6 +30,9 @@ class Window {
     constexpr bool isPaused() const { return paused; }
 
   protected:
+    // advance the values returned by getCurrentFrameDelta, getCurrentFrameTime, getCurrentFrameNumber and getCurrentFrameIndex
+    static void updateFrameTime(double frameDelta);
+    static void setCurrentFrameIndex(uint32 frameIndex);
     SeFormat framebufferFormat;
     uint32 framebufferWidth;
     uint32 framebufferHeight;
@@ -50,6 +53,8 @@ class Viewport {
     constexpr uint32 getHeight() const { return sizeY; }
     constexpr uint32 getOffsetX() const { return offsetX; }
     constexpr uint32 getOffsetY() const { return offsetY; }
+    // vertical, in radians, 0 for orthographic viewports
+    constexpr float getFieldOfView() const { return fieldOfView; }
     constexpr float getContentScaleX() const { return owner->getContentScaleX(); }
     constexpr float getContentScaleY() const { return owner->getContentScaleY(); }
     Matrix4 getProjectionMatrix(float nearPlane, float farPlane) const;
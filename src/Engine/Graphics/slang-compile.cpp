@@ -1,9 +1,20 @@
 #include "slang-compile.h"
+#include "Asset/AssetRegistry.h"
 #include "Containers/Array.h"
+#include "Containers/List.h"
 #include "Graphics/Descriptor.h"
+#include "Profiler.h"
+#include <CRC.h>
 #include <fmt/core.h>
+#include <cctype>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <slang.h>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 
 using namespace Seele;
 
@@ -22,14 +33,434 @@ using namespace Seele;
         }                                                                                                                                  \
     }
 
-thread_local Slang::ComPtr<slang::IGlobalSession> globalSession;
-thread_local Slang::ComPtr<slang::IComponentType> specializedComponent;
-thread_local Slang::ComPtr<slang::ISession> session;
-thread_local Array<std::string> entryPoints;
+thread_local Array<Pair<std::string, Array<uint8>>> compiledEntryPoints;
 
-void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarget target, Gfx::PPipelineLayout layout) {
-    if (!globalSession) {
-        slang::createGlobalSession(globalSession.writeRef());
+// Sessions are shared by all threads and reused by every compilation with the same target and defines,
+// so modules shared between permutations, like materials and vertex data, are only loaded once
+// A slang global session and everything created from it may only be used by one thread at a time, so every cached session
+// has its own global session and is taken out of the cache while it compiles
+struct CachedSession {
+    std::string key;
+    Slang::ComPtr<slang::IGlobalSession> globalSession;
+    Slang::ComPtr<slang::ISession> session;
+    Map<std::string, slang::IModule*> modules;
+    // source files each loaded module depends on, for the shader cache entries
+    Map<std::string, Array<Pair<std::string, uint64>>> moduleSources;
+};
+// materials are linked in as modules, so the defines only come from the flags of a permutation and there are few combinations
+// the number of sessions is still bounded to keep the memory of the modules in check
+// more can exist while that many threads compile at the same time, they are dropped once they are put back
+constexpr uint64 MAX_CACHED_SESSIONS = 16;
+static std::mutex sessionLock;
+// sessions that are not compiling right now, the least recently used one in front
+static List<OwningPtr<CachedSession>> idleSessions;
+
+// Compiled code and parameter bindings of every compilation are stored in the asset cache folder
+// The file name is a hash over everything that selects the permutation, together with the compiler version
+// Each file also lists the source files slang loaded, so any change in an imported module invalidates it
+constexpr uint32 SHADER_CACHE_MAGIC = 0x53434853; // "SHCS"
+constexpr uint32 SHADER_CACHE_VERSION = 1;
+
+struct ShaderCacheEntry {
+    Array<Pair<std::string, uint64>> sourceFiles;
+    Array<Pair<std::string, uint32>> parameterMappings;
+    Array<Pair<std::string, Array<uint8>>> entryPoints;
+};
+
+// the defines map is ordered by pointer, so sort by content to get a stable key
+static Array<Pair<std::string, std::string>> getSortedDefines(const ShaderCompilationInfo& info) {
+    Array<Pair<std::string, std::string>> defines;
+    for (const auto& [name, value] : info.defines) {
+        defines.add(Pair<std::string, std::string>{name, value});
+    }
+    std::sort(defines.begin(), defines.end(), [](const auto& lhs, const auto& rhs) { return lhs.key < rhs.key; });
+    return defines;
+}
+
+static std::string getDefinesKey(const ShaderCompilationInfo& info) {
+    std::stringstream key;
+    for (const auto& [name, value] : getSortedDefines(info)) {
+        key << name << "=" << value << ";";
+    }
+    return key.str();
+}
+
+static std::string getCacheKey(const ShaderCompilationInfo& info, SlangCompileTarget target) {
+    std::stringstream key;
+    key << SHADER_CACHE_VERSION << "|" << spGetBuildTagString() << "|" << (int)target << "|";
+    for (const auto& moduleName : info.modules) {
+        key << moduleName << ";";
+    }
+    key << "|";
+    for (const auto& [name, mod] : info.entryPoints) {
+        key << mod << ":" << name << ";";
+    }
+    key << "|";
+    for (const auto& [typeName, value] : info.typeParameter) {
+        key << typeName << "=" << value << ";";
+    }
+    key << "|" << getDefinesKey(info);
+    return key.str();
+}
+
+// everything that is set on the session instead of per compilation
+static std::string getSessionKey(const ShaderCompilationInfo& info, SlangCompileTarget target) {
+    return fmt::format("{0}|{1}|{2}", (int)target, info.dumpIntermediate, getDefinesKey(info));
+}
+
+static std::filesystem::path getCachePath(const std::string& key, const char* subFolder = "") {
+    std::filesystem::path cacheFolder = AssetRegistry::getCacheFolder();
+    if (cacheFolder.empty()) {
+        return {};
+    }
+    uint64 hash = CRC::Calculate(key.data(), key.size(), CRC::CRC_64());
+    return cacheFolder / "Shaders" / subFolder / fmt::format("{0:016x}.bin", hash);
+}
+
+// source files are shared between most permutations, so a file is only hashed again once it was written to
+// generated material sources are rewritten at runtime, so the hash is tied to the write time and size of the file
+struct SourceHash {
+    std::filesystem::file_time_type writeTime;
+    uintmax_t size = 0;
+    uint64 hash = 0;
+    // every identifier in the file, a define that is not among them can not change what the file compiles to
+    std::unordered_set<std::string> identifiers;
+};
+static std::mutex sourceHashLock;
+static Map<std::string, SourceHash> sourceHashes;
+
+// slang reports dependencies with paths relative to its search paths, so the same file can be named differently
+static std::string getSourceKey(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.string();
+}
+
+static std::unordered_set<std::string> collectIdentifiers(const std::string& content) {
+    std::unordered_set<std::string> identifiers;
+    size_t i = 0;
+    while (i < content.size()) {
+        if (!std::isalpha((unsigned char)content[i]) && content[i] != '_') {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < content.size() && (std::isalnum((unsigned char)content[i]) || content[i] == '_')) {
+            i++;
+        }
+        identifiers.insert(content.substr(start, i - start));
+    }
+    return identifiers;
+}
+
+static uint64 hashSourceFile(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return 0;
+    }
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return 0;
+    }
+    const std::string key = getSourceKey(path);
+    {
+        std::unique_lock l(sourceHashLock);
+        if (sourceHashes.contains(key) && sourceHashes[key].writeTime == writeTime && sourceHashes[key].size == size) {
+            return sourceHashes[key].hash;
+        }
+    }
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return 0;
+    }
+    std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    uint64 hash = CRC::Calculate(content.data(), content.size(), CRC::CRC_64());
+    std::unique_lock l(sourceHashLock);
+    sourceHashes[key] = SourceHash{
+        .writeTime = writeTime,
+        .size = size,
+        .hash = hash,
+        .identifiers = collectIdentifiers(content),
+    };
+    return hash;
+}
+
+static bool sourceReads(const std::string& path, const std::string& define) {
+    // brings the identifiers up to date if the file was written to
+    hashSourceFile(path);
+    std::unique_lock l(sourceHashLock);
+    const std::string key = getSourceKey(path);
+    return !sourceHashes.contains(key) || sourceHashes[key].identifiers.contains(define);
+}
+
+void Seele::invalidateSourceFile(const std::string& path) {
+    std::unique_lock l(sourceHashLock);
+    sourceHashes.erase(getSourceKey(path));
+}
+
+static void writeString(std::ostream& stream, const std::string& str) {
+    uint64 size = str.size();
+    stream.write((const char*)&size, sizeof(uint64));
+    stream.write(str.data(), size);
+}
+
+static std::string readString(std::istream& stream) {
+    uint64 size = 0;
+    stream.read((char*)&size, sizeof(uint64));
+    if (!stream || size > (1 << 20)) {
+        stream.setstate(std::ios::failbit);
+        return {};
+    }
+    std::string str(size, '\0');
+    stream.read(str.data(), size);
+    return str;
+}
+
+template <typename T> static void writeValue(std::ostream& stream, T value) { stream.write((const char*)&value, sizeof(T)); }
+
+template <typename T> static T readValue(std::istream& stream) {
+    T value = T();
+    stream.read((char*)&value, sizeof(T));
+    return value;
+}
+
+static bool readSourceFiles(std::istream& stream, Array<Pair<std::string, uint64>>& sourceFiles) {
+    uint64 numSources = readValue<uint64>(stream);
+    for (uint64 i = 0; i < numSources && stream; ++i) {
+        std::string sourcePath = readString(stream);
+        uint64 hash = readValue<uint64>(stream);
+        if (hashSourceFile(sourcePath) != hash) {
+            return false;
+        }
+        sourceFiles.add(Pair<std::string, uint64>{std::move(sourcePath), hash});
+    }
+    return bool(stream);
+}
+
+static void writeSourceFiles(std::ostream& stream, const Array<Pair<std::string, uint64>>& sourceFiles) {
+    writeValue<uint64>(stream, sourceFiles.size());
+    for (const auto& [sourcePath, hash] : sourceFiles) {
+        writeString(stream, sourcePath);
+        writeValue(stream, hash);
+    }
+}
+
+static bool loadCacheEntry(const std::filesystem::path& path, const std::string& key, ShaderCacheEntry& entry) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    if (readValue<uint32>(stream) != SHADER_CACHE_MAGIC || readValue<uint32>(stream) != SHADER_CACHE_VERSION) {
+        return false;
+    }
+    // full key comparison, so a hash collision is a miss instead of the wrong shader
+    if (readString(stream) != key) {
+        return false;
+    }
+    if (!readSourceFiles(stream, entry.sourceFiles)) {
+        return false;
+    }
+    uint64 numMappings = readValue<uint64>(stream);
+    for (uint64 i = 0; i < numMappings && stream; ++i) {
+        std::string name = readString(stream);
+        uint32 index = readValue<uint32>(stream);
+        entry.parameterMappings.add(Pair<std::string, uint32>{std::move(name), index});
+    }
+    uint64 numEntryPoints = readValue<uint64>(stream);
+    for (uint64 i = 0; i < numEntryPoints && stream; ++i) {
+        std::string name = readString(stream);
+        uint64 codeSize = readValue<uint64>(stream);
+        if (!stream || codeSize > (1ull << 30)) {
+            return false;
+        }
+        Array<uint8> code(codeSize);
+        stream.read((char*)code.data(), codeSize);
+        entry.entryPoints.add(Pair<std::string, Array<uint8>>{std::move(name), std::move(code)});
+    }
+    return bool(stream);
+}
+
+// multiple threads can compile the same permutation, so write to a private file first and move it into place
+template <typename Writer> static void writeCacheFile(const std::filesystem::path& path, Writer&& write) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::filesystem::path tempPath = path;
+    tempPath += fmt::format(".{0}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream stream(tempPath, std::ios::binary);
+        write(stream);
+        if (!stream) {
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+static void storeCacheEntry(const std::filesystem::path& path, const std::string& key, const ShaderCacheEntry& entry) {
+    writeCacheFile(path, [&](std::ostream& stream) {
+        writeValue(stream, SHADER_CACHE_MAGIC);
+        writeValue(stream, SHADER_CACHE_VERSION);
+        writeString(stream, key);
+        writeSourceFiles(stream, entry.sourceFiles);
+        writeValue<uint64>(stream, entry.parameterMappings.size());
+        for (const auto& [name, index] : entry.parameterMappings) {
+            writeString(stream, name);
+            writeValue(stream, index);
+        }
+        writeValue<uint64>(stream, entry.entryPoints.size());
+        for (const auto& [name, code] : entry.entryPoints) {
+            writeString(stream, name);
+            writeValue<uint64>(stream, code.size());
+            stream.write((const char*)code.data(), code.size());
+        }
+    });
+}
+
+// Serialized IR of single modules, so that a permutation that missed the shader cache only has to link and specialize
+// The IR is generated after preprocessing, so its key contains the defines, but only those that one of the files of the
+// module reads. Which files those are is stored in a manifest per module, so common modules are shared by all permutations
+// that agree on the few flags they check. None of the shaders import a module conditionally, so the files do not depend
+// on the defines
+constexpr uint32 MODULE_CACHE_MAGIC = 0x534D4353; // "SCMS"
+constexpr uint32 MODULE_MANIFEST_MAGIC = 0x534D4D53; // "SMMS"
+constexpr uint32 MODULE_CACHE_VERSION = 2;
+
+static bool loadModuleManifest(const std::string& key, Array<Pair<std::string, uint64>>& sourceFiles) {
+    const std::filesystem::path path = getCachePath(key, "Modules");
+    if (path.empty()) {
+        return false;
+    }
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    if (readValue<uint32>(stream) != MODULE_MANIFEST_MAGIC || readValue<uint32>(stream) != MODULE_CACHE_VERSION) {
+        return false;
+    }
+    if (readString(stream) != key) {
+        return false;
+    }
+    return readSourceFiles(stream, sourceFiles);
+}
+
+static void storeModuleManifest(const std::string& key, const Array<Pair<std::string, uint64>>& sourceFiles) {
+    const std::filesystem::path path = getCachePath(key, "Modules");
+    if (path.empty()) {
+        return;
+    }
+    writeCacheFile(path, [&](std::ostream& stream) {
+        writeValue(stream, MODULE_MANIFEST_MAGIC);
+        writeValue(stream, MODULE_CACHE_VERSION);
+        writeString(stream, key);
+        writeSourceFiles(stream, sourceFiles);
+    });
+}
+
+static std::string getModuleKey(const std::string& manifestKey, const ShaderCompilationInfo& info,
+                                const Array<Pair<std::string, uint64>>& sourceFiles) {
+    std::stringstream key;
+    key << manifestKey << "|";
+    for (const auto& [name, value] : getSortedDefines(info)) {
+        for (const auto& [sourcePath, hash] : sourceFiles) {
+            if (sourceReads(sourcePath, name)) {
+                key << name << "=" << value << ";";
+                break;
+            }
+        }
+    }
+    return key.str();
+}
+
+static slang::IModule* loadModuleFromCache(slang::ISession* session, const std::string& moduleName, const std::string& key,
+                                           Array<Pair<std::string, uint64>>& sourceFiles) {
+    const std::filesystem::path path = getCachePath(key, "Modules");
+    if (path.empty()) {
+        return nullptr;
+    }
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return nullptr;
+    }
+    if (readValue<uint32>(stream) != MODULE_CACHE_MAGIC || readValue<uint32>(stream) != MODULE_CACHE_VERSION) {
+        return nullptr;
+    }
+    if (readString(stream) != key) {
+        return nullptr;
+    }
+    Array<Pair<std::string, uint64>> cachedSources;
+    if (!readSourceFiles(stream, cachedSources)) {
+        return nullptr;
+    }
+    uint64 irSize = readValue<uint64>(stream);
+    if (!stream || irSize > (1ull << 30)) {
+        return nullptr;
+    }
+    Array<uint8> ir(irSize);
+    stream.read((char*)ir.data(), irSize);
+    if (!stream) {
+        return nullptr;
+    }
+    Slang::ComPtr<ISlangBlob> irBlob;
+    irBlob.attach(slang_createBlob(ir.data(), ir.size()));
+    Slang::ComPtr<slang::IBlob> diagnostics;
+    slang::IModule* loaded =
+        session->loadModuleFromIRBlob(moduleName.c_str(), path.string().c_str(), irBlob, diagnostics.writeRef());
+    // a blob from an incompatible compiler is not fatal, the module is just parsed again
+    if (loaded == nullptr) {
+        return nullptr;
+    }
+    sourceFiles = std::move(cachedSources);
+    return loaded;
+}
+
+static void storeModuleInCache(slang::IModule* module, const std::string& key, const Array<Pair<std::string, uint64>>& sourceFiles) {
+    const std::filesystem::path path = getCachePath(key, "Modules");
+    if (path.empty()) {
+        return;
+    }
+    Slang::ComPtr<ISlangBlob> irBlob;
+    if (SLANG_FAILED(module->serialize(irBlob.writeRef()))) {
+        return;
+    }
+    writeCacheFile(path, [&](std::ostream& stream) {
+        writeValue(stream, MODULE_CACHE_MAGIC);
+        writeValue(stream, MODULE_CACHE_VERSION);
+        writeString(stream, key);
+        writeSourceFiles(stream, sourceFiles);
+        writeValue<uint64>(stream, irBlob->getBufferSize());
+        stream.write((const char*)irBlob->getBufferPointer(), irBlob->getBufferSize());
+    });
+}
+
+static void applyParameterMappings(const ShaderCompilationInfo& info, Gfx::PPipelineLayout layout,
+                                   const Array<Pair<std::string, uint32>>& mappings) {
+    for (const auto& [name, index] : mappings) {
+        layout->addMapping(name, index);
+    }
+    // workaround
+    if (info.name == "RayGenMiss")
+    {
+        layout->addMapping("pScene", 2);
+        layout->addMapping("pLightEnv", 3);
+        layout->addMapping("pResources", 4);
+        layout->addMapping("pRayTracingParams", 5);
+    }
+    //layout->addMapping("pVertexData", 1);
+    // layout->addMapping("pWaterMaterial", 1);
+}
+
+// a new session drops every module of the old one, slang can not unload single modules
+static void createSession(CachedSession& cached, const ShaderCompilationInfo& info, SlangCompileTarget target) {
+    cached.session = nullptr;
+    cached.modules.clear();
+    cached.moduleSources.clear();
+    if (!cached.globalSession) {
+        CHECK_RESULT(slang::createGlobalSession(cached.globalSession.writeRef()));
     }
     slang::SessionDesc sessionDesc;
     sessionDesc.flags = 0;
@@ -89,7 +520,7 @@ void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarg
     sessionDesc.preprocessorMacroCount = macros.size();
     sessionDesc.preprocessorMacros = macros.data();
     slang::TargetDesc targetDesc;
-    targetDesc.profile = globalSession->findProfile("spv_1_4");
+    targetDesc.profile = cached.globalSession->findProfile("spv_1_4");
     targetDesc.format = target;
     sessionDesc.targetCount = 1;
     sessionDesc.targets = &targetDesc;
@@ -97,20 +528,125 @@ void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarg
     sessionDesc.searchPaths = searchPaths.data();
     sessionDesc.searchPathCount = searchPaths.size();
 
+    CHECK_RESULT(cached.globalSession->createSession(sessionDesc, cached.session.writeRef()));
+}
+
+// takes the most recently used session with the options of info out of the cache, or creates one
+static OwningPtr<CachedSession> acquireSession(const ShaderCompilationInfo& info, SlangCompileTarget target) {
+    const std::string sessionKey = getSessionKey(info, target);
+    OwningPtr<CachedSession> result;
+    {
+        std::unique_lock l(sessionLock);
+        auto found = idleSessions.end();
+        for (auto it = idleSessions.begin(); it != idleSessions.end(); ++it) {
+            if ((*it)->key == sessionKey) {
+                found = it;
+            }
+        }
+        if (found != idleSessions.end()) {
+            result = std::move(*found);
+            idleSessions.remove(found);
+            return result;
+        }
+        // the global session of the least recently used one is kept, creating one is expensive
+        if (idleSessions.size() >= MAX_CACHED_SESSIONS) {
+            result = std::move(idleSessions.front());
+            idleSessions.popFront();
+        }
+    }
+    if (result == nullptr) {
+        result = new CachedSession();
+    }
+    result->key = sessionKey;
+    createSession(*result, info, target);
+    return result;
+}
+
+static void releaseSession(OwningPtr<CachedSession> cached) {
+    std::unique_lock l(sessionLock);
+    idleSessions.add(std::move(cached));
+    while (idleSessions.size() > MAX_CACHED_SESSIONS) {
+        idleSessions.popFront();
+    }
+}
+
+static bool sourcesChanged(const Array<Pair<std::string, uint64>>& sourceFiles) {
+    for (const auto& [sourcePath, hash] : sourceFiles) {
+        if (hashSourceFile(sourcePath) != hash) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// loads a module into the session once, from the module cache if possible
+static slang::IModule* loadModule(CachedSession& cached, const ShaderCompilationInfo& info, SlangCompileTarget target,
+                                  const std::string& moduleName) {
+    if (cached.modules.contains(moduleName)) {
+        return cached.modules[moduleName];
+    }
+    const std::string manifestKey =
+        fmt::format("{0}|{1}|{2}|{3}|{4}", MODULE_CACHE_VERSION, spGetBuildTagString(), (int)target, info.dumpIntermediate, moduleName);
+    Array<Pair<std::string, uint64>> sourceFiles;
+    slang::IModule* loaded = nullptr;
+    if (loadModuleManifest(manifestKey, sourceFiles)) {
+        loaded = loadModuleFromCache(cached.session, moduleName, getModuleKey(manifestKey, info, sourceFiles), sourceFiles);
+    }
+    if (loaded == nullptr) {
+        Slang::ComPtr<slang::IBlob> diagnostics;
+        loaded = cached.session->loadModule(moduleName.c_str(), diagnostics.writeRef());
+        CHECK_DIAGNOSTICS();
+        // includes every file the module imports
+        sourceFiles.clear();
+        for (SlangInt32 i = 0; i < loaded->getDependencyFileCount(); ++i) {
+            std::string sourcePath = loaded->getDependencyFilePath(i);
+            sourceFiles.add(Pair<std::string, uint64>{sourcePath, hashSourceFile(sourcePath)});
+        }
+        storeModuleManifest(manifestKey, sourceFiles);
+        storeModuleInCache(loaded, getModuleKey(manifestKey, info, sourceFiles), sourceFiles);
+    }
+    cached.modules[moduleName] = loaded;
+    cached.moduleSources[moduleName] = std::move(sourceFiles);
+    return loaded;
+}
+
+void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarget target, Gfx::PPipelineLayout layout) {
+    PROFILE_ZONE_DETAIL("CompileShader", info.name);
+    compiledEntryPoints.clear();
+    const std::string cacheKey = getCacheKey(info, target);
+    // dumping intermediates needs the compiler to actually run
+    const std::filesystem::path cachePath = info.dumpIntermediate ? std::filesystem::path() : getCachePath(cacheKey);
+    if (!cachePath.empty()) {
+        ShaderCacheEntry cached;
+        if (loadCacheEntry(cachePath, cacheKey, cached)) {
+            applyParameterMappings(info, layout, cached.parameterMappings);
+            compiledEntryPoints = std::move(cached.entryPoints);
+            return;
+        }
+    }
+    OwningPtr<CachedSession> cachedSession = acquireSession(info, target);
+    CachedSession& cached = **cachedSession;
+    // a regenerated material source would otherwise keep using the module that was loaded from its old contents
+    for (const auto& moduleName : info.modules) {
+        if (cached.modules.contains(moduleName) && sourcesChanged(cached.moduleSources[moduleName])) {
+            createSession(cached, info, target);
+            break;
+        }
+    }
+    slang::ISession* session = cached.session;
+
     Slang::ComPtr<slang::IBlob> diagnostics;
 
-    CHECK_RESULT(globalSession->createSession(sessionDesc, session.writeRef()));
+    ShaderCacheEntry cacheEntry;
     Array<slang::IComponentType*> components;
     Map<std::string, slang::IModule*> moduleMap;
     for (const auto& moduleName : info.modules) {
-        slang::IModule* loaded = session->loadModule(moduleName.c_str(), diagnostics.writeRef());
-        CHECK_DIAGNOSTICS();
+        slang::IModule* loaded = loadModule(cached, info, target, moduleName);
         components.add(loaded);
         moduleMap[moduleName] = loaded;
+        cacheEntry.sourceFiles.addAll(cached.moduleSources[moduleName]);
     }
-    entryPoints.clear();
     for (const auto& [name, mod] : info.entryPoints) {
-        entryPoints.add(name);
         slang::IEntryPoint* entry;
         CHECK_RESULT(moduleMap[mod]->findEntryPointByName(name.c_str(), &entry));
         components.add(entry);
@@ -131,6 +667,7 @@ void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarg
     CHECK_DIAGNOSTICS();
 
     Array<slang::SpecializationArg> specialization;
+    Slang::ComPtr<slang::IComponentType> specializedComponent;
     for (const auto& [key, value] : info.typeParameter) {
         specialization.add(slang::SpecializationArg::fromType(reflection->findTypeByName(value)));
     }
@@ -141,25 +678,31 @@ void Seele::beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarg
     CHECK_DIAGNOSTICS();
     for (uint32 i = 0; i < signature->getParameterCount(); ++i) {
         auto param = signature->getParameterByIndex(i);
-        layout->addMapping(param->getName(), param->getBindingIndex());
+        cacheEntry.parameterMappings.add(Pair<std::string, uint32>{param->getName(), param->getBindingIndex()});
     }
+    applyParameterMappings(info, layout, cacheEntry.parameterMappings);
 
-    // workaround
-    if (info.name == "RayGenMiss")
-    {
-        layout->addMapping("pScene", 2);
-        layout->addMapping("pLightEnv", 3);
-        layout->addMapping("pResources", 4);
-        layout->addMapping("pRayTracingParams", 5);
+    // generate all entry points right away so that they can be cached together
+    for (uint32 i = 0; i < info.entryPoints.size(); ++i) {
+        Slang::ComPtr<slang::IBlob> kernelBlob;
+        specializedComponent->getEntryPointCode(i, 0, kernelBlob.writeRef(), diagnostics.writeRef());
+        CHECK_DIAGNOSTICS();
+        Array<uint8> code(kernelBlob->getBufferSize());
+        std::memcpy(code.data(), kernelBlob->getBufferPointer(), code.size());
+        compiledEntryPoints.add(Pair<std::string, Array<uint8>>{info.entryPoints[i].key, std::move(code)});
     }
-    //layout->addMapping("pVertexData", 1);
-    // layout->addMapping("pWaterMaterial", 1);
+    if (!cachePath.empty()) {
+        cacheEntry.entryPoints = compiledEntryPoints;
+        storeCacheEntry(cachePath, cacheKey, cacheEntry);
+    }
+    // everything that refers to the session has to be released before another thread can take it
+    specializedComponent = nullptr;
+    linkedProgram = nullptr;
+    moduleComposition = nullptr;
+    releaseSession(std::move(cachedSession));
 }
 
-Pair<Slang::ComPtr<slang::IBlob>, std::string> Seele::generateShader(const ShaderCreateInfo& createInfo) {
-    Slang::ComPtr<slang::IBlob> diagnostics;
-    Slang::ComPtr<slang::IBlob> kernelBlob;
-    specializedComponent->getEntryPointCode(createInfo.entryPointIndex, 0, kernelBlob.writeRef(), diagnostics.writeRef());
-    CHECK_DIAGNOSTICS();
-    return {kernelBlob, entryPoints[createInfo.entryPointIndex]};
+Pair<Array<uint8>, std::string> Seele::generateShader(const ShaderCreateInfo& createInfo) {
+    const auto& [name, code] = compiledEntryPoints[createInfo.entryPointIndex];
+    return {code, name};
 }
@@ -4,6 +4,11 @@
 #include <slang.h>
 
 namespace Seele {
+// compiles all entry points of info, or loads them from the shader cache if nothing changed since the last compilation
 void beginCompilation(const ShaderCompilationInfo& info, SlangCompileTarget target, Gfx::PPipelineLayout layout);
-Pair<Slang::ComPtr<slang::IBlob>, std::string> generateShader(const ShaderCreateInfo& createInfo);
+// returns the code and entry point name of a previously compiled entry point
+Pair<Array<uint8>, std::string> generateShader(const ShaderCreateInfo& createInfo);
+// a source file was rewritten, so cached shaders that were compiled from the old contents are not used anymore
+// write time and size are checked on every lookup anyway, this catches rewrites the file clock can not tell apart
+void invalidateSourceFile(const std::string& path);
 }
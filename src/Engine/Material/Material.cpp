@@ -2,6 +2,7 @@
 #include "Graphics/Enums.h"
 #include "Graphics/Graphics.h"
 #include "Graphics/Shader.h"
+#include "Graphics/slang-compile.h"
 #include "MaterialInstance.h"
 #include "Serialization/Serialization.h"
 #include "Window/WindowManager.h"
@@ -9,12 +10,25 @@
 
 using namespace Seele;
 
-Array<Gfx::PTexture2D> Material::textures;
-Array<Gfx::PSampler> Material::samplers;
+std::mutex Material::heapLock;
+Array<Gfx::PTexture2D> Material::textures(MAX_TEXTURES);
+Array<Gfx::PSampler> Material::samplers(MAX_SAMPLERS);
+Gfx::BindlessSlots Material::textureSlots(MAX_TEXTURES);
+Gfx::BindlessSlots Material::samplerSlots(MAX_SAMPLERS);
+Array<uint32> Material::indexData;
+Gfx::OShaderBuffer Material::indexBuffer;
 Gfx::OShaderBuffer Material::floatBuffer;
 Array<float> Material::floatData;
+bool Material::buffersChanged = false;
+uint64 Material::bufferVersion = 0;
 Gfx::ODescriptorLayout Material::layout;
-Gfx::ODescriptorSet Material::set;
+Gfx::DescriptorBindingHandle Material::texturesBinding;
+Gfx::DescriptorBindingHandle Material::samplersBinding;
+Gfx::DescriptorBindingHandle Material::floatsBinding;
+Gfx::DescriptorBindingHandle Material::indicesBinding;
+Array<Gfx::ODescriptorSet> Material::sets;
+Array<uint64> Material::setBufferVersions;
+Gfx::PDescriptorSet Material::set;
 std::atomic_uint64_t Material::materialIdCounter = 0;
 Array<PMaterial> Material::materials;
 
@@ -35,84 +49,158 @@ Material::~Material() {}
 
 void Material::init(Gfx::PGraphics graphics) {
     layout = graphics->createDescriptorLayout("pResources");
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    texturesBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "textures",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-        .descriptorCount = 512,
+        .descriptorCount = MAX_TEXTURES,
         .bindingFlags = Gfx::SE_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
         .shaderStages = Gfx::SE_SHADER_STAGE_FRAGMENT_BIT | Gfx::SE_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
         .access = Gfx::SE_DESCRIPTOR_ACCESS_SAMPLE_BIT,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    samplersBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "samplers",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
-        .descriptorCount = 512,
+        .descriptorCount = MAX_SAMPLERS,
         .bindingFlags = Gfx::SE_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
         .shaderStages = Gfx::SE_SHADER_STAGE_FRAGMENT_BIT | Gfx::SE_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    floatsBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "floats",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
         .descriptorCount = 1,
         .bindingFlags = Gfx::SE_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
         .shaderStages = Gfx::SE_SHADER_STAGE_FRAGMENT_BIT | Gfx::SE_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
     });
+    indicesBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
+        .name = "indices",
+        .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1,
+        .bindingFlags = Gfx::SE_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+        .shaderStages = Gfx::SE_SHADER_STAGE_FRAGMENT_BIT | Gfx::SE_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
+    });
     layout->create();
     floatBuffer = graphics->createShaderBuffer(ShaderBufferCreateInfo{
         .name = "MaterialFloatBuffer",
     });
+    indexBuffer = graphics->createShaderBuffer(ShaderBufferCreateInfo{
+        .name = "MaterialIndexBuffer",
+    });
 }
 
 void Material::destroy() {
-    floatBuffer = nullptr;
     set = nullptr;
+    sets.clear();
+    setBufferVersions.clear();
+    floatBuffer = nullptr;
+    indexBuffer = nullptr;
     layout = nullptr;
 }
 
+Array<Pair<std::string, Gfx::PShaderBuffer>> Material::getUploadedBuffers() {
+    return {
+        Pair<std::string, Gfx::PShaderBuffer>{"MATERIAL_FLOATS", floatBuffer},
+        Pair<std::string, Gfx::PShaderBuffer>{"MATERIAL_INDICES", indexBuffer},
+    };
+}
+
 void Material::updateDescriptor() {
-    floatBuffer->rotateBuffer(floatData.size() * sizeof(float));
-    floatBuffer->updateContents(0, floatData.size() * sizeof(float), floatData.data());
-    floatBuffer->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT, Gfx::SE_ACCESS_SHADER_READ_BIT,
-                                 Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-    layout->reset();
-    set = layout->allocateDescriptorSet();
-    for (uint32 i = 0; i < textures.size(); ++i) {
-        if (textures[i] != nullptr) {
-            set->updateTexture("textures", i, textures[i]->getDefaultView());
-        }
+    std::unique_lock l(heapLock);
+    if (buffersChanged) {
+        floatBuffer->rotateBuffer(floatData.size() * sizeof(float));
+        floatBuffer->updateContents(0, floatData.size() * sizeof(float), floatData.data());
+        indexBuffer->rotateBuffer(indexData.size() * sizeof(uint32));
+        indexBuffer->updateContents(0, indexData.size() * sizeof(uint32), indexData.data());
+        buffersChanged = false;
+        bufferVersion++;
     }
-    for (uint32 i = 0; i < samplers.size(); ++i) {
-        if (samplers[i] != nullptr) {
-            set->updateSampler("samplers", i, samplers[i]);
-        }
+    // like a rotating buffer, the first set no command reads anymore is used, the others catch up once it is their turn
+    uint32 setIndex = 0;
+    while (setIndex < sets.size() && sets[setIndex]->isCurrentlyBound()) {
+        setIndex++;
+    }
+    if (setIndex == sets.size()) {
+        sets.add(layout->allocateDescriptorSet());
+        setBufferVersions.add(0);
+        textureSlots.addSet();
+        samplerSlots.addSet();
+    }
+    set = sets[setIndex];
+    for (uint32 slot : textureSlots.takeChanges(setIndex)) {
+        set->updateTexture(texturesBinding, slot, textures[slot] != nullptr ? textures[slot]->getDefaultView() : nullptr);
+    }
+    for (uint32 slot : samplerSlots.takeChanges(setIndex)) {
+        set->updateSampler(samplersBinding, slot, samplers[slot]);
+    }
+    if (setBufferVersions[setIndex] != bufferVersion) {
+        set->updateBuffer(floatsBinding, 0, floatBuffer);
+        set->updateBuffer(indicesBinding, 0, indexBuffer);
+        setBufferVersions[setIndex] = bufferVersion;
     }
-    set->updateBuffer("floats", 0, floatBuffer);
     set->writeChanges();
 }
 
-void Material::updateTexture(uint32 index, Gfx::PTexture2D texture) { textures[index] = texture; }
+uint32 Material::allocateTexture() {
+    std::unique_lock l(heapLock);
+    return textureSlots.allocate();
+}
 
-void Material::updateSampler(uint32 index, Gfx::PSampler sampler) { samplers[index] = sampler; }
+void Material::freeTexture(uint32 slot) {
+    std::unique_lock l(heapLock);
+    textures[slot] = nullptr;
+    textureSlots.free(slot);
+}
+
+void Material::updateTexture(uint32 slot, Gfx::PTexture2D texture) {
+    std::unique_lock l(heapLock);
+    textures[slot] = texture;
+    textureSlots.markChanged(slot);
+}
+
+uint32 Material::allocateSampler() {
+    std::unique_lock l(heapLock);
+    return samplerSlots.allocate();
+}
+
+void Material::freeSampler(uint32 slot) {
+    std::unique_lock l(heapLock);
+    samplers[slot] = nullptr;
+    samplerSlots.free(slot);
+}
+
+void Material::updateSampler(uint32 slot, Gfx::PSampler sampler) {
+    std::unique_lock l(heapLock);
+    samplers[slot] = sampler;
+    samplerSlots.markChanged(slot);
+}
+
+void Material::updateIndex(uint32 offset, uint32 slot) {
+    std::unique_lock l(heapLock);
+    indexData[offset] = slot;
+    buffersChanged = true;
+}
 
 void Material::updateFloatData(uint32 offset, uint32 numFloats, float* data) {
+    std::unique_lock l(heapLock);
     std::memcpy(floatData.data() + offset, data, numFloats * sizeof(float));
+    buffersChanged = true;
 }
 
 uint32 Material::addTextures(uint32 numTextures) {
-    uint32 textureOffset = (uint32)textures.size();
-    textures.resize(textures.size() + numTextures);
-    assert(textures.size() < 512);
+    std::unique_lock l(heapLock);
+    uint32 textureOffset = (uint32)indexData.size();
+    indexData.resize(indexData.size() + numTextures);
     return textureOffset;
 }
 
 uint32 Material::addSamplers(uint32 numSamplers) {
-    uint32 samplerOffset = (uint32)samplers.size();
-    samplers.resize(samplers.size() + numSamplers);
-    assert(textures.size() < 512);
+    std::unique_lock l(heapLock);
+    uint32 samplerOffset = (uint32)indexData.size();
+    indexData.resize(indexData.size() + numSamplers);
     return samplerOffset;
 }
 
 uint32 Material::addFloats(uint32 numFloats) {
+    std::unique_lock l(heapLock);
     uint32 floatOffset = (uint32)floatData.size();
     floatData.resize(floatData.size() + numFloats);
     return floatOffset;
@@ -157,26 +245,31 @@ void Material::load(ArchiveBuffer& buffer) {
 }
 
 void Material::compile() {
-    std::ofstream codeStream("./shaders/generated/" + materialName + ".slang");
-    codeStream << "import MaterialParameter;\n";
-    codeStream << "import Material;\n";
-    codeStream << "import LightEnv;\n";
-    codeStream << "struct Material : IMaterial{\n";
-    codeStream << "\ttypedef " << brdf.profile << " BRDF;\n";
-    codeStream << "\tstatic " << brdf.profile << " prepare(MaterialParameter input) {\n";
-    codeStream << "\t\t" << brdf.profile << " result;\n";
-    Map<std::string, std::string> varState;
-    // initialize variable state
-    for (const auto& expr : codeExpressions) {
-        codeStream << "\t\t" << expr->evaluate(varState);
-    }
-    for (const auto& [name, exp] : brdf.variables) {
-        codeStream << "\t\tresult." << name << " = " << varState[exp] << ";" << std::endl;
+    const std::string sourcePath = "./shaders/generated/" + materialName + ".slang";
+    {
+        std::ofstream codeStream(sourcePath);
+        codeStream << "import MaterialParameter;\n";
+        codeStream << "import Material;\n";
+        codeStream << "import LightEnv;\n";
+        codeStream << "export struct Material : IMaterial{\n";
+        codeStream << "\ttypedef " << brdf.profile << " BRDF;\n";
+        codeStream << "\tstatic " << brdf.profile << " prepare(MaterialParameter input) {\n";
+        codeStream << "\t\t" << brdf.profile << " result;\n";
+        Map<std::string, std::string> varState;
+        // initialize variable state
+        for (const auto& expr : codeExpressions) {
+            codeStream << "\t\t" << expr->evaluate(varState);
+        }
+        for (const auto& [name, exp] : brdf.variables) {
+            codeStream << "\t\tresult." << name << " = " << varState[exp] << ";" << std::endl;
+        }
+        codeStream << "\t\tresult.normal = mul(input.tangentToWorld, result.normal);" << std::endl;
+        codeStream << "\t\treturn result;\n";
+        codeStream << "\t}\n";
+        codeStream << "};\n";
     }
-    codeStream << "\t\tresult.normal = mul(input.tangentToWorld, result.normal);" << std::endl;
-    codeStream << "\t\treturn result;\n";
-    codeStream << "\t}\n";
-    codeStream << "};\n";
+    // the permutations might be compiled on another thread right away, so the file is complete before registering
+    invalidateSourceFile(sourcePath);
     graphics->getShaderCompiler()->registerMaterial(this);
 }
 
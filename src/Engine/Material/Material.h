@@ -1,7 +1,10 @@
 #pragma once
+#include "Containers/Pair.h"
+#include "Graphics/BindlessSlots.h"
 #include "Graphics/Descriptor.h"
 #include "ShaderExpression.h"
 #include <atomic>
+#include <mutex>
 
 
 namespace Seele {
@@ -18,9 +21,21 @@ class Material {
     static void destroy();
     static Gfx::PDescriptorLayout getDescriptorLayout() { return layout; }
     static Gfx::PDescriptorSet getDescriptorSet() { return set; }
+    // brings the descriptor set of this frame up to date with the slots that changed since it was last used
     static void updateDescriptor();
-    static void updateTexture(uint32 index, Gfx::PTexture2D texture);
-    static void updateSampler(uint32 index, Gfx::PSampler sampler);
+    // buffers updateDescriptor writes, by the name of their render graph resource, see UploadPass
+    static Array<Pair<std::string, Gfx::PShaderBuffer>> getUploadedBuffers();
+    // textures and samplers live in one persistent array each, their slots stay the same until they are freed
+    static constexpr uint32 MAX_TEXTURES = 512;
+    static constexpr uint32 MAX_SAMPLERS = 512;
+    static uint32 allocateTexture();
+    static void freeTexture(uint32 slot);
+    static void updateTexture(uint32 slot, Gfx::PTexture2D texture);
+    static uint32 allocateSampler();
+    static void freeSampler(uint32 slot);
+    static void updateSampler(uint32 slot, Gfx::PSampler sampler);
+    // the material instances refer to the texture and sampler slots through a table of indices
+    static void updateIndex(uint32 offset, uint32 slot);
     static void updateFloatData(uint32 offset, uint32 numFloats, float* data);
     static uint32 addTextures(uint32 numTextures);
     static uint32 addSamplers(uint32 numSamplers);
@@ -58,12 +73,29 @@ class Material {
     Array<OShaderExpression> codeExpressions;
     Array<std::string> parameters;
     MaterialNode brdf;
+    static std::mutex heapLock;
+    // indexed by slot
     static Array<Gfx::PTexture2D> textures;
     static Array<Gfx::PSampler> samplers;
+    static Gfx::BindlessSlots textureSlots;
+    static Gfx::BindlessSlots samplerSlots;
+    static Array<uint32> indexData;
+    static Gfx::OShaderBuffer indexBuffer;
     static Gfx::OShaderBuffer floatBuffer;
     static Array<float> floatData;
+    // the floats or indices changed since they were uploaded
+    static bool buffersChanged;
+    // counts the uploads, every set knows the one it is bound to
+    static uint64 bufferVersion;
     static Gfx::ODescriptorLayout layout;
-    static Gfx::ODescriptorSet set;
+    static Gfx::DescriptorBindingHandle texturesBinding;
+    static Gfx::DescriptorBindingHandle samplersBinding;
+    static Gfx::DescriptorBindingHandle floatsBinding;
+    static Gfx::DescriptorBindingHandle indicesBinding;
+    // one for every frame that might still be reading, in the same order as the sets of the slots
+    static Array<Gfx::ODescriptorSet> sets;
+    static Array<uint64> setBufferVersions;
+    static Gfx::PDescriptorSet set;
     static std::atomic_uint64_t materialIdCounter;
     static Array<PMaterial> materials;
 };
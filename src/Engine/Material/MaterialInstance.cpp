@@ -23,6 +23,7 @@ MaterialInstance::MaterialInstance(uint64 id, Gfx::PGraphics graphics, Array<OSh
         parameters.add(std::move(param));
         buffer.rewind();
     }
+    updateDescriptor();
 }
 
 MaterialInstance::~MaterialInstance() {}
@@ -33,6 +34,17 @@ void MaterialInstance::updateDescriptor() {
     }
 }
 
+Array<PTextureAsset> MaterialInstance::getTextures() const {
+    Array<PTextureAsset> result;
+    for (const auto& p : parameters) {
+        PTextureParameter texture = PShaderParameter(p).cast<TextureParameter>();
+        if (texture != nullptr && texture->data != nullptr) {
+            result.add(texture->data);
+        }
+    }
+    return result;
+}
+
 void MaterialInstance::setBaseMaterial(PMaterialAsset asset) { baseMaterial = asset; }
 
 void MaterialInstance::save(ArchiveBuffer& buffer) const {
@@ -52,6 +64,7 @@ void MaterialInstance::load(ArchiveBuffer& buffer) {
     texturesOffset = Material::addTextures(numTextures);
     samplersOffset = Material::addSamplers(numSamplers);
     floatBufferOffset = Material::addFloats(numFloats);
+    updateDescriptor();
 }
 
 uint64 MaterialInstance::getCPUSize() const {
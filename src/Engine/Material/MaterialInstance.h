@@ -15,9 +15,12 @@ class MaterialInstance {
     MaterialInstance(uint64 id, Gfx::PGraphics graphics, Array<OShaderExpression>& expressions, Array<std::string> params,
                      uint32 numTextures, uint32 numSamplers, uint32 numFloats);
     ~MaterialInstance();
+    // writes the parameters into the tables of Material, they only change when the instance is created or loaded
     void updateDescriptor();
     PMaterial getBaseMaterial() const { return baseMaterial->getMaterial(); }
     uint64 getId() const { return id; }
+    // texture assets bound to the texture parameters
+    Array<PTextureAsset> getTextures() const;
 
     void setBaseMaterial(PMaterialAsset asset);
     MaterialOffsets getMaterialOffsets() const {
@@ -122,7 +122,7 @@ TextureParameter::TextureParameter(std::string name, PTextureAsset asset, uint32
 TextureParameter::~TextureParameter() {}
 
 void TextureParameter::updateDescriptorSet(uint32 textureOffset, uint32, uint32) {
-    Material::updateTexture(textureOffset + index, data->getTexture());
+    Material::updateIndex(textureOffset + index, data->getBindlessSlot());
 }
 
 std::string TextureParameter::evaluate(Map<std::string, std::string>& varState) const {
@@ -152,9 +152,19 @@ SamplerParameter::SamplerParameter(std::string name, Gfx::OSampler sampler, uint
     output.type = ExpressionType::SAMPLER;
 }
 
-SamplerParameter::~SamplerParameter() {}
+SamplerParameter::~SamplerParameter() {
+    if (slot != INVALID_SLOT) {
+        Material::freeSampler(slot);
+    }
+}
 
-void SamplerParameter::updateDescriptorSet(uint32, uint32 samplerOffset, uint32) { Material::updateSampler(samplerOffset + index, data); }
+void SamplerParameter::updateDescriptorSet(uint32, uint32 samplerOffset, uint32) {
+    if (slot == INVALID_SLOT) {
+        slot = Material::allocateSampler();
+    }
+    Material::updateSampler(slot, data);
+    Material::updateIndex(samplerOffset + index, slot);
+}
 
 std::string SamplerParameter::evaluate(Map<std::string, std::string>& varState) const {
     std::string varName = fmt::format("exp_{}", key);
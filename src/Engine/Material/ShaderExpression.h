@@ -109,7 +109,10 @@ DEFINE_REF(TextureParameter)
 DECLARE_NAME_REF(Gfx, Sampler)
 struct SamplerParameter : public ShaderParameter {
     static constexpr uint64 IDENTIFIER = 0x08;
+    static constexpr uint32 INVALID_SLOT = std::numeric_limits<uint32>::max();
     Gfx::OSampler data = nullptr;
+    // in the sampler array of Material, allocated once the parameter of an instance is bound
+    uint32 slot = INVALID_SLOT;
     SamplerParameter() {}
     SamplerParameter(std::string name, Gfx::OSampler sampler, uint32 index);
     virtual ~SamplerParameter();
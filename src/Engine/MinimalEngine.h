@@ -1,6 +1,7 @@
 #pragma once
 #include "EngineTypes.h"
 #include <assert.h>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -160,6 +161,17 @@ struct Globals {
     bool useLightCulling = true;
     bool useImagebasedLighting = true;
     bool useRayTracing = false;
+    // simulate the next frame while the current one is being rendered, see Window::render
+    bool pipelineFrames = true;
+    // record CPU zones and frame markers, see Profiler
+    // every thread checks it when it begins a zone
+    std::atomic_bool profiling = false;
+    // keep textures transcoded for this GPU in the asset cache folder, see TextureAsset::load
+    bool cacheTranscodedTextures = true;
+    // start textures out with their small mips and load the others once they are seen up close, see TextureStreamer
+    bool streamTextures = true;
+    // bytes the mips of streamed textures may take up on the GPU together
+    uint64 textureStreamingBudget = 512ull * 1024 * 1024;
     bool running = true;
 };
 Globals& getGlobals();
@@ -5,11 +5,16 @@ using namespace Seele;
 
 GameInterface::GameInterface(std::filesystem::path soPath) : lib(NULL), soPath(soPath) {}
 
+GameInterface::GameInterface(Game* game) : lib(NULL), game(game) {}
+
 GameInterface::~GameInterface() {}
 
 Game* GameInterface::getGame() { return game; }
 
 void GameInterface::reload() {
+    if (soPath.empty()) {
+        return;
+    }
     if (lib != NULL) {
         destroyInstance(game);
         dlclose(lib);
@@ -5,11 +5,16 @@ using namespace Seele;
 
 GameInterface::GameInterface(std::filesystem::path dllPath) : dllPath(dllPath) {}
 
+GameInterface::GameInterface(Game* game) : game(game) {}
+
 GameInterface::~GameInterface() {}
 
 Game* GameInterface::getGame() { return game; }
 
 void GameInterface::reload() {
+    if (dllPath.empty()) {
+        return;
+    }
     if (lib != NULL) {
         destroyInstance(game);
         FreeLibrary(lib);
@@ -8,6 +8,8 @@ namespace Seele {
 class GameInterface {
   public:
     GameInterface(std::filesystem::path dllPath);
+    // a game that is linked into the executable, reload only sets up its scene again
+    GameInterface(Game* game);
     ~GameInterface();
     Game* getGame();
     void reload();
@@ -0,0 +1,346 @@
+#include "Profiler.h"
+#include "Containers/List.h"
+#include "Containers/Map.h"
+#include "Containers/Pair.h"
+#include "Graphics/Query.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <set>
+
+using namespace Seele;
+
+namespace Seele {
+// a zone stored as words that other threads can copy while the owning thread overwrites it
+// sequence is 2 * n + 2 once the n-th zone of the thread is complete in the slot, and odd while it is being written
+struct ZoneSlot {
+    static constexpr size_t NUM_WORDS = sizeof(Profiler::Zone) / sizeof(uint64);
+    static_assert(sizeof(Profiler::Zone) % sizeof(uint64) == 0);
+    std::atomic_uint64_t sequence = 0;
+    std::atomic_uint64_t words[NUM_WORDS] = {};
+};
+
+struct ProfilerThread {
+    std::string name;
+    uint32 index = 0;
+    // only ever written by the owning thread
+    std::unique_ptr<ZoneSlot[]> zones = std::make_unique<ZoneSlot[]>(Profiler::ZONES_PER_THREAD);
+    // number of zones ever written, the ring position is head % ZONES_PER_THREAD
+    std::atomic_uint64_t head = 0;
+    // everything before this was dropped by a reset
+    std::atomic_uint64_t resetHead = 0;
+    // zones that were begun but not ended yet, they are written once they end
+    Array<Profiler::Zone> open;
+};
+
+struct ProfilerState {
+    std::mutex lock;
+    Array<ProfilerThread*> threads;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::atomic_uint64_t frameNumber = 0;
+    // frame number and begin time of the recent frames
+    List<Pair<uint64, uint64>> frames;
+    List<Profiler::Zone> gpuZones;
+    // GPU time plus this is CPU time, in nanoseconds
+    int64 gpuOffset = 0;
+    bool gpuCalibrated = false;
+    // GPU timestamp names are runtime strings, zones need names that stay around
+    std::set<std::string> names;
+    Map<std::string, List<Profiler::CounterSample>> counters;
+};
+} // namespace Seele
+
+static ProfilerState& getState() {
+    // never destroyed, workers of static thread pools might still end zones while the program exits
+    static ProfilerState* state = new ProfilerState();
+    return *state;
+}
+
+static thread_local ProfilerThread* currentThread = nullptr;
+// the ring buffer is only allocated once a thread records its first zone, until then only its name is kept
+static thread_local std::string pendingThreadName;
+
+static ProfilerThread* getThread() {
+    if (currentThread == nullptr) {
+        ProfilerState& state = getState();
+        std::unique_lock l(state.lock);
+        currentThread = new ProfilerThread();
+        currentThread->index = uint32(state.threads.size());
+        currentThread->name = pendingThreadName.empty() ? fmt::format("Thread {}", currentThread->index) : pendingThreadName;
+        state.threads.add(currentThread);
+    }
+    return currentThread;
+}
+
+static void writeZone(ProfilerThread* thread, const Profiler::Zone& zone) {
+    uint64 head = thread->head.load(std::memory_order_relaxed);
+    ZoneSlot& slot = thread->zones[head % Profiler::ZONES_PER_THREAD];
+    uint64 words[ZoneSlot::NUM_WORDS];
+    std::memcpy(words, &zone, sizeof(words));
+    slot.sequence.store(head * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < ZoneSlot::NUM_WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(head * 2 + 2, std::memory_order_release);
+    thread->head.store(head + 1, std::memory_order_release);
+}
+
+static Array<Profiler::Zone> readZones(const ProfilerThread* thread) {
+    uint64 head = thread->head.load(std::memory_order_acquire);
+    uint64 start = std::max(thread->resetHead.load(), head > Profiler::ZONES_PER_THREAD ? head - Profiler::ZONES_PER_THREAD : 0);
+    Array<Profiler::Zone> result;
+    for (uint64 i = start; i < head; ++i) {
+        const ZoneSlot& slot = thread->zones[i % Profiler::ZONES_PER_THREAD];
+        uint64 sequence = slot.sequence.load(std::memory_order_acquire);
+        // the owning thread keeps writing while this copies, zones it already overwrote or is overwriting right now are dropped
+        if (sequence != i * 2 + 2) {
+            continue;
+        }
+        uint64 words[ZoneSlot::NUM_WORDS];
+        for (size_t w = 0; w < ZoneSlot::NUM_WORDS; ++w) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        Profiler::Zone& zone = result.add();
+        std::memcpy(&zone, words, sizeof(words));
+    }
+    return result;
+}
+
+static const char* internName(ProfilerState& state, const std::string& name) { return state.names.insert(name).first->c_str(); }
+
+uint64 Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - getState().epoch).count();
+}
+
+void Profiler::beginFrame() {
+    ProfilerState& state = getState();
+    // counted even while not profiling, so GPU results read later can still be matched to their frame
+    uint64 frame = ++state.frameNumber;
+    if (!getGlobals().profiling) {
+        return;
+    }
+    std::unique_lock l(state.lock);
+    state.frames.add(Pair<uint64, uint64>{frame, now()});
+    if (state.frames.size() > ZONES_PER_THREAD) {
+        state.frames.popFront();
+    }
+}
+
+uint64 Profiler::getFrameNumber() { return getState().frameNumber; }
+
+void Profiler::setThreadName(const std::string& name) {
+    if (currentThread == nullptr) {
+        pendingThreadName = name;
+        return;
+    }
+    std::unique_lock l(getState().lock);
+    currentThread->name = name;
+}
+
+void Profiler::beginZone(const char* name, std::string_view detail) {
+    ProfilerThread* thread = getThread();
+    Zone& zone = thread->open.add();
+    zone.name = name;
+    size_t length = std::min(detail.size(), sizeof(zone.detail) - 1);
+    std::memcpy(zone.detail, detail.data(), length);
+    zone.detail[length] = '\0';
+    zone.depth = uint32(thread->open.size() - 1);
+    zone.begin = now();
+}
+
+void Profiler::endZone() {
+    ProfilerThread* thread = getThread();
+    if (thread->open.empty()) {
+        return;
+    }
+    Zone zone = thread->open.back();
+    thread->open.pop();
+    zone.end = now();
+    writeZone(thread, zone);
+}
+
+void Profiler::addGpuTimestamps(uint64 frameNumber, const Array<Gfx::Timestamp>& timestamps, double nanosecondsPerTick) {
+    if (timestamps.empty() || !getGlobals().profiling) {
+        return;
+    }
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    uint64 gpuBegin = std::numeric_limits<uint64>::max();
+    for (const auto& ts : timestamps) {
+        gpuBegin = std::min(gpuBegin, uint64(ts.time * nanosecondsPerTick));
+    }
+    for (const auto& [frame, frameBegin] : state.frames) {
+        // the offset only ever moves forward, so GPU zones of different frames keep their distances
+        if (frame == frameNumber && (!state.gpuCalibrated || int64(gpuBegin) + state.gpuOffset < int64(frameBegin))) {
+            state.gpuOffset = int64(frameBegin) - int64(gpuBegin);
+            state.gpuCalibrated = true;
+        }
+    }
+    if (!state.gpuCalibrated) {
+        return;
+    }
+    Map<std::string, uint64> begins;
+    for (const auto& ts : timestamps) {
+        uint64 time = uint64(int64(ts.time * nanosecondsPerTick) + state.gpuOffset);
+        Zone zone;
+        if (ts.name.ends_with("Begin")) {
+            begins[ts.name.substr(0, ts.name.size() - 5)] = time;
+            continue;
+        }
+        if (ts.name.ends_with("End") && begins.contains(ts.name.substr(0, ts.name.size() - 3))) {
+            std::string name = ts.name.substr(0, ts.name.size() - 3);
+            zone.name = internName(state, name);
+            zone.begin = begins[name];
+            zone.end = time;
+            begins.erase(name);
+        } else {
+            zone.name = internName(state, ts.name);
+            zone.begin = time;
+            zone.end = time;
+        }
+        state.gpuZones.add(zone);
+    }
+    // a begin without an end is still worth seeing
+    for (const auto& [name, time] : begins) {
+        Zone zone;
+        zone.name = internName(state, name + "Begin");
+        zone.begin = time;
+        zone.end = time;
+        state.gpuZones.add(zone);
+    }
+    while (state.gpuZones.size() > ZONES_PER_THREAD) {
+        state.gpuZones.popFront();
+    }
+}
+
+void Profiler::setCounter(const std::string& name, int64 value) {
+    if (!getGlobals().profiling) {
+        return;
+    }
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    List<CounterSample>& samples = state.counters[name];
+    samples.add(CounterSample{
+        .time = now(),
+        .value = value,
+    });
+    if (samples.size() > ZONES_PER_THREAD) {
+        samples.popFront();
+    }
+}
+
+Array<Profiler::CounterSample> Profiler::collectCounter(const std::string& name) {
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    Array<CounterSample> result;
+    if (state.counters.contains(name)) {
+        for (const auto& sample : state.counters[name]) {
+            result.add(sample);
+        }
+    }
+    return result;
+}
+
+Array<Profiler::Zone> Profiler::collectZones(const std::string& threadName) {
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    if (threadName == "GPU") {
+        Array<Zone> result;
+        for (const auto& zone : state.gpuZones) {
+            result.add(zone);
+        }
+        return result;
+    }
+    for (const auto& thread : state.threads) {
+        if (thread->name == threadName) {
+            return readZones(thread);
+        }
+    }
+    return {};
+}
+
+void Profiler::reset() {
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    for (auto& thread : state.threads) {
+        thread->resetHead = thread->head.load();
+    }
+    state.frames.clear();
+    state.gpuZones.clear();
+    state.gpuCalibrated = false;
+    state.counters.clear();
+}
+
+void Profiler::writeChromeTrace(const std::filesystem::path& path) {
+    ProfilerState& state = getState();
+    std::unique_lock l(state.lock);
+    constexpr uint32 cpuProcess = 1;
+    constexpr uint32 gpuProcess = 2;
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", cpuProcess}, {"args", {{"name", "CPU"}}}});
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", gpuProcess}, {"args", {{"name", "GPU"}}}});
+    // trace event times are in microseconds
+    auto addZone = [&events](const Zone& zone, uint32 pid, uint32 tid) {
+        nlohmann::json event = {
+            {"name", zone.name},
+            {"pid", pid},
+            {"tid", tid},
+            {"ts", zone.begin / 1000.0},
+        };
+        if (zone.end == zone.begin) {
+            event["ph"] = "i";
+            event["s"] = "t";
+        } else {
+            event["ph"] = "X";
+            event["dur"] = (zone.end - zone.begin) / 1000.0;
+        }
+        if (zone.detail[0] != '\0') {
+            event["args"] = {{"detail", zone.detail}};
+        }
+        events.push_back(std::move(event));
+    };
+    for (const auto& thread : state.threads) {
+        events.push_back(
+            {{"name", "thread_name"}, {"ph", "M"}, {"pid", cpuProcess}, {"tid", thread->index}, {"args", {{"name", thread->name}}}});
+        for (const auto& zone : readZones(thread)) {
+            addZone(zone, cpuProcess, thread->index);
+        }
+    }
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", gpuProcess}, {"tid", 0}, {"args", {{"name", "Graphics Queue"}}}});
+    for (const auto& zone : state.gpuZones) {
+        addZone(zone, gpuProcess, 0);
+    }
+    for (const auto& [frame, begin] : state.frames) {
+        events.push_back({
+            {"name", fmt::format("Frame {}", frame)},
+            {"ph", "i"},
+            {"s", "g"},
+            {"pid", cpuProcess},
+            {"tid", 0},
+            {"ts", begin / 1000.0},
+        });
+    }
+    for (const auto& [name, samples] : state.counters) {
+        for (const auto& sample : samples) {
+            events.push_back({
+                {"name", name},
+                {"ph", "C"},
+                {"pid", cpuProcess},
+                {"ts", sample.time / 1000.0},
+                {"args", {{"value", sample.value}}},
+            });
+        }
+    }
+    std::ofstream stream(path);
+    stream << nlohmann::json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}.dump() << std::endl;
+}
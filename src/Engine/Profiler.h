@@ -0,0 +1,83 @@
+#pragma once
+#include "Containers/Array.h"
+#include "MinimalEngine.h"
+#include <filesystem>
+#include <string>
+
+namespace Seele {
+namespace Gfx {
+struct Timestamp;
+} // namespace Gfx
+
+// CPU zones are recorded into a ring buffer per thread, so writing one never takes a lock
+// they are only recorded while getGlobals().profiling is set
+class Profiler {
+  public:
+    struct Zone {
+        // has to outlive the profiler, string literals or typeid names
+        const char* name = nullptr;
+        // optional copy of a runtime string like an asset name, cut off if too long
+        char detail[32] = {0};
+        // nanoseconds since the profiler was started
+        uint64 begin = 0;
+        uint64 end = 0;
+        // number of zones this one is nested in on its thread
+        uint32 depth = 0;
+    };
+    struct CounterSample {
+        // nanoseconds since the profiler was started
+        uint64 time = 0;
+        int64 value = 0;
+    };
+    // number of zones each thread keeps before overwriting its oldest ones
+    static constexpr uint64 ZONES_PER_THREAD = 1 << 14;
+
+    static uint64 now();
+    // frame marker, every zone after it belongs to the new frame
+    static void beginFrame();
+    static uint64 getFrameNumber();
+    static void setThreadName(const std::string& name);
+    static void beginZone(const char* name, std::string_view detail = {});
+    static void endZone();
+    // GPU timestamps of one frame, in ticks of the GPU clock
+    // pairs of "<Name>Begin" and "<Name>End" become zones, everything else a marker
+    // the GPU clock is put on the CPU timeline by assuming no GPU work of a frame started before its frame marker
+    static void addGpuTimestamps(uint64 frameNumber, const Array<Gfx::Timestamp>& timestamps, double nanosecondsPerTick);
+    // a value that is tracked over time, like the number of descriptor sets a pool created in the last frame
+    // only the newest ZONES_PER_THREAD samples of each counter are kept
+    static void setCounter(const std::string& name, int64 value);
+    static Array<CounterSample> collectCounter(const std::string& name);
+    // zones of a thread that are still in its ring buffer, oldest first
+    static Array<Zone> collectZones(const std::string& threadName);
+    // forgets everything recorded up to now
+    static void reset();
+    // trace event JSON that chrome://tracing and ui.perfetto.dev can open
+    static void writeChromeTrace(const std::filesystem::path& path);
+};
+
+class ProfileZone {
+  public:
+    ProfileZone(const char* name, std::string_view detail = {}) : active(getGlobals().profiling) {
+        if (active) {
+            Profiler::beginZone(name, detail);
+        }
+    }
+    ~ProfileZone() {
+        if (active) {
+            Profiler::endZone();
+        }
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+  private:
+    // toggling profiling inside of a zone must not leave it open
+    bool active;
+};
+} // namespace Seele
+
+#define SEELE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SEELE_PROFILE_CONCAT(a, b) SEELE_PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_ZONE(name) Seele::ProfileZone SEELE_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_ZONE_DETAIL(name, detail) Seele::ProfileZone SEELE_PROFILE_CONCAT(profileZone, __LINE__)(name, detail)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
@@ -10,39 +10,39 @@ using namespace Seele;
 LightEnvironment::LightEnvironment(Gfx::PGraphics graphics)
     : graphics(graphics), environment(AssetRegistry::findEnvironmentMap("", "newport_loft")) {
     layout = graphics->createDescriptorLayout("pLightEnv");
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    directionalLightsBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "directionalLights",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    numDirectionalLightsBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "numDirectionalLights",
         .uniformLength = sizeof(uint32),
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    pointLightsBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "pointLights",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_STORAGE_BUFFER,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    numPointLightsBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "numPointLights",
         .uniformLength = sizeof(uint32),
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    irradianceMapBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "irradianceMap",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    irradianceSamplerBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "irradianceSampler",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    prefilteredMapBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "prefilteredMap",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    brdfLUTBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "brdfLUT",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
     });
-    layout->addDescriptorBinding(Gfx::DescriptorBinding{
+    lutSamplerBinding = layout->addDescriptorBinding(Gfx::DescriptorBinding{
         .name = "lutSampler",
         .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLER,
     });
@@ -66,55 +66,60 @@ LightEnvironment::LightEnvironment(Gfx::PGraphics graphics)
 LightEnvironment::~LightEnvironment() {}
 
 void LightEnvironment::reset() {
-    layout->reset();
-    set = layout->allocateDescriptorSet();
-    dirs.clear();
-    directionalTransforms.clear();
-    points.clear();
+    updateDirs.clear();
+    updateDirectionalTransforms.clear();
+    updatePoints.clear();
 }
 
 void LightEnvironment::addDirectionalLight(const Component::DirectionalLight& dirLight, const Component::Transform& transform) {
-    dirs.add(ShaderDirectionalLight{
+    updateDirs.add(ShaderDirectionalLight{
         .color = Vector4(dirLight.color, dirLight.intensity),
         .direction = Vector4(transform.getForward(), 0),
     });
-    directionalTransforms.add(transform);
+    updateDirectionalTransforms.add(transform);
 }
 
 void LightEnvironment::addPointLight(const Component::PointLight& pointLight, const Component::Transform& transform) {
-    points.add(ShaderPointLight{
+    updatePoints.add(ShaderPointLight{
         .position_WS = Vector4(transform.getPosition(), pointLight.intensity),
         .colorRange = Vector4(pointLight.color, pointLight.attenuation),
     });
 }
 
+void LightEnvironment::commitUpdate() {
+    std::swap(dirs, updateDirs);
+    std::swap(directionalTransforms, updateDirectionalTransforms);
+    std::swap(points, updatePoints);
+}
+
 void LightEnvironment::commit() {
+    layout->reset();
+    set = layout->allocateDescriptorSet();
     directionalLights->rotateBuffer(sizeof(ShaderDirectionalLight) * dirs.size());
     directionalLights->updateContents(0, sizeof(ShaderDirectionalLight) * dirs.size(), dirs.data());
-    directionalLights->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
-                                       Gfx::SE_ACCESS_SHADER_READ_BIT | Gfx::SE_ACCESS_TRANSFER_WRITE_BIT,
-                                       Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
-                                           Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT);
     pointLights->rotateBuffer(sizeof(ShaderPointLight) * points.size());
     pointLights->updateContents(0, sizeof(ShaderPointLight) * points.size(), points.data());
-    pointLights->pipelineBarrier(Gfx::SE_ACCESS_TRANSFER_WRITE_BIT, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
-                                 Gfx::SE_ACCESS_SHADER_READ_BIT | Gfx::SE_ACCESS_TRANSFER_WRITE_BIT,
-                                 Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
-                                     Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT);
     uint32 numPointLights = (uint32)points.size();
     uint32 numDirectionalLights = (uint32)dirs.size();
-    set->updateConstants("numDirectionalLights", 0, &numDirectionalLights);
-    set->updateBuffer("directionalLights", 0, directionalLights);
-    set->updateConstants("numPointLights", 0, &numPointLights);
-    set->updateBuffer("pointLights", 0, pointLights);
-    set->updateTexture("irradianceMap", 0, environment->getIrradianceMap()->getDefaultView());
-    set->updateSampler("irradianceSampler", 0, environmentSampler);
-    set->updateTexture("prefilteredMap", 0, environment->getPrefilteredMap()->getDefaultView());
-    set->updateTexture("brdfLUT", 0, environment->getBrdfLUT()->getDefaultView());
-    set->updateSampler("lutSampler", 0, environment->getLUTSampler());
+    set->updateConstants(numDirectionalLightsBinding, 0, &numDirectionalLights);
+    set->updateBuffer(directionalLightsBinding, 0, directionalLights);
+    set->updateConstants(numPointLightsBinding, 0, &numPointLights);
+    set->updateBuffer(pointLightsBinding, 0, pointLights);
+    set->updateTexture(irradianceMapBinding, 0, environment->getIrradianceMap()->getDefaultView());
+    set->updateSampler(irradianceSamplerBinding, 0, environmentSampler);
+    set->updateTexture(prefilteredMapBinding, 0, environment->getPrefilteredMap()->getDefaultView());
+    set->updateTexture(brdfLUTBinding, 0, environment->getBrdfLUT()->getDefaultView());
+    set->updateSampler(lutSamplerBinding, 0, environment->getLUTSampler());
     set->writeChanges();
 }
 
+Array<Pair<std::string, Gfx::PShaderBuffer>> LightEnvironment::getUploadedBuffers() const {
+    return {
+        Pair<std::string, Gfx::PShaderBuffer>{"LIGHTENV_DIRECTIONAL", directionalLights},
+        Pair<std::string, Gfx::PShaderBuffer>{"LIGHTENV_POINT", pointLights},
+    };
+}
+
 const Gfx::PDescriptorLayout LightEnvironment::getDescriptorLayout() const { return layout; }
 
 Gfx::PDescriptorSet LightEnvironment::getDescriptorSet() { return set; }
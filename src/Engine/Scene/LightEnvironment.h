@@ -2,6 +2,7 @@
 #include "Component/DirectionalLight.h"
 #include "Component/PointLight.h"
 #include "Component/Transform.h"
+#include "Containers/Pair.h"
 #include "Graphics/Buffer.h"
 #include "Graphics/Descriptor.h"
 
@@ -19,10 +20,16 @@ class LightEnvironment {
     };
     LightEnvironment(Gfx::PGraphics graphics);
     ~LightEnvironment();
+    // update side, gathers the lights of the next frame
     void reset();
     void addDirectionalLight(const Component::DirectionalLight& dirLight, const Component::Transform& transform);
     void addPointLight(const Component::PointLight& pointLight, const Component::Transform& transform);
+    // hands the gathered lights over to the render side
+    void commitUpdate();
+    // render side, uploads the committed lights, called by the UploadPass of the render graph
     void commit();
+    // buffers commit writes, by the name of their render graph resource
+    Array<Pair<std::string, Gfx::PShaderBuffer>> getUploadedBuffers() const;
     const Gfx::PDescriptorLayout getDescriptorLayout() const;
     const ShaderDirectionalLight& getDirectionalLight(uint32 lightIndex) const { return dirs[lightIndex]; }
     const Component::Transform& getDirectionalTransform(uint32 lightIndex) const { return directionalTransforms[lightIndex]; }
@@ -35,12 +42,24 @@ class LightEnvironment {
     Gfx::OShaderBuffer directionalLights;
     Array<Gfx::OSampler> shadowSamplers;
     Gfx::OShaderBuffer pointLights;
+    Array<ShaderDirectionalLight> updateDirs;
+    Array<Component::Transform> updateDirectionalTransforms;
+    Array<ShaderPointLight> updatePoints;
     Array<ShaderDirectionalLight> dirs;
     Array<Component::Transform> directionalTransforms;
     Array<ShaderPointLight> points;
     PEnvironmentMapAsset environment;
     Gfx::OSampler environmentSampler;
     Gfx::ODescriptorLayout layout;
+    Gfx::DescriptorBindingHandle directionalLightsBinding;
+    Gfx::DescriptorBindingHandle numDirectionalLightsBinding;
+    Gfx::DescriptorBindingHandle pointLightsBinding;
+    Gfx::DescriptorBindingHandle numPointLightsBinding;
+    Gfx::DescriptorBindingHandle irradianceMapBinding;
+    Gfx::DescriptorBindingHandle irradianceSamplerBinding;
+    Gfx::DescriptorBindingHandle prefilteredMapBinding;
+    Gfx::DescriptorBindingHandle brdfLUTBinding;
+    Gfx::DescriptorBindingHandle lutSamplerBinding;
     Gfx::ODescriptorSet set;
 };
 DEFINE_REF(LightEnvironment)
@@ -10,7 +10,13 @@ MeshUpdater::MeshUpdater(PScene scene) : ComponentSystem<Component::Transform, C
 MeshUpdater::~MeshUpdater() {}
 
 void MeshUpdater::update(entt::entity id, Component::Transform& transform, Component::Mesh& comp) {
-    if (comp.meshletOffsets.empty()) {
+    if (comp.asset->getStatus() == Asset::Status::Loading) {
+        // a re-import is replacing the meshes
+        return;
+    }
+    if (comp.meshletOffsets.empty() || comp.revision != comp.asset->revision) {
+        comp.meshletOffsets.clear();
+        comp.revision = comp.asset->revision;
         for (uint32 i = 0; i < comp.asset->meshes.size(); ++i) {
             comp.meshletOffsets.add(comp.asset->meshes[i]->vertexData->addCullingMapping(comp.asset->meshes[i]->id));
         }
@@ -1,4 +1,6 @@
 #include "SystemGraph.h"
+#include "Profiler.h"
+#include <typeinfo>
 
 using namespace Seele;
 
@@ -6,6 +8,8 @@ void SystemGraph::addSystem(System::OSystemBase system) { systems.add(std::move(
 
 void SystemGraph::run(float deltaTime) {
     for (auto& system : systems) {
+        // the class name, mangled with some compilers but still enough to tell the systems apart
+        PROFILE_ZONE(typeid(**system).name());
         system->run(deltaTime);
     }
 }
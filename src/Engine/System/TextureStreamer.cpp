@@ -0,0 +1,110 @@
+#include "TextureStreamer.h"
+#include "Component/Camera.h"
+#include "Graphics/Mesh.h"
+#include "Profiler.h"
+
+using namespace Seele;
+using namespace Seele::System;
+
+TextureStreamer::TextureStreamer(PScene scene, Gfx::PViewport viewport)
+    : ComponentSystem<Component::Transform, Component::Mesh>(scene), viewport(viewport),
+      residency(getGlobals().textureStreamingBudget) {}
+
+TextureStreamer::~TextureStreamer() {}
+
+void TextureStreamer::run(double delta) {
+    if (!getGlobals().streamTextures) {
+        return;
+    }
+    bool foundCamera = false;
+    registry.view<Component::Camera, Component::Transform>().each([&](Component::Camera& camera, Component::Transform& transform) {
+        if (camera.mainCamera) {
+            cameraPosition = transform.getPosition();
+            cameraForward = transform.getForward();
+            foundCamera = true;
+        }
+    });
+    if (!foundCamera || viewport->getHeight() == 0) {
+        return;
+    }
+    PROFILE_ZONE("TextureStreamer");
+    ComponentSystem::run(delta);
+    residency.setBudget(getGlobals().textureStreamingBudget);
+    Array<Pair<uint32, uint32>> changes = residency.update();
+    std::unique_lock l(pendingLock);
+    for (const auto& [id, level] : changes) {
+        pending[textures[id]] = level;
+    }
+}
+
+void TextureStreamer::update(entt::entity, Component::Transform& transform, Component::Mesh& comp) {
+    const float tanHalfFov = std::tan(viewport->getFieldOfView() * 0.5f);
+    const float aspect = static_cast<float>(viewport->getWidth()) / viewport->getHeight();
+    // half the angle of the cone around the screen diagonal, anything outside of it is off-screen
+    const float halfDiagonal = std::atan(tanHalfFov * std::sqrt(1 + aspect * aspect));
+    for (uint32 i = 0; i < comp.asset->meshes.size(); ++i) {
+        PMesh mesh = comp.asset->meshes[i];
+        if (mesh->referencedMaterial == nullptr) {
+            continue;
+        }
+        const Array<uint32>& ids = getResidencyIds(mesh->referencedMaterial->getHandle());
+        if (ids.empty()) {
+            continue;
+        }
+        BoundingSphere sphere =
+            mesh->vertexData->getMeshData(mesh->id).bounding.getTransformedBox(transform.toMatrix() * mesh->transform).toSphere();
+        Vector toCenter = sphere.center - cameraPosition;
+        float distance = glm::length(toCenter);
+        // height of the bounds on the screen in pixels, orthographic views get everything at full resolution
+        float pixels = std::numeric_limits<float>::max();
+        if (viewport->getFieldOfView() > 0.0f && distance > sphere.radius) {
+            float angle = std::acos(std::clamp(glm::dot(toCenter / distance, cameraForward), -1.0f, 1.0f));
+            if (angle - std::asin(sphere.radius / distance) > halfDiagonal) {
+                continue;
+            }
+            pixels = sphere.radius / (distance * tanHalfFov) * viewport->getHeight();
+        }
+        for (uint32 id : ids) {
+            // assumes the texture is mapped once across the mesh, tiling textures end up a level or two too coarse
+            float texels = static_cast<float>(std::max(textures[id]->getWidth(), textures[id]->getHeight()));
+            uint32 level = pixels < texels ? static_cast<uint32>(std::log2(texels / pixels)) : 0;
+            residency.request(id, level);
+        }
+    }
+}
+
+void TextureStreamer::commit() {
+    std::unique_lock l(pendingLock);
+    for (const auto& [texture, level] : pending) {
+        // a re-import replaces the levels, the texture is requested again once it is done
+        if (texture->getStatus() == Asset::Status::Loading || !texture->isStreamed()) {
+            continue;
+        }
+        texture->streamTo(scene->getGraphics(), std::min(level, texture->getNumLevels() - 1));
+    }
+    pending.clear();
+}
+
+const Array<uint32>& TextureStreamer::getResidencyIds(PMaterialInstance material) {
+    auto it = materialIds.find(material);
+    if (it != materialIds.end()) {
+        return it->value;
+    }
+    Array<uint32> ids;
+    for (PTextureAsset texture : material->getTextures()) {
+        if (!texture->isStreamed()) {
+            continue;
+        }
+        if (!textureIds.contains(texture)) {
+            Array<uint64> levelSizes;
+            for (uint32 level = 0; level < texture->getNumLevels(); ++level) {
+                levelSizes.add(texture->getLevelSize(level));
+            }
+            // nothing is ever removed from the residency, so the ids are handed out in order
+            textureIds[texture] = residency.add(std::move(levelSizes), texture->getInitialLevel());
+            textures.add(texture);
+        }
+        ids.add(textureIds[texture]);
+    }
+    return materialIds[material] = std::move(ids);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Component/Mesh.h"
+#include "Component/Transform.h"
+#include "ComponentSystem.h"
+#include "Graphics/MipResidency.h"
+#include "Graphics/Window.h"
+#include <mutex>
+
+namespace Seele {
+namespace System {
+// requests the mip level the textures of a mesh would be sampled at, estimated from the size of its bounds on the screen
+// of the main camera, and decides which levels are resident within getGlobals().textureStreamingBudget
+// the textures are recreated by commit, since the systems might run on the update thread
+class TextureStreamer : public ComponentSystem<Component::Transform, Component::Mesh> {
+  public:
+    TextureStreamer(PScene scene, Gfx::PViewport viewport);
+    virtual ~TextureStreamer();
+    virtual void run(double delta) override;
+    virtual void update(entt::entity id, Component::Transform& transform, Component::Mesh& mesh) override;
+    // creates the textures whose levels changed since the last commit, on the thread whose commands get submitted
+    void commit();
+
+  private:
+    const Array<uint32>& getResidencyIds(PMaterialInstance material);
+    Gfx::PViewport viewport;
+    Gfx::MipResidency residency;
+    // indexed by residency id
+    Array<PTextureAsset> textures;
+    Map<PTextureAsset, uint32> textureIds;
+    Map<PMaterialInstance, Array<uint32>> materialIds;
+    Vector cameraPosition;
+    Vector cameraForward;
+    std::mutex pendingLock;
+    // level each texture is recreated with on the next commit
+    Map<PTextureAsset, uint32> pending;
+};
+DEFINE_REF(TextureStreamer)
+} // namespace System
+} // namespace Seele
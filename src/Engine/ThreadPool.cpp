@@ -1,6 +1,8 @@
 #include "ThreadPool.h"
 #include "MinimalEngine.h"
 #include "Graphics/Texture.h"
+#include "Profiler.h"
+#include <fmt/format.h>
 
 using namespace Seele;
 
@@ -12,7 +14,7 @@ void test(Gfx::PTexture base) { (void)base; }
 
 ThreadPool::ThreadPool(uint32 numWorkers) {
     for (uint32 i = 0; i < numWorkers; ++i) {
-        workers.add(std::thread(&ThreadPool::work, this));
+        workers.add(std::thread(&ThreadPool::work, this, i));
     }
 }
 
@@ -27,7 +29,16 @@ ThreadPool::~ThreadPool() {
     }
 }
 
+thread_local bool ThreadPool::isWorker = false;
+
 void ThreadPool::runAndWait(List<std::function<void()>> functions) {
+    if (isWorker) {
+        // every worker might be waiting like this, so nobody would be left to run the jobs
+        for (auto& func : functions) {
+            func();
+        }
+        return;
+    }
     std::unique_lock l(taskLock);
     auto newTask = runningTasks.add();
     newTask->numRemaining = functions.size();
@@ -65,7 +76,9 @@ void ThreadPool::waitIdle() {
     }
 }
 
-void ThreadPool::work() {
+void ThreadPool::work(uint32 index) {
+    Profiler::setThreadName(fmt::format("Worker {}", index));
+    isWorker = true;
     while (running) {
         std::unique_lock l(queueLock);
         while (queue.empty()) {
@@ -83,7 +96,10 @@ void ThreadPool::work() {
         auto entry = std::move(queue.front());
         queue.popFront();
         l.unlock();
-        entry.func();
+        {
+            PROFILE_ZONE("ThreadPool Job");
+            entry.func();
+        }
         l.lock();
         if (entry.task != nullptr) {
             std::unique_lock t(taskLock);
@@ -10,6 +10,7 @@ class ThreadPool {
   public:
     ThreadPool(uint32 numWorkers = 14);
     ~ThreadPool();
+    // the caller does not help with the jobs, so a worker calling this runs them itself instead of waiting on the other workers
     void runAndWait(List<std::function<void()>> functions);
     void runAsync(std::function<void()> func);
     void waitIdle();
@@ -28,7 +29,8 @@ class ThreadPool {
     std::condition_variable idleCV;
     List<QueueEntry> queue;
     
-    void work();
+    void work(uint32 index);
+    static thread_local bool isWorker;
     Array<std::thread> workers;
 
     std::mutex taskLock;
@@ -7,8 +7,10 @@
 #include "Graphics/RenderPass/LightCullingPass.h"
 #include "Graphics/RenderPass/RayTracingPass.h"
 #include "Graphics/RenderPass/ToneMappingPass.h"
+#include "Graphics/RenderPass/UploadPass.h"
 #include "Graphics/RenderPass/VisibilityPass.h"
 #include "Graphics/RenderPass/ShadowPass.h"
+#include "Profiler.h"
 #include "System/CameraUpdater.h"
 #include "System/LightGather.h"
 #include "System/MeshUpdater.h"
@@ -16,9 +18,31 @@
 
 using namespace Seele;
 
+static float elapsedMillis(std::chrono::high_resolution_clock::time_point& start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    float elapsed = std::chrono::duration<float, std::milli>(end - start).count();
+    start = end;
+    return elapsed;
+}
+
 GameView::GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreateInfo& createInfo, std::filesystem::path dllPath)
     : View(graphics, window, createInfo, "Game"), graphics(graphics), scene(new Scene(graphics)), gameInterface(dllPath) {
     reloadGame();
+    setupRenderGraphs();
+}
+
+GameView::GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreateInfo& createInfo, Game* game)
+    : View(graphics, window, createInfo, "Game"), graphics(graphics), scene(new Scene(graphics)), gameInterface(game) {
+    reloadGame();
+    setupRenderGraphs();
+}
+
+GameView::~GameView() {}
+
+void GameView::setupRenderGraphs() {
+    OUploadPass upload = new UploadPass(graphics, scene);
+    uploadPass = upload;
+    renderGraph.addPass(std::move(upload));
     renderGraph.addPass(new CachedDepthPass(graphics, scene));
     renderGraph.addPass(new DepthCullingPass(graphics, scene));
     renderGraph.addPass(new VisibilityPass(graphics));
@@ -29,6 +53,9 @@ GameView::GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreate
     renderGraph.setViewport(viewport);
     renderGraph.createRenderPass();
     if (graphics->supportRayTracing()) {
+        OUploadPass rayTracingUpload = new UploadPass(graphics, scene);
+        rayTracingUploadPass = rayTracingUpload;
+        rayTracingGraph.addPass(std::move(rayTracingUpload));
         rayTracingGraph.addPass(new RayTracingPass(graphics, scene));
         rayTracingGraph.addPass(new ToneMappingPass(graphics));
         rayTracingGraph.setViewport(viewport);
@@ -36,45 +63,74 @@ GameView::GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreate
     }
 }
 
-GameView::~GameView() {}
-
 void GameView::beginUpdate() {}
 
 void GameView::update() {
     static auto startTime = std::chrono::high_resolution_clock::now();
-    for (VertexData* vd : VertexData::getList()) {
-        vd->resetMeshData();
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    {
+        PROFILE_ZONE("MeshReset");
+        for (VertexData* vd : VertexData::getList()) {
+            vd->resetMeshData();
+        }
     }
-    systemGraph->run(updateTime);
-    scene->update(updateTime);
-    for (VertexData* vd : VertexData::getList()) {
-        vd->createDescriptors();
+    timings.meshReset = elapsedMillis(phaseStart);
+    {
+        PROFILE_ZONE("Systems");
+        systemGraph->run(updateTime);
+    }
+    timings.systems = elapsedMillis(phaseStart);
+    {
+        PROFILE_ZONE("Physics");
+        scene->update(updateTime);
     }
-    scene->getLightEnvironment()->commit();
+    timings.physics = elapsedMillis(phaseStart);
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<float> duration = (endTime - startTime);
     updateTime = duration.count();
     startTime = endTime;
 }
 
-void GameView::commitUpdate() {}
-
-void GameView::prepareRender() {}
-
-void GameView::render() {
-    Component::Camera cam;
-    Component::Transform transform;
-    scene->view<Component::Camera, Component::Transform>([&cam, &transform](Component::Camera& c, Component::Transform& t) {
+void GameView::commitUpdate() {
+    PROFILE_ZONE("CommitUpdate");
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    scene->view<Component::Camera, Component::Transform>([this](Component::Camera& c, Component::Transform& t) {
         if (c.mainCamera) {
-            cam = c;
-            transform = t;
+            renderCamera = c;
+            renderCameraTransform = t;
         }
     });
+    for (VertexData* vd : VertexData::getList()) {
+        vd->commitUpdate();
+    }
+    scene->getLightEnvironment()->commitUpdate();
+    timings.commit = elapsedMillis(phaseStart);
+}
+
+void GameView::prepareRender() {
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    {
+        // before the descriptors pick up the textures
+        PROFILE_ZONE("TextureStreaming");
+        textureStreamer->commit();
+    }
+    timings.textureStreaming = elapsedMillis(phaseStart);
+}
+
+void GameView::render() {
+    PROFILE_ZONE("RecordRenderGraph");
+    auto phaseStart = std::chrono::high_resolution_clock::now();
+    PUploadPass upload = uploadPass;
     if (getGlobals().useRayTracing && graphics->supportRayTracing()) {
-        rayTracingGraph.render(cam, transform);
+        rayTracingGraph.render(renderCamera, renderCameraTransform);
+        upload = rayTracingUploadPass;
     } else {
-        renderGraph.render(cam, transform);
+        renderGraph.render(renderCamera, renderCameraTransform);
     }
+    timings.recording = elapsedMillis(phaseStart);
+    // the uploads are the first pass of the graph, so they are part of the recording
+    timings.createDescriptors = upload->getCreateDescriptorsTime();
+    timings.lightCommit = upload->getLightCommitTime();
 }
 
 void GameView::applyArea(URect) {
@@ -93,6 +149,9 @@ void GameView::reloadGame() {
     systemGraph->addSystem(new System::LightGather(scene));
     systemGraph->addSystem(new System::MeshUpdater(scene));
     systemGraph->addSystem(new System::CameraUpdater(scene));
+    System::OTextureStreamer streamer = new System::TextureStreamer(scene, viewport);
+    textureStreamer = streamer;
+    systemGraph->addSystem(std::move(streamer));
 }
 
 void GameView::keyCallback(KeyCode code, InputAction action, KeyModifier modifier) { keyboardSystem->keyCallback(code, action, modifier); }
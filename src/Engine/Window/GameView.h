@@ -1,6 +1,7 @@
 #pragma once
 #include "Scene/Scene.h"
 #include "System/KeyboardInput.h"
+#include "System/TextureStreamer.h"
 #include "Window/View.h"
 
 #ifdef WIN32
@@ -10,9 +11,24 @@
 #endif
 
 namespace Seele {
+DECLARE_REF(UploadPass)
+// CPU time in milliseconds of the phases of a frame
+// with pipelined frames the update phases belong to the frame after the one that was rendered
+struct GameViewTimings {
+    float meshReset = 0;
+    float systems = 0;
+    float physics = 0;
+    float commit = 0;
+    float textureStreaming = 0;
+    // recorded by the UploadPass, they are included in recording
+    float createDescriptors = 0;
+    float lightCommit = 0;
+    float recording = 0;
+};
 class GameView : public View {
   public:
     GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreateInfo& createInfo, std::filesystem::path dllPath);
+    GameView(Gfx::PGraphics graphics, PWindow window, const ViewportCreateInfo& createInfo, Game* game);
     virtual ~GameView();
     virtual void beginUpdate() override;
     virtual void update() override;
@@ -22,6 +38,7 @@ class GameView : public View {
     virtual void render() override;
 
     void reloadGame();
+    const GameViewTimings& getTimings() const { return timings; }
 
   protected:
     virtual void applyArea(URect rect) override;
@@ -30,16 +47,27 @@ class GameView : public View {
     GameInterface gameInterface;
     RenderGraph renderGraph;
     RenderGraph rayTracingGraph;
+    // first pass of each graph
+    PUploadPass uploadPass;
+    PUploadPass rayTracingUploadPass;
 
     OSystemGraph systemGraph;
     System::PKeyboardInput keyboardSystem;
+    System::PTextureStreamer textureStreamer;
     float updateTime = 0;
+    GameViewTimings timings;
+    // main camera as of the last commitUpdate, the scene itself might already be simulating the next frame
+    Component::Camera renderCamera;
+    Component::Transform renderCameraTransform;
 
     virtual void keyCallback(Seele::KeyCode code, Seele::InputAction action, Seele::KeyModifier modifier) override;
     virtual void mouseMoveCallback(double xPos, double yPos) override;
     virtual void mouseButtonCallback(Seele::MouseButton button, Seele::InputAction action, Seele::KeyModifier modifier) override;
     virtual void scrollCallback(double xOffset, double yOffset) override;
     virtual void fileCallback(int count, const char** paths) override;
+
+  private:
+    void setupRenderGraphs();
 };
 DEFINE_REF(GameView)
 } // namespace Seele
@@ -1,29 +1,81 @@
 #include "Window.h"
 #include "WindowManager.h"
+#include "Profiler.h"
 #include <functional>
 
 using namespace Seele;
 
 Window::Window(PWindowManager owner, Gfx::OWindow handle) : owner(owner), gfxHandle(std::move(handle)) {
     gfxHandle->setResizeCallback([this](uint32 w, uint32 h) { onResize(w, h); });
+    updateThread = std::thread(&Window::updateLoop, this);
 }
 
-Window::~Window() {}
+Window::~Window() {
+    {
+        std::unique_lock l(updateLock);
+        running = false;
+        updateCV.notify_all();
+    }
+    updateThread.join();
+}
 
 void Window::addView(PView view) { views.add(view); }
 
 void Window::pollInputs() { gfxHandle->pollInput(); }
 
 void Window::render() {
-    gfxHandle->beginFrame();
+    PROFILE_ZONE("Window::render");
+    if (!updateReady) {
+        // first frame, or the last one was not pipelined
+        update();
+    }
+    // nothing reads the update or render side at this point, so the views can swap them
     for (auto& view : views) {
-        view->beginUpdate();
-        view->update();
         view->commitUpdate();
+    }
+    updateReady = false;
+    const bool pipelined = getGlobals().pipelineFrames;
+    if (pipelined) {
+        std::unique_lock l(updateLock);
+        updateRequested = true;
+        updateCV.notify_all();
+    }
+    gfxHandle->beginFrame();
+    for (auto& view : views) {
         view->prepareRender();
         view->render();
     }
     gfxHandle->endFrame();
+    if (pipelined) {
+        // wait for the next frame to finish simulating, so that input polling and resizing never run alongside it
+        std::unique_lock l(updateLock);
+        updateCV.wait(l, [this]() { return !updateRequested; });
+        updateReady = true;
+    }
+}
+
+void Window::update() {
+    PROFILE_ZONE("Window::update");
+    for (auto& view : views) {
+        view->beginUpdate();
+        view->update();
+    }
+}
+
+void Window::updateLoop() {
+    Profiler::setThreadName("Update");
+    std::unique_lock l(updateLock);
+    while (true) {
+        updateCV.wait(l, [this]() { return updateRequested || !running; });
+        if (!running) {
+            return;
+        }
+        l.unlock();
+        update();
+        l.lock();
+        updateRequested = false;
+        updateCV.notify_all();
+    }
 }
 
 Gfx::PWindow Window::getGfxHandle() { return gfxHandle; }
@@ -1,6 +1,8 @@
 #pragma once
 #include "Graphics/RenderTarget.h"
 #include "View.h"
+#include <condition_variable>
+#include <thread>
 
 namespace Seele {
 DECLARE_REF(WindowManager)
@@ -19,9 +21,19 @@ class Window {
     constexpr bool isPaused() const { return gfxHandle->isPaused(); }
 
   protected:
+    void update();
+    void updateLoop();
     PWindowManager owner;
     Array<PView> views;
     Gfx::OWindow gfxHandle;
+    // the views are updated for the next frame on this thread while the current frame is rendered
+    std::thread updateThread;
+    std::mutex updateLock;
+    std::condition_variable updateCV;
+    bool updateRequested = false;
+    // an update has run ahead and is waiting for the next commitUpdate
+    bool updateReady = false;
+    bool running = true;
 };
 DEFINE_REF(Window)
 } // namespace Seele
@@ -1,5 +1,6 @@
 #include "WindowManager.h"
 #include "Graphics/Graphics.h"
+#include "Profiler.h"
 
 using namespace Seele;
 
@@ -14,6 +15,7 @@ OWindow WindowManager::addWindow(Gfx::PGraphics graphics, const WindowCreateInfo
 }
 
 void WindowManager::render() {
+    Profiler::beginFrame();
     for (auto& window : windows) {
         window->pollInputs();
         if (window->isPaused())
@@ -0,0 +1,53 @@
+#include "EngineTest.h"
+#include "Graphics/BindlessSlots.h"
+
+using namespace Seele;
+
+TEST(BindlessSlots, slots_stay_stable_and_are_reused_after_free)
+{
+    Gfx::BindlessSlots slots(4);
+    ASSERT_EQ(slots.allocate(), 0);
+    ASSERT_EQ(slots.allocate(), 1);
+    ASSERT_EQ(slots.allocate(), 2);
+    slots.free(1);
+    ASSERT_FALSE(slots.isAllocated(1));
+    ASSERT_EQ(slots.allocate(), 1);
+    ASSERT_EQ(slots.allocate(), 3);
+    ASSERT_THROW(slots.allocate(), std::logic_error);
+}
+
+TEST(BindlessSlots, sets_only_write_what_changed_since_their_last_write)
+{
+    Gfx::BindlessSlots slots(16);
+    uint32 first = slots.allocate();
+    uint32 second = slots.allocate();
+    uint32 frame0 = slots.addSet();
+    ASSERT_EQ(slots.takeChanges(frame0), (Array<uint32>{first, second}));
+    ASSERT_TRUE(slots.takeChanges(frame0).empty());
+    slots.markChanged(second);
+    slots.markChanged(second);
+    // a set that is created later gets everything that is allocated
+    uint32 frame1 = slots.addSet();
+    ASSERT_EQ(slots.takeChanges(frame1), (Array<uint32>{first, second}));
+    slots.markChanged(first);
+    ASSERT_EQ(slots.takeChanges(frame1), (Array<uint32>{first}));
+    // changes pile up for a set until it is written again
+    ASSERT_EQ(slots.takeChanges(frame0), (Array<uint32>{second, first}));
+}
+
+TEST(BindlessSlots, freed_slots_are_cleared_in_every_set)
+{
+    Gfx::BindlessSlots slots(16);
+    uint32 slot = slots.allocate();
+    uint32 frame0 = slots.addSet();
+    uint32 frame1 = slots.addSet();
+    slots.takeChanges(frame0);
+    slots.takeChanges(frame1);
+    slots.free(slot);
+    ASSERT_EQ(slots.takeChanges(frame0), (Array<uint32>{slot}));
+    // handed out again before the other set was written, it writes the new contents once
+    ASSERT_EQ(slots.allocate(), slot);
+    slots.markChanged(slot);
+    ASSERT_EQ(slots.takeChanges(frame1), (Array<uint32>{slot}));
+    ASSERT_EQ(slots.takeChanges(frame0), (Array<uint32>{slot}));
+}
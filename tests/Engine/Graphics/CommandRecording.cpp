@@ -0,0 +1,73 @@
+#include "EngineTest.h"
+#include "Graphics/Null/Command.h"
+#include "Graphics/Null/Graphics.h"
+#include <thread>
+
+using namespace Seele;
+
+TEST(CommandRecording, keeps_index_order)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    constexpr uint64 NUM_COMMANDS = 64;
+    Array<Gfx::ORenderCommand> commands =
+        graphics->recordRenderCommands("Test", NUM_COMMANDS, [](Gfx::PRenderCommand command, uint64 index) {
+            // uneven amounts of work so that jobs finish out of order
+            for (uint64 i = 0; i < (NUM_COMMANDS - index) % 7 + 1; ++i) {
+                command->draw((uint32)index, 1, 0, 0);
+            }
+        });
+    ASSERT_EQ(commands.size(), NUM_COMMANDS);
+    for (uint64 i = 0; i < NUM_COMMANDS; ++i) {
+        Null::PRenderCommand command = Gfx::PRenderCommand(commands[i]).cast<Null::RenderCommand>();
+        ASSERT_EQ(command->name, "Test");
+        ASSERT_EQ(command->getStatistics().numDraws, (NUM_COMMANDS - i) % 7 + 1);
+        ASSERT_EQ(command->getStatistics().numVertices, i * ((NUM_COMMANDS - i) % 7 + 1));
+    }
+}
+
+TEST(CommandRecording, records_and_ends_on_worker_threads)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    graphics->beginRenderPass(nullptr);
+    graphics->executeCommands(graphics->recordRenderCommands("Test", 32, [](Gfx::PRenderCommand command, uint64 index) {
+        command->drawIndexed(3, (uint32)index + 1, 0, 0, 0);
+    }));
+    graphics->endRenderPass();
+    Array<Null::PRenderCommand> executed = graphics->getExecutedRenderCommands();
+    ASSERT_EQ(executed.size(), 32);
+    for (uint64 i = 0; i < executed.size(); ++i) {
+        ASSERT_EQ(executed[i]->getStatistics().numVertices, 3 * (i + 1));
+        ASSERT_TRUE(executed[i]->isEnded());
+        // the submitting thread must not touch the command pool of a worker
+        ASSERT_NE(executed[i]->getRecordingThread(), std::this_thread::get_id());
+        ASSERT_EQ(executed[i]->getEndingThread(), executed[i]->getRecordingThread());
+    }
+}
+
+TEST(CommandRecording, submission_is_deterministic)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    graphics->beginRenderPass(nullptr);
+    for (uint32 run = 0; run < 4; ++run) {
+        graphics->executeCommands(graphics->recordRenderCommands(
+            "Test", 16, [](Gfx::PRenderCommand command, uint64 index) { command->draw((uint32)index, 1, 0, 0); }));
+    }
+    graphics->endRenderPass();
+    Array<Null::PRenderCommand> executed = graphics->getExecutedRenderCommands();
+    ASSERT_EQ(executed.size(), 64);
+    for (uint64 i = 0; i < executed.size(); ++i) {
+        ASSERT_EQ(executed[i]->getStatistics().numVertices, i % 16);
+    }
+}
+
+TEST(CommandRecording, empty)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Array<Gfx::ORenderCommand> commands =
+        graphics->recordRenderCommands("Test", 0, [](Gfx::PRenderCommand, uint64) { FAIL(); });
+    ASSERT_TRUE(commands.empty());
+}
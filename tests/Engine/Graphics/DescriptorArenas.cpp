@@ -0,0 +1,66 @@
+#include "EngineTest.h"
+#include "Graphics/DescriptorArenas.h"
+
+using namespace Seele;
+
+TEST(DescriptorArenas, sets_come_back_once_their_frame_is_reused)
+{
+    Gfx::DescriptorArenas arenas;
+    auto released = [](uint32) { return true; };
+    arenas.beginFrame(1, released);
+    ASSERT_EQ(arenas.allocate(), 0);
+    ASSERT_EQ(arenas.allocate(), 1);
+    // the frames in between might still be read by the GPU
+    for (uint64 frame = 2; frame < 1 + Gfx::numFramesBuffered; ++frame) {
+        arenas.beginFrame(frame, released);
+        ASSERT_EQ(arenas.allocate(), frame);
+    }
+    arenas.beginFrame(1 + Gfx::numFramesBuffered, released);
+    uint32 first = arenas.allocate();
+    uint32 second = arenas.allocate();
+    ASSERT_LT(first, 2);
+    ASSERT_LT(second, 2);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(arenas.getStatistics().allocated, 2);
+    ASSERT_EQ(arenas.getStatistics().created, 0);
+    ASSERT_EQ(arenas.getNumSets(), Gfx::numFramesBuffered + 1);
+}
+
+TEST(DescriptorArenas, held_sets_are_retained_until_released)
+{
+    Gfx::DescriptorArenas arenas;
+    bool held = true;
+    auto released = [&held](uint32 set) { return set != 0 || !held; };
+    arenas.beginFrame(1, released);
+    ASSERT_EQ(arenas.allocate(), 0);
+    ASSERT_EQ(arenas.allocate(), 1);
+    arenas.beginFrame(1 + Gfx::numFramesBuffered, released);
+    ASSERT_EQ(arenas.getStatistics().retained, 1);
+    ASSERT_EQ(arenas.allocate(), 1);
+    ASSERT_EQ(arenas.allocate(), 2);
+    held = false;
+    arenas.beginFrame(1 + 2 * Gfx::numFramesBuffered, released);
+    ASSERT_EQ(arenas.getStatistics().retained, 0);
+    ASSERT_EQ(arenas.getNumSets(), 3);
+}
+
+TEST(DescriptorArenas, steady_frames_stop_creating_sets)
+{
+    Gfx::DescriptorArenas arenas;
+    auto released = [](uint32) { return true; };
+    for (uint64 frame = 1; frame < 1000; ++frame) {
+        arenas.beginFrame(frame, released);
+        for (uint32 i = 0; i < 16; ++i) {
+            arenas.allocate();
+        }
+    }
+    ASSERT_EQ(arenas.getStatistics().created, 0);
+    ASSERT_EQ(arenas.getNumSets(), 16 * Gfx::numFramesBuffered);
+    // skipping ahead recycles every arena exactly once
+    ASSERT_TRUE(arenas.beginFrame(5000, released));
+    ASSERT_FALSE(arenas.beginFrame(5000, released));
+    for (uint32 i = 0; i < 16 * Gfx::numFramesBuffered; ++i) {
+        arenas.allocate();
+    }
+    ASSERT_EQ(arenas.getStatistics().created, 0);
+}
@@ -0,0 +1,36 @@
+#include "EngineTest.h"
+#include "Graphics/Query.h"
+
+using namespace Seele;
+
+TEST(FrameStats, pending_queries_hide_frame)
+{
+    Gfx::FrameStatsRing ring;
+    Gfx::FrameStats stats;
+    ASSERT_FALSE(ring.get(1, stats));
+    ring.expect(1);
+    ring.expect(1);
+    ring.resolveTimestamp(1, "BaseBegin", 100);
+    ASSERT_FALSE(ring.get(1, stats));
+    ring.resolvePipelineStatistics(1, "BasePass", Gfx::PipelineStatisticsResult{.meshShaderInvocations = 42});
+    ASSERT_TRUE(ring.get(1, stats));
+    ASSERT_EQ(stats.frameNumber, 1);
+    ASSERT_EQ(stats.timestamps.at("BaseBegin"), 100);
+    ASSERT_EQ(stats.pipelineStatistics.at("BasePass").meshShaderInvocations, 42);
+}
+
+TEST(FrameStats, newer_frames_overwrite_old_ones)
+{
+    Gfx::FrameStatsRing ring;
+    Gfx::FrameStats stats;
+    ring.expect(2);
+    ring.resolveOcclusion(2, "Occlusion", Gfx::OcclusionResult{.numFragments = 5});
+    ring.expect(2 + Gfx::FrameStatsRing::NUM_FRAMES);
+    ASSERT_FALSE(ring.get(2, stats));
+    // results that arrive after their slot was reused are dropped instead of corrupting the newer frame
+    ring.resolveOcclusion(2, "Late", Gfx::OcclusionResult{.numFragments = 1});
+    ring.resolveOcclusion(2 + Gfx::FrameStatsRing::NUM_FRAMES, "Occlusion", Gfx::OcclusionResult{.numFragments = 7});
+    ASSERT_TRUE(ring.get(2 + Gfx::FrameStatsRing::NUM_FRAMES, stats));
+    ASSERT_EQ(stats.occlusion.size(), 1);
+    ASSERT_EQ(stats.occlusion.at("Occlusion").numFragments, 7);
+}
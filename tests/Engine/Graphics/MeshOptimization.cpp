@@ -0,0 +1,79 @@
+#include "EngineTest.h"
+#include "Graphics/Meshlet.h"
+#include <algorithm>
+#include <random>
+
+// regular grid with the triangles in random order, which is close to the worst case for the vertex cache
+static void makeShuffledGrid(uint32 size, Array<Vector>& positions, Array<uint32>& indices) {
+    for (uint32 y = 0; y <= size; ++y) {
+        for (uint32 x = 0; x <= size; ++x) {
+            positions.add(Vector(x, y, 0));
+        }
+    }
+    Array<StaticArray<uint32, 3>> triangles;
+    for (uint32 y = 0; y < size; ++y) {
+        for (uint32 x = 0; x < size; ++x) {
+            uint32 i = y * (size + 1) + x;
+            triangles.add({i, i + 1, i + size + 1});
+            triangles.add({i + 1, i + size + 2, i + size + 1});
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1337));
+    for (const auto& tri : triangles) {
+        indices.add(tri[0]);
+        indices.add(tri[1]);
+        indices.add(tri[2]);
+    }
+}
+
+// rotated so that the smallest index comes first, keeps the winding intact
+static Array<Array<uint32>> canonicalTriangles(const Array<uint32>& indices) {
+    Array<Array<uint32>> result;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        Array<uint32> tri = {indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        result.add(tri);
+    }
+    std::sort(result.begin(), result.end(), [](const Array<uint32>& a, const Array<uint32>& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    });
+    return result;
+}
+
+TEST(MeshOptimization, preserves_triangles)
+{
+    Array<Vector> positions;
+    Array<uint32> indices;
+    makeShuffledGrid(16, positions, indices);
+    // one vertex that no triangle references
+    positions.add(Vector(-1, -1, -1));
+    Array<uint32> original = indices;
+    Array<uint32> vertexRemap;
+    uint32 numVertices = optimizeMesh(positions, indices, vertexRemap);
+    ASSERT_EQ(numVertices, positions.size() - 1);
+    ASSERT_EQ(vertexRemap.back(), ~0u);
+    ASSERT_EQ(indices.size(), original.size());
+    for (auto& index : original) {
+        index = vertexRemap[index];
+    }
+    ASSERT_EQ(canonicalTriangles(indices), canonicalTriangles(original));
+}
+
+TEST(MeshOptimization, improves_vertex_cache)
+{
+    Array<Vector> positions;
+    Array<uint32> indices;
+    makeShuffledGrid(64, positions, indices);
+    MeshOptimizationStats before = analyzeMesh(positions, indices);
+    Array<uint32> vertexRemap;
+    uint32 numVertices = optimizeMesh(positions, indices, vertexRemap);
+    Array<Vector> optimizedPositions(numVertices);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        optimizedPositions[vertexRemap[i]] = positions[i];
+    }
+    MeshOptimizationStats after = analyzeMesh(optimizedPositions, indices);
+    ASSERT_EQ(before.numTriangles, after.numTriangles);
+    ASSERT_LT(after.getACMR(), before.getACMR());
+    ASSERT_LT(after.getACMR(), 1.0f);
+    ASSERT_GE(after.getPrimitiveFill(), before.getPrimitiveFill());
+}
@@ -0,0 +1,100 @@
+#include "EngineTest.h"
+#include "Graphics/MeshletCulling.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+// with an identity view projection, ndc == model space and the projected depth is 1 - z
+static MeshletCullingParams identityParams() {
+    return MeshletCullingParams{
+        .viewProjection = Matrix4(1.0f),
+        .cameraPosition = Vector(0, 0, -5),
+        .screenDimensions = UVector2(64, 64),
+    };
+}
+
+static MeshletBounds makeBounds(Vector center, float extent) {
+    MeshletBounds bounds;
+    bounds.bounding.adjust(center - Vector(extent));
+    bounds.bounding.adjust(center + Vector(extent));
+    bounds.sphere = BoundingSphere{
+        .center = center,
+        .radius = extent,
+    };
+    return bounds;
+}
+
+TEST(MeshletCulling, depth_pyramid_reduce)
+{
+    Array<float> depth(16, 1.0f);
+    depth[2 + 3 * 4] = 0.1f;
+    DepthPyramid pyramid(UVector2(4, 4), depth);
+    ASSERT_EQ(pyramid.getNumLevels(), 2);
+    ASSERT_EQ(pyramid.getDimensions(1), UVector2(2, 2));
+    ASSERT_EQ(pyramid.load(1, UVector2(1, 1)), 0.1f);
+    ASSERT_EQ(pyramid.load(1, UVector2(0, 0)), 1.0f);
+}
+
+TEST(MeshletCulling, frustum)
+{
+    MeshletCuller culler(identityParams());
+    Array<MeshletBounds> meshlets = {
+        makeBounds(Vector(0, 0, 0.5f), 0.1f),
+        makeBounds(Vector(3, 0, 0.5f), 0.5f),
+        makeBounds(Vector(0, -1.2f, 0.5f), 0.5f),
+    };
+    Array<uint32> visible;
+    culler.cullInstance(Matrix4(1.0f), meshlets, visible);
+    ASSERT_EQ(visible.size(), 2);
+    ASSERT_EQ(visible[0], 0);
+    ASSERT_EQ(visible[1], 2);
+    ASSERT_EQ(culler.getStats().numFrustumCulled, 1);
+}
+
+TEST(MeshletCulling, backface_cone)
+{
+    MeshletCuller culler(identityParams());
+    MeshletBounds away = makeBounds(Vector(0, 0, 0.5f), 0.1f);
+    away.cone = MeshletCone{
+        .apex = Vector(0, 0, 0.5f),
+        .cutoff = 0.5f,
+        .axis = Vector(0, 0, 1),
+    };
+    MeshletBounds towards = away;
+    towards.cone.axis = Vector(0, 0, -1);
+    Array<uint32> visible;
+    culler.cullInstance(Matrix4(1.0f), {away, towards}, visible);
+    ASSERT_EQ(visible.size(), 1);
+    ASSERT_EQ(visible[0], 1);
+    ASSERT_EQ(culler.getStats().numBackfaceCulled, 1);
+}
+
+TEST(MeshletCulling, occlusion)
+{
+    MeshletCuller culler(identityParams());
+    DepthPyramid pyramid(UVector2(64, 64), Array<float>(64 * 64, 0.5f));
+    culler.setDepthPyramid(&pyramid);
+    Array<MeshletBounds> meshlets = {
+        makeBounds(Vector(0, 0, 0.85f), 0.05f),
+        makeBounds(Vector(0, 0, 0.15f), 0.05f),
+    };
+    Array<uint32> visible;
+    culler.cullInstance(Matrix4(1.0f), meshlets, visible);
+    ASSERT_EQ(visible.size(), 1);
+    ASSERT_EQ(visible[0], 1);
+    ASSERT_EQ(culler.getStats().numOcclusionCulled, 1);
+    ASSERT_EQ(culler.getStats().getNumVisible(), 1);
+    ASSERT_FLOAT_EQ(culler.getStats().getCulledRatio(), 0.5f);
+}
+
+TEST(MeshletCulling, instance_transform)
+{
+    MeshletCuller culler(identityParams());
+    Array<MeshletBounds> meshlets = {
+        makeBounds(Vector(0, 0, 0.5f), 0.1f),
+    };
+    Array<uint32> visible;
+    culler.cullInstance(glm::translate(Matrix4(1.0f), Vector(5, 0, 0)), meshlets, visible);
+    ASSERT_EQ(visible.size(), 0);
+    culler.cullInstance(Matrix4(1.0f), meshlets, visible);
+    ASSERT_EQ(visible.size(), 1);
+    ASSERT_EQ(culler.getStats().numMeshlets, 2);
+}
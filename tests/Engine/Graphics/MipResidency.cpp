@@ -0,0 +1,84 @@
+#include "EngineTest.h"
+#include "Graphics/MipResidency.h"
+
+using namespace Seele;
+
+static Array<uint64> levelSizes() { return {64, 16, 4, 1}; }
+
+TEST(MipResidency, streams_one_level_per_frame_towards_the_request)
+{
+    Gfx::MipResidency residency(1024);
+    uint32 id = residency.add(levelSizes(), 2);
+    ASSERT_EQ(residency.getResidentLevel(id), 2);
+    ASSERT_EQ(residency.getResidentSize(), 5);
+    residency.request(id, 0);
+    auto changes = residency.update();
+    ASSERT_EQ(changes.size(), 1);
+    ASSERT_EQ(changes[0].key, id);
+    ASSERT_EQ(changes[0].value, 1);
+    residency.request(id, 0);
+    residency.update();
+    ASSERT_EQ(residency.getResidentLevel(id), 0);
+    ASSERT_EQ(residency.getResidentSize(), 85);
+    // nothing needs the room, so the levels stay until something does
+    ASSERT_TRUE(residency.update().empty());
+    ASSERT_EQ(residency.getResidentLevel(id), 0);
+}
+
+TEST(MipResidency, unrequested_levels_make_room_for_requested_ones)
+{
+    Gfx::MipResidency residency(100);
+    uint32 far = residency.add(levelSizes(), 2);
+    uint32 near = residency.add(levelSizes(), 2);
+    for (uint32 i = 0; i < 2; ++i) {
+        residency.request(far, 0);
+        residency.request(near, 3);
+        residency.update();
+    }
+    ASSERT_EQ(residency.getResidentLevel(far), 0);
+    ASSERT_EQ(residency.getResidentSize(), 90);
+    residency.request(far, 2);
+    residency.request(near, 0);
+    auto changes = residency.update();
+    ASSERT_EQ(changes.size(), 2);
+    ASSERT_EQ(residency.getResidentLevel(far), 1);
+    ASSERT_EQ(residency.getResidentLevel(near), 1);
+    residency.request(near, 0);
+    residency.update();
+    ASSERT_EQ(residency.getResidentLevel(far), 2);
+    ASSERT_EQ(residency.getResidentLevel(near), 0);
+    ASSERT_EQ(residency.getResidentSize(), 90);
+}
+
+TEST(MipResidency, lowered_budget_evicts_the_least_recently_requested_first)
+{
+    Gfx::MipResidency residency(1024);
+    uint32 first = residency.add(levelSizes(), 2);
+    uint32 second = residency.add(levelSizes(), 2);
+    for (uint32 i = 0; i < 2; ++i) {
+        residency.request(first, 0);
+        residency.request(second, 0);
+        residency.update();
+    }
+    residency.request(second, 0);
+    residency.update();
+    ASSERT_EQ(residency.getResidentSize(), 170);
+    residency.setBudget(100);
+    residency.update();
+    ASSERT_EQ(residency.getResidentLevel(first), 2);
+    ASSERT_EQ(residency.getResidentLevel(second), 0);
+    ASSERT_EQ(residency.getResidentSize(), 90);
+}
+
+TEST(MipResidency, initial_levels_stay_resident)
+{
+    Gfx::MipResidency residency(0);
+    uint32 id = residency.add(levelSizes(), 2);
+    residency.request(id, 0);
+    ASSERT_TRUE(residency.update().empty());
+    ASSERT_EQ(residency.getResidentLevel(id), 2);
+    ASSERT_EQ(residency.getResidentSize(), 5);
+    residency.remove(id);
+    ASSERT_EQ(residency.getResidentSize(), 0);
+    ASSERT_EQ(residency.add(levelSizes(), 3), id);
+}
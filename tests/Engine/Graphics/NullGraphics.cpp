@@ -0,0 +1,187 @@
+#include "EngineTest.h"
+#include "Graphics/Null/Buffer.h"
+#include "Graphics/Null/Graphics.h"
+#include "Graphics/Null/Texture.h"
+
+using namespace Seele;
+
+TEST(NullGraphics, buffer_contents)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Array<uint32> data = {1, 2, 3, 4};
+    Gfx::OShaderBuffer buffer = graphics->createShaderBuffer(ShaderBufferCreateInfo{
+        .sourceData =
+            {
+                .size = data.size() * sizeof(uint32),
+                .data = (uint8*)data.data(),
+            },
+        .numElements = data.size(),
+        .clearValue = 7,
+    });
+    uint32 update = 9;
+    buffer->updateContents(sizeof(uint32), sizeof(uint32), &update);
+    Array<uint32> result(4);
+    buffer->readContents(0, result.size() * sizeof(uint32), result.data());
+    ASSERT_EQ(result[0], 1);
+    ASSERT_EQ(result[1], 9);
+    ASSERT_EQ(result[2], 3);
+    buffer->clear();
+    buffer->readContents(0, result.size() * sizeof(uint32), result.data());
+    for (uint32 value : result) {
+        ASSERT_EQ(value, 7);
+    }
+    // allocations only grow, so shrinking keeps the data around
+    buffer->rotateBuffer(sizeof(uint32));
+    ASSERT_EQ(Gfx::PShaderBuffer(buffer).cast<Null::ShaderBuffer>()->getSize(), 4 * sizeof(uint32));
+}
+
+TEST(NullGraphics, texture_layout)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Array<uint8> pixels(16 * 8 * 4, 0xAB);
+    Gfx::OTextureCube cube = graphics->createTextureCube(TextureCreateInfo{
+        .sourceData =
+            {
+                .size = pixels.size(),
+                .data = pixels.data(),
+            },
+        .format = Gfx::SE_FORMAT_R8G8B8A8_UNORM,
+        .width = 16,
+        .height = 8,
+        .useMip = true,
+    });
+    ASSERT_EQ(cube->getNumLayers(), 6);
+    ASSERT_EQ(cube->getMipLevels(), 5);
+    Array<uint8> download;
+    cube->download(0, 0, 0, download);
+    ASSERT_EQ(download.size(), 16 * 8 * 4);
+    ASSERT_EQ(download[0], 0xAB);
+    // only the first face was uploaded
+    cube->download(0, 0, 1, download);
+    ASSERT_EQ(download[0], 0);
+    cube->download(4, 0, 5, download);
+    ASSERT_EQ(download.size(), 4);
+    Gfx::OTextureView view = cube->createTextureView(2, 1, 0, 6);
+    ASSERT_EQ(view->getWidth(), 4);
+    ASSERT_EQ(view->getHeight(), 2);
+    ASSERT_EQ(view->getMipLevels(), 1);
+}
+
+TEST(NullGraphics, texture_with_all_mip_levels)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    // levels are stored smallest first, like KTX2 does, 4x4 blocks of 16 bytes
+    Array<uint8> blocks(16 + 16 + 16 + 64);
+    std::memset(blocks.data(), 3, 16);
+    std::memset(blocks.data() + 16, 2, 16);
+    std::memset(blocks.data() + 32, 1, 16);
+    std::memset(blocks.data() + 48, 0xCD, 64);
+    Gfx::OTexture2D texture = graphics->createTexture2D(TextureCreateInfo{
+        .sourceData =
+            {
+                .size = blocks.size(),
+                .data = blocks.data(),
+            },
+        .format = Gfx::SE_FORMAT_BC7_SRGB_BLOCK,
+        .width = 8,
+        .height = 8,
+        .useMip = true,
+        .mipOffsets = {48, 32, 16, 0},
+    });
+    ASSERT_EQ(texture->getMipLevels(), 4);
+    Array<uint8> download;
+    texture->download(0, 0, 0, download);
+    ASSERT_EQ(download.size(), 64);
+    ASSERT_EQ(download[63], 0xCD);
+    texture->download(1, 0, 0, download);
+    ASSERT_EQ(download.size(), 16);
+    ASSERT_EQ(download[0], 1);
+    texture->download(3, 0, 0, download);
+    ASSERT_EQ(download[15], 3);
+}
+
+TEST(NullGraphics, command_statistics)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    graphics->executeCommands(graphics->recordRenderCommands("Test", 8, [](Gfx::PRenderCommand command, uint64 index) {
+        command->bindPipeline(Gfx::PGraphicsPipeline(nullptr));
+        command->draw(3, (uint32)index + 1, 0, 0);
+        command->drawMesh(2, 2, 1);
+    }));
+    Gfx::OComputeCommand compute = graphics->createComputeCommand("Compute");
+    compute->dispatch(4, 4, 1);
+    graphics->executeCommands(std::move(compute));
+    Null::CommandStatistics stats = graphics->getStatistics();
+    ASSERT_EQ(stats.numRenderCommands, 8);
+    ASSERT_EQ(stats.numComputeCommands, 1);
+    ASSERT_EQ(stats.numPipelineBinds, 8);
+    ASSERT_EQ(stats.numDraws, 8);
+    // 3 vertices times 1 + 2 + ... + 8 instances
+    ASSERT_EQ(stats.numVertices, 3 * 36);
+    ASSERT_EQ(stats.numMeshDraws, 8);
+    ASSERT_EQ(stats.numMeshGroups, 32);
+    ASSERT_EQ(stats.numDispatchGroups, 16);
+    graphics->resetStatistics();
+    ASSERT_EQ(graphics->getStatistics().numDraws, 0);
+}
+
+TEST(NullGraphics, descriptor_binding_handles)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Gfx::ODescriptorLayout layout = graphics->createDescriptorLayout("pTest");
+    Gfx::DescriptorBindingHandle constants = layout->addDescriptorBinding(Gfx::DescriptorBinding{
+        .name = "constants",
+        .uniformLength = sizeof(Vector4),
+    });
+    Gfx::DescriptorBindingHandle texture = layout->addDescriptorBinding(Gfx::DescriptorBinding{
+        .name = "texture",
+        .descriptorType = Gfx::SE_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    });
+    layout->create();
+    ASSERT_TRUE(constants.isValid());
+    ASSERT_NE(constants.index, texture.index);
+    ASSERT_EQ(layout->findBinding("constants").index, constants.index);
+    ASSERT_EQ(layout->findBinding("texture").index, texture.index);
+    ASSERT_FALSE(Gfx::DescriptorBindingHandle().isValid());
+    ASSERT_THROW(layout->findBinding("missing"), std::logic_error);
+    Gfx::ODescriptorSet set = layout->allocateDescriptorSet();
+    Vector4 data = Vector4(1);
+    set->updateConstants(constants, 0, &data);
+    set->updateConstants("constants", 0, &data);
+    ASSERT_THROW(set->updateConstants("missing", 0, &data), std::logic_error);
+}
+
+TEST(NullGraphics, pipelines_are_cached_by_create_info)
+{
+    Null::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Gfx::OPipelineLayout layout = graphics->createPipelineLayout("pTest", nullptr);
+    Gfx::OComputeShader shader = graphics->createComputeShader({0});
+    Gfx::OComputeShader otherShader = graphics->createComputeShader({1});
+    Gfx::PComputePipeline pipeline = graphics->createComputePipeline(Gfx::ComputePipelineCreateInfo{
+        .computeShader = shader,
+        .pipelineLayout = layout,
+    });
+    ASSERT_EQ(pipeline, graphics->createComputePipeline(Gfx::ComputePipelineCreateInfo{
+                            .computeShader = shader,
+                            .pipelineLayout = layout,
+                        }));
+    ASSERT_NE(pipeline, graphics->createComputePipeline(Gfx::ComputePipelineCreateInfo{
+                            .computeShader = otherShader,
+                            .pipelineLayout = layout,
+                        }));
+    Gfx::OMeshShader meshShader = graphics->createMeshShader({0});
+    Gfx::MeshPipelineCreateInfo meshInfo = {
+        .meshShader = meshShader,
+        .pipelineLayout = layout,
+    };
+    Gfx::PGraphicsPipeline meshPipeline = graphics->createGraphicsPipeline(meshInfo);
+    ASSERT_EQ(meshPipeline, graphics->createGraphicsPipeline(meshInfo));
+    meshInfo.rasterizationState.cullMode = Gfx::SE_CULL_MODE_NONE;
+    ASSERT_NE(meshPipeline, graphics->createGraphicsPipeline(meshInfo));
+}
@@ -0,0 +1,257 @@
+#include "EngineTest.h"
+#include "Graphics/Null/Graphics.h"
+#include "Graphics/Null/Texture.h"
+#include "Graphics/RenderPass/RenderGraph.h"
+#include "Graphics/RenderPass/RenderGraphCompiler.h"
+
+using namespace Seele;
+
+static RenderGraphAccess shaderRead(const std::string& resource,
+                                    Gfx::SePipelineStageFlags stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT)
+{
+    return RenderGraphAccess{
+        .resource = resource,
+        .access = Gfx::SE_ACCESS_SHADER_READ_BIT,
+        .stage = stage,
+    };
+}
+
+static RenderGraphAccess shaderWrite(const std::string& resource)
+{
+    return RenderGraphAccess{
+        .resource = resource,
+        .access = Gfx::SE_ACCESS_SHADER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    };
+}
+
+TEST(RenderGraph, orders_readers_after_writers)
+{
+    RenderGraphCompiler compiler;
+    // added in the wrong order on purpose
+    compiler.addPass(RenderGraphPassDesc{.name = "Lighting", .reads = {shaderRead("Depth")}, .sideEffects = true});
+    compiler.addPass(RenderGraphPassDesc{.name = "Depth", .writes = {shaderWrite("Depth")}});
+    Array<uint32> order = compiler.sortPasses();
+    ASSERT_EQ(order.size(), 2);
+    ASSERT_EQ(order[0], 1);
+    ASSERT_EQ(order[1], 0);
+}
+
+TEST(RenderGraph, previous_frame_reads_run_before_the_writer)
+{
+    RenderGraphCompiler compiler;
+    compiler.addPass(RenderGraphPassDesc{.name = "Visibility", .writes = {shaderWrite("Culling")}});
+    RenderGraphAccess history = shaderRead("Culling");
+    history.previousFrame = true;
+    compiler.addPass(RenderGraphPassDesc{.name = "Cached", .reads = {history}, .sideEffects = true});
+    Array<uint32> order = compiler.sortPasses();
+    ASSERT_EQ(order.size(), 2);
+    ASSERT_EQ(order[0], 1);
+    ASSERT_EQ(order[1], 0);
+}
+
+TEST(RenderGraph, culls_passes_without_used_outputs)
+{
+    RenderGraphCompiler compiler;
+    compiler.addPass(RenderGraphPassDesc{.name = "Shadows", .writes = {shaderWrite("Shadow")}});
+    compiler.addPass(RenderGraphPassDesc{.name = "Debug", .writes = {shaderWrite("DebugLines")}});
+    compiler.addPass(RenderGraphPassDesc{.name = "Base", .reads = {shaderRead("Shadow")}, .writes = {shaderWrite("Color")}});
+    compiler.addPass(RenderGraphPassDesc{.name = "Present", .sideEffects = true});
+    compiler.markOutput("Color");
+    Array<uint32> order = compiler.sortPasses();
+    ASSERT_EQ(order.size(), 3);
+    ASSERT_EQ(order[0], 0);
+    ASSERT_EQ(order[1], 2);
+    ASSERT_EQ(order[2], 3);
+}
+
+TEST(RenderGraph, cycles_throw)
+{
+    RenderGraphCompiler compiler;
+    compiler.addPass(RenderGraphPassDesc{.name = "A", .reads = {shaderRead("B")}, .writes = {shaderWrite("A")}, .sideEffects = true});
+    compiler.addPass(RenderGraphPassDesc{.name = "B", .reads = {shaderRead("A")}, .writes = {shaderWrite("B")}, .sideEffects = true});
+    ASSERT_THROW(compiler.sortPasses(), std::logic_error);
+}
+
+TEST(RenderGraph, barriers_only_where_needed)
+{
+    RenderGraphCompiler compiler;
+    compiler.addPass(RenderGraphPassDesc{.name = "Write", .writes = {shaderWrite("Buffer")}});
+    compiler.addPass(RenderGraphPassDesc{.name = "ReadA", .reads = {shaderRead("Buffer"), shaderRead("External")}, .sideEffects = true});
+    // same stage and access as the read before, already covered by its barrier
+    compiler.addPass(RenderGraphPassDesc{.name = "ReadB", .reads = {shaderRead("Buffer")}, .sideEffects = true});
+    compiler.addPass(RenderGraphPassDesc{
+        .name = "ReadC",
+        .reads = {shaderRead("Buffer", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT)},
+        .sideEffects = true,
+    });
+    RenderGraphSchedule schedule = compiler.compile();
+    ASSERT_EQ(schedule.order.size(), 4);
+    // the write waits for the reads of the frame before
+    ASSERT_EQ(schedule.barriers[0].size(), 1);
+    ASSERT_EQ(schedule.barriers[0][0].srcStage, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT | Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    ASSERT_EQ(schedule.barriers[0][0].dstAccess, Gfx::SE_ACCESS_SHADER_WRITE_BIT);
+    // nothing in the graph writes External, so only Buffer needs one
+    ASSERT_EQ(schedule.barriers[1].size(), 1);
+    ASSERT_EQ(schedule.barriers[1][0].resource, "Buffer");
+    ASSERT_EQ(schedule.barriers[1][0].srcAccess, Gfx::SE_ACCESS_SHADER_WRITE_BIT);
+    ASSERT_EQ(schedule.barriers[1][0].srcStage, Gfx::SE_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    ASSERT_EQ(schedule.barriers[2].size(), 0);
+    ASSERT_EQ(schedule.barriers[3].size(), 1);
+    ASSERT_EQ(schedule.barriers[3][0].dstStage, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
+
+TEST(RenderGraph, layout_transitions)
+{
+    RenderGraphCompiler compiler;
+    RenderGraphAccess color = {
+        .resource = "Color",
+        .access = Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    };
+    RenderGraphAccess sampled = shaderRead("Color", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    sampled.layout = Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    compiler.addPass(RenderGraphPassDesc{.name = "Base", .writes = {color}});
+    compiler.addPass(RenderGraphPassDesc{.name = "ToneMapping", .reads = {sampled}, .sideEffects = true});
+    compiler.addPass(RenderGraphPassDesc{.name = "Bloom", .reads = {sampled}, .sideEffects = true});
+    RenderGraphSchedule schedule = compiler.compile();
+    // the render pass of Base transitions the attachment itself, so the graph only waits for the reads
+    ASSERT_EQ(schedule.barriers[0].size(), 1);
+    ASSERT_EQ(schedule.barriers[0][0].newLayout, Gfx::SE_IMAGE_LAYOUT_UNDEFINED);
+    ASSERT_EQ(schedule.barriers[1].size(), 1);
+    ASSERT_EQ(schedule.barriers[1][0].newLayout, Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    ASSERT_EQ(schedule.barriers[1][0].srcAccess, Gfx::SE_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    ASSERT_EQ(schedule.barriers[2].size(), 0);
+}
+
+TEST(RenderGraph, async_compute_hands_resources_over)
+{
+    RenderGraphCompiler compiler;
+    compiler.addPass(RenderGraphPassDesc{.name = "Depth", .writes = {shaderWrite("Depth")}});
+    compiler.addPass(RenderGraphPassDesc{
+        .name = "LightCulling",
+        .reads = {shaderRead("Depth")},
+        .writes = {shaderWrite("LightList")},
+        .queue = Gfx::QueueType::COMPUTE,
+    });
+    compiler.addPass(RenderGraphPassDesc{.name = "Shadows", .writes = {shaderWrite("Shadow")}});
+    compiler.addPass(RenderGraphPassDesc{
+        .name = "Base",
+        .reads = {shaderRead("Shadow", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT),
+                  shaderRead("LightList", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT)},
+        .sideEffects = true,
+    });
+    RenderGraphSchedule schedule = compiler.compile();
+    ASSERT_EQ(schedule.order.size(), 4);
+    ASSERT_EQ(schedule.queues[1], Gfx::QueueType::COMPUTE);
+    // the depth of this frame goes over to the compute queue
+    ASSERT_EQ(schedule.queueWaits[1].size(), 1);
+    ASSERT_EQ(schedule.queueWaits[1][0], Gfx::QueueType::GRAPHICS);
+    ASSERT_EQ(schedule.barriers[1].size(), 2);
+    for (const auto& barrier : schedule.barriers[1]) {
+        ASSERT_EQ(barrier.srcQueue, Gfx::QueueType::GRAPHICS);
+        ASSERT_EQ(barrier.dstQueue, Gfx::QueueType::COMPUTE);
+    }
+    // the shadows do not need anything from the compute queue, so they overlap with the light culling
+    ASSERT_EQ(schedule.queueWaits[2].size(), 0);
+    ASSERT_EQ(schedule.queueWaits[3].size(), 1);
+    ASSERT_EQ(schedule.queueWaits[3][0], Gfx::QueueType::COMPUTE);
+    // and the depth comes back before the next frame overwrites it
+    ASSERT_EQ(schedule.queueWaits[0].size(), 1);
+    ASSERT_EQ(schedule.queueWaits[0][0], Gfx::QueueType::COMPUTE);
+    ASSERT_EQ(schedule.barriers[0][0].srcQueue, Gfx::QueueType::COMPUTE);
+    ASSERT_EQ(schedule.barriers[0][0].dstQueue, Gfx::QueueType::GRAPHICS);
+}
+
+TEST(RenderGraph, uploads_are_synchronized_with_their_readers)
+{
+    RenderGraphCompiler compiler;
+    RenderGraphAccess upload = {
+        .resource = "Lights",
+        .access = Gfx::SE_ACCESS_TRANSFER_WRITE_BIT,
+        .stage = Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT,
+    };
+    compiler.addPass(RenderGraphPassDesc{.name = "Upload", .writes = {upload}});
+    compiler.addPass(RenderGraphPassDesc{.name = "LightCulling", .reads = {shaderRead("Lights")}, .sideEffects = true,
+                                         .queue = Gfx::QueueType::COMPUTE});
+    compiler.addPass(RenderGraphPassDesc{
+        .name = "Base",
+        .reads = {shaderRead("Lights", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT)},
+        .sideEffects = true,
+    });
+    RenderGraphSchedule schedule = compiler.compile();
+    ASSERT_EQ(schedule.order.size(), 3);
+    ASSERT_EQ(schedule.order[0], 0);
+    // the transfer write goes over to the compute queue
+    ASSERT_EQ(schedule.barriers[1].size(), 1);
+    ASSERT_EQ(schedule.barriers[1][0].srcAccess, Gfx::SE_ACCESS_TRANSFER_WRITE_BIT);
+    ASSERT_EQ(schedule.barriers[1][0].srcStage, Gfx::SE_PIPELINE_STAGE_TRANSFER_BIT);
+    ASSERT_EQ(schedule.barriers[1][0].dstQueue, Gfx::QueueType::COMPUTE);
+    // and comes back for the fragment shader
+    ASSERT_EQ(schedule.barriers[2].size(), 1);
+    ASSERT_EQ(schedule.barriers[2][0].srcAccess, Gfx::SE_ACCESS_TRANSFER_WRITE_BIT);
+    ASSERT_EQ(schedule.barriers[2][0].dstStage, Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    ASSERT_EQ(schedule.barriers[2][0].dstQueue, Gfx::QueueType::GRAPHICS);
+}
+
+class MockPass : public RenderPass
+{
+  public:
+    MockPass(Gfx::PGraphics graphics, const std::string& name, Array<std::string>& log) : RenderPass(graphics), name(name), log(log) {}
+    virtual ~MockPass() {}
+    virtual void beginFrame(const Component::Camera&, const Component::Transform&) override {}
+    virtual void render() override { log.add(name); }
+    virtual void endFrame() override {}
+    virtual void publishOutputs() override
+    {
+        if (!output.empty()) {
+            texture = graphics->createTexture2D(TextureCreateInfo{.width = 4, .height = 4, .name = output});
+            resources->registerTextureOutput(output, Gfx::PTexture2D(texture));
+        }
+    }
+    virtual void createRenderPass() override {}
+    void read(RenderGraphAccess access) { declareRead(std::move(access)); }
+    void write(RenderGraphAccess access) { declareWrite(std::move(access)); }
+    void setSideEffects() { declaration.sideEffects = true; }
+    std::string output;
+
+  private:
+    Gfx::OTexture2D texture;
+    std::string name;
+    Array<std::string>& log;
+};
+DEFINE_REF(MockPass)
+
+TEST(RenderGraph, executes_the_schedule)
+{
+    Gfx::OGraphics graphics = new Null::Graphics();
+    graphics->init(GraphicsInitializer());
+    Array<std::string> log;
+    RenderGraph graph;
+
+    OMockPass unused = new MockPass(graphics, "Unused", log);
+    unused->write(shaderWrite("Unused"));
+    unused->output = "Unused";
+    OMockPass producer = new MockPass(graphics, "Producer", log);
+    producer->write(shaderWrite("Color"));
+    producer->output = "Color";
+    OMockPass consumer = new MockPass(graphics, "Consumer", log);
+    RenderGraphAccess sampled = shaderRead("Color", Gfx::SE_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    sampled.layout = Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    consumer->read(sampled);
+    consumer->setSideEffects();
+
+    graph.addPass(std::move(consumer));
+    graph.addPass(std::move(unused));
+    graph.addPass(std::move(producer));
+    graph.createRenderPass();
+    graph.render(Component::Camera(), Component::Transform());
+
+    ASSERT_EQ(log.size(), 2);
+    ASSERT_EQ(log[0], "Producer");
+    ASSERT_EQ(log[1], "Consumer");
+    // culled passes do not publish their outputs
+    ASSERT_THROW(graph.getResources()->requestTexture("Unused"), std::logic_error);
+    Gfx::PTexture color = graph.getResources()->requestTexture("Color");
+    ASSERT_EQ(color.cast<Null::Texture2D>()->getLayout(), Gfx::SE_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
@@ -0,0 +1,49 @@
+#include "EngineTest.h"
+#include "Graphics/RingAllocator.h"
+
+using namespace Seele;
+
+TEST(RingAllocator, allocates_linearly_with_alignment)
+{
+	Gfx::RingAllocator ring(1024);
+	ASSERT_EQ(ring.allocate(10, 4), 0);
+	ASSERT_EQ(ring.allocate(10, 16), 16);
+	ASSERT_EQ(ring.allocate(8, 1), 26);
+	ASSERT_EQ(ring.getUsed(), 34);
+	ASSERT_TRUE(ring.hasUnsubmitted());
+}
+
+TEST(RingAllocator, regions_are_reused_once_their_submission_completed)
+{
+	Gfx::RingAllocator ring(256);
+	ASSERT_EQ(ring.allocate(128, 16), 0);
+	ring.submit(1);
+	ASSERT_EQ(ring.allocate(128, 16), 128);
+	ring.submit(2);
+	ASSERT_FALSE(ring.hasUnsubmitted());
+	// everything is still read by the GPU
+	ASSERT_EQ(ring.allocate(16, 16), Gfx::RingAllocator::INVALID_OFFSET);
+	ASSERT_EQ(ring.getOldestPending(), 1);
+	ring.complete(1);
+	ASSERT_EQ(ring.getOldestPending(), 2);
+	ASSERT_EQ(ring.allocate(16, 16), 0);
+	ring.submit(3);
+	ring.complete(3);
+	ASSERT_EQ(ring.getOldestPending(), 0);
+	ASSERT_EQ(ring.getUsed(), 0);
+}
+
+TEST(RingAllocator, regions_do_not_wrap_around_the_end)
+{
+	Gfx::RingAllocator ring(256);
+	ASSERT_EQ(ring.allocate(200, 16), 0);
+	ring.submit(1);
+	// the 56 bytes at the end are too small, but the start is still in use
+	ASSERT_EQ(ring.allocate(100, 16), Gfx::RingAllocator::INVALID_OFFSET);
+	ring.complete(1);
+	ASSERT_EQ(ring.allocate(100, 16), 0);
+	// the skipped end counts as used until the region after it completes
+	ASSERT_EQ(ring.getUsed(), 156);
+	ASSERT_EQ(ring.allocate(256, 16), Gfx::RingAllocator::INVALID_OFFSET);
+	ASSERT_EQ(ring.allocate(300, 16), Gfx::RingAllocator::INVALID_OFFSET);
+}
@@ -0,0 +1,43 @@
+#include "EngineTest.h"
+#include "Graphics/Shader.h"
+
+using namespace Seele::Gfx;
+
+TEST(ShaderPermutation, equal_permutations)
+{
+    ShaderPermutation a;
+    a.setVertexFile("LegacyBasePass");
+    a.setMaterial("Material", "Phong");
+    ShaderPermutation b;
+    b.setVertexFile("LegacyBasePass");
+    b.setMaterial("Material", "Phong");
+    ASSERT_EQ(PermutationId(a), PermutationId(b));
+    ASSERT_EQ(PermutationId(a).hash, PermutationId(b).hash);
+}
+
+TEST(ShaderPermutation, different_permutations)
+{
+    ShaderPermutation a;
+    a.setVertexFile("LegacyBasePass");
+    ShaderPermutation b = a;
+    b.setDepthCulling(true);
+    ASSERT_NE(PermutationId(a), PermutationId(b));
+}
+
+TEST(ShaderPermutation, hash_collision)
+{
+    ShaderPermutation a;
+    a.setVertexFile("LegacyBasePass");
+    ShaderPermutation b = a;
+    b.setPositionOnly(true);
+    PermutationId idA(a);
+    PermutationId idB(b);
+    // a colliding hash must not make two different permutations equal
+    idB.hash = idA.hash;
+    ASSERT_NE(idA, idB);
+    std::unordered_map<PermutationId, uint32, PermutationIdHasher> ids;
+    ids[idA] = 1;
+    ids[idB] = 2;
+    ASSERT_EQ(ids.size(), 2);
+    ASSERT_EQ(ids[idA], 1);
+}
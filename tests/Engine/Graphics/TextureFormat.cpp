@@ -0,0 +1,42 @@
+#include "EngineTest.h"
+#include "Graphics/TextureFormat.h"
+
+using namespace Seele;
+
+static bool desktop(Gfx::SeFormat format) { return format >= Gfx::SE_FORMAT_BC1_RGB_UNORM_BLOCK && format <= Gfx::SE_FORMAT_BC7_SRGB_BLOCK; }
+
+static bool mobile(Gfx::SeFormat format) {
+    return format >= Gfx::SE_FORMAT_ETC2_R8G8B8_UNORM_BLOCK && format <= Gfx::SE_FORMAT_ASTC_4x4_SRGB_BLOCK;
+}
+
+TEST(TextureFormat, desktop_uses_bc)
+{
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR, desktop), Gfx::SE_FORMAT_BC7_SRGB_BLOCK);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR_ALPHA, desktop), Gfx::SE_FORMAT_BC7_SRGB_BLOCK);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::NORMAL, desktop), Gfx::SE_FORMAT_BC5_UNORM_BLOCK);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::SINGLE_CHANNEL, desktop), Gfx::SE_FORMAT_BC4_UNORM_BLOCK);
+}
+
+TEST(TextureFormat, falls_back_to_older_bc)
+{
+    auto noBC7 = [](Gfx::SeFormat format) { return desktop(format) && format != Gfx::SE_FORMAT_BC7_SRGB_BLOCK; };
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR, noBC7), Gfx::SE_FORMAT_BC1_RGB_SRGB_BLOCK);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR_ALPHA, noBC7), Gfx::SE_FORMAT_BC3_SRGB_BLOCK);
+}
+
+TEST(TextureFormat, mobile_uses_astc_and_eac)
+{
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR, mobile), Gfx::SE_FORMAT_ASTC_4x4_SRGB_BLOCK);
+    // ASTC would put x into all color channels
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::NORMAL, mobile), Gfx::SE_FORMAT_EAC_R11G11_UNORM_BLOCK);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::SINGLE_CHANNEL, mobile), Gfx::SE_FORMAT_EAC_R11_UNORM_BLOCK);
+    auto etcOnly = [](Gfx::SeFormat format) { return mobile(format) && format < Gfx::SE_FORMAT_ASTC_4x4_UNORM_BLOCK; };
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR_ALPHA, etcOnly), Gfx::SE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK);
+}
+
+TEST(TextureFormat, uncompressed_without_support)
+{
+    auto nothing = [](Gfx::SeFormat) { return false; };
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::COLOR, nothing), Gfx::SE_FORMAT_R8G8B8A8_SRGB);
+    ASSERT_EQ(Gfx::chooseTextureFormat(Gfx::TextureContent::NORMAL, nothing), Gfx::SE_FORMAT_R8G8B8A8_UNORM);
+}
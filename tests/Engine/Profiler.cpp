@@ -0,0 +1,118 @@
+#include "EngineTest.h"
+#include "Graphics/Query.h"
+#include "Profiler.h"
+#include <atomic>
+#include <thread>
+
+// every test records on its own thread, so the zones of the others do not show up
+
+TEST(Profiler, nested_zones)
+{
+    getGlobals().profiling = true;
+    std::thread([]() {
+        Profiler::setThreadName("NestedZones");
+        PROFILE_ZONE("Outer");
+        {
+            PROFILE_ZONE_DETAIL("Inner", "Textures/a_rather_long_asset_name_that_gets_cut");
+        }
+    }).join();
+    getGlobals().profiling = false;
+    Array<Profiler::Zone> zones = Profiler::collectZones("NestedZones");
+    ASSERT_EQ(zones.size(), 2);
+    // zones are written when they end, so the inner one comes first
+    ASSERT_STREQ(zones[0].name, "Inner");
+    ASSERT_EQ(zones[0].depth, 1);
+    ASSERT_EQ(std::string(zones[0].detail).size(), sizeof(zones[0].detail) - 1);
+    ASSERT_STREQ(zones[1].name, "Outer");
+    ASSERT_EQ(zones[1].depth, 0);
+    ASSERT_LE(zones[1].begin, zones[0].begin);
+    ASSERT_GE(zones[1].end, zones[0].end);
+}
+
+TEST(Profiler, disabled_records_nothing)
+{
+    getGlobals().profiling = false;
+    std::thread([]() {
+        Profiler::setThreadName("Disabled");
+        PROFILE_ZONE("Zone");
+    }).join();
+    ASSERT_EQ(Profiler::collectZones("Disabled").size(), 0);
+}
+
+TEST(Profiler, ring_keeps_newest_zones)
+{
+    getGlobals().profiling = true;
+    std::thread([]() {
+        Profiler::setThreadName("Ring");
+        for (uint64 i = 0; i < Profiler::ZONES_PER_THREAD + 10; ++i) {
+            PROFILE_ZONE(i < 10 ? "Old" : "New");
+        }
+    }).join();
+    getGlobals().profiling = false;
+    Array<Profiler::Zone> zones = Profiler::collectZones("Ring");
+    ASSERT_EQ(zones.size(), Profiler::ZONES_PER_THREAD);
+    for (const auto& zone : zones) {
+        ASSERT_STREQ(zone.name, "New");
+    }
+}
+
+TEST(Profiler, zones_collected_while_recording_are_complete)
+{
+    getGlobals().profiling = true;
+    std::atomic_bool done = false;
+    std::thread writer([&done]() {
+        Profiler::setThreadName("Concurrent");
+        for (uint64 i = 0; i < 4 * Profiler::ZONES_PER_THREAD; ++i) {
+            PROFILE_ZONE_DETAIL("Zone", "detail");
+        }
+        done = true;
+    });
+    uint64 broken = 0;
+    while (!done) {
+        for (const auto& zone : Profiler::collectZones("Concurrent")) {
+            if (zone.name == nullptr || std::string(zone.detail) != "detail" || zone.end < zone.begin) {
+                broken++;
+            }
+        }
+    }
+    writer.join();
+    getGlobals().profiling = false;
+    ASSERT_EQ(broken, 0);
+}
+
+TEST(Profiler, gpu_timestamps_follow_frame_marker)
+{
+    getGlobals().profiling = true;
+    Profiler::reset();
+    Profiler::beginFrame();
+    uint64 frameBegin = Profiler::now();
+    Array<Gfx::Timestamp> timestamps;
+    timestamps.add(Gfx::Timestamp{.name = "BaseBegin", .time = 100});
+    timestamps.add(Gfx::Timestamp{.name = "BaseEnd", .time = 150});
+    timestamps.add(Gfx::Timestamp{.name = "Present", .time = 160});
+    Profiler::addGpuTimestamps(Profiler::getFrameNumber(), timestamps, 2.0);
+    getGlobals().profiling = false;
+    Array<Profiler::Zone> zones = Profiler::collectZones("GPU");
+    ASSERT_EQ(zones.size(), 2);
+    ASSERT_STREQ(zones[0].name, "Base");
+    ASSERT_EQ(zones[0].end - zones[0].begin, 100);
+    ASSERT_LE(zones[0].begin, frameBegin);
+    ASSERT_STREQ(zones[1].name, "Present");
+    ASSERT_EQ(zones[1].begin, zones[0].end + 20);
+}
+
+TEST(Profiler, counters_keep_their_samples)
+{
+    getGlobals().profiling = true;
+    Profiler::reset();
+    Profiler::setCounter("Sets", 3);
+    Profiler::setCounter("Sets", 5);
+    getGlobals().profiling = false;
+    Profiler::setCounter("Sets", 7);
+    Array<Profiler::CounterSample> samples = Profiler::collectCounter("Sets");
+    ASSERT_EQ(samples.size(), 2);
+    ASSERT_EQ(samples[0].value, 3);
+    ASSERT_EQ(samples[1].value, 5);
+    ASSERT_LE(samples[0].time, samples[1].time);
+    ASSERT_EQ(Profiler::collectCounter("Unknown").size(), 0);
+}